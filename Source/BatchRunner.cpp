@@ -0,0 +1,221 @@
+#include "BatchRunner.h"
+#include "Decompressor.h"
+#include "Parallel.h"
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <glob.h>
+#include <sys/stat.h>
+
+namespace {
+
+bool isPattern(const std::string& argument) {
+    return argument.find_first_of("*?[") != std::string::npos;
+}
+
+// Files matching a pattern, in sorted order
+void expandPattern(const std::string& pattern, std::vector<std::string>& inputs) {
+    glob_t matches;
+    int status = glob(pattern.c_str(), 0, nullptr, &matches);
+    if (status != 0) {
+        if (status != GLOB_NOMATCH) globfree(&matches);
+        throw std::runtime_error("No input file matches: " + pattern);
+    }
+    for (std::size_t i = 0; i < matches.gl_pathc; ++i) {
+        inputs.push_back(matches.gl_pathv[i]);
+    }
+    globfree(&matches);
+}
+
+void expandArgument(const std::string& argument, std::vector<std::string>& inputs) {
+    if (isPattern(argument)) {
+        expandPattern(argument, inputs);
+    } else {
+        inputs.push_back(argument);
+    }
+}
+
+std::uint64_t fileSize(const std::string& filename) {
+    struct stat status;
+    return stat(filename.c_str(), &status) == 0 ? static_cast<std::uint64_t>(status.st_size) : 0;
+}
+
+}
+
+std::vector<std::string> expandInputs(const std::vector<std::string>& arguments) {
+    std::vector<std::string> inputs;
+    for (const std::string& argument : arguments) {
+        if (argument.size() > 1 && argument[0] == '@') {
+            std::ifstream manifest(argument.substr(1));
+            if (!manifest) {
+                throw std::runtime_error("Cannot open the manifest: " + argument.substr(1));
+            }
+            std::string line;
+            while (std::getline(manifest, line)) {
+                line.erase(0, line.find_first_not_of(" \t"));
+                line.erase(line.find_last_not_of(" \t\r") + 1);
+                if (line.empty() || line[0] == '#') continue;
+                expandArgument(line, inputs);
+            }
+        } else {
+            expandArgument(argument, inputs);
+        }
+    }
+    return inputs;
+}
+
+std::string resultName(const std::string& input, const std::string& extension) {
+    std::string name = uncompressedName(input);
+    std::size_t slash = name.find_last_of('/');
+    if (slash != std::string::npos) name = name.substr(slash + 1);
+    std::size_t dot = name.find_last_of('.');
+    if (dot != std::string::npos && dot > 0) name = name.substr(0, dot);
+    return "result_" + name + extension;
+}
+
+template<typename Scalar>
+BatchRunner<Scalar>::BatchRunner(const BatchOptions& options) : mOptions(options) {
+    outputExtension(mOptions.format);
+}
+
+// The jobs are submitted from the largest file to the smallest, and their result files are named beforehand,
+// in input order, so that inputs with the same name get distinct files whatever the order they finish in
+template<typename Scalar>
+BatchStats BatchRunner<Scalar>::run(const std::vector<std::string>& inputs, std::ostream& log) {
+    auto start = std::chrono::steady_clock::now();
+    BatchStats stats;
+    stats.jobs = static_cast<long>(inputs.size());
+
+    const std::string extension = outputExtension(mOptions.format);
+    std::vector<std::string> outputs;
+    std::map<std::string, int> uses;
+    for (const std::string& input : inputs) {
+        std::string name = resultName(input, extension);
+        int use = ++uses[name];
+        if (use > 1) name = resultName(input, "_" + std::to_string(use) + extension);
+        outputs.push_back(mOptions.outputDirectory + "/" + name);
+    }
+
+    std::vector<std::uint64_t> sizes(inputs.size());
+    for (std::size_t i = 0; i < inputs.size(); ++i) sizes[i] = fileSize(inputs[i]);
+    std::vector<std::size_t> order(inputs.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return sizes[a] > sizes[b]; });
+
+    const int jobs = std::min<int>(mOptions.jobs < 1 ? defaultThreadCount() : mOptions.jobs,
+                                   std::max<int>(1, static_cast<int>(inputs.size())));
+    const int threads = mOptions.threads >= 0 ? mOptions.threads : (jobs > 1 ? 1 : -1);
+
+    std::unique_ptr<ResultCache> cache;
+    if (!mOptions.cacheDirectory.empty()) {
+        cache.reset(new ResultCache(mOptions.cacheDirectory, mOptions.cacheBytes));
+    }
+    Solutions solutions;
+    solutions.cache = cache.get();
+
+    std::mutex mutex;
+    {
+        WorkStealingPool pool(jobs);
+        for (std::size_t i : order) {
+            pool.submit([&, i] {
+                auto jobStart = std::chrono::steady_clock::now();
+                std::string summary, error;
+                Origin origin = Origin::Solved;
+                try {
+                    summary = runJob(inputs[i], outputs[i], threads, solutions, origin);
+                } catch (const std::exception& e) {
+                    error = e.what();
+                }
+                double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - jobStart).count();
+
+                std::lock_guard<std::mutex> lock(mutex);
+                stats.jobSeconds += seconds;
+                if (error.empty()) {
+                    stats.solved++;
+                    stats.cached += origin == Origin::Cached;
+                    stats.duplicates += origin == Origin::Duplicate;
+                    log << inputs[i] << " -> " << outputs[i] << ": " << summary << ", " << seconds << " s" << std::endl;
+                } else {
+                    stats.failed++;
+                    log << inputs[i] << " failed: " << error << std::endl;
+                }
+            });
+        }
+        pool.wait();
+        stats.stolen = pool.stolenCount();
+    }
+    stats.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+template<typename Scalar>
+std::string BatchRunner<Scalar>::runJob(const std::string& input, const std::string& outputFile, int threads,
+                                        Solutions& solutions, Origin& origin) const {
+    std::unique_ptr<Reader<Scalar>> reader = createReader<Scalar>(input);
+    Parameters params = reader->ReadParameters();
+    if (!mOptions.algorithm.empty()) params.setAlgorithm(mOptions.algorithm);
+    if (threads >= 0) params.setThreads(threads);
+    if (!params.validate()) {
+        throw std::runtime_error("Invalid parameters");
+    }
+    Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> matrixA = reader->ReadMatrix();
+    Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> matrixB = reader->ReadMatrixB();
+    reader.reset();
+
+    // The first job of a problem publishes a future of its result; the jobs of the same problem wait for it
+    // (identical inputs have the same size, so they are dealt next to each other and wait little)
+    const std::string key = ResultCache::key(matrixA, matrixB, params);
+    std::promise<SolveResult<Scalar>> promise;
+    std::shared_future<SolveResult<Scalar>> shared;
+    bool first = false;
+    {
+        std::lock_guard<std::mutex> lock(solutions.mutex);
+        auto found = solutions.byKey.find(key);
+        if (found == solutions.byKey.end()) {
+            shared = promise.get_future().share();
+            solutions.byKey.emplace(key, shared);
+            first = true;
+        } else {
+            shared = found->second;
+        }
+    }
+    if (first) {
+        try {
+            SolveResult<Scalar> solved;
+            if (solutions.cache && solutions.cache->load(key, matrixA.rows(), matrixA.cols(), solved)) {
+                origin = Origin::Cached;
+            } else {
+                solved = solveProblem<Scalar>(matrixA, matrixB, params);
+                if (solutions.cache) {
+                    solutions.cache->store(key, matrixA.rows(), matrixA.cols(), params.getAlgorithm(), solved);
+                }
+            }
+            promise.set_value(std::move(solved));
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+        }
+    } else {
+        origin = Origin::Duplicate;
+    }
+    const SolveResult<Scalar>& result = shared.get();
+
+    std::unique_ptr<Writer> writer = createWriter(mOptions.format, outputFile, params.getAlgorithm());
+    writeResult(result, *writer);
+
+    std::ostringstream summary;
+    summary << params.getAlgorithm() << " " << matrixA.rows() << "x" << matrixA.cols() << ", " << result.iterations
+            << " iterations, " << (result.converged ? "converged" : "not converged")
+            << (origin == Origin::Cached ? ", from the cache" :
+                origin == Origin::Duplicate ? ", same problem as another input" : "");
+    return summary.str();
+}
+
+template class BatchRunner<double>;
+template class BatchRunner<std::complex<double>>;
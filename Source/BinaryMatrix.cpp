@@ -0,0 +1,51 @@
+#include "BinaryMatrix.h"
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+void BinaryMatrixWriter::write(const std::string& filename, const Eigen::MatrixXd& matrix, const Parameters* params) {
+    writeFile(filename, kBinaryScalarReal, matrix.rows(), matrix.cols(), matrix.data(),
+              sizeof(double) * matrix.size(), params);
+}
+
+void BinaryMatrixWriter::write(const std::string& filename, const Eigen::MatrixXcd& matrix, const Parameters* params) {
+    writeFile(filename, kBinaryScalarComplex, matrix.rows(), matrix.cols(), matrix.data(),
+              sizeof(std::complex<double>) * matrix.size(), params);
+}
+
+void BinaryMatrixWriter::writeFile(const std::string& filename, std::uint32_t scalarType, long rows, long cols,
+                                   const void* data, std::size_t bytes, const Parameters* params) {
+    std::string parameters;
+    if (params) {
+        std::ostringstream text;
+        params->writeValues(text);
+        parameters = text.str();
+    }
+
+    BinaryMatrixHeader header{};
+    std::memcpy(header.magic, kBinaryMatrixMagic, sizeof(header.magic));
+    header.version = kBinaryMatrixVersion;
+    header.scalarType = scalarType;
+    header.rows = static_cast<std::uint64_t>(rows);
+    header.cols = static_cast<std::uint64_t>(cols);
+    header.storageOrder = 0;
+    header.parameterBytes = parameters.size();
+    std::uint64_t end = sizeof(header) + parameters.size();
+    header.dataOffset = (end + kBinaryMatrixAlignment - 1) / kBinaryMatrixAlignment * kBinaryMatrixAlignment;
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Opening binary matrix file for writing failed: " + filename);
+    }
+    std::vector<char> padding(header.dataOffset - end, '\0');
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(parameters.data(), static_cast<std::streamsize>(parameters.size()));
+    file.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+    file.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+    file.close();
+    if (!file) {
+        throw std::runtime_error("Writing binary matrix file failed: " + filename);
+    }
+}
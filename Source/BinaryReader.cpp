@@ -0,0 +1,122 @@
+#include "BinaryReader.h"
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+// Constructor
+template<typename Scalar>
+BinaryReader<Scalar>::BinaryReader(const std::string& filename)
+    : Reader<Scalar>(filename),
+      mFile(filename),
+      mHeader{} {
+
+    if (mFile.size() < sizeof(BinaryMatrixHeader)) {
+        throw std::runtime_error("Not a binary matrix file (too short): " + filename);
+    }
+    std::memcpy(&mHeader, mFile.data(), sizeof(mHeader));
+    if (std::memcmp(mHeader.magic, kBinaryMatrixMagic, sizeof(mHeader.magic)) != 0) {
+        throw std::runtime_error("Not a binary matrix file (bad magic): " + filename);
+    }
+    if (mHeader.version != kBinaryMatrixVersion) {
+        throw std::runtime_error("Unsupported binary matrix version " + std::to_string(mHeader.version) + ": " + filename);
+    }
+    if (mHeader.scalarType != kBinaryScalarReal && mHeader.scalarType != kBinaryScalarComplex) {
+        throw std::runtime_error("Unknown scalar type in binary matrix file: " + filename);
+    }
+    if (mHeader.storageOrder > 1) {
+        throw std::runtime_error("Unknown storage order in binary matrix file: " + filename);
+    }
+
+    // Every sum is compared as a difference to the file size: the header comes from the file and could wrap them
+    const std::uint64_t size = mFile.size();
+    std::uint64_t scalarBytes = mHeader.scalarType == kBinaryScalarReal ? sizeof(double) : sizeof(std::complex<double>);
+    if (mHeader.parameterBytes > size - sizeof(BinaryMatrixHeader) || mHeader.dataOffset > size ||
+        mHeader.dataOffset % kBinaryMatrixAlignment != 0 ||
+        mHeader.dataOffset < sizeof(BinaryMatrixHeader) + mHeader.parameterBytes ||
+        (mHeader.cols > 0 && mHeader.rows > (size / scalarBytes) / mHeader.cols) ||
+        mHeader.rows * mHeader.cols * scalarBytes > size - mHeader.dataOffset) {
+        throw std::runtime_error("Truncated or corrupted binary matrix file: " + filename);
+    }
+}
+
+// Destructor
+template<typename Scalar>
+BinaryReader<Scalar>::~BinaryReader() {}
+
+template<typename Scalar>
+typename BinaryReader<Scalar>::MatrixMap BinaryReader<Scalar>::MapMatrix() const {
+    const bool complexFile = mHeader.scalarType == kBinaryScalarComplex;
+    if (complexFile != Eigen::NumTraits<Scalar>::IsComplex) {
+        throw std::runtime_error("The binary matrix file holds another scalar type, use ReadMatrix()");
+    }
+    if (mHeader.storageOrder != 0) {
+        throw std::runtime_error("The binary matrix file is row-major, use ReadMatrix()");
+    }
+    const Scalar* data = reinterpret_cast<const Scalar*>(mFile.data() + mHeader.dataOffset);
+    return MatrixMap(data, static_cast<Eigen::Index>(mHeader.rows), static_cast<Eigen::Index>(mHeader.cols));
+}
+
+template<typename Scalar>
+typename BinaryReader<Scalar>::Matrix BinaryReader<Scalar>::copyRows(long firstRow, long rowCount) const {
+    using RealMatrix = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>;
+    using RealRowMatrix = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+    using ComplexMatrix = Eigen::Matrix<std::complex<double>, Eigen::Dynamic, Eigen::Dynamic>;
+    using ComplexRowMatrix = Eigen::Matrix<std::complex<double>, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+    const Eigen::Index rows = static_cast<Eigen::Index>(mHeader.rows);
+    const Eigen::Index cols = static_cast<Eigen::Index>(mHeader.cols);
+    const char* data = mFile.data() + mHeader.dataOffset;
+    const bool rowMajor = mHeader.storageOrder == 1;
+
+    if (mHeader.scalarType == kBinaryScalarReal) {
+        const double* values = reinterpret_cast<const double*>(data);
+        if (rowMajor) {
+            return Eigen::Map<const RealRowMatrix>(values, rows, cols).middleRows(firstRow, rowCount).template cast<Scalar>();
+        }
+        return Eigen::Map<const RealMatrix>(values, rows, cols).middleRows(firstRow, rowCount).template cast<Scalar>();
+    }
+
+    if constexpr (Eigen::NumTraits<Scalar>::IsComplex) {
+        const std::complex<double>* values = reinterpret_cast<const std::complex<double>*>(data);
+        if (rowMajor) {
+            return Eigen::Map<const ComplexRowMatrix>(values, rows, cols).middleRows(firstRow, rowCount);
+        }
+        return Eigen::Map<const ComplexMatrix>(values, rows, cols).middleRows(firstRow, rowCount);
+    } else {
+        throw std::runtime_error("The binary matrix file holds complex values, read it as complex");
+    }
+}
+
+template<typename Scalar>
+typename BinaryReader<Scalar>::Matrix BinaryReader<Scalar>::ReadMatrix() {
+    return copyRows(0, static_cast<long>(mHeader.rows));
+}
+
+template<typename Scalar>
+long BinaryReader<Scalar>::CountMatrixRows() {
+    return static_cast<long>(mHeader.rows);
+}
+
+template<typename Scalar>
+typename BinaryReader<Scalar>::Matrix BinaryReader<Scalar>::ReadMatrixRows(long firstRow, long rowCount) {
+    if (firstRow < 0 || rowCount < 0 || firstRow + rowCount > static_cast<long>(mHeader.rows)) {
+        throw std::runtime_error("Requested rows are outside the matrix");
+    }
+    return copyRows(firstRow, rowCount);
+}
+
+template<typename Scalar>
+Parameters BinaryReader<Scalar>::ReadParameters() {
+    Parameters params;
+    std::istringstream text(std::string(mFile.data() + sizeof(BinaryMatrixHeader), mHeader.parameterBytes));
+    std::string line;
+    while (std::getline(text, line)) {
+        std::size_t comma = line.find(',');
+        if (comma == std::string::npos) continue;
+        params.setValue(line.substr(0, comma), line.substr(comma + 1));
+    }
+    return params;
+}
+
+template class BinaryReader<double>;
+template class BinaryReader<std::complex<double>>;
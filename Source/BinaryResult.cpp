@@ -0,0 +1,73 @@
+#include "BinaryResult.h"
+#include <complex>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+
+BinaryResultReader::BinaryResultReader(const std::string& filename) : mFile(filename), mHeader{} {
+    if (mFile.size() < sizeof(BinaryResultHeader)) {
+        throw std::runtime_error("Not a binary result file (too short): " + filename);
+    }
+    std::memcpy(&mHeader, mFile.data(), sizeof(mHeader));
+    if (std::memcmp(mHeader.magic, kBinaryResultMagic, sizeof(mHeader.magic)) != 0) {
+        throw std::runtime_error("Not a binary result file (bad magic): " + filename);
+    }
+    if (mHeader.version != kBinaryResultVersion) {
+        throw std::runtime_error("Unsupported binary result version " + std::to_string(mHeader.version) + ": " + filename);
+    }
+    if (mHeader.scalarType != kBinaryScalarReal && mHeader.scalarType != kBinaryScalarComplex) {
+        throw std::runtime_error("Unknown scalar type in binary result file: " + filename);
+    }
+
+    const std::uint64_t size = mFile.size();
+    const std::uint64_t scalarBytes = mHeader.scalarType == kBinaryScalarReal ? sizeof(double) : sizeof(std::complex<double>);
+    if (mHeader.valuesOffset % kBinaryMatrixAlignment != 0 || mHeader.vectorsOffset % kBinaryMatrixAlignment != 0 ||
+        mHeader.metadataBytes > size || mHeader.valuesOffset < sizeof(BinaryResultHeader) + mHeader.metadataBytes ||
+        mHeader.count > size / scalarBytes || mHeader.valuesOffset + mHeader.count * scalarBytes > size ||
+        mHeader.vectorsOffset < mHeader.valuesOffset + mHeader.count * scalarBytes ||
+        (mHeader.vectorCount > 0 && mHeader.rows > (size / scalarBytes) / mHeader.vectorCount) ||
+        mHeader.vectorsOffset + mHeader.rows * mHeader.vectorCount * scalarBytes > size) {
+        throw std::runtime_error("Truncated or corrupted binary result file: " + filename);
+    }
+}
+
+std::string BinaryResultReader::metadata(const std::string& name) const {
+    std::string_view text(mFile.data() + sizeof(BinaryResultHeader), mHeader.metadataBytes);
+    while (!text.empty()) {
+        std::size_t end = text.find('\n');
+        std::string_view line = text.substr(0, end);
+        if (line.size() > name.size() && line.compare(0, name.size(), name) == 0 && line[name.size()] == ',') {
+            return std::string(line.substr(name.size() + 1));
+        }
+        text = end == std::string_view::npos ? std::string_view() : text.substr(end + 1);
+    }
+    return "";
+}
+
+template<typename Scalar>
+void BinaryResultReader::checkScalar() const {
+    const bool complexFile = mHeader.scalarType == kBinaryScalarComplex;
+    if (complexFile != Eigen::NumTraits<Scalar>::IsComplex) {
+        throw std::runtime_error("The binary result file holds another scalar type: " + mFile.filename());
+    }
+}
+
+template<typename Scalar>
+Eigen::Map<const Eigen::Matrix<Scalar, Eigen::Dynamic, 1>> BinaryResultReader::MapEigenvalues() const {
+    checkScalar<Scalar>();
+    const Scalar* data = reinterpret_cast<const Scalar*>(mFile.data() + mHeader.valuesOffset);
+    return Eigen::Map<const Eigen::Matrix<Scalar, Eigen::Dynamic, 1>>(data, static_cast<Eigen::Index>(mHeader.count));
+}
+
+template<typename Scalar>
+Eigen::Map<const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>> BinaryResultReader::MapEigenvectors() const {
+    checkScalar<Scalar>();
+    const Scalar* data = reinterpret_cast<const Scalar*>(mFile.data() + mHeader.vectorsOffset);
+    return Eigen::Map<const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>>(
+        data, static_cast<Eigen::Index>(mHeader.rows), static_cast<Eigen::Index>(mHeader.vectorCount));
+}
+
+template Eigen::Map<const Eigen::VectorXd> BinaryResultReader::MapEigenvalues<double>() const;
+template Eigen::Map<const Eigen::VectorXcd> BinaryResultReader::MapEigenvalues<std::complex<double>>() const;
+template Eigen::Map<const Eigen::MatrixXd> BinaryResultReader::MapEigenvectors<double>() const;
+template Eigen::Map<const Eigen::MatrixXcd> BinaryResultReader::MapEigenvectors<std::complex<double>>() const;
@@ -0,0 +1,129 @@
+#include "BinaryWriter.h"
+#include "MappedFile.h"
+#include "OutputBuffer.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+// Bytes copied by one task: large enough to amortize the task, small enough to spread the page faults
+const std::size_t kCopyBytes = std::size_t(64) << 20;
+
+std::uint64_t aligned(std::uint64_t offset) {
+    return (offset + kBinaryMatrixAlignment - 1) / kBinaryMatrixAlignment * kBinaryMatrixAlignment;
+}
+
+// Copies a block into the mapping in slices, on several threads for large blocks
+void copyBlock(char* out, const void* data, std::size_t bytes, int threads) {
+    const long slices = static_cast<long>((bytes + kCopyBytes - 1) / kCopyBytes);
+    parallelFor(0, slices, threads, [&](long s) {
+        const std::size_t first = static_cast<std::size_t>(s) * kCopyBytes;
+        std::memcpy(out + first, static_cast<const char*>(data) + first, std::min(kCopyBytes, bytes - first));
+    });
+}
+
+}
+
+BinaryWriter::BinaryWriter(const std::string& filename, const std::string& algorithm)
+    : Writer(filename), mAlgorithm(algorithm), mQuiet(false) {}
+
+void BinaryWriter::setAlgorithm(const std::string& algorithm) {
+    mAlgorithm = algorithm;
+}
+
+void BinaryWriter::setTiming(const std::string& name, double seconds) {
+    for (auto& timing : mTimings) {
+        if (timing.first == name) {
+            timing.second = seconds;
+            return;
+        }
+    }
+    mTimings.emplace_back(name, seconds);
+}
+
+void BinaryWriter::setMetadata(const std::string& name, const std::string& value) {
+    for (auto& line : mMetadata) {
+        if (line.first == name) {
+            line.second = value;
+            return;
+        }
+    }
+    mMetadata.emplace_back(name, value);
+}
+
+void BinaryWriter::setQuiet(bool quiet) {
+    mQuiet = quiet;
+}
+
+void BinaryWriter::write(double eigenvalue,
+                        const Eigen::VectorXd& eigenvector,
+                        int iterations,
+                        bool converged) const {
+    writeResult(kBinaryScalarReal, sizeof(double), &eigenvalue, 1, eigenvector.data(), eigenvector.size(), 1,
+                iterations, converged);
+}
+
+void BinaryWriter::write(std::complex<double> eigenvalue,
+                        const Eigen::VectorXcd& eigenvector,
+                        int iterations,
+                        bool converged) const {
+    writeResult(kBinaryScalarComplex, sizeof(std::complex<double>), &eigenvalue, 1, eigenvector.data(),
+                eigenvector.size(), 1, iterations, converged);
+}
+
+void BinaryWriter::writeAll(const Eigen::VectorXd& eigenvalues,
+                           const Eigen::MatrixXd& eigenvectors,
+                           int iterations,
+                           bool converged) const {
+    writeResult(kBinaryScalarReal, sizeof(double), eigenvalues.data(), eigenvalues.size(), eigenvectors.data(),
+                eigenvectors.rows(), eigenvectors.cols(), iterations, converged);
+}
+
+void BinaryWriter::writeAll(const Eigen::VectorXcd& eigenvalues,
+                           const Eigen::MatrixXcd& eigenvectors,
+                           int iterations,
+                           bool converged) const {
+    writeResult(kBinaryScalarComplex, sizeof(std::complex<double>), eigenvalues.data(), eigenvalues.size(),
+                eigenvectors.data(), eigenvectors.rows(), eigenvectors.cols(), iterations, converged);
+}
+
+void BinaryWriter::writeResult(std::uint32_t scalarType, std::size_t scalarBytes, const void* values, long count,
+                               const void* vectors, long rows, long cols, int iterations, bool converged) const {
+    // Metadata lines; timings with the shortest text that reads back to the same double
+    OutputBuffer metadata(0);
+    if (!mAlgorithm.empty()) metadata << "Algorithm," << mAlgorithm << '\n';
+    for (const auto& timing : mTimings) metadata << timing.first << "Seconds," << timing.second << '\n';
+    for (const auto& line : mMetadata) metadata << line.first << ',' << line.second << '\n';
+    if (mHasStats) {
+        for (const auto& field : mStats.fields()) metadata << field.first << ',' << field.second << '\n';
+    }
+
+    BinaryResultHeader header{};
+    std::memcpy(header.magic, kBinaryResultMagic, sizeof(header.magic));
+    header.version = kBinaryResultVersion;
+    header.scalarType = scalarType;
+    header.count = static_cast<std::uint64_t>(count);
+    header.rows = static_cast<std::uint64_t>(rows);
+    header.vectorCount = rows > 0 ? static_cast<std::uint64_t>(cols) : 0;
+    header.iterations = iterations;
+    header.converged = converged ? 1 : 0;
+    header.metadataBytes = metadata.size();
+    header.valuesOffset = aligned(sizeof(header) + metadata.size());
+    header.vectorsOffset = aligned(header.valuesOffset + scalarBytes * header.count);
+    const std::size_t valueBytes = scalarBytes * header.count;
+    const std::size_t vectorBytes = scalarBytes * header.rows * header.vectorCount;
+
+    MappedFile file(mFilename, static_cast<std::size_t>(header.vectorsOffset + vectorBytes));
+    char* out = file.mutableData();
+    std::memcpy(out, &header, sizeof(header));
+    std::memcpy(out + sizeof(header), metadata.data(), metadata.size());
+    std::memset(out + sizeof(header) + metadata.size(), 0, header.valuesOffset - sizeof(header) - metadata.size());
+    if (valueBytes > 0) std::memcpy(out + header.valuesOffset, values, valueBytes);
+    std::memset(out + header.valuesOffset + valueBytes, 0, header.vectorsOffset - header.valuesOffset - valueBytes);
+    copyBlock(out + header.vectorsOffset, vectors, vectorBytes, mThreads);
+    file.flush();
+
+    if (!mQuiet) std::cout << "Results written to " << mFilename << std::endl;
+}
@@ -0,0 +1,359 @@
+#include "BisectionMethod.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+// Constructor
+BisectionMethod::BisectionMethod(const TridiagonalMatrix& matrix, const Parameters& params)
+    : mMatrix(matrix),
+      mSpectrumLow(0.0),
+      mSpectrumHigh(0.0),
+      mPivotMin(std::numeric_limits<double>::min()),
+      mTolerance(params.getTolerance()),
+      mMaxIteration(params.getMaxIterations()),
+      mParams(params),
+      mComputeEigenvectors(true),
+      mThreads(params.getThreads()),
+      mConverged(false),
+      mIterationCount(0) {
+
+    const Eigen::VectorXd& d = mMatrix.getDiagonal();
+    int n = mMatrix.size();
+
+    // Off-diagonal of the equivalent symmetric matrix: e(i)^2 = lower(i) * upper(i)
+    mOffDiagonalSquared = mMatrix.getLower().cwiseProduct(mMatrix.getUpper());
+    double maxOffSquared = mOffDiagonalSquared.size() > 0 ? mOffDiagonalSquared.cwiseAbs().maxCoeff() : 0.0;
+    mPivotMin = std::numeric_limits<double>::min() * std::max(1.0, maxOffSquared);
+
+    // Gershgorin interval of the symmetric matrix
+    if (n > 0) {
+        mSpectrumLow = std::numeric_limits<double>::max();
+        mSpectrumHigh = std::numeric_limits<double>::lowest();
+        for (int i = 0; i < n; ++i) {
+            double radius = 0.0;
+            if (i > 0) radius += std::sqrt(std::abs(mOffDiagonalSquared(i - 1)));
+            if (i < n - 1) radius += std::sqrt(std::abs(mOffDiagonalSquared(i)));
+            mSpectrumLow = std::min(mSpectrumLow, d(i) - radius);
+            mSpectrumHigh = std::max(mSpectrumHigh, d(i) + radius);
+        }
+        // Widen slightly so the end points are never eigenvalues
+        double norm = std::max(std::abs(mSpectrumLow), std::abs(mSpectrumHigh));
+        double margin = 2.0 * std::numeric_limits<double>::epsilon() * norm * n + 2.0 * mPivotMin;
+        mSpectrumLow -= margin;
+        mSpectrumHigh += margin;
+    }
+}
+
+// Destructor
+BisectionMethod::~BisectionMethod() {}
+
+// Setters
+void BisectionMethod::setIndexRange(int indexLow, int indexHigh) {
+    mParams.setIndexRange(indexLow, indexHigh);
+}
+
+void BisectionMethod::setValueRange(double lower, double upper) {
+    mParams.setValueRange(lower, upper);
+}
+
+void BisectionMethod::setComputeEigenvectors(bool compute) {
+    mComputeEigenvectors = compute;
+}
+
+void BisectionMethod::setThreadCount(int threads) {
+    mThreads = threads;
+}
+
+int BisectionMethod::countEigenvaluesBelow(double x) const {
+    const Eigen::VectorXd& d = mMatrix.getDiagonal();
+    int n = mMatrix.size();
+    int count = 0;
+
+    // Pivots of the LDL^T factorization of T - xI; each negative pivot is one eigenvalue below x
+    double q = 1.0;
+    for (int i = 0; i < n; ++i) {
+        q = (i == 0) ? d(0) - x : d(i) - x - mOffDiagonalSquared(i - 1) / q;
+        if (std::abs(q) < mPivotMin) {
+            q = -mPivotMin;
+        }
+        if (q < 0.0) {
+            count++;
+        }
+    }
+    return count;
+}
+
+double BisectionMethod::bisect(int k, int& steps) const {
+    const double eps = std::numeric_limits<double>::epsilon();
+    double low = mSpectrumLow;
+    double high = mSpectrumHigh;
+
+    for (steps = 0; steps < mMaxIteration; ++steps) {
+        double width = std::max(mTolerance, 2.0 * eps * std::max(std::abs(low), std::abs(high))) + mPivotMin;
+        if (high - low <= width) {
+            break;
+        }
+        double mid = 0.5 * (low + high);
+        if (countEigenvaluesBelow(mid) > k) {
+            high = mid;  // The k-th eigenvalue is below mid
+        } else {
+            low = mid;
+        }
+    }
+    return 0.5 * (low + high);
+}
+
+int BisectionMethod::inverseIteration(int first, int last) {
+    const double eps = std::numeric_limits<double>::epsilon();
+    const Eigen::VectorXd& d = mMatrix.getDiagonal();
+    const Eigen::VectorXd& upper = mMatrix.getUpper();
+    int n = mMatrix.size();
+    double norm = std::max(std::abs(mSpectrumLow), std::abs(mSpectrumHigh));
+    double pivotFloor = std::max(eps * norm, mPivotMin);
+
+    // Off-diagonal of the symmetric matrix S, keeping the sign of the super-diagonal
+    Eigen::VectorXd e(n > 0 ? n - 1 : 0);
+    for (int i = 0; i + 1 < n; ++i) {
+        double magnitude = std::sqrt(std::abs(mOffDiagonalSquared(i)));
+        e(i) = upper(i) < 0.0 ? -magnitude : magnitude;
+    }
+
+    // Workspace of the LU factorization of S - lambda I with partial pivoting (U has three diagonals)
+    Eigen::VectorXd u0(n), u1(n), u2(n), multiplier(n);
+    std::vector<char> swapped(n);
+    Eigen::VectorXd x(n), y(n);
+
+    int solves = 0;
+    double previous = 0.0;
+    for (int j = first; j <= last; ++j) {
+        double lambda = mAllEigenvalues(j);
+        // Separate (numerically) equal eigenvalues so that each gets its own vector
+        if (j > first && lambda - previous < 10.0 * eps * norm) {
+            lambda = previous + 10.0 * eps * norm;
+        }
+        previous = lambda;
+
+        // 1. Factorize S - lambda I = P L U
+        u0(0) = d(0) - lambda;
+        u1(0) = n > 1 ? e(0) : 0.0;
+        for (int i = 0; i + 1 < n; ++i) {
+            double sub = e(i);
+            double nextDiagonal = d(i + 1) - lambda;
+            double nextUpper = (i + 2 < n) ? e(i + 1) : 0.0;
+            if (std::abs(sub) > std::abs(u0(i))) {
+                // Row interchange: row i+1 becomes the pivot row
+                double m = u0(i) / sub;
+                double oldUpper = u1(i);
+                u0(i) = sub;
+                u1(i) = nextDiagonal;
+                u2(i) = nextUpper;
+                u0(i + 1) = oldUpper - m * nextDiagonal;
+                u1(i + 1) = -m * nextUpper;
+                multiplier(i) = m;
+                swapped[i] = 1;
+            } else {
+                if (u0(i) == 0.0) u0(i) = pivotFloor;
+                double m = sub / u0(i);
+                u2(i) = 0.0;
+                u0(i + 1) = nextDiagonal - m * u1(i);
+                u1(i + 1) = nextUpper;
+                multiplier(i) = m;
+                swapped[i] = 0;
+            }
+        }
+        for (int i = 0; i < n; ++i) {
+            if (std::abs(u0(i)) < pivotFloor) u0(i) = (u0(i) < 0.0) ? -pivotFloor : pivotFloor;
+        }
+
+        // 2. Deterministic pseudo-random start vector
+        std::mt19937 generator(12345u + static_cast<unsigned int>(j));
+        std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+        for (int i = 0; i < n; ++i) x(i) = uniform(generator);
+        x.normalize();
+
+        // 3. Iterate y = (S - lambda I)^{-1} x until the growth shows convergence, plus two extra steps
+        int extra = -1;
+        for (int iteration = 0; iteration < 5 && extra != 0; ++iteration) {
+            solves++;
+            y = x;
+            for (int i = 0; i + 1 < n; ++i) {
+                if (swapped[i]) std::swap(y(i), y(i + 1));
+                y(i + 1) -= multiplier(i) * y(i);
+            }
+            for (int i = n - 1; i >= 0; --i) {
+                double value = y(i);
+                if (i + 1 < n) value -= u1(i) * y(i + 1);
+                if (i + 2 < n) value -= u2(i) * y(i + 2);
+                y(i) = value / u0(i);
+            }
+
+            // Orthogonalize against the previous vectors of the cluster (modified Gram-Schmidt)
+            for (int k = first; k < j; ++k) {
+                y -= mAllEigenvectors.col(k).dot(y) * mAllEigenvectors.col(k);
+            }
+
+            double growth = y.norm();
+            x = y / growth;
+            if (extra > 0) {
+                extra--;
+            } else if (extra < 0 && growth * eps * norm * std::sqrt(static_cast<double>(n)) >= 0.1) {
+                extra = 2;
+            }
+        }
+        mAllEigenvectors.col(j) = x;
+    }
+    return solves;
+}
+
+std::vector<std::pair<int, int>> BisectionMethod::clusters(int count) const {
+    const int maxClusterSize = 64;
+    double norm = std::max(std::abs(mSpectrumLow), std::abs(mSpectrumHigh));
+    double clusterGap = 1e-3 * norm;
+    double splitGap = 1e-6 * norm;
+
+    std::vector<std::pair<int, int>> close;
+    for (int k = 0; k < count; ++k) {
+        if (k > 0 && mAllEigenvalues(k) - mAllEigenvalues(k - 1) <= clusterGap) {
+            close.back().second = k;
+        } else {
+            close.emplace_back(k, k);
+        }
+    }
+
+    // Split the long clusters, left piece first so that the result stays in ascending order
+    std::vector<std::pair<int, int>> result;
+    std::vector<std::pair<int, int>> pending(close.rbegin(), close.rend());
+    while (!pending.empty()) {
+        std::pair<int, int> cluster = pending.back();
+        pending.pop_back();
+        int size = cluster.second - cluster.first + 1;
+        int split = -1;
+        if (size > maxClusterSize) {
+            double widest = splitGap;
+            for (int k = cluster.first + size / 4; k < cluster.second - size / 4; ++k) {
+                double gap = mAllEigenvalues(k + 1) - mAllEigenvalues(k);
+                if (gap >= widest) {
+                    widest = gap;
+                    split = k;
+                }
+            }
+        }
+        if (split < 0) {
+            result.push_back(cluster);
+        } else {
+            pending.emplace_back(split + 1, cluster.second);
+            pending.emplace_back(cluster.first, split);
+        }
+    }
+    return result;
+}
+
+void BisectionMethod::solve() {
+    int n = mMatrix.size();
+    this->mConverged = false;
+    this->mIterationCount = 0;
+    this->mStats = SolverStats();
+
+    if (!mMatrix.isSymmetrizable()) {
+        throw std::runtime_error("BisectionMethod requires lower(i) * upper(i) > 0 (or both zero)");
+    }
+
+    // 1. Translate the wanted range into 0-based indices [first, last]
+    PhaseTimer setupTimer(mStats.setupSeconds);
+    int first = 0;
+    int last = n - 1;
+    if (mParams.hasValueRange()) {
+        first = countEigenvaluesBelow(mParams.getLowerBound());
+        last = countEigenvaluesBelow(mParams.getUpperBound()) - 1;
+        mStats.factorizations += 2;
+    } else if (mParams.getIndexLow() > 0) {
+        if (mParams.getIndexHigh() > n) {
+            throw std::runtime_error("IndexHigh exceeds the matrix size");
+        }
+        first = mParams.getIndexLow() - 1;
+        last = mParams.getIndexHigh() - 1;
+    }
+    int count = std::max(0, last - first + 1);
+    setupTimer.stop();
+
+    // 2. Bisection, one eigenvalue per task
+    PhaseTimer iterationTimer(mStats.iterationSeconds);
+    mAllEigenvalues.resize(count);
+    std::vector<int> steps(count, 0);
+    parallelFor(0, count, mThreads, [&](long k) {
+        int used = 0;
+        mAllEigenvalues(k) = bisect(first + static_cast<int>(k), used);
+        steps[k] = used;
+    });
+
+    this->mConverged = true;
+    for (int k = 0; k < count; ++k) {
+        this->mIterationCount = std::max(this->mIterationCount, steps[k]);
+        if (steps[k] >= mMaxIteration) this->mConverged = false;
+        mStats.factorizations += steps[k];
+    }
+    iterationTimer.stop();
+    mStats.bytesAllocated += static_cast<std::uint64_t>(count) * (sizeof(double) + sizeof(int));
+
+    // 4n flops per Sturm count
+    mStats.flops = 4.0 * n * mStats.factorizations;
+
+    // 3. Inverse iteration, one cluster of close eigenvalues per task
+    PhaseTimer extractionTimer(mStats.extractionSeconds);
+    if (mComputeEigenvectors) {
+        mAllEigenvectors.resize(n, count);
+        std::vector<std::pair<int, int>> clusters = this->clusters(count);
+        std::vector<int> solves(clusters.size(), 0);
+        parallelFor(0, static_cast<long>(clusters.size()), mThreads, [&](long c) {
+            solves[c] = inverseIteration(clusters[c].first, clusters[c].second);
+        });
+
+        // One LU of S - lambda I per eigenvalue (8n flops), then 5n per solve plus the Gram-Schmidt steps, counted
+        // as 4n per solve on average; each task allocates 7 vectors of n
+        mStats.factorizations += count;
+        for (int s : solves) mStats.solves += s;
+        mStats.flops += 8.0 * n * count + 9.0 * n * mStats.solves;
+        mStats.bytesAllocated += static_cast<std::uint64_t>(n) * count * sizeof(double) +
+                                 static_cast<std::uint64_t>(clusters.size()) * 7 * n * sizeof(double);
+
+        // Eigenvectors of a non-symmetric T are D * y, with the diagonal scaling D^2(i+1)/D^2(i) = lower(i)/upper(i)
+        if (!mMatrix.isSymmetric()) {
+            Eigen::VectorXd logScale(n);
+            logScale(0) = 0.0;
+            for (int i = 0; i + 1 < n; ++i) {
+                double ratio = (mMatrix.getUpper()(i) != 0.0) ? mMatrix.getLower()(i) / mMatrix.getUpper()(i) : 1.0;
+                logScale(i + 1) = logScale(i) + 0.5 * std::log(ratio);
+            }
+            logScale.array() -= logScale.maxCoeff();
+            Eigen::VectorXd scale = logScale.array().exp();
+            for (int k = 0; k < count; ++k) {
+                mAllEigenvectors.col(k).array() *= scale.array();
+                mAllEigenvectors.col(k).normalize();
+            }
+        }
+
+        // Residual of the returned pairs, one tridiagonal product each
+        for (int k = 0; k < count; ++k) {
+            Eigen::VectorXd residual = mMatrix.multiply(mAllEigenvectors.col(k)) -
+                                       mAllEigenvalues(k) * mAllEigenvectors.col(k);
+            mStats.residual = std::max(mStats.residual, residual.norm());
+        }
+        mStats.matrixVectorProducts += count;
+        mStats.flops += 7.0 * n * count;
+    } else {
+        mAllEigenvectors.resize(n, 0);
+    }
+    extractionTimer.stop();
+
+    if (this->mConverged) {
+        std::cout << "BisectionMethod isolated " << count << " eigenvalue(s) in at most "
+                  << this->mIterationCount << " bisection steps." << std::endl;
+    } else {
+        std::cerr << "BisectionMethod failed to reach the tolerance within " << mMaxIteration << " steps." << std::endl;
+    }
+}
@@ -2,16 +2,15 @@
 // Created by 32484 on 05-12-25.
 //
 #include "CSVReader.h"
-#include <fstream>
-#include <sstream>
 #include <iostream>
+#include <stdexcept>
 #include "Reader.h"
 
 
 //constructor
 template<typename Scalar>
 CSVReader<Scalar>::CSVReader(const std::string &filename)
-    :Reader<Scalar>(filename)
+    :Reader<Scalar>(filename), mParser(filename)
 {
     if (this->GetFileType()!= Reader<Scalar>::FileType::CSV) {
         throw std::runtime_error( "This file is not a CSV file" );
@@ -24,144 +23,37 @@ CSVReader<Scalar>::CSVReader(const std::string &filename)
 template<typename Scalar>
 CSVReader<Scalar>::~CSVReader() {}
 
-
-
-// Function to remove leading and trailing whitespace
-template<typename Scalar>
-std::string CSVReader<Scalar>::trim(const std::string& str) { // this function is generated with the help of  llms
-    if (str.empty()) return str; // If the string is empty, return it directly
-
-    // Find first non-space
-    int start = 0;
-    while (start < str.length() && std::isspace(str[start])) {
-        start++;
-    }
-
-    // Find last non-space
-    int end = str.length() - 1;
-    while (end >= start && std::isspace(str[end])) {
-        end--;
-    }
-
-    // Return trimmed string
-    return str.substr(start, end - start + 1);
-}
-
 template<typename Scalar>
 typename CSVReader<Scalar>::Matrix CSVReader<Scalar>::ReadMatrix() {
-    std::ifstream file(this->mFilename);
-    if (!file.is_open()) {
-        throw std::runtime_error("Opening CSV file failed");
-    }
-    std::vector<std::vector<Scalar>> matrixData;
-    std::string line;
-
-    while (std::getline(file, line)){
-        line=trim(line); //remove whitespace
-        if (line.empty()) continue;
-
-        if (line.find("Algorithm") != std::string::npos) {
-            break;  //  Stop because the parameters begin
-        }
-
-
-        //For each line, split by delimiter and convert each value to Scalar type
-        std::vector<Scalar> row;
-        std::stringstream ss(line);
-        std::string value;
-
-        char delimiter = (line.find(';') != std::string::npos) ? ';' : ',';
-
-        while (std::getline(ss, value, delimiter)) {
-            value=trim(value); //Remove spaces between numbers
-            if (!value.empty()) {
-                row.push_back(std::stod(value));
-            }
-        }
-        if (!row.empty()) {
-            matrixData.push_back(row);
-        }
-    }
-
-
-    file.close();
-    // Convert vector to Eigen matrix
-    if (matrixData.empty()) {
+    Matrix matrix = mParser.template parse<Scalar>(TextMatrixParser::Section::A);
+    if (matrix.size() == 0) {
         throw std::runtime_error("No matrix found in CSV file");
     }
-
-    int n = matrixData.size();
-    int m = matrixData[0].size();
-
-    Matrix matrix(n, m);
-
-    for (int i = 0; i < n; ++i) {
-        for (int j = 0; j < m; ++j) {
-            matrix(i, j) = static_cast<Scalar>(matrixData[i][j]); //llms
-        }
-    }
-
     return matrix;
 }
 
+// Without a "MatrixB" line the problem is a standard one
 template<typename Scalar>
-Parameters CSVReader<Scalar>::ReadParameters() {
-    std::ifstream file(this->mFilename);
-    if (!file.is_open()) {
-        throw std::runtime_error("Cannot open file");
-    }
-
-    Parameters params;
-    std::string line;
-
-    // Skip until "Algorithm" line
-    while (std::getline(file, line)) {
-        if (line.find("Algorithm") != std::string::npos) {
-            char delimiter = (line.find(';') != std::string::npos) ? ';' : ',';
-
-            // Process this line first
-            std::stringstream ss(line);
-            std::string name, value;
-            std::getline(ss, name, delimiter);
-            std::getline(ss, value, delimiter);
-
-            name = trim(name);
-            value = trim(value);
-
-            params.setAlgorithm(value);
-            break;
-        }
-    }
-
-    // Read remaining parameters
-    while (std::getline(file, line)) {
-        if (line.empty()) continue;
-
-        char delimiter = (line.find(';') != std::string::npos) ? ';' : ',';
-
-        std::stringstream ss(line);
-        std::string name, value;
-
-        std::getline(ss, name, delimiter);
-        std::getline(ss, value,delimiter);
+typename CSVReader<Scalar>::Matrix CSVReader<Scalar>::ReadMatrixB() {
+    return mParser.template parse<Scalar>(TextMatrixParser::Section::B);
+}
 
-        name = trim(name);
-        value = trim(value);
+template<typename Scalar>
+long CSVReader<Scalar>::CountMatrixRows() {
+    return mParser.rows(TextMatrixParser::Section::A);
+}
 
-        if (name == "MaxIterations") {
-            params.setMaxIterations(std::stoi(value));
-        }
-        else if (name == "Tolerance") {
-            params.setTolerance(std::stod(value));
-        }
-        else if (name == "Shift") {
-            params.setShift(std::stod(value));
-        }
+template<typename Scalar>
+typename CSVReader<Scalar>::Matrix CSVReader<Scalar>::ReadMatrixRows(long firstRow, long rowCount) {
+    if (rowCount < 0) {
+        throw std::runtime_error("Requested rows are outside the matrix");
     }
+    return mParser.template parse<Scalar>(TextMatrixParser::Section::A, firstRow, rowCount);
+}
 
-    file.close();
-    return params;
-
+template<typename Scalar>
+Parameters CSVReader<Scalar>::ReadParameters() {
+    return mParser.parameters();
 }
 
 template class CSVReader<double>;
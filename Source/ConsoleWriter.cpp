@@ -1,20 +1,118 @@
 #include "ConsoleWriter.h"
+#include "OutputBuffer.h"
 #include <iostream>
 
+namespace {
+
+// "a + bi" or "a - bi", as the text files write complex values
+void appendComplex(OutputBuffer& out, std::complex<double> value) {
+    out << value.real();
+    if (value.imag() >= 0) {
+        out << " + " << value.imag() << "i";
+    } else {
+        out << " - " << -value.imag() << "i";
+    }
+}
+
+void appendStatus(OutputBuffer& out, int iterations, bool converged) {
+    out << "\n--- Results ---\n";
+    out << "Converged: " << (converged ? "Yes" : "No") << " (" << iterations << " iterations)\n";
+}
+
+void appendStats(OutputBuffer& out, const SolverStats& stats) {
+    out << "Solver statistics:\n";
+    for (const auto& field : stats.fields()) {
+        out << "  " << field.first << ": " << field.second << '\n';
+    }
+}
+
+}
+
 // Constructor
-ConsoleWriter::ConsoleWriter() : Writer() {}
+ConsoleWriter::ConsoleWriter() : Writer(""), mOut(std::cout) {}
+
+ConsoleWriter::ConsoleWriter(std::ostream& out) : Writer(""), mOut(out) {}
 
 // Destructor
 ConsoleWriter::~ConsoleWriter() {}
 
-// function
-void ConsoleWriter::Write() {
-    std::cout << "\n--- Results ---" << std::endl;
-    std::cout << "Eigenvalue: " << mEigenvalue << std::endl;
-    if (mEigenvector.size() > 0) {
-        std::cout << "Eigenvector:\n" << mEigenvector << std::endl;
-    } else {
-        std::cout << "Eigenvector: [Not computed or empty]" << std::endl;
+void ConsoleWriter::write(double eigenvalue,
+                          const Eigen::VectorXd& eigenvector,
+                          int iterations,
+                          bool converged) const {
+    OutputBuffer out(mPrecision);
+    appendStatus(out, iterations, converged);
+    out << "Eigenvalue: " << eigenvalue << '\n';
+    out << "Eigenvector:\n";
+    for (Eigen::Index i = 0; i < eigenvector.size(); ++i) {
+        out << "  v[" << static_cast<long>(i) << "] = " << eigenvector(i) << '\n';
+    }
+    if (mHasStats) appendStats(out, mStats);
+    out << "---------------\n";
+    out.writeTo(mOut);
+    mOut.flush();
+}
+
+void ConsoleWriter::write(std::complex<double> eigenvalue,
+                          const Eigen::VectorXcd& eigenvector,
+                          int iterations,
+                          bool converged) const {
+    OutputBuffer out(mPrecision);
+    appendStatus(out, iterations, converged);
+    out << "Eigenvalue: ";
+    appendComplex(out, eigenvalue);
+    out << "\nEigenvector:\n";
+    for (Eigen::Index i = 0; i < eigenvector.size(); ++i) {
+        out << "  v[" << static_cast<long>(i) << "] = ";
+        appendComplex(out, eigenvector(i));
+        out << '\n';
+    }
+    if (mHasStats) appendStats(out, mStats);
+    out << "---------------\n";
+    out.writeTo(mOut);
+    mOut.flush();
+}
+
+void ConsoleWriter::writeAll(const Eigen::VectorXd& eigenvalues,
+                             const Eigen::MatrixXd& eigenvectors,
+                             int iterations,
+                             bool converged) const {
+    OutputBuffer out(mPrecision);
+    appendStatus(out, iterations, converged);
+    for (Eigen::Index j = 0; j < eigenvalues.size(); ++j) {
+        out << "Eigenvalue " << static_cast<long>(j + 1) << ": " << eigenvalues(j) << '\n';
+        if (j < eigenvectors.cols()) {
+            for (Eigen::Index i = 0; i < eigenvectors.rows(); ++i) {
+                out << "  v[" << static_cast<long>(i) << "] = " << eigenvectors(i, j) << '\n';
+            }
+        }
+    }
+    if (mHasStats) appendStats(out, mStats);
+    out << "---------------\n";
+    out.writeTo(mOut);
+    mOut.flush();
+}
+
+void ConsoleWriter::writeAll(const Eigen::VectorXcd& eigenvalues,
+                             const Eigen::MatrixXcd& eigenvectors,
+                             int iterations,
+                             bool converged) const {
+    OutputBuffer out(mPrecision);
+    appendStatus(out, iterations, converged);
+    for (Eigen::Index j = 0; j < eigenvalues.size(); ++j) {
+        out << "Eigenvalue " << static_cast<long>(j + 1) << ": ";
+        appendComplex(out, eigenvalues(j));
+        out << '\n';
+        if (j < eigenvectors.cols()) {
+            for (Eigen::Index i = 0; i < eigenvectors.rows(); ++i) {
+                out << "  v[" << static_cast<long>(i) << "] = ";
+                appendComplex(out, eigenvectors(i, j));
+                out << '\n';
+            }
+        }
     }
-    std::cout << "---------------\n" << std::endl;
-}
\ No newline at end of file
+    if (mHasStats) appendStats(out, mStats);
+    out << "---------------\n";
+    out.writeTo(mOut);
+    mOut.flush();
+}
@@ -0,0 +1,30 @@
+#include "ConvergenceHistory.h"
+#include <algorithm>
+
+ConvergenceHistory::ConvergenceHistory() : mNext(0), mRecorded(0), mStart(std::chrono::steady_clock::now()) {}
+
+void ConvergenceHistory::setCapacity(std::size_t capacity) {
+    mEntries.assign(capacity, Entry{0, 0.0, 0.0, 0.0});
+    start();
+}
+
+void ConvergenceHistory::start() {
+    mNext = 0;
+    mRecorded = 0;
+    mStart = std::chrono::steady_clock::now();
+}
+
+std::size_t ConvergenceHistory::size() const {
+    return std::min<std::size_t>(static_cast<std::size_t>(mRecorded), mEntries.size());
+}
+
+std::vector<ConvergenceHistory::Entry> ConvergenceHistory::getEntries() const {
+    std::vector<Entry> entries;
+    entries.reserve(size());
+    // Once the buffer has wrapped, the oldest entry is the next one to be overwritten
+    std::size_t first = (static_cast<std::size_t>(mRecorded) > mEntries.size()) ? mNext : 0;
+    for (std::size_t i = 0; i < size(); ++i) {
+        entries.push_back(mEntries[(first + i) % mEntries.size()]);
+    }
+    return entries;
+}
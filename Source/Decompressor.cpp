@@ -0,0 +1,236 @@
+#include "Decompressor.h"
+#include <algorithm>
+#include <climits>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#ifdef PCSC_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef PCSC_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+// Compression given by the first bytes of a file
+static Compression compressionOf(const char* bytes, std::size_t size) {
+    if (size >= 2 && static_cast<unsigned char>(bytes[0]) == 0x1f && static_cast<unsigned char>(bytes[1]) == 0x8b) {
+        return Compression::Gzip;
+    }
+    if (size >= 4 && static_cast<unsigned char>(bytes[0]) == 0x28 && static_cast<unsigned char>(bytes[1]) == 0xb5 &&
+        static_cast<unsigned char>(bytes[2]) == 0x2f && static_cast<unsigned char>(bytes[3]) == 0xfd) {
+        return Compression::Zstd;
+    }
+    return Compression::None;
+}
+
+Compression detectCompression(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file: " + filename);
+    }
+    char bytes[4] = {};
+    file.read(bytes, sizeof(bytes));
+    return compressionOf(bytes, static_cast<std::size_t>(file.gcount()));
+}
+
+const char* compressionName(Compression compression) {
+    if (compression == Compression::Gzip) return "gzip";
+    if (compression == Compression::Zstd) return "zstd";
+    return "none";
+}
+
+std::string uncompressedName(const std::string& filename) {
+    for (const std::string suffix : {".gz", ".zst"}) {
+        if (filename.size() > suffix.size() &&
+            filename.compare(filename.size() - suffix.size(), suffix.size(), suffix) == 0) {
+            return filename.substr(0, filename.size() - suffix.size());
+        }
+    }
+    return filename;
+}
+
+// Constructor: the thread starts at once
+Decompressor::Decompressor(const std::string& filename, std::size_t chunkBytes, std::size_t queuedChunks)
+    : mInput(filename),
+      mCompression(compressionOf(mInput.data(), mInput.size())),
+      mChunkBytes(std::max<std::size_t>(chunkBytes, 1)),
+      mQueuedChunks(std::max<std::size_t>(queuedChunks, 1)),
+      mSizeHint(0),
+      mDone(false),
+      mStopped(false) {
+
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(mInput.data());
+    if (mCompression == Compression::None) {
+        throw std::runtime_error("Not a gzip or zstd file: " + filename);
+    }
+    if (mCompression == Compression::Gzip) {
+#ifndef PCSC_HAVE_ZLIB
+        throw std::runtime_error("gzip input needs zlib, which was not found at build time: " + filename);
+#endif
+        // ISIZE: the last 4 bytes of the (last) member, modulo 4 GiB
+        if (mInput.size() >= 18) {
+            const unsigned char* size = bytes + mInput.size() - 4;
+            mSizeHint = std::size_t(size[0]) | std::size_t(size[1]) << 8 | std::size_t(size[2]) << 16 |
+                        std::size_t(size[3]) << 24;
+        }
+    } else {
+#ifndef PCSC_HAVE_ZSTD
+        throw std::runtime_error("zstd input needs libzstd, which was not found at build time: " + filename);
+#else
+        unsigned long long size = ZSTD_getFrameContentSize(mInput.data(), mInput.size());
+        if (size != ZSTD_CONTENTSIZE_UNKNOWN && size != ZSTD_CONTENTSIZE_ERROR) {
+            mSizeHint = static_cast<std::size_t>(size);
+        }
+#endif
+    }
+
+    mInput.advise(MappedFile::Access::Sequential);
+    mThread = std::thread(&Decompressor::run, this);
+}
+
+// Destructor: a thread waiting for space is released, then joined
+Decompressor::~Decompressor() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopped = true;
+    }
+    mSpace.notify_all();
+    if (mThread.joinable()) {
+        mThread.join();
+    }
+}
+
+bool Decompressor::next(std::vector<char>& chunk) {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mReady.wait(lock, [this] { return !mQueue.empty() || mDone; });
+    if (!mQueue.empty()) {
+        chunk = std::move(mQueue.front());
+        mQueue.pop_front();
+        mSpace.notify_one();
+        return true;
+    }
+    if (mError) {
+        std::rethrow_exception(mError);
+    }
+    chunk.clear();
+    return false;
+}
+
+bool Decompressor::push(std::vector<char>&& chunk) {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mSpace.wait(lock, [this] { return mStopped || mQueue.size() < mQueuedChunks; });
+    if (mStopped) {
+        return false;
+    }
+    mQueue.push_back(std::move(chunk));
+    mReady.notify_one();
+    return true;
+}
+
+void Decompressor::run() {
+    try {
+        if (mCompression == Compression::Gzip) {
+            inflateGzip();
+        } else {
+            inflateZstd();
+        }
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mError = std::current_exception();
+    }
+    std::lock_guard<std::mutex> lock(mMutex);
+    mDone = true;
+    mReady.notify_all();
+}
+
+void Decompressor::inflateGzip() {
+#ifdef PCSC_HAVE_ZLIB
+    z_stream stream{};
+    // 15 + 32: largest window, gzip or zlib header detected automatically
+    if (inflateInit2(&stream, 15 + 32) != Z_OK) {
+        throw std::runtime_error("Cannot initialize zlib");
+    }
+    std::unique_ptr<z_stream, int (*)(z_stream*)> guard(&stream, inflateEnd);
+
+    const char* input = mInput.data();
+    std::size_t remaining = mInput.size();
+    std::vector<char> chunk(mChunkBytes);
+    std::size_t filled = 0;
+    while (true) {
+        if (stream.avail_in == 0 && remaining > 0) {
+            std::size_t bytes = std::min<std::size_t>(remaining, UINT_MAX);
+            stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input));
+            stream.avail_in = static_cast<uInt>(bytes);
+            input += bytes;
+            remaining -= bytes;
+        }
+        std::size_t space = std::min<std::size_t>(chunk.size() - filled, UINT_MAX);
+        stream.next_out = reinterpret_cast<Bytef*>(chunk.data() + filled);
+        stream.avail_out = static_cast<uInt>(space);
+        int status = inflate(&stream, Z_NO_FLUSH);
+        filled += space - stream.avail_out;
+
+        if (status == Z_STREAM_END) {
+            // NUL padding after the last member (tape blocks, some archivers) is ignored, as gzip -d does
+            const char* rest = reinterpret_cast<const char*>(stream.next_in);
+            if (std::all_of(rest, rest + stream.avail_in, [](char c) { return c == 0; }) &&
+                std::all_of(input, input + remaining, [](char c) { return c == 0; })) {
+                break;
+            }
+            // Concatenated members, as written by pigz or "cat a.gz b.gz"
+            inflateReset(&stream);
+        } else if (status == Z_BUF_ERROR && stream.avail_in == 0 && remaining == 0) {
+            throw std::runtime_error("Truncated gzip file: " + mInput.filename());
+        } else if (status != Z_OK && status != Z_BUF_ERROR) {
+            throw std::runtime_error("Corrupted gzip file: " + mInput.filename() + " (" +
+                                     (stream.msg ? stream.msg : "inflate failed") + ")");
+        }
+
+        if (filled == chunk.size()) {
+            if (!push(std::move(chunk))) return;
+            chunk = std::vector<char>(mChunkBytes);
+            filled = 0;
+        }
+    }
+    chunk.resize(filled);
+    if (filled > 0) push(std::move(chunk));
+#endif
+}
+
+void Decompressor::inflateZstd() {
+#ifdef PCSC_HAVE_ZSTD
+    std::unique_ptr<ZSTD_DStream, std::size_t (*)(ZSTD_DStream*)> stream(ZSTD_createDStream(), ZSTD_freeDStream);
+    if (!stream || ZSTD_isError(ZSTD_initDStream(stream.get()))) {
+        throw std::runtime_error("Cannot initialize zstd");
+    }
+
+    ZSTD_inBuffer input = {mInput.data(), mInput.size(), 0};
+    std::vector<char> chunk(mChunkBytes);
+    std::size_t filled = 0;
+    std::size_t pending = 0;
+    while (true) {
+        ZSTD_outBuffer output = {chunk.data(), chunk.size(), filled};
+        pending = ZSTD_decompressStream(stream.get(), &output, &input);
+        if (ZSTD_isError(pending)) {
+            throw std::runtime_error("Corrupted zstd file: " + mInput.filename() + " (" + ZSTD_getErrorName(pending) + ")");
+        }
+        filled = output.pos;
+
+        // A full chunk may leave data inside the decoder: call it again even without input
+        if (filled == chunk.size()) {
+            if (!push(std::move(chunk))) return;
+            chunk = std::vector<char>(mChunkBytes);
+            filled = 0;
+        } else if (input.pos == input.size) {
+            break;
+        }
+    }
+    if (pending != 0) {
+        throw std::runtime_error("Truncated zstd file: " + mInput.filename());
+    }
+    chunk.resize(filled);
+    if (filled > 0) push(std::move(chunk));
+#endif
+}
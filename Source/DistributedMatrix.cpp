@@ -0,0 +1,111 @@
+#include "DistributedMatrix.h"
+#include <chrono>
+#include <stdexcept>
+
+using Clock = std::chrono::steady_clock;
+
+static double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Constructor
+template<typename Scalar>
+DistributedMatrix<Scalar>::DistributedMatrix(const Matrix& localRows, long globalRows, Transport& transport)
+    : mLocalRows(localRows),
+      mGlobalRows(globalRows),
+      mFirstRow(0),
+      mTransport(transport) {
+
+    long count = 0;
+    rowRange(mGlobalRows, mTransport.rank(), mTransport.size(), mFirstRow, count);
+    if (mLocalRows.rows() != count || (count > 0 && mLocalRows.cols() != mGlobalRows)) {
+        throw std::runtime_error("DistributedMatrix: the local block does not match the row split of rank " +
+                                 std::to_string(mTransport.rank()));
+    }
+    mLocalRows.resize(count, mGlobalRows);  // no-op unless the block is empty
+
+    mBytesPerRank.resize(mTransport.size());
+    for (int r = 0; r < mTransport.size(); ++r) {
+        long first, rows;
+        rowRange(mGlobalRows, r, mTransport.size(), first, rows);
+        mBytesPerRank[r] = sizeof(Scalar) * static_cast<std::size_t>(rows);
+    }
+}
+
+template<typename Scalar>
+DistributedMatrix<Scalar> DistributedMatrix<Scalar>::fromReader(Reader<Scalar>& reader, Transport& transport) {
+    long globalRows = reader.CountMatrixRows();
+    long first, count;
+    rowRange(globalRows, transport.rank(), transport.size(), first, count);
+    Matrix block = reader.ReadMatrixRows(first, count);
+    if (count > 0 && block.cols() != globalRows) {
+        throw std::runtime_error("DistributedMatrix: the matrix must be square");
+    }
+    return DistributedMatrix(block, globalRows, transport);
+}
+
+template<typename Scalar>
+void DistributedMatrix<Scalar>::rowRange(long globalRows, int rank, int ranks, long& firstRow, long& rowCount) {
+    firstRow = globalRows * rank / ranks;
+    rowCount = globalRows * (rank + 1) / ranks - firstRow;
+}
+
+template<typename Scalar>
+void DistributedMatrix<Scalar>::multiplyLocal(const Vector& x, Vector& localResult) {
+    auto start = Clock::now();
+    localResult.noalias() = mLocalRows * x;
+    mTimings.computeSeconds += secondsSince(start);
+}
+
+template<typename Scalar>
+void DistributedMatrix<Scalar>::gather(const Vector& local, Vector& global) {
+    auto start = Clock::now();
+    global.resize(mGlobalRows);
+    mTransport.allGather(local.data(), global.data(), mBytesPerRank);
+    mTimings.communicationSeconds += secondsSince(start);
+}
+
+template<typename Scalar>
+void DistributedMatrix<Scalar>::multiply(const Vector& x, Vector& y) {
+    Vector local;
+    multiplyLocal(x, local);
+    gather(local, y);
+    mTimings.products += 1.0;
+}
+
+template<typename Scalar>
+Scalar DistributedMatrix<Scalar>::dot(const Vector& localA, const Vector& localB) {
+    auto start = Clock::now();
+    Scalar local = localA.dot(localB);
+    mTimings.computeSeconds += secondsSince(start);
+
+    start = Clock::now();
+    double parts[2] = {std::real(local), std::imag(local)};
+    mTransport.allReduceSum(parts, 2);
+    mTimings.communicationSeconds += secondsSince(start);
+    if constexpr (Eigen::NumTraits<Scalar>::IsComplex) {
+        return Scalar(parts[0], parts[1]);
+    } else {
+        return parts[0];
+    }
+}
+
+template<typename Scalar>
+DistributedTimings DistributedMatrix<Scalar>::getTimings() const {
+    DistributedTimings timings = mTimings;
+    timings.bytesSent = static_cast<double>(mTransport.getBytesSent());
+    timings.bytesReceived = static_cast<double>(mTransport.getBytesReceived());
+    return timings;
+}
+
+template<typename Scalar>
+std::vector<DistributedTimings> DistributedMatrix<Scalar>::gatherTimings() {
+    DistributedTimings local = getTimings();
+    std::vector<DistributedTimings> all(mTransport.size());
+    std::vector<std::size_t> bytes(mTransport.size(), sizeof(DistributedTimings));
+    mTransport.allGather(&local, all.data(), bytes);
+    return all;
+}
+
+template class DistributedMatrix<double>;
+template class DistributedMatrix<std::complex<double>>;
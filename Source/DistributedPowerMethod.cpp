@@ -0,0 +1,79 @@
+#include "DistributedPowerMethod.h"
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+// Constructor
+template<typename Scalar>
+DistributedPowerMethod<Scalar>::DistributedPowerMethod(DistributedMatrix<Scalar>& matrix, const Parameters& params)
+    : mMatrix(matrix),
+      mMaxIteration(params.getMaxIterations()),
+      mTolerance(params.getTolerance()),
+      mEigenvalue(Scalar(0.0)),
+      mConverged(false),
+      mIterationCount(0) {}
+
+template<typename Scalar>
+void DistributedPowerMethod<Scalar>::solve() {
+    // Same start vector on every rank: a fixed seed instead of Eigen's setRandom()
+    const long n = mMatrix.globalRows();
+    Vector b_k(n);
+    std::mt19937 generator(2025u);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    for (long i = 0; i < n; ++i) b_k(i) = Scalar(uniform(generator));
+    b_k.normalize();
+
+    Vector b_k1;
+    Scalar lambda_k = 0.0;
+    mConverged = false;
+
+    for (mIterationCount = 1; mIterationCount <= mMaxIteration; ++mIterationCount) {
+        mMatrix.multiply(b_k, b_k1);
+
+        // Replicated on every rank, with identical results
+        Eigen::Index max_idx;
+        b_k1.cwiseAbs2().maxCoeff(&max_idx);
+        Scalar lambda_k_plus_1 = b_k1(max_idx) / b_k(max_idx);
+
+        b_k = b_k1.normalized();
+        if (std::abs(lambda_k_plus_1 - lambda_k) < mTolerance) {
+            mConverged = true;
+            mEigenvalue = lambda_k_plus_1;
+            mEigenvector = b_k;
+            break;
+        }
+        lambda_k = lambda_k_plus_1;
+    }
+
+    if (!mConverged) {
+        if (mMatrix.transport().rank() == 0) {
+            std::cerr << "DistributedPowerMethod failed to converge after " << mMaxIteration << " iterations." << std::endl;
+        }
+        mEigenvalue = lambda_k;
+        mEigenvector = b_k;
+    }
+}
+
+template<typename Scalar>
+void DistributedPowerMethod<Scalar>::reportTimings(std::ostream& out) {
+    std::vector<DistributedTimings> timings = mMatrix.gatherTimings();
+    if (mMatrix.transport().rank() != 0) return;
+
+    out << "\nRank  rows  compute [s]  communication [s]  sent [MB]  received [MB]" << std::endl;
+    for (std::size_t r = 0; r < timings.size(); ++r) {
+        long first, rows;
+        DistributedMatrix<Scalar>::rowRange(mMatrix.globalRows(), static_cast<int>(r),
+                                            static_cast<int>(timings.size()), first, rows);
+        out << std::setw(4) << r << std::setw(6) << rows
+            << std::setw(13) << std::fixed << std::setprecision(4) << timings[r].computeSeconds
+            << std::setw(19) << timings[r].communicationSeconds
+            << std::setw(11) << std::setprecision(3) << timings[r].bytesSent / 1e6
+            << std::setw(15) << timings[r].bytesReceived / 1e6 << std::endl;
+    }
+    out.unsetf(std::ios::floatfield);
+    out << std::setprecision(6);
+}
+
+template class DistributedPowerMethod<double>;
+template class DistributedPowerMethod<std::complex<double>>;
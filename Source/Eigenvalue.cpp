@@ -1,5 +1,6 @@
 #include "Eigenvalue.h"
 #include <Eigen/LU> // Required for Eigen::FullPivLU
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <complex>
@@ -12,12 +13,32 @@ template class Eigenvalue<std::complex<double>>;
 // Template to work with different Scalar types particulary for matrices
 template<typename Scalar>
 Eigenvalue<Scalar>::Eigenvalue(const Matrix& matrix, const Parameters& params)
-    : mMatrix(matrix),
+    : mStorage(matrix),
+      mMatrix(mStorage.data(), mStorage.rows(), mStorage.cols()),
+      mShift(Scalar(params.getShift())),
+      mParams(params),
       mMaxIteration(params.getMaxIterations()),
       mTolerance(params.getTolerance()),
       mConverged(false),
       mIterationCount(0) {
+    initialize();
+}
 
+// Constructor on the caller's storage (no copy)
+template<typename Scalar>
+Eigenvalue<Scalar>::Eigenvalue(const MatrixMap& matrix, const Parameters& params)
+    : mMatrix(matrix.data(), matrix.rows(), matrix.cols()),
+      mShift(Scalar(params.getShift())),
+      mParams(params),
+      mMaxIteration(params.getMaxIterations()),
+      mTolerance(params.getTolerance()),
+      mConverged(false),
+      mIterationCount(0) {
+    initialize();
+}
+
+template<typename Scalar>
+void Eigenvalue<Scalar>::initialize() {
     if (mMatrix.rows() != mMatrix.cols()) {
         std::cerr << "Error: Matrix must be square to be invertible." << std::endl;
     }
@@ -27,6 +48,7 @@ Eigenvalue<Scalar>::Eigenvalue(const Matrix& matrix, const Parameters& params)
     mEigenvector.setRandom();
     mEigenvector.normalize();
     mEigenvalue = Scalar(0.0);
+    mHistory.setCapacity(static_cast<std::size_t>(std::max(mParams.getHistoryCapacity(), 0)));
 }
 
 // Destructor
@@ -41,7 +63,9 @@ void Eigenvalue<Scalar>::setTolerance(double tolerance) {
 
 template<typename Scalar>
 void Eigenvalue<Scalar>::setMatrix(const Matrix& matrix) {
-    mMatrix = matrix;
+    mStorage = matrix;
+    // Eigen::Map is re-pointed by placement new
+    new (&mMatrix) MatrixMap(mStorage.data(), mStorage.rows(), mStorage.cols());
 }
 
 template<typename Scalar>
@@ -49,6 +73,11 @@ void Eigenvalue<Scalar>::setMaxIteration(int maxIteration) {
     mMaxIteration = maxIteration;
 }
 
+template<typename Scalar>
+void Eigenvalue<Scalar>::setHistoryCapacity(std::size_t capacity) {
+    mHistory.setCapacity(capacity);
+}
+
 // Getters
 template<typename T>
 bool Eigenvalue<T>::hasConverged() const {
@@ -80,6 +109,27 @@ int Eigenvalue<Scalar>::getIterationCount() const {
     return mIterationCount;
 }
 
+template<typename Scalar>
+const SolverStats& Eigenvalue<Scalar>::getStats() const {
+    return mStats;
+}
+
+template<typename Scalar>
+const ConvergenceHistory& Eigenvalue<Scalar>::getHistory() const {
+    return mHistory;
+}
+
+template<typename Scalar>
+double Eigenvalue<Scalar>::measureResidual(Scalar eigenvalue, const Vector& eigenvector) {
+    const double norm = eigenvector.norm();
+    if (norm == 0.0) return 0.0;
+    Vector residual = mMatrix * eigenvector - eigenvalue * eigenvector;
+    mStats.matrixVectorProducts++;
+    mStats.flops += flopScale<Scalar>() * (2.0 * mMatrix.rows() * mMatrix.cols() + 4.0 * mMatrix.rows());
+    mStats.bytesAllocated += sizeof(Scalar) * residual.size();
+    return residual.norm() / norm;
+}
+
 template<typename Scalar>
 bool Eigenvalue<Scalar>::IsInvertible() const {
     if (mMatrix.rows() != mMatrix.cols()) {
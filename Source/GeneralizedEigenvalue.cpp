@@ -0,0 +1,111 @@
+#include "GeneralizedEigenvalue.h"
+#include <iostream>
+#include <complex>
+
+// Tolerance of the Hermitian check, relative to the norm of the matrix
+static const double kHermitianTolerance = 1e-12;
+
+template<typename Matrix>
+static bool isHermitian(const Matrix& matrix) {
+    if (matrix.rows() != matrix.cols()) return false;
+    return (matrix - matrix.adjoint()).norm() <= kHermitianTolerance * matrix.norm();
+}
+
+// Constructor
+template<typename Scalar>
+GeneralizedEigenvalue<Scalar>::GeneralizedEigenvalue(const Matrix& matrixA, const Matrix& matrixB,
+                                                     const Parameters& params)
+    : Eigenvalue<Scalar>(matrixA, params),
+      mMatrixB(matrixB),
+      mHasCholesky(false),
+      mHasLu(false),
+      mStructureChecked(false),
+      mSymmetricDefinite(false) {
+
+    if (mMatrixB.rows() != this->mMatrix.rows() || mMatrixB.cols() != this->mMatrix.cols()) {
+        std::cerr << "Error: Matrix B must have the same size as matrix A." << std::endl;
+    }
+}
+
+// Destructor
+template<typename Scalar>
+GeneralizedEigenvalue<Scalar>::~GeneralizedEigenvalue() {}
+
+// Setters
+template<typename Scalar>
+void GeneralizedEigenvalue<Scalar>::setMatrix(const Matrix& matrix) {
+    Eigenvalue<Scalar>::setMatrix(matrix);
+    mStructureChecked = false;
+    invalidateFactorizations();
+}
+
+template<typename Scalar>
+void GeneralizedEigenvalue<Scalar>::setMatrixB(const Matrix& matrixB) {
+    mMatrixB = matrixB;
+    mHasCholesky = false;
+    mHasLu = false;
+    mStructureChecked = false;
+    invalidateFactorizations();
+}
+
+template<typename Scalar>
+void GeneralizedEigenvalue<Scalar>::invalidateFactorizations() {}
+
+template<typename Scalar>
+void GeneralizedEigenvalue<Scalar>::factorizeB() {
+    if (mHasCholesky || mHasLu) {
+        return;  // Cached from a previous call
+    }
+    PhaseTimer factorization(this->mStats.factorizationSeconds);
+    const double n = mMatrixB.rows();
+    if (isHermitian(mMatrixB)) {
+        this->mStats.factorizations++;
+        this->mStats.flops += flopScale<Scalar>() * n * n * n / 3.0;
+        this->mStats.bytesAllocated += sizeof(Scalar) * mMatrixB.size();
+        mCholeskyB.compute(mMatrixB);
+        mHasCholesky = (mCholeskyB.info() == Eigen::Success);
+    }
+    if (!mHasCholesky) {
+        mLuB.compute(mMatrixB);
+        mHasLu = true;
+        this->mStats.factorizations++;
+        this->mStats.flops += flopScale<Scalar>() * 2.0 / 3.0 * n * n * n;
+        this->mStats.bytesAllocated += sizeof(Scalar) * mMatrixB.size() + sizeof(int) * mMatrixB.rows();
+    }
+}
+
+template<typename Scalar>
+bool GeneralizedEigenvalue<Scalar>::isSymmetricDefinite() {
+    if (!mStructureChecked) {
+        factorizeB();
+        mSymmetricDefinite = mHasCholesky && isHermitian(this->mMatrix);
+        mStructureChecked = true;
+    }
+    return mSymmetricDefinite;
+}
+
+template<typename Scalar>
+void GeneralizedEigenvalue<Scalar>::applyBInverse(const Vector& rhs, Vector& result) {
+    factorizeB();
+    if (mHasCholesky) {
+        result = mCholeskyB.solve(rhs);
+    } else {
+        result = mLuB.solve(rhs);
+    }
+    this->mStats.solves++;
+    this->mStats.flops += flopScale<Scalar>() * 2.0 * mMatrixB.size();
+}
+
+template<typename Scalar>
+double GeneralizedEigenvalue<Scalar>::measureResidual(Scalar eigenvalue, const Vector& eigenvector) {
+    const double norm = eigenvector.norm();
+    if (norm == 0.0) return 0.0;
+    Vector residual = this->mMatrix * eigenvector - eigenvalue * (mMatrixB * eigenvector);
+    this->mStats.matrixVectorProducts += 2;
+    this->mStats.flops += flopScale<Scalar>() * (4.0 * mMatrixB.size() + 4.0 * mMatrixB.rows());
+    this->mStats.bytesAllocated += sizeof(Scalar) * 2 * residual.size();
+    return residual.norm() / norm;
+}
+
+template class GeneralizedEigenvalue<double>;
+template class GeneralizedEigenvalue<std::complex<double>>;
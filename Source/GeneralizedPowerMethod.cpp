@@ -0,0 +1,80 @@
+#include "GeneralizedPowerMethod.h"
+#include <cmath>
+#include <iostream>
+#include <complex>
+
+//Constructor
+template<typename Scalar>
+GeneralizedPowerMethod<Scalar>::GeneralizedPowerMethod(const Matrix& matrixA, const Matrix& matrixB,
+                                                       const Parameters& params)
+    : GeneralizedEigenvalue<Scalar>(matrixA, matrixB, params) {}
+
+//Destructor
+template<typename Scalar>
+GeneralizedPowerMethod<Scalar>::~GeneralizedPowerMethod() {}
+
+template<typename Scalar>
+void GeneralizedPowerMethod<Scalar>::solve() {
+    this->mStats = SolverStats();
+    const double n = this->mMatrix.rows();
+    // Factorized before the loop, so that its time is not counted in the first iteration
+    this->factorizeB();
+
+    PhaseTimer setup(this->mStats.setupSeconds);
+    Vector b_k = this->mEigenvector;
+    Vector Ab_k;
+    Vector b_k1;
+    Scalar lambda_k = 0.0; // Previous eigenvalue approximation
+    setup.stop();
+    this->mStats.bytesAllocated += sizeof(Scalar) * 3 * n;
+
+    this->mConverged = false;
+    this->mIterationCount = 0;
+    this->mHistory.start();
+
+    PhaseTimer iterations(this->mStats.iterationSeconds);
+    for (this->mIterationCount = 1;
+         this->mIterationCount <= this->mMaxIteration;
+         ++this->mIterationCount)
+    {
+        // b_k+1 = B^-1 (A b_k), with B^-1 applied through the cached factorization
+        Ab_k = this->mMatrix * b_k;
+        this->mStats.matrixVectorProducts++;
+        this->applyBInverse(Ab_k, b_k1);
+
+        // Ratio of the largest components gives the eigenvalue approximation
+        Eigen::Index max_idx;
+        b_k1.cwiseAbs2().maxCoeff(&max_idx);
+        Scalar lambda_k_plus_1 = b_k1(max_idx) / b_k(max_idx);
+
+        // Residual ||B^-1 A b_k - lambda b_k|| of the unit iterate, only computed when recorded
+        if (this->mHistory.isEnabled()) {
+            this->mHistory.record(this->mIterationCount, lambda_k_plus_1, (b_k1 - lambda_k_plus_1 * b_k).norm());
+        }
+
+        b_k = b_k1.normalized();
+        if (std::abs(lambda_k_plus_1 - lambda_k) < this->mTolerance) {
+            this->mConverged = true;
+            this->mEigenvalue = lambda_k_plus_1;
+            this->mEigenvector = b_k;
+            break;
+        }
+
+        lambda_k = lambda_k_plus_1;
+    }
+
+    iterations.stop();
+    // The product with A, then the largest component and the normalization (the solves are counted by applyBInverse)
+    this->mStats.flops += flopScale<Scalar>() * this->mStats.matrixVectorProducts * (2 * n * n + 4 * n);
+
+    if (!this->mConverged) {
+        std::cerr << "GeneralizedPowerMethod failed to converge after " << this->mMaxIteration << " iterations." << std::endl;
+        this->mEigenvalue = lambda_k;
+        this->mEigenvector = b_k;
+    }
+    PhaseTimer extraction(this->mStats.extractionSeconds);
+    this->mStats.residual = this->measureResidual(this->mEigenvalue, this->mEigenvector);
+}
+
+template class GeneralizedPowerMethod<double>;
+template class GeneralizedPowerMethod<std::complex<double>>;
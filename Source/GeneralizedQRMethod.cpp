@@ -0,0 +1,151 @@
+#include "GeneralizedQRMethod.h"
+#include "QRMethod.h"
+#include <Eigen/Eigenvalues>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <complex>
+
+//Constructor
+template<typename Scalar>
+GeneralizedQRMethod<Scalar>::GeneralizedQRMethod(const Matrix& matrixA, const Matrix& matrixB,
+                                                 const Parameters& params)
+    : GeneralizedEigenvalue<Scalar>(matrixA, matrixB, params) {}
+
+//Destructor
+template<typename Scalar>
+GeneralizedQRMethod<Scalar>::~GeneralizedQRMethod() {}
+
+// Real pairs: QZ algorithm on (A, B)
+template<>
+void GeneralizedQRMethod<double>::solveGeneralPair() {
+    const double n = this->mMatrix.rows();
+    PhaseTimer iterations(this->mStats.iterationSeconds);
+    Eigen::GeneralizedEigenSolver<Matrix> qz(this->mMatrix, this->mMatrixB, true);
+    iterations.stop();
+    this->mConverged = (qz.info() == Eigen::Success);
+    this->mIterationCount = 1;
+    // QZ with eigenvectors (Golub and Van Loan): copies of A and B, Q, Z, then complex values and vectors
+    this->mStats.factorizations++;
+    this->mStats.flops += 66.0 * n * n * n;
+    this->mStats.bytesAllocated += sizeof(double) * (4 * n * n + 2 * (2 * n * n + 3 * n));
+
+    PhaseTimer extraction(this->mStats.extractionSeconds);
+
+    Eigen::VectorXcd eigenvalues = qz.eigenvalues();
+    Eigen::MatrixXcd eigenvectors = qz.eigenvectors();
+    // A real result cannot hold a complex pair: the solve is reported as not converged
+    for (Eigen::Index i = 0; i < eigenvalues.size(); ++i) {
+        if (std::abs(eigenvalues(i).imag()) > this->mTolerance * std::max(1.0, std::abs(eigenvalues(i)))) {
+            std::cerr << "Warning: the pair has complex generalized eigenvalues, which a real result cannot hold; "
+                      << "only their real parts are kept. Use the complex type for this problem." << std::endl;
+            this->mConverged = false;
+            break;
+        }
+    }
+    mAllEigenvalues = eigenvalues.real();
+    mAllEigenvectors = eigenvectors.real();
+    for (Eigen::Index j = 0; j < mAllEigenvectors.cols(); ++j) {
+        if (mAllEigenvectors.col(j).norm() > 0.0) mAllEigenvectors.col(j).normalize();
+    }
+}
+
+// Complex pairs: B^-1 A through the cached LU factorization, then a complex Schur decomposition
+template<>
+void GeneralizedQRMethod<std::complex<double>>::solveGeneralPair() {
+    this->factorizeB();
+    const double n = this->mMatrix.rows();
+    PhaseTimer setup(this->mStats.setupSeconds);
+    Matrix reduced = this->mHasCholesky ? Matrix(this->mCholeskyB.solve(this->mMatrix))
+                                        : Matrix(this->mLuB.solve(this->mMatrix));
+    setup.stop();
+    this->mStats.solves += this->mMatrix.cols();
+
+    PhaseTimer iterations(this->mStats.iterationSeconds);
+    Eigen::ComplexEigenSolver<Matrix> solver(reduced, true);
+    iterations.stop();
+    this->mConverged = (solver.info() == Eigen::Success);
+    this->mIterationCount = 1;
+    // Substitutions for each column, then the complex Schur decomposition with its eigenvectors
+    this->mStats.flops += flopScale<std::complex<double>>() * (2.0 + 25.0) * n * n * n;
+    this->mStats.bytesAllocated += sizeof(std::complex<double>) * (4 * n * n + n);
+
+    PhaseTimer extraction(this->mStats.extractionSeconds);
+    mAllEigenvalues = solver.eigenvalues();
+    mAllEigenvectors = solver.eigenvectors();
+}
+
+template<typename Scalar>
+void GeneralizedQRMethod<Scalar>::solve() {
+    if (this->mMatrix.rows() != this->mMatrix.cols() || this->mMatrixB.rows() != this->mMatrix.rows()) {
+        std::cerr << "GeneralizedQRMethod requires square matrices of the same size." << std::endl;
+        return;
+    }
+    int n = this->mMatrix.rows();
+    this->mStats = SolverStats();
+    this->mHistory.start();
+    const double size = n;
+
+    if (this->isSymmetricDefinite()) {
+        // 1. Reduce to C = L^-1 A L^-H with the cached Cholesky factor (symmetry is preserved)
+        PhaseTimer setup(this->mStats.setupSeconds);
+        Matrix C = this->mCholeskyB.matrixL().solve(this->mMatrix);
+        C = this->mCholeskyB.matrixL().solve(C.adjoint()).adjoint();
+        C = (C + C.adjoint()) * Scalar(0.5);
+        setup.stop();
+        this->mStats.solves += 2 * n;
+        this->mStats.flops += flopScale<Scalar>() * 2 * size * size * size;
+        this->mStats.bytesAllocated += sizeof(Scalar) * 4 * size * size;
+
+        // 2. Standard Hermitian problem, solved by the QR Method
+        // Its convergence trace is that of this solve (the QZ path of a general pair records none)
+        QRMethod<Scalar> qr(C, this->mParams);
+        qr.setHistoryCapacity(this->mHistory.getCapacity());
+        qr.solve();
+        this->mConverged = qr.hasConverged();
+        this->mIterationCount = qr.getIterationCount();
+        this->mStats += qr.getStats();
+        this->mHistory = qr.getHistory();
+
+        // 3. Back-transform the eigenvectors: x = L^-H y
+        PhaseTimer extraction(this->mStats.extractionSeconds);
+        mAllEigenvalues = qr.getAllEigenvalues();
+        mAllEigenvectors = this->mCholeskyB.matrixU().solve(qr.getAllEigenvectors());
+        this->mStats.solves += n;
+        this->mStats.flops += flopScale<Scalar>() * size * size * size;
+        this->mStats.bytesAllocated += sizeof(Scalar) * 2 * size * size;
+    } else {
+        solveGeneralPair();
+    }
+
+    // Stock the eigenvalue of largest magnitude
+    int max_idx = 0;
+    for (int i = 1; i < n; ++i) {
+        if (std::abs(mAllEigenvalues(i)) > std::abs(mAllEigenvalues(max_idx))) {
+            max_idx = i;
+        }
+    }
+    if (n > 0) {
+        PhaseTimer extraction(this->mStats.extractionSeconds);
+        this->mEigenvalue = mAllEigenvalues(max_idx);
+        // No residual without eigenvectors, or when that of the dominant eigenvalue was not selected
+        if (mAllEigenvectors.cols() == n && mAllEigenvectors.col(max_idx).squaredNorm() > 0) {
+            this->mEigenvector = mAllEigenvectors.col(max_idx);
+            this->mStats.residual = this->measureResidual(this->mEigenvalue, this->mEigenvector);
+        } else {
+            this->mEigenvector.resize(0);
+        }
+    }
+
+    if (this->mConverged) {
+        std::cout << "GeneralizedQRMethod converged ("
+                  << (this->isSymmetricDefinite() ? "Cholesky reduction" : "general pair") << ")." << std::endl;
+    } else {
+        std::cerr << "GeneralizedQRMethod failed to converge";
+        if (this->isSymmetricDefinite()) std::cerr << " after " << this->mMaxIteration << " iterations";
+        std::cerr << "." << std::endl;
+    }
+}
+
+template class GeneralizedQRMethod<double>;
+template class GeneralizedQRMethod<std::complex<double>>;
@@ -0,0 +1,107 @@
+#include "GeneralizedShiftedInversePowerMethod.h"
+#include <cmath>
+#include <iostream>
+#include <complex>
+
+//Constructor
+template<typename Scalar>
+GeneralizedShiftedInversePowerMethod<Scalar>::GeneralizedShiftedInversePowerMethod(const Matrix& matrixA,
+                                                                                   const Matrix& matrixB,
+                                                                                   const Parameters& params)
+    : GeneralizedEigenvalue<Scalar>(matrixA, matrixB, params),
+      mHasShiftedLu(false),
+      mFactorizedShift(0.0) {}
+
+//Destructor
+template<typename Scalar>
+GeneralizedShiftedInversePowerMethod<Scalar>::~GeneralizedShiftedInversePowerMethod() {}
+
+template<typename Scalar>
+void GeneralizedShiftedInversePowerMethod<Scalar>::invalidateFactorizations() {
+    mHasShiftedLu = false;
+}
+
+template<typename Scalar>
+void GeneralizedShiftedInversePowerMethod<Scalar>::solve() {
+    this->mStats = SolverStats();
+    const double n = this->mMatrix.rows();
+
+    // 1. Factorize A - mu*B once; reuse it while A, B and the shift are unchanged
+    if (!mHasShiftedLu || mFactorizedShift != this->mShift) {
+        PhaseTimer factorization(this->mStats.factorizationSeconds);
+        mLuShifted.compute(this->mMatrix - this->mShift * this->mMatrixB);
+        mFactorizedShift = this->mShift;
+        mHasShiftedLu = true;
+        this->mStats.factorizations = 1;
+        this->mStats.flops = flopScale<Scalar>() * 2.0 / 3.0 * n * n * n;
+        this->mStats.bytesAllocated = sizeof(Scalar) * 2 * this->mMatrix.size() + sizeof(int) * n;
+    }
+
+    Scalar det = mLuShifted.determinant();
+    const double epsilon = 1e-10;
+    if (std::abs(det) < epsilon) {
+        std::cerr << "The matrix (A - mu*B) is singular (shift is likely an exact eigenvalue). Choose a different shift mu." << std::endl;
+        return;
+    }
+
+    Vector x_k = this->mEigenvector;
+    Vector Bx_k;
+    Vector x_k_plus_1;
+    Scalar mu_prime_k = 0.0;
+
+    this->mConverged = false;
+    this->mIterationCount = 0;
+    this->mHistory.start();
+    this->mStats.bytesAllocated += sizeof(Scalar) * 3 * n;
+
+    PhaseTimer iterations(this->mStats.iterationSeconds);
+    for (this->mIterationCount = 1;
+         this->mIterationCount <= this->mMaxIteration;
+         ++this->mIterationCount)
+    {
+        // 2. Solve (A - mu*B) x_k+1 = B x_k
+        Bx_k = this->mMatrixB * x_k;
+        x_k_plus_1 = mLuShifted.solve(Bx_k);
+        this->mStats.matrixVectorProducts++;
+        this->mStats.solves++;
+
+        // 3. Dominant eigenvalue of (A - mu*B)^-1 B is 1 / (lambda - mu)
+        Eigen::Index max_idx;
+        x_k_plus_1.cwiseAbs2().maxCoeff(&max_idx);
+        Scalar mu_prime_k_plus_1 = x_k_plus_1(max_idx) / x_k(max_idx);
+
+        // Relative residual ||y - mu' x_k|| / ||y|| of the inverse iteration, only computed when recorded
+        if (this->mHistory.isEnabled()) {
+            this->mHistory.record(this->mIterationCount, this->mShift + Scalar(1.0) / mu_prime_k_plus_1,
+                                  (x_k_plus_1 - mu_prime_k_plus_1 * x_k).norm() / x_k_plus_1.norm());
+        }
+
+        x_k_plus_1.normalize();
+        Scalar lambda_k_plus_1 = this->mShift + (Scalar(1.0) / mu_prime_k_plus_1);
+
+        if (std::abs(mu_prime_k_plus_1 - mu_prime_k) < this->mTolerance) {
+            this->mConverged = true;
+            this->mEigenvalue = lambda_k_plus_1;
+            this->mEigenvector = x_k_plus_1;
+            break;
+        }
+
+        x_k = x_k_plus_1;
+        mu_prime_k = mu_prime_k_plus_1;
+    }
+
+    iterations.stop();
+    // The product with B, the substitutions, then the largest component, normalization and copy
+    this->mStats.flops += flopScale<Scalar>() * this->mStats.solves * (4 * n * n + 5 * n);
+
+    if (!this->mConverged) {
+        std::cerr << "GeneralizedShiftedInversePowerMethod failed to converge after " << this->mMaxIteration << " iterations." << std::endl;
+        this->mEigenvalue = this->mShift + (Scalar(1.0) / mu_prime_k);
+        this->mEigenvector = x_k;
+    }
+    PhaseTimer extraction(this->mStats.extractionSeconds);
+    this->mStats.residual = this->measureResidual(this->mEigenvalue, this->mEigenvector);
+}
+
+template class GeneralizedShiftedInversePowerMethod<double>;
+template class GeneralizedShiftedInversePowerMethod<std::complex<double>>;
@@ -0,0 +1,107 @@
+#include "MappedFile.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+// Error message with the reason given by errno
+static std::runtime_error mappingError(const std::string& what, const std::string& filename) {
+    return std::runtime_error("MappedFile: " + what + " " + filename + " (" + std::strerror(errno) + ")");
+}
+
+MappedFile::MappedFile() : mData(nullptr), mSize(0), mWritable(false) {}
+
+MappedFile::MappedFile(const std::string& filename)
+    : mFilename(filename), mData(nullptr), mSize(0), mWritable(false) {
+    int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw mappingError("cannot open", filename);
+    }
+    struct stat status;
+    if (::fstat(fd, &status) != 0) {
+        ::close(fd);
+        throw mappingError("cannot stat", filename);
+    }
+    mSize = static_cast<std::size_t>(status.st_size);
+    if (mSize > 0) {
+        void* address = ::mmap(nullptr, mSize, PROT_READ, MAP_SHARED, fd, 0);
+        if (address == MAP_FAILED) {
+            ::close(fd);
+            throw mappingError("cannot map", filename);
+        }
+        mData = static_cast<char*>(address);
+    }
+    // The mapping keeps its own reference to the file
+    ::close(fd);
+}
+
+MappedFile::MappedFile(const std::string& filename, std::size_t size)
+    : mFilename(filename), mData(nullptr), mSize(size), mWritable(true) {
+    int fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throw mappingError("cannot create", filename);
+    }
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        ::close(fd);
+        throw mappingError("cannot resize", filename);
+    }
+    if (size > 0) {
+        void* address = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (address == MAP_FAILED) {
+            ::close(fd);
+            throw mappingError("cannot map", filename);
+        }
+        mData = static_cast<char*>(address);
+    }
+    ::close(fd);
+}
+
+MappedFile::~MappedFile() {
+    release();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : mFilename(std::move(other.mFilename)), mData(other.mData), mSize(other.mSize), mWritable(other.mWritable) {
+    other.mData = nullptr;
+    other.mSize = 0;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        mFilename = std::move(other.mFilename);
+        mData = other.mData;
+        mSize = other.mSize;
+        mWritable = other.mWritable;
+        other.mData = nullptr;
+        other.mSize = 0;
+    }
+    return *this;
+}
+
+void MappedFile::release() {
+    if (mData) {
+        ::munmap(mData, mSize);
+    }
+    mData = nullptr;
+    mSize = 0;
+}
+
+void MappedFile::advise(Access access) const {
+    if (!mData) return;
+    int advice = MADV_NORMAL;
+    if (access == Access::Sequential) advice = MADV_SEQUENTIAL;
+    if (access == Access::WillNeed) advice = MADV_WILLNEED;
+    // Only a hint: failures are ignored
+    ::madvise(mData, mSize, advice);
+}
+
+void MappedFile::flush() {
+    if (mData && mWritable && ::msync(mData, mSize, MS_SYNC) != 0) {
+        throw mappingError("cannot write back", mFilename);
+    }
+}
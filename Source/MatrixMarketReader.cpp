@@ -0,0 +1,368 @@
+#include "MatrixMarketReader.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <climits>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Returns the line at cursor (without its newline) and moves cursor to the next one
+static std::string_view nextLine(const char*& cursor, const char* end) {
+    const char* newline = std::find(cursor, end, '\n');
+    std::string_view line(cursor, newline - cursor);
+    cursor = newline < end ? newline + 1 : end;
+    return line;
+}
+
+static const char* skipBlanks(const char* cursor, const char* end) {
+    while (cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r')) ++cursor;
+    return cursor;
+}
+
+// Blank lines and comments carry no entry
+static bool isDataLine(std::string_view line) {
+    const char* first = skipBlanks(line.data(), line.data() + line.size());
+    return first < line.data() + line.size() && *first != '%';
+}
+
+// Reads an integer after optional blanks; null on failure
+static const char* readIndex(const char* cursor, const char* end, long& value) {
+    cursor = skipBlanks(cursor, end);
+    std::from_chars_result result = std::from_chars(cursor, end, value);
+    return result.ec == std::errc() ? result.ptr : nullptr;
+}
+
+// Reads a real number after optional blanks; null on failure
+static const char* readReal(const char* cursor, const char* end, double& value) {
+    cursor = skipBlanks(cursor, end);
+    if (cursor < end && *cursor == '+') ++cursor;
+    std::from_chars_result result = std::from_chars(cursor, end, value);
+    return result.ec == std::errc() ? result.ptr : nullptr;
+}
+
+static std::string lowercase(std::string word) {
+    std::transform(word.begin(), word.end(), word.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return word;
+}
+
+static std::string trim(std::string_view text) {
+    std::size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string_view::npos) return std::string();
+    std::size_t last = text.find_last_not_of(" \t\r");
+    return std::string(text.substr(first, last - first + 1));
+}
+
+// Constructor
+template<typename Scalar>
+MatrixMarketReader<Scalar>::MatrixMarketReader(const std::string& filename)
+    : Reader<Scalar>(filename),
+      mFile(filename),
+      mFormat(Format::Coordinate),
+      mField(Field::Real),
+      mSymmetry(Symmetry::General),
+      mRows(0),
+      mCols(0),
+      mEntries(0),
+      mCommentsOffset(0),
+      mDataOffset(0) {
+
+    const char* data = mFile.data();
+    const char* end = data + mFile.size();
+    const char* cursor = data;
+
+    // Banner: %%MatrixMarket matrix <format> <field> <symmetry>
+    std::istringstream banner{std::string(nextLine(cursor, end))};
+    std::string tag, object, format, field, symmetry;
+    banner >> tag >> object >> format >> field >> symmetry;
+    if (tag != "%%MatrixMarket") {
+        throw std::runtime_error("Not a Matrix Market file (no %%MatrixMarket banner): " + filename);
+    }
+    object = lowercase(object);
+    format = lowercase(format);
+    field = lowercase(field);
+    symmetry = lowercase(symmetry);
+
+    if (object != "matrix") {
+        throw std::runtime_error("Unsupported Matrix Market object '" + object + "' in " + filename);
+    }
+    if (format == "coordinate") {
+        mFormat = Format::Coordinate;
+    } else if (format == "array") {
+        mFormat = Format::Array;
+    } else {
+        throw std::runtime_error("Unsupported Matrix Market format '" + format + "' in " + filename);
+    }
+    if (field == "real" || field == "double") {
+        mField = Field::Real;
+    } else if (field == "integer") {
+        mField = Field::Integer;
+    } else if (field == "complex") {
+        mField = Field::Complex;
+    } else if (field == "pattern" && mFormat == Format::Coordinate) {
+        mField = Field::Pattern;
+    } else {
+        throw std::runtime_error("Unsupported Matrix Market field '" + field + "' in " + filename);
+    }
+    if (symmetry == "general") {
+        mSymmetry = Symmetry::General;
+    } else if (symmetry == "symmetric") {
+        mSymmetry = Symmetry::Symmetric;
+    } else if (symmetry == "skew-symmetric") {
+        mSymmetry = Symmetry::SkewSymmetric;
+    } else if (symmetry == "hermitian") {
+        mSymmetry = Symmetry::Hermitian;
+    } else {
+        throw std::runtime_error("Unsupported Matrix Market symmetry '" + symmetry + "' in " + filename);
+    }
+    mCommentsOffset = cursor - data;
+
+    // Size line: the first line after the comments
+    std::string_view line;
+    do {
+        if (cursor == end) {
+            throw std::runtime_error("No size line in Matrix Market file " + filename);
+        }
+        line = nextLine(cursor, end);
+    } while (!isDataLine(line));
+    mDataOffset = cursor - data;
+
+    const char* lineEnd = line.data() + line.size();
+    const char* position = readIndex(line.data(), lineEnd, mRows);
+    if (position) position = readIndex(position, lineEnd, mCols);
+    if (position && mFormat == Format::Coordinate) position = readIndex(position, lineEnd, mEntries);
+    if (!position || mRows < 0 || mCols < 0 || mEntries < 0) {
+        throw std::runtime_error("Invalid Matrix Market size line '" + trim(line) + "' in " + filename);
+    }
+    if (mRows > INT_MAX || mCols > INT_MAX) {
+        throw std::runtime_error("Matrix Market matrix too large for 32-bit indices: " + filename);
+    }
+    if (mSymmetry != Symmetry::General && mRows != mCols) {
+        throw std::runtime_error("A symmetric Matrix Market matrix must be square: " + filename);
+    }
+    if (mFormat == Format::Array) {
+        // Only the lower triangle (without the diagonal for skew-symmetric matrices) is stored
+        if (mSymmetry == Symmetry::General) {
+            mEntries = mRows * mCols;
+        } else if (mSymmetry == Symmetry::SkewSymmetric) {
+            mEntries = mRows * (mRows - 1) / 2;
+        } else {
+            mEntries = mRows * (mRows + 1) / 2;
+        }
+    }
+
+    std::cout << "Matrix Market file: " << filename << " (" << mRows << "x" << mCols << ", " << format << " "
+              << field << " " << symmetry << ", " << mEntries << " stored entries)" << std::endl;
+}
+
+// Destructor
+template<typename Scalar>
+MatrixMarketReader<Scalar>::~MatrixMarketReader() {}
+
+template<typename Scalar>
+typename MatrixMarketReader<Scalar>::SparseMatrix MatrixMarketReader<Scalar>::ReadSparse() {
+    if (mField == Field::Complex && !Eigen::NumTraits<Scalar>::IsComplex) {
+        throw std::runtime_error("The Matrix Market file holds complex values, read it as complex");
+    }
+
+    // Eigen's sparse matrices index their entries with int: every coordinate entry is stored at least once
+    if (mFormat == Format::Coordinate && mEntries > INT_MAX) {
+        throw std::runtime_error("Matrix Market matrix has too many entries for 32-bit indices (" +
+                                 std::to_string(mEntries) + "): " + this->mFilename);
+    }
+
+    // Triplet buffers at their final size: the off-diagonal entries of a triangle are stored twice
+    const bool mirrored = mSymmetry != Symmetry::General;
+    const std::size_t capacity = static_cast<std::size_t>(mEntries) * (mirrored ? 2 : 1);
+    std::vector<int> rowIndex, colIndex;
+    std::vector<Scalar> values;
+    rowIndex.reserve(capacity);
+    colIndex.reserve(capacity);
+    values.reserve(capacity);
+
+    auto add = [&](long i, long j, const Scalar& value) {
+        rowIndex.push_back(static_cast<int>(i));
+        colIndex.push_back(static_cast<int>(j));
+        values.push_back(value);
+        if (mirrored && i != j) {
+            rowIndex.push_back(static_cast<int>(j));
+            colIndex.push_back(static_cast<int>(i));
+            if (mSymmetry == Symmetry::SkewSymmetric) {
+                values.push_back(-value);
+            } else if (mSymmetry == Symmetry::Hermitian) {
+                values.push_back(Eigen::numext::conj(value));
+            } else {
+                values.push_back(value);
+            }
+        }
+    };
+
+    // Entries, in file order
+    const char* cursor = mFile.data() + mDataOffset;
+    const char* end = mFile.data() + mFile.size();
+    long arrayRow = mSymmetry == Symmetry::SkewSymmetric ? 1 : 0;
+    long arrayCol = 0;
+    for (long k = 0; k < mEntries; ++k) {
+        std::string_view line;
+        do {
+            if (cursor == end) {
+                throw std::runtime_error("Truncated Matrix Market file: " + std::to_string(k) + " of " +
+                                         std::to_string(mEntries) + " entries in " + this->mFilename);
+            }
+            line = nextLine(cursor, end);
+        } while (!isDataLine(line));
+
+        const char* position = line.data();
+        const char* lineEnd = position + line.size();
+        long i = 0, j = 0;
+        if (mFormat == Format::Coordinate) {
+            position = readIndex(position, lineEnd, i);
+            if (position) position = readIndex(position, lineEnd, j);
+            // 1-based in the file; a failed read is reported below
+            if (position) {
+                --i;
+                --j;
+            }
+        } else {
+            i = arrayRow;
+            j = arrayCol;
+            if (++arrayRow >= mRows) {
+                ++arrayCol;
+                arrayRow = mSymmetry == Symmetry::General ? 0
+                         : mSymmetry == Symmetry::SkewSymmetric ? arrayCol + 1 : arrayCol;
+            }
+        }
+
+        Scalar value(1);
+        if (position && mField != Field::Pattern) {
+            double real = 0.0, imag = 0.0;
+            position = readReal(position, lineEnd, real);
+            if (position && mField == Field::Complex) position = readReal(position, lineEnd, imag);
+            if constexpr (Eigen::NumTraits<Scalar>::IsComplex) {
+                value = Scalar(real, imag);
+            } else {
+                value = real;
+            }
+        }
+        if (!position) {
+            throw std::runtime_error("Invalid Matrix Market entry '" + trim(line) + "' in " + this->mFilename);
+        }
+        if (i < 0 || i >= mRows || j < 0 || j >= mCols || (mirrored && j > i)) {
+            throw std::runtime_error("Matrix Market entry '" + trim(line) + "' outside the " +
+                                     (mirrored ? std::string("lower triangle") : std::string("matrix")) + " in " +
+                                     this->mFilename);
+        }
+        if (mFormat == Format::Array && value == Scalar(0)) {
+            continue;
+        }
+        add(i, j, value);
+    }
+
+    // Compression into CSR: count the entries of each row, then place them with a counting sort on the rows
+    const std::size_t nonZeros = values.size();
+    if (nonZeros > static_cast<std::size_t>(INT_MAX)) {
+        throw std::runtime_error("Matrix Market matrix has too many nonzeros for 32-bit indices once its triangle "
+                                 "is mirrored (" + std::to_string(nonZeros) + "): " + this->mFilename);
+    }
+    SparseMatrix matrix(mRows, mCols);
+    matrix.resizeNonZeros(static_cast<Eigen::Index>(nonZeros));
+    int* outer = matrix.outerIndexPtr();
+    int* inner = matrix.innerIndexPtr();
+    Scalar* stored = matrix.valuePtr();
+    std::fill(outer, outer + mRows + 1, 0);
+    for (int row : rowIndex) {
+        ++outer[row + 1];
+    }
+    for (long r = 0; r < mRows; ++r) {
+        outer[r + 1] += outer[r];
+    }
+    std::vector<int> next(outer, outer + mRows);
+    for (std::size_t k = 0; k < nonZeros; ++k) {
+        int position = next[rowIndex[k]]++;
+        inner[position] = colIndex[k];
+        stored[position] = values[k];
+    }
+    std::vector<int>().swap(rowIndex);
+    std::vector<int>().swap(colIndex);
+    std::vector<Scalar>().swap(values);
+
+    // Columns in increasing order within each row; duplicates are summed
+    std::vector<std::pair<int, Scalar>> row;
+    int write = 0;
+    for (long r = 0; r < mRows; ++r) {
+        const int begin = outer[r];
+        const int stop = outer[r + 1];
+        if (!std::is_sorted(inner + begin, inner + stop)) {
+            row.clear();
+            for (int k = begin; k < stop; ++k) row.emplace_back(inner[k], stored[k]);
+            std::stable_sort(row.begin(), row.end(),
+                             [](const std::pair<int, Scalar>& a, const std::pair<int, Scalar>& b) {
+                                 return a.first < b.first;
+                             });
+            for (int k = begin; k < stop; ++k) {
+                inner[k] = row[k - begin].first;
+                stored[k] = row[k - begin].second;
+            }
+        }
+        outer[r] = write;
+        for (int k = begin; k < stop; ++k) {
+            if (write > outer[r] && inner[write - 1] == inner[k]) {
+                stored[write - 1] += stored[k];
+            } else {
+                inner[write] = inner[k];
+                stored[write] = stored[k];
+                ++write;
+            }
+        }
+    }
+    outer[mRows] = write;
+    if (static_cast<std::size_t>(write) != nonZeros) {
+        matrix.resizeNonZeros(write);
+    }
+    return matrix;
+}
+
+template<typename Scalar>
+typename MatrixMarketReader<Scalar>::Matrix MatrixMarketReader<Scalar>::ReadMatrix() {
+    return ReadSparse().toDense();
+}
+
+template<typename Scalar>
+long MatrixMarketReader<Scalar>::CountMatrixRows() {
+    return mRows;
+}
+
+template<typename Scalar>
+typename MatrixMarketReader<Scalar>::Matrix MatrixMarketReader<Scalar>::ReadMatrixRows(long firstRow, long rowCount) {
+    if (firstRow < 0 || rowCount < 0 || firstRow + rowCount > mRows) {
+        throw std::runtime_error("Requested rows are outside the matrix");
+    }
+    return ReadSparse().middleRows(firstRow, rowCount).toDense();
+}
+
+// Parameters in the comments: "% Name,Value" or "% Name: Value"
+template<typename Scalar>
+Parameters MatrixMarketReader<Scalar>::ReadParameters() {
+    Parameters params;
+    const char* cursor = mFile.data() + mCommentsOffset;
+    const char* end = mFile.data() + mDataOffset;
+    while (cursor < end) {
+        std::string line = trim(nextLine(cursor, end));
+        if (line.size() < 2 || line[0] != '%') continue;
+
+        std::size_t delimiter = line.find_first_of(":,;");
+        if (delimiter == std::string::npos) continue;
+        std::string name = trim(std::string_view(line).substr(1, delimiter - 1));
+        std::string value = trim(std::string_view(line).substr(delimiter + 1));
+        if (name.empty() || name.find_first_of(" \t") != std::string::npos) continue;
+        params.setValue(name, value);
+    }
+    return params;
+}
+
+template class MatrixMarketReader<double>;
+template class MatrixMarketReader<std::complex<double>>;
@@ -0,0 +1,275 @@
+#include "NumpyFormat.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+const char kNpyMagic[6] = {'\x93', 'N', 'U', 'M', 'P', 'Y'};
+
+std::uint64_t readLittle(const char* bytes, int count) {
+    std::uint64_t value = 0;
+    for (int i = 0; i < count; ++i) {
+        value |= static_cast<std::uint64_t>(static_cast<unsigned char>(bytes[i])) << (8 * i);
+    }
+    return value;
+}
+
+bool hasSignature(const char* data, std::size_t size, std::size_t offset, const char* signature) {
+    return offset <= size && size - offset >= 4 && std::memcmp(data + offset, signature, 4) == 0;
+}
+
+std::size_t skipBlanks(const std::string& text, std::size_t pos) {
+    while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t')) pos++;
+    return pos;
+}
+
+// Position just after the colon that follows a key of the header dictionary
+std::size_t findKey(const std::string& dictionary, const std::string& key) {
+    for (char quote : {'\'', '"'}) {
+        std::size_t pos = dictionary.find(quote + key + quote);
+        if (pos == std::string::npos) continue;
+        pos = skipBlanks(dictionary, pos + key.size() + 2);
+        if (pos < dictionary.size() && dictionary[pos] == ':') return pos + 1;
+    }
+    throw std::runtime_error("Invalid .npy header: no '" + key + "' entry");
+}
+
+// Size in bytes of one element of a simple dtype such as "<f8", "|b1" or "<U12" (UTF-32 characters)
+std::size_t itemSize(const std::string& descr) {
+    if (descr.size() < 3 || descr.find_first_not_of("0123456789", 2) != std::string::npos) {
+        throw std::runtime_error("Unsupported .npy dtype '" + descr + "'");
+    }
+    return std::stoul(descr.substr(2)) * (descr[1] == 'U' ? 4 : 1);
+}
+
+}
+
+std::uint64_t NpyHeader::elements() const {
+    std::uint64_t count = 1;
+    for (std::uint64_t size : shape) count *= size;
+    return count;
+}
+
+NpyHeader parseNpyHeader(const char* data, std::size_t size) {
+    if (size < 10 || std::memcmp(data, kNpyMagic, sizeof(kNpyMagic)) != 0) {
+        throw std::runtime_error("Not a .npy array (bad magic)");
+    }
+    int major = static_cast<unsigned char>(data[6]);
+    if (major < 1 || major > 3) {
+        throw std::runtime_error("Unsupported .npy version " + std::to_string(major));
+    }
+    std::size_t prefix = major == 1 ? 10 : 12;
+    if (size < prefix) {
+        throw std::runtime_error("Truncated .npy array");
+    }
+    std::size_t length = static_cast<std::size_t>(readLittle(data + 8, major == 1 ? 2 : 4));
+    if (length > size - prefix) {
+        throw std::runtime_error("Truncated .npy array");
+    }
+    std::string dictionary(data + prefix, length);
+
+    NpyHeader header;
+    header.dataOffset = prefix + length;
+
+    // 'descr': '<f8' (structured dtypes are lists)
+    std::size_t pos = skipBlanks(dictionary, findKey(dictionary, "descr"));
+    char quote = pos < dictionary.size() ? dictionary[pos] : '\0';
+    std::size_t end = quote == '\'' || quote == '"' ? dictionary.find(quote, pos + 1) : std::string::npos;
+    if (end == std::string::npos) {
+        throw std::runtime_error("Unsupported .npy dtype (only simple dtypes such as '<f8' are read)");
+    }
+    header.descr = dictionary.substr(pos + 1, end - pos - 1);
+
+    // 'fortran_order': True
+    pos = skipBlanks(dictionary, findKey(dictionary, "fortran_order"));
+    if (dictionary.compare(pos, 4, "True") == 0) {
+        header.fortranOrder = true;
+    } else if (dictionary.compare(pos, 5, "False") != 0) {
+        throw std::runtime_error("Invalid .npy header: bad 'fortran_order' entry");
+    }
+
+    // 'shape': (3, 4)
+    pos = skipBlanks(dictionary, findKey(dictionary, "shape"));
+    if (pos >= dictionary.size() || dictionary[pos] != '(') {
+        throw std::runtime_error("Invalid .npy header: bad 'shape' entry");
+    }
+    pos++;
+    while (true) {
+        pos = skipBlanks(dictionary, pos);
+        if (pos < dictionary.size() && dictionary[pos] == ')') break;
+        std::size_t digits = dictionary.find_first_not_of("0123456789", pos);
+        if (digits == pos || digits == std::string::npos) {
+            throw std::runtime_error("Invalid .npy header: bad 'shape' entry");
+        }
+        header.shape.push_back(std::stoull(dictionary.substr(pos, digits - pos)));
+        pos = skipBlanks(dictionary, digits);
+        if (pos < dictionary.size() && dictionary[pos] == ',') pos++;
+    }
+
+    // The array must fit in the data
+    std::uint64_t available = (size - header.dataOffset) / std::max<std::size_t>(itemSize(header.descr), 1);
+    std::uint64_t count = 1;
+    for (std::uint64_t dimension : header.shape) {
+        if (dimension != 0 && count > available / dimension) {
+            throw std::runtime_error("Truncated .npy array");
+        }
+        count *= dimension;
+    }
+    return header;
+}
+
+std::string makeNpyHeader(const std::string& descr, bool fortranOrder, const std::vector<std::uint64_t>& shape) {
+    std::string dictionary = "{'descr': '" + descr + "', 'fortran_order': " + (fortranOrder ? "True" : "False") +
+                             ", 'shape': (";
+    for (std::size_t i = 0; i < shape.size(); ++i) {
+        dictionary += std::to_string(shape[i]) + (i + 1 < shape.size() ? ", " : "");
+    }
+    dictionary += shape.size() == 1 ? ",), }" : "), }";
+
+    // Blanks and a newline up to the alignment
+    std::size_t total = 10 + dictionary.size() + 1;
+    dictionary += std::string((kNpyAlignment - total % kNpyAlignment) % kNpyAlignment, ' ') + "\n";
+
+    std::string header(kNpyMagic, sizeof(kNpyMagic));
+    header += '\x01';
+    header += '\x00';
+    header += static_cast<char>(dictionary.size() & 0xff);
+    header += static_cast<char>(dictionary.size() >> 8);
+    return header + dictionary;
+}
+
+std::vector<NpzEntry> listNpzEntries(const char* data, std::size_t size) {
+    // End of central directory record, possibly followed by a comment of up to 64 KiB
+    if (size < 22) {
+        throw std::runtime_error("Not a .npz archive (too short)");
+    }
+    std::size_t record = size - 22;
+    std::size_t lowest = size - 22 > 0xffff ? size - 22 - 0xffff : 0;
+    while (!hasSignature(data, size, record, "PK\x05\x06")) {
+        if (record == lowest) {
+            throw std::runtime_error("Not a .npz archive (no zip directory)");
+        }
+        record--;
+    }
+    std::uint64_t entries = readLittle(data + record + 10, 2);
+    std::uint64_t directory = readLittle(data + record + 16, 4);
+
+    // Zip64: the real values are in the Zip64 end of central directory record
+    if (entries == 0xffff || directory == 0xffffffff) {
+        if (record < 20 || !hasSignature(data, size, record - 20, "PK\x06\x07")) {
+            throw std::runtime_error("Invalid .npz archive (no Zip64 locator)");
+        }
+        std::uint64_t record64 = readLittle(data + record - 20 + 8, 8);
+        if (size < 56 || record64 > size - 56 || !hasSignature(data, size, record64, "PK\x06\x06")) {
+            throw std::runtime_error("Invalid .npz archive (bad Zip64 record)");
+        }
+        entries = readLittle(data + record64 + 32, 8);
+        directory = readLittle(data + record64 + 48, 8);
+    }
+
+    std::vector<NpzEntry> result;
+    std::size_t pos = static_cast<std::size_t>(directory);
+    for (std::uint64_t i = 0; i < entries; ++i) {
+        if (!hasSignature(data, size, pos, "PK\x01\x02") || size - pos < 46) {
+            throw std::runtime_error("Invalid .npz archive (bad directory entry)");
+        }
+        std::uint16_t method = static_cast<std::uint16_t>(readLittle(data + pos + 10, 2));
+        std::uint64_t compressedSize = readLittle(data + pos + 20, 4);
+        std::uint64_t uncompressedSize = readLittle(data + pos + 24, 4);
+        std::size_t nameLength = static_cast<std::size_t>(readLittle(data + pos + 28, 2));
+        std::size_t extraLength = static_cast<std::size_t>(readLittle(data + pos + 30, 2));
+        std::size_t commentLength = static_cast<std::size_t>(readLittle(data + pos + 32, 2));
+        std::uint64_t localHeader = readLittle(data + pos + 42, 4);
+        if (size - pos - 46 < nameLength + extraLength + commentLength) {
+            throw std::runtime_error("Invalid .npz archive (bad directory entry)");
+        }
+        std::string name(data + pos + 46, nameLength);
+
+        // Zip64 extra field: 64-bit values of the saturated fields, in this order
+        const char* extra = data + pos + 46 + nameLength;
+        for (std::size_t field = 0; field + 4 <= extraLength;) {
+            std::size_t id = static_cast<std::size_t>(readLittle(extra + field, 2));
+            std::size_t length = static_cast<std::size_t>(readLittle(extra + field + 2, 2));
+            const char* value = extra + field + 4;
+            if (id == 1) {
+                std::size_t used = 0;
+                for (std::uint64_t* saturated : {&uncompressedSize, &compressedSize, &localHeader}) {
+                    if (*saturated == 0xffffffff && used + 8 <= length) {
+                        *saturated = readLittle(value + used, 8);
+                        used += 8;
+                    }
+                }
+            }
+            field += 4 + length;
+        }
+
+        // The data follows the local header, whose extra field may differ from the directory's
+        if (localHeader > size || !hasSignature(data, size, localHeader, "PK\x03\x04") || size - localHeader < 30) {
+            throw std::runtime_error("Invalid .npz archive (bad local header for " + name + ")");
+        }
+        std::uint64_t offset = localHeader + 30 + readLittle(data + localHeader + 26, 2) +
+                               readLittle(data + localHeader + 28, 2);
+        if (offset > size || compressedSize > size - offset) {
+            throw std::runtime_error("Truncated .npz archive (" + name + ")");
+        }
+
+        NpzEntry entry;
+        entry.name = name.size() > 4 && name.compare(name.size() - 4, 4, ".npy") == 0 ? name.substr(0, name.size() - 4) : name;
+        entry.method = method;
+        entry.offset = static_cast<std::size_t>(offset);
+        entry.size = static_cast<std::size_t>(compressedSize);
+        result.push_back(entry);
+        pos += 46 + nameLength + extraLength + commentLength;
+    }
+    return result;
+}
+
+std::uint32_t crc32(const char* data, std::size_t size, std::uint32_t crc) {
+    static const std::array<std::uint32_t, 256> table = [] {
+        std::array<std::uint32_t, 256> values{};
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            std::uint32_t value = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                value = value & 1 ? 0xedb88320u ^ (value >> 1) : value >> 1;
+            }
+            values[i] = value;
+        }
+        return values;
+    }();
+
+    crc = ~crc;
+    for (std::size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ static_cast<unsigned char>(data[i])) & 0xff] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+namespace {
+
+void writeNpy(const std::string& filename, const char* descr, long rows, long cols, const void* data, std::size_t bytes) {
+    std::string header = makeNpyHeader(descr, true, {static_cast<std::uint64_t>(rows), static_cast<std::uint64_t>(cols)});
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Opening .npy file for writing failed: " + filename);
+    }
+    file.write(header.data(), static_cast<std::streamsize>(header.size()));
+    file.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+    file.close();
+    if (!file) {
+        throw std::runtime_error("Writing .npy file failed: " + filename);
+    }
+}
+
+}
+
+void NpyMatrixWriter::write(const std::string& filename, const Eigen::MatrixXd& matrix) {
+    writeNpy(filename, kNpyReal, matrix.rows(), matrix.cols(), matrix.data(), sizeof(double) * matrix.size());
+}
+
+void NpyMatrixWriter::write(const std::string& filename, const Eigen::MatrixXcd& matrix) {
+    writeNpy(filename, kNpyComplex, matrix.rows(), matrix.cols(), matrix.data(),
+             sizeof(std::complex<double>) * matrix.size());
+}
@@ -0,0 +1,209 @@
+#include "NumpyReader.h"
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+Eigen::Index arrayRows(const NpyHeader& header) {
+    return static_cast<Eigen::Index>(header.shape[0]);
+}
+
+Eigen::Index arrayCols(const NpyHeader& header) {
+    return header.shape.size() == 2 ? static_cast<Eigen::Index>(header.shape[1]) : 1;
+}
+
+// A vector is stored the same way in both orders
+bool isRowMajor(const NpyHeader& header) {
+    return !header.fortranOrder && header.shape.size() == 2;
+}
+
+}
+
+// Constructor
+template<typename Scalar>
+NumpyReader<Scalar>::NumpyReader(const std::string& filename, const std::string& arrayName)
+    : Reader<Scalar>(filename),
+      mFile(filename),
+      mArray(nullptr),
+      mHeader{},
+      mArrayB(nullptr),
+      mArrayBSize(0) {
+
+    std::size_t arraySize = mFile.size();
+    mArray = mFile.data();
+    std::string source = filename;
+
+    // An archive starts with the local header of its first entry
+    if (mFile.size() >= 4 && std::memcmp(mFile.data(), "PK\x03\x04", 4) == 0) {
+        std::vector<NpzEntry> entries = listNpzEntries(mFile.data(), mFile.size());
+        const NpzEntry* selected = nullptr;
+        for (const NpzEntry& entry : entries) {
+            if (!arrayName.empty() ? entry.name == arrayName : entry.name == "A") selected = &entry;
+            if (entry.name == "B") {
+                mArrayB = mFile.data() + entry.offset;
+                mArrayBSize = entry.size;
+            }
+            if (entry.name == "parameters" && entry.method == 0) {
+                mParameters = readText(mFile.data() + entry.offset, entry.size);
+            }
+        }
+        if (!selected && arrayName.empty()) {
+            for (const NpzEntry& entry : entries) {
+                if (entry.name != "B" && entry.name != "parameters") {
+                    selected = &entry;
+                    break;
+                }
+            }
+        }
+        if (!selected) {
+            throw std::runtime_error("No array '" + (arrayName.empty() ? std::string("A") : arrayName) +
+                                     "' in the .npz archive: " + filename);
+        }
+        for (const NpzEntry& entry : entries) {
+            if ((&entry == selected || entry.name == "B") && entry.method != 0) {
+                throw std::runtime_error("The .npz archive is compressed (np.savez_compressed), save it with np.savez: " + filename);
+            }
+        }
+        mArray = mFile.data() + selected->offset;
+        arraySize = selected->size;
+        source = filename + "[" + selected->name + "]";
+    }
+
+    mHeader = readHeader(mArray, arraySize);
+    if (mArrayB) {
+        readHeader(mArrayB, mArrayBSize);
+    }
+
+    std::cout << "NumPy file: " << source << " (" << arrayRows(mHeader) << "x" << arrayCols(mHeader) << ", "
+              << mHeader.descr << ", " << (isRowMajor(mHeader) ? "C" : "Fortran") << " order)" << std::endl;
+}
+
+// Destructor
+template<typename Scalar>
+NumpyReader<Scalar>::~NumpyReader() {}
+
+template<typename Scalar>
+NpyHeader NumpyReader<Scalar>::readHeader(const char* array, std::size_t size) {
+    NpyHeader header = parseNpyHeader(array, size);
+    if (header.descr != kNpyReal && header.descr != kNpyComplex) {
+        throw std::runtime_error("Unsupported .npy dtype '" + header.descr + "' (float64 '<f8' or complex128 '<c16' expected)");
+    }
+    if (header.shape.empty() || header.shape.size() > 2) {
+        throw std::runtime_error("The .npy array has " + std::to_string(header.shape.size()) +
+                                 " dimensions, a vector or a matrix is expected");
+    }
+    return header;
+}
+
+template<typename Scalar>
+std::string NumpyReader<Scalar>::readText(const char* array, std::size_t size) {
+    NpyHeader header = parseNpyHeader(array, size);
+    if (header.elements() != 1 || (header.descr.compare(0, 2, "|S") != 0 && header.descr.compare(0, 2, "<U") != 0)) {
+        throw std::runtime_error("The .npz parameters must be a single string (np.bytes_ or np.str_)");
+    }
+    // Bytes, or UTF-32 characters of which only ASCII is meaningful here; both are padded with zeros
+    const char* data = array + header.dataOffset;
+    const std::size_t width = header.descr[1] == 'U' ? 4 : 1;
+    const std::size_t length = std::stoul(header.descr.substr(2));
+    std::string text;
+    for (std::size_t i = 0; i < length && data[i * width] != '\0'; ++i) {
+        text += data[i * width];
+    }
+    return text;
+}
+
+template<typename Scalar>
+bool NumpyReader<Scalar>::isMappable() const {
+    const bool complexFile = mHeader.descr == kNpyComplex;
+    return complexFile == Eigen::NumTraits<Scalar>::IsComplex && !isRowMajor(mHeader);
+}
+
+template<typename Scalar>
+typename NumpyReader<Scalar>::MatrixMap NumpyReader<Scalar>::MapMatrix() const {
+    const bool complexFile = mHeader.descr == kNpyComplex;
+    if (complexFile != Eigen::NumTraits<Scalar>::IsComplex) {
+        throw std::runtime_error("The .npy array holds another scalar type, use ReadMatrix()");
+    }
+    if (isRowMajor(mHeader)) {
+        throw std::runtime_error("The .npy array is in C order, use ReadMatrix()");
+    }
+    const Scalar* data = reinterpret_cast<const Scalar*>(mArray + mHeader.dataOffset);
+    return MatrixMap(data, arrayRows(mHeader), arrayCols(mHeader));
+}
+
+template<typename Scalar>
+typename NumpyReader<Scalar>::Matrix NumpyReader<Scalar>::copyRows(const NpyHeader& header, const char* array,
+                                                                   long firstRow, long rowCount) {
+    using RealMatrix = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>;
+    using RealRowMatrix = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+    using ComplexMatrix = Eigen::Matrix<std::complex<double>, Eigen::Dynamic, Eigen::Dynamic>;
+    using ComplexRowMatrix = Eigen::Matrix<std::complex<double>, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+    const Eigen::Index rows = arrayRows(header);
+    const Eigen::Index cols = arrayCols(header);
+    const char* data = array + header.dataOffset;
+    const bool rowMajor = isRowMajor(header);
+
+    if (header.descr == kNpyReal) {
+        const double* values = reinterpret_cast<const double*>(data);
+        if (rowMajor) {
+            return Eigen::Map<const RealRowMatrix>(values, rows, cols).middleRows(firstRow, rowCount).template cast<Scalar>();
+        }
+        return Eigen::Map<const RealMatrix>(values, rows, cols).middleRows(firstRow, rowCount).template cast<Scalar>();
+    }
+
+    if constexpr (Eigen::NumTraits<Scalar>::IsComplex) {
+        const std::complex<double>* values = reinterpret_cast<const std::complex<double>*>(data);
+        if (rowMajor) {
+            return Eigen::Map<const ComplexRowMatrix>(values, rows, cols).middleRows(firstRow, rowCount);
+        }
+        return Eigen::Map<const ComplexMatrix>(values, rows, cols).middleRows(firstRow, rowCount);
+    } else {
+        throw std::runtime_error("The .npy array holds complex values, read it as complex");
+    }
+}
+
+template<typename Scalar>
+typename NumpyReader<Scalar>::Matrix NumpyReader<Scalar>::ReadMatrix() {
+    return copyRows(mHeader, mArray, 0, static_cast<long>(arrayRows(mHeader)));
+}
+
+template<typename Scalar>
+typename NumpyReader<Scalar>::Matrix NumpyReader<Scalar>::ReadMatrixB() {
+    if (!mArrayB) {
+        return Matrix();
+    }
+    NpyHeader header = readHeader(mArrayB, mArrayBSize);
+    return copyRows(header, mArrayB, 0, static_cast<long>(arrayRows(header)));
+}
+
+template<typename Scalar>
+long NumpyReader<Scalar>::CountMatrixRows() {
+    return static_cast<long>(arrayRows(mHeader));
+}
+
+template<typename Scalar>
+typename NumpyReader<Scalar>::Matrix NumpyReader<Scalar>::ReadMatrixRows(long firstRow, long rowCount) {
+    if (firstRow < 0 || rowCount < 0 || firstRow + rowCount > static_cast<long>(arrayRows(mHeader))) {
+        throw std::runtime_error("Requested rows are outside the matrix");
+    }
+    return copyRows(mHeader, mArray, firstRow, rowCount);
+}
+
+template<typename Scalar>
+Parameters NumpyReader<Scalar>::ReadParameters() {
+    Parameters params;
+    std::istringstream text(mParameters);
+    std::string line;
+    while (std::getline(text, line)) {
+        std::size_t comma = line.find(',');
+        if (comma == std::string::npos) continue;
+        params.setValue(line.substr(0, comma), line.substr(comma + 1));
+    }
+    return params;
+}
+
+template class NumpyReader<double>;
+template class NumpyReader<std::complex<double>>;
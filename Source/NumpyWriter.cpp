@@ -0,0 +1,219 @@
+#include "NumpyWriter.h"
+#include "MappedFile.h"
+#include "NumpyFormat.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+// An array of the archive: its .npy header, then its raw data
+struct ArchiveEntry {
+    std::string name;
+    std::string header;
+    const char* data;
+    std::size_t bytes;
+    std::uint64_t offset;
+    std::size_t padding;
+    std::uint32_t crc;
+};
+
+// Extra field id of the alignment padding (the one of zipalign)
+const std::uint16_t kPaddingField = 0xd935;
+
+void put(char*& out, std::uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        *out++ = static_cast<char>((value >> (8 * i)) & 0xff);
+    }
+}
+
+void putBytes(char*& out, const char* data, std::size_t bytes) {
+    std::memcpy(out, data, bytes);
+    out += bytes;
+}
+
+}
+
+NumpyWriter::NumpyWriter(const std::string& filename) : Writer(filename) {}
+
+void NumpyWriter::write(double eigenvalue,
+                       const Eigen::VectorXd& eigenvector,
+                       int iterations,
+                       bool converged) const {
+    writeArchive(kNpyReal, sizeof(double), &eigenvalue, 1, eigenvector.data(), eigenvector.size(), iterations, converged);
+}
+
+void NumpyWriter::write(std::complex<double> eigenvalue,
+                       const Eigen::VectorXcd& eigenvector,
+                       int iterations,
+                       bool converged) const {
+    writeArchive(kNpyComplex, sizeof(std::complex<double>), &eigenvalue, 1, eigenvector.data(), eigenvector.size(),
+                 iterations, converged);
+}
+
+void NumpyWriter::writeAll(const Eigen::VectorXd& eigenvalues,
+                          const Eigen::MatrixXd& eigenvectors,
+                          int iterations,
+                          bool converged) const {
+    writeArchive(kNpyReal, sizeof(double), eigenvalues.data(), eigenvalues.size(), eigenvectors.data(),
+                 eigenvectors.rows(), iterations, converged);
+}
+
+void NumpyWriter::writeAll(const Eigen::VectorXcd& eigenvalues,
+                          const Eigen::MatrixXcd& eigenvectors,
+                          int iterations,
+                          bool converged) const {
+    writeArchive(kNpyComplex, sizeof(std::complex<double>), eigenvalues.data(), eigenvalues.size(),
+                 eigenvectors.data(), eigenvectors.rows(), iterations, converged);
+}
+
+void NumpyWriter::writeArchive(const char* descr, std::size_t scalarBytes, const void* values, long count,
+                               const void* vectors, long rows, int iterations, bool converged) const {
+    const std::int64_t iterationCount = iterations;
+    const char convergedFlag = converged ? 1 : 0;
+    const std::uint64_t vectorCount = rows > 0 ? static_cast<std::uint64_t>(count) : 0;
+
+    std::vector<ArchiveEntry> entries = {
+        {"eigenvalues.npy", makeNpyHeader(descr, false, {static_cast<std::uint64_t>(count)}),
+         static_cast<const char*>(values), scalarBytes * count, 0, 0, 0},
+        {"eigenvectors.npy", makeNpyHeader(descr, true, {static_cast<std::uint64_t>(rows), vectorCount}),
+         static_cast<const char*>(vectors), scalarBytes * rows * vectorCount, 0, 0, 0},
+        {"iterations.npy", makeNpyHeader("<i8", false, {}), reinterpret_cast<const char*>(&iterationCount),
+         sizeof(iterationCount), 0, 0, 0},
+        {"converged.npy", makeNpyHeader("|b1", false, {}), &convergedFlag, 1, 0, 0, 0}};
+
+    // Statistics: the values, and the names as fixed-width UCS-4 strings (NumPy's "<U" dtype)
+    std::vector<double> statValues;
+    std::vector<std::uint32_t> statNames;
+    if (mHasStats) {
+        const auto fields = mStats.fields();
+        std::size_t width = 0;
+        for (const auto& field : fields) width = std::max(width, field.first.size());
+        statNames.assign(fields.size() * width, 0);
+        for (std::size_t i = 0; i < fields.size(); ++i) {
+            statValues.push_back(fields[i].second);
+            for (std::size_t c = 0; c < fields[i].first.size(); ++c) {
+                statNames[i * width + c] = static_cast<unsigned char>(fields[i].first[c]);
+            }
+        }
+        const std::uint64_t count = fields.size();
+        entries.push_back({"stats.npy", makeNpyHeader("<f8", false, {count}),
+                           reinterpret_cast<const char*>(statValues.data()), sizeof(double) * statValues.size(), 0, 0, 0});
+        entries.push_back({"stats_names.npy", makeNpyHeader("<U" + std::to_string(width), false, {count}),
+                           reinterpret_cast<const char*>(statNames.data()), sizeof(std::uint32_t) * statNames.size(),
+                           0, 0, 0});
+    }
+
+    // Archives of 4 GiB or more store their sizes and offsets in Zip64 extra fields
+    std::uint64_t estimate = 0;
+    for (const ArchiveEntry& entry : entries) estimate += entry.header.size() + entry.bytes + 256;
+    const bool zip64 = estimate >= 0xffffffffu;
+    const std::size_t localZip64 = zip64 ? 20 : 0;
+    const std::size_t centralZip64 = zip64 ? 28 : 0;
+
+    // Layout: each .npy starts on a kNpyAlignment boundary, so its data does too
+    std::uint64_t position = 0;
+    for (ArchiveEntry& entry : entries) {
+        entry.offset = position;
+        std::uint64_t extraStart = position + 30 + entry.name.size() + localZip64 + 4;
+        entry.padding = static_cast<std::size_t>((kNpyAlignment - extraStart % kNpyAlignment) % kNpyAlignment);
+        position = extraStart + entry.padding + entry.header.size() + entry.bytes;
+        entry.crc = crc32(entry.data, entry.bytes, crc32(entry.header.data(), entry.header.size()));
+    }
+    const std::uint64_t directory = position;
+    for (const ArchiveEntry& entry : entries) position += 46 + entry.name.size() + centralZip64;
+    const std::uint64_t directorySize = position - directory;
+    position += (zip64 ? 56 + 20 : 0) + 22;
+
+    MappedFile file(mFilename, static_cast<std::size_t>(position));
+    char* out = file.mutableData();
+    const std::uint16_t version = zip64 ? 45 : 20;
+
+    for (const ArchiveEntry& entry : entries) {
+        const std::uint64_t size = entry.header.size() + entry.bytes;
+        putBytes(out, "PK\x03\x04", 4);
+        put(out, version, 2);
+        put(out, 0, 2);                             // flags
+        put(out, 0, 2);                             // stored
+        put(out, 0, 2);                             // time
+        put(out, 0x21, 2);                          // date: 1980-01-01
+        put(out, entry.crc, 4);
+        put(out, zip64 ? 0xffffffffu : size, 4);
+        put(out, zip64 ? 0xffffffffu : size, 4);
+        put(out, entry.name.size(), 2);
+        put(out, localZip64 + 4 + entry.padding, 2);
+        putBytes(out, entry.name.data(), entry.name.size());
+        if (zip64) {
+            put(out, 1, 2);
+            put(out, 16, 2);
+            put(out, size, 8);
+            put(out, size, 8);
+        }
+        put(out, kPaddingField, 2);
+        put(out, entry.padding, 2);
+        std::memset(out, 0, entry.padding);
+        out += entry.padding;
+        putBytes(out, entry.header.data(), entry.header.size());
+        putBytes(out, entry.data, entry.bytes);
+    }
+
+    for (const ArchiveEntry& entry : entries) {
+        const std::uint64_t size = entry.header.size() + entry.bytes;
+        putBytes(out, "PK\x01\x02", 4);
+        put(out, version, 2);                       // made by
+        put(out, version, 2);                       // needed
+        put(out, 0, 2);
+        put(out, 0, 2);
+        put(out, 0, 2);
+        put(out, 0x21, 2);
+        put(out, entry.crc, 4);
+        put(out, zip64 ? 0xffffffffu : size, 4);
+        put(out, zip64 ? 0xffffffffu : size, 4);
+        put(out, entry.name.size(), 2);
+        put(out, centralZip64, 2);
+        put(out, 0, 2);                             // comment
+        put(out, 0, 2);                             // disk
+        put(out, 0, 2);                             // internal attributes
+        put(out, 0, 4);                             // external attributes
+        put(out, zip64 ? 0xffffffffu : entry.offset, 4);
+        putBytes(out, entry.name.data(), entry.name.size());
+        if (zip64) {
+            put(out, 1, 2);
+            put(out, 24, 2);
+            put(out, size, 8);
+            put(out, size, 8);
+            put(out, entry.offset, 8);
+        }
+    }
+
+    if (zip64) {
+        const std::uint64_t record64 = directory + directorySize;
+        putBytes(out, "PK\x06\x06", 4);
+        put(out, 44, 8);
+        put(out, version, 2);
+        put(out, version, 2);
+        put(out, 0, 4);
+        put(out, 0, 4);
+        put(out, entries.size(), 8);
+        put(out, entries.size(), 8);
+        put(out, directorySize, 8);
+        put(out, directory, 8);
+        putBytes(out, "PK\x06\x07", 4);
+        put(out, 0, 4);
+        put(out, record64, 8);
+        put(out, 1, 4);
+    }
+    putBytes(out, "PK\x05\x06", 4);
+    put(out, 0, 2);
+    put(out, 0, 2);
+    put(out, entries.size(), 2);
+    put(out, entries.size(), 2);
+    put(out, zip64 ? 0xffffffffu : directorySize, 4);
+    put(out, zip64 ? 0xffffffffu : directory, 4);
+    put(out, 0, 2);
+    file.flush();
+
+    std::cout << "Results written to " << mFilename << std::endl;
+}
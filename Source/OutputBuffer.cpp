@@ -0,0 +1,38 @@
+#include "OutputBuffer.h"
+#include <algorithm>
+#include <charconv>
+
+// 17 significant digits already identify every double
+OutputBuffer::OutputBuffer(int precision) : mPrecision(precision < 0 ? kStreamPrecision : std::min(precision, 17)) {}
+
+OutputBuffer& OutputBuffer::operator<<(std::string_view text) {
+    mText.append(text.data(), text.size());
+    return *this;
+}
+
+OutputBuffer& OutputBuffer::operator<<(char c) {
+    mText.push_back(c);
+    return *this;
+}
+
+OutputBuffer& OutputBuffer::operator<<(long value) {
+    char digits[24];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+    mText.append(digits, result.ptr);
+    return *this;
+}
+
+// "general" with a precision is the %g of printf, used by std::ostream; without one, the shortest round trip
+OutputBuffer& OutputBuffer::operator<<(double value) {
+    char digits[32];
+    std::to_chars_result result = mPrecision == 0
+        ? std::to_chars(digits, digits + sizeof(digits), value)
+        : std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::general, mPrecision);
+    mText.append(digits, result.ptr);
+    return *this;
+}
+
+void OutputBuffer::writeTo(std::ostream& out) {
+    out.write(mText.data(), static_cast<std::streamsize>(mText.size()));
+    mText.clear();
+}
@@ -0,0 +1,95 @@
+#include "PanelSource.h"
+#include "Decompressor.h"
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+// Target size of a panel when the caller does not choose the height
+static const long kDefaultPanelBytes = 32L << 20;
+
+// Panel height for about kDefaultPanelBytes per panel
+template<typename Scalar>
+static long defaultPanelRows(long rows, long cols) {
+    long panelRows = std::max<long>(1, kDefaultPanelBytes / (std::max<long>(cols, 1) * static_cast<long>(sizeof(Scalar))));
+    return std::min(panelRows, std::max<long>(rows, 1));
+}
+
+// Destructor
+template<typename Scalar>
+PanelSource<Scalar>::~PanelSource() {}
+
+// The file name, once checked: panels are parsed again at every pass, which a compressed file (decompressed in
+// memory by TextMatrixParser) would defeat
+static const std::string& uncompressedFile(const std::string& filename) {
+    if (detectCompression(filename) != Compression::None) {
+        throw std::runtime_error("Compressed files cannot be streamed by panels: " + filename);
+    }
+    return filename;
+}
+
+// Constructor
+template<typename Scalar>
+TextPanelSource<Scalar>::TextPanelSource(const std::string& filename, long panelRows)
+    : mParser(uncompressedFile(filename)),
+      mRows(mParser.rows(TextMatrixParser::Section::A)),
+      mCols(0),
+      mPanelRows(panelRows),
+      mNextRow(0) {
+
+    // The first row gives the width in scalars (complex literals, or column pairs with ComplexPairs)
+    if (mRows > 0) {
+        mCols = mParser.template parse<Scalar>(TextMatrixParser::Section::A, 0, 1).cols();
+    }
+    if (mRows == 0 || mCols == 0) {
+        throw std::runtime_error("No matrix found in " + filename);
+    }
+    mPanelRows = mPanelRows > 0 ? std::min(mPanelRows, mRows) : defaultPanelRows<Scalar>(mRows, mCols);
+}
+
+template<typename Scalar>
+void TextPanelSource<Scalar>::rewind() {
+    mNextRow = 0;
+}
+
+template<typename Scalar>
+long TextPanelSource<Scalar>::nextPanel(Matrix& panel) {
+    if (mNextRow >= mRows) {
+        return -1;
+    }
+    long first = mNextRow;
+    long count = std::min(mPanelRows, mRows - first);
+    panel = mParser.template parse<Scalar>(TextMatrixParser::Section::A, first, count);
+    if (panel.cols() != mCols) {
+        throw std::runtime_error("Inconsistent row sizes in matrix at row " + std::to_string(first));
+    }
+    mNextRow += count;
+    return first;
+}
+
+// Constructor
+template<typename Scalar>
+BinaryPanelSource<Scalar>::BinaryPanelSource(const std::string& filename, long panelRows)
+    : mReader(filename),
+      mPanelRows(panelRows),
+      mNextRow(0) {
+    mPanelRows = mPanelRows > 0 ? std::min(mPanelRows, rows()) : defaultPanelRows<Scalar>(rows(), cols());
+}
+
+template<typename Scalar>
+long BinaryPanelSource<Scalar>::nextPanel(Matrix& panel) {
+    if (mNextRow >= rows()) {
+        return -1;
+    }
+    long first = mNextRow;
+    long count = std::min(mPanelRows, rows() - first);
+    panel = mReader.ReadMatrixRows(first, count);
+    mNextRow += count;
+    return first;
+}
+
+template class PanelSource<double>;
+template class PanelSource<std::complex<double>>;
+template class TextPanelSource<double>;
+template class TextPanelSource<std::complex<double>>;
+template class BinaryPanelSource<double>;
+template class BinaryPanelSource<std::complex<double>>;
@@ -2,6 +2,7 @@
 // Created by fanni on 05/12/2025.
 //
 #include "Parameters.h"
+#include <sstream>
 #include <stdexcept>
 
 Parameters::Parameters()
@@ -9,7 +10,21 @@ Parameters::Parameters()
       mAlgorithm("PowerMethod"),
       mMaxIter(1000),
       mTolerance(1e-6),
-      mShift(0.0) {}
+      mShift(0.0),
+      mIndexLow(0),
+      mIndexHigh(0),
+      mHasValueRange(false),
+      mLowerBound(0.0),
+      mUpperBound(0.0),
+      mNumValues(1),
+      mThreads(0),
+      mPinThreads(false),
+      mPlanarComplex(false),
+      mOutOfCore(false),
+      mPanelRows(0),
+      mComplexPairs(false),
+      mHistoryCapacity(0),
+      mComputeEigenvectors(true) {}
 
 
 void Parameters::setMatrixFile(const std::string& filename) {
@@ -22,7 +37,9 @@ void Parameters::setMatrixFile(const std::string& filename) {
 void Parameters::setAlgorithm(const std::string& algorithm) {
     if (algorithm == "PowerMethod" ||
         algorithm == "ShiftedInversePowerMethod" ||
-        algorithm == "QRMethod") {
+        algorithm == "QRMethod" ||
+        algorithm == "BisectionMethod" ||
+        algorithm == "TruncatedSVD") {
 
         mAlgorithm = algorithm;
         } else {
@@ -41,6 +58,178 @@ void Parameters::setTolerance(double tol) {
     mTolerance= tol;
 }
 
+void Parameters::setIndexRange(int indexLow, int indexHigh) {
+    mIndexLow = indexLow;
+    mIndexHigh = indexHigh;
+}
+
+void Parameters::setValueRange(double lower, double upper) {
+    mHasValueRange = true;
+    mLowerBound = lower;
+    mUpperBound = upper;
+}
+
+void Parameters::setNumValues(int numValues) {
+    mNumValues = numValues;
+}
+
+void Parameters::setThreads(int threads) {
+    mThreads = threads;
+}
+
+void Parameters::setPinThreads(bool pinThreads) {
+    mPinThreads = pinThreads;
+}
+
+void Parameters::setPlanarComplex(bool planarComplex) {
+    mPlanarComplex = planarComplex;
+}
+
+void Parameters::setOutOfCore(bool outOfCore) {
+    mOutOfCore = outOfCore;
+}
+
+void Parameters::setPanelRows(int panelRows) {
+    mPanelRows = panelRows;
+}
+
+void Parameters::setComplexPairs(bool complexPairs) {
+    mComplexPairs = complexPairs;
+}
+
+void Parameters::setHistoryCapacity(int capacity) {
+    mHistoryCapacity = capacity;
+}
+
+void Parameters::setComputeEigenvectors(bool computeEigenvectors) {
+    mComputeEigenvectors = computeEigenvectors;
+}
+
+void Parameters::setEigenvectorIndices(const std::vector<int>& indices) {
+    mEigenvectorIndices = indices;
+}
+
+void Parameters::setEigenvectors(const std::string& selection) {
+    if (selection == "All" || selection == "all") {
+        setComputeEigenvectors(true);
+        setEigenvectorIndices({});
+    } else if (selection == "None" || selection == "none") {
+        setComputeEigenvectors(false);
+        setEigenvectorIndices({});
+    } else {
+        std::istringstream text(selection);
+        std::vector<int> indices;
+        std::string token;
+        while (text >> token) {
+            indices.push_back(std::stoi(token));
+        }
+        if (indices.empty()) {
+            throw std::invalid_argument("Invalid eigenvector selection: " + selection);
+        }
+        setComputeEigenvectors(true);
+        setEigenvectorIndices(indices);
+    }
+}
+
+std::string Parameters::getEigenvectors() const {
+    if (!mComputeEigenvectors) return "None";
+    if (mEigenvectorIndices.empty()) return "All";
+    std::string selection;
+    for (int index : mEigenvectorIndices) {
+        if (!selection.empty()) selection += ' ';
+        selection += std::to_string(index);
+    }
+    return selection;
+}
+
+bool Parameters::setValue(const std::string& name, const std::string& value) {
+    if (name == "Algorithm") {
+        setAlgorithm(value);
+    }
+    else if (name == "MaxIterations") {
+        setMaxIterations(std::stoi(value));
+    }
+    else if (name == "Tolerance") {
+        setTolerance(std::stod(value));
+    }
+    else if (name == "Shift") {
+        setShift(std::stod(value));
+    }
+    else if (name == "IndexLow") {
+        setIndexRange(std::stoi(value), mIndexHigh);
+    }
+    else if (name == "IndexHigh") {
+        setIndexRange(mIndexLow, std::stoi(value));
+    }
+    else if (name == "LowerBound") {
+        setValueRange(std::stod(value), mUpperBound);
+    }
+    else if (name == "UpperBound") {
+        setValueRange(mLowerBound, std::stod(value));
+    }
+    else if (name == "NumValues") {
+        setNumValues(std::stoi(value));
+    }
+    else if (name == "Threads") {
+        setThreads(std::stoi(value));
+    }
+    else if (name == "PinThreads") {
+        setPinThreads(std::stoi(value) != 0);
+    }
+    else if (name == "PlanarComplex") {
+        setPlanarComplex(std::stoi(value) != 0);
+    }
+    else if (name == "OutOfCore") {
+        setOutOfCore(std::stoi(value) != 0);
+    }
+    else if (name == "PanelRows") {
+        setPanelRows(std::stoi(value));
+    }
+    else if (name == "ComplexPairs") {
+        setComplexPairs(std::stoi(value) != 0);
+    }
+    else if (name == "HistoryCapacity") {
+        setHistoryCapacity(std::stoi(value));
+    }
+    else if (name == "Eigenvectors") {
+        setEigenvectors(value);
+    }
+    else {
+        return false;
+    }
+    return true;
+}
+
+void Parameters::writeValues(std::ostream& out) const {
+    std::streamsize precision = out.precision(17);
+    out << "Algorithm," << mAlgorithm << "\n";
+    out << "MaxIterations," << mMaxIter << "\n";
+    out << "Tolerance," << mTolerance << "\n";
+    out << "Shift," << mShift << "\n";
+    if (mIndexLow > 0) {
+        out << "IndexLow," << mIndexLow << "\n";
+        out << "IndexHigh," << mIndexHigh << "\n";
+    }
+    if (mHasValueRange) {
+        out << "LowerBound," << mLowerBound << "\n";
+        out << "UpperBound," << mUpperBound << "\n";
+    }
+    out << "NumValues," << mNumValues << "\n";
+    out << "Threads," << mThreads << "\n";
+    out << "PinThreads," << (mPinThreads ? 1 : 0) << "\n";
+    out << "PlanarComplex," << (mPlanarComplex ? 1 : 0) << "\n";
+    out << "OutOfCore," << (mOutOfCore ? 1 : 0) << "\n";
+    out << "PanelRows," << mPanelRows << "\n";
+    out << "ComplexPairs," << (mComplexPairs ? 1 : 0) << "\n";
+    if (mHistoryCapacity > 0) {
+        out << "HistoryCapacity," << mHistoryCapacity << "\n";
+    }
+    if (!mComputeEigenvectors || !mEigenvectorIndices.empty()) {
+        out << "Eigenvectors," << getEigenvectors() << "\n";
+    }
+    out.precision(precision);
+}
+
 bool Parameters::validate() const {
     if (mTolerance <= 0) {
         std::cerr << "Tolerance must be positive" << std::endl;
@@ -52,6 +241,44 @@ bool Parameters::validate() const {
         return false;
     }
 
+    // IndexLow 0 means no index range: an IndexHigh alone would be dropped by writeValues()
+    if (mIndexLow < 0 || mIndexHigh < mIndexLow || (mIndexLow < 1 && mIndexHigh > 0)) {
+        std::cerr << "IndexLow/IndexHigh must satisfy 1 <= IndexLow <= IndexHigh" << std::endl;
+        return false;
+    }
+
+    if (mNumValues <= 0) {
+        std::cerr << "NumValues must be positive" << std::endl;
+        return false;
+    }
+
+    if (mThreads < 0) {
+        std::cerr << "Threads must be 0 (automatic) or positive" << std::endl;
+        return false;
+    }
+
+    if (mPanelRows < 0) {
+        std::cerr << "PanelRows must be 0 (automatic) or positive" << std::endl;
+        return false;
+    }
+
+    if (mHistoryCapacity < 0) {
+        std::cerr << "HistoryCapacity must be 0 (disabled) or positive" << std::endl;
+        return false;
+    }
+
+    for (int index : mEigenvectorIndices) {
+        if (index < 1) {
+            std::cerr << "Eigenvectors must be All, None or 1-based indices" << std::endl;
+            return false;
+        }
+    }
+
+    if (mHasValueRange && mUpperBound <= mLowerBound) {
+        std::cerr << "UpperBound must be greater than LowerBound" << std::endl;
+        return false;
+    }
+
     return true;
 }
 
@@ -61,4 +288,31 @@ void Parameters::display() const {
     std::cout << "Max Iterations:  " << mMaxIter << "\n";
     std::cout << "Tolerance:       " << mTolerance << "\n";
     std::cout << "Shift:           " << mShift << "\n";
+    if (mIndexLow > 0) {
+        std::cout << "Index Range:     " << mIndexLow << ".." << mIndexHigh << "\n";
+    }
+    if (mNumValues > 1) {
+        std::cout << "Num Values:      " << mNumValues << "\n";
+    }
+    if (mThreads > 0) {
+        std::cout << "Threads:         " << mThreads << (mPinThreads ? " (pinned)" : "") << "\n";
+    }
+    if (mPlanarComplex) {
+        std::cout << "Complex Storage: planar\n";
+    }
+    if (mComplexPairs) {
+        std::cout << "Complex Input:   real/imaginary column pairs\n";
+    }
+    if (mOutOfCore) {
+        std::cout << "Out of Core:     panels of " << (mPanelRows > 0 ? std::to_string(mPanelRows) : "auto") << " rows\n";
+    }
+    if (mHasValueRange) {
+        std::cout << "Value Range:     [" << mLowerBound << ", " << mUpperBound << ")\n";
+    }
+    if (mHistoryCapacity > 0) {
+        std::cout << "History:         last " << mHistoryCapacity << " iterations\n";
+    }
+    if (!mComputeEigenvectors || !mEigenvectorIndices.empty()) {
+        std::cout << "Eigenvectors:    " << getEigenvectors() << "\n";
+    }
 }
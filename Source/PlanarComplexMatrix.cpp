@@ -0,0 +1,99 @@
+#include "PlanarComplexMatrix.h"
+#include "PlanarKernels.h"
+#include <algorithm>
+
+// PlanarVector
+PlanarVector::PlanarVector(const Eigen::VectorXcd& vector)
+    : mReal(vector.real()),
+      mImag(vector.imag()) {}
+
+Eigen::VectorXcd PlanarVector::toComplex() const {
+    Eigen::VectorXcd vector(size());
+    vector.real() = mReal;
+    vector.imag() = mImag;
+    return vector;
+}
+
+void PlanarVector::resize(Eigen::Index size) {
+    mReal.resize(size);
+    mImag.resize(size);
+}
+
+void PlanarVector::swap(PlanarVector& other) {
+    mReal.swap(other.mReal);
+    mImag.swap(other.mImag);
+}
+
+// PlanarComplexMatrix
+PlanarComplexMatrix::PlanarComplexMatrix(const Eigen::Ref<const Eigen::MatrixXcd>& matrix, ThreadPool* pool)
+    : mPool(pool),
+      mRows(matrix.rows()),
+      mCols(matrix.cols()) {
+
+    int workers = mPool ? mPool->size() : 1;
+    int blocks = static_cast<int>(std::max<Eigen::Index>(1, std::min<Eigen::Index>(workers, mRows)));
+    mOffsets.resize(blocks + 1);
+    for (int t = 0; t <= blocks; ++t) {
+        mOffsets[t] = mRows * t / blocks;
+    }
+    mReal.resize(blocks);
+    mImag.resize(blocks);
+    mPartials.resize(blocks);
+
+    // First touch: each worker allocates and fills the block it will multiply
+    forEachBlock([&](int t) {
+        auto rows = matrix.middleRows(mOffsets[t], mOffsets[t + 1] - mOffsets[t]);
+        mReal[t] = rows.real();
+        mImag[t] = rows.imag();
+    });
+}
+
+template<typename Task>
+void PlanarComplexMatrix::forEachBlock(Task task) {
+    const int blocks = blockCount();
+    if (!mPool) {
+        for (int t = 0; t < blocks; ++t) task(t);
+        return;
+    }
+    mPool->run([&](int t) {
+        if (t < blocks) task(t);
+    });
+}
+
+double PlanarComplexMatrix::multiply(const PlanarVector& x, PlanarVector& y, Eigen::Index& maxIndex) {
+    y.resize(mRows);
+
+    forEachBlock([&](int t) {
+        Eigen::Index offset = mOffsets[t];
+        long rows = static_cast<long>(mOffsets[t + 1] - offset);
+        planarGemv(mReal[t].data(), mImag[t].data(), rows, static_cast<long>(mCols), rows,
+                   x.mReal.data(), x.mImag.data(), y.mReal.data() + offset, y.mImag.data() + offset);
+
+        PartialResult& partial = mPartials[t];
+        partial.squaredNorm = planarSquaredNormArgmax(y.mReal.data() + offset, y.mImag.data() + offset, rows,
+                                                      partial.maxIndex, partial.maxMagnitude);
+        partial.maxIndex += static_cast<long>(offset);
+    });
+
+    // Combine in block order, so that the result does not depend on the timing
+    double squaredNorm = 0.0;
+    double maxMagnitude = -1.0;
+    maxIndex = 0;
+    for (const PartialResult& partial : mPartials) {
+        squaredNorm += partial.squaredNorm;
+        if (partial.maxMagnitude > maxMagnitude) {
+            maxMagnitude = partial.maxMagnitude;
+            maxIndex = partial.maxIndex;
+        }
+    }
+    return squaredNorm;
+}
+
+void PlanarComplexMatrix::scale(PlanarVector& v, double factor) {
+    forEachBlock([&](int t) {
+        Eigen::Index offset = mOffsets[t];
+        Eigen::Index rows = mOffsets[t + 1] - offset;
+        v.mReal.segment(offset, rows) *= factor;
+        v.mImag.segment(offset, rows) *= factor;
+    });
+}
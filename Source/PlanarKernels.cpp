@@ -0,0 +1,322 @@
+#include "PlanarKernels.h"
+#include <algorithm>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define PLANAR_HAS_X86_KERNELS 1
+#include <immintrin.h>
+#else
+#define PLANAR_HAS_X86_KERNELS 0
+#endif
+
+// Rows processed together, so that the slice of y stays in L1 while the columns stream through
+static const long kRowChunk = 512;
+
+// ---------------------------------------------------------------------------------------------------------------
+// Portable kernels
+// ---------------------------------------------------------------------------------------------------------------
+
+static inline void axpyColumnScalar(const double* cr, const double* ci, double br, double bi,
+                                    long begin, long end, double* yr, double* yi) {
+    for (long i = begin; i < end; ++i) {
+        yr[i] += cr[i] * br - ci[i] * bi;
+        yi[i] += cr[i] * bi + ci[i] * br;
+    }
+}
+
+static void gemvScalar(const double* ar, const double* ai, long rows, long cols, long ld,
+                       const double* xr, const double* xi, double* yr, double* yi) {
+    std::fill(yr, yr + rows, 0.0);
+    std::fill(yi, yi + rows, 0.0);
+    for (long i0 = 0; i0 < rows; i0 += kRowChunk) {
+        long i1 = std::min(rows, i0 + kRowChunk);
+        for (long j = 0; j < cols; ++j) {
+            axpyColumnScalar(ar + j * ld, ai + j * ld, xr[j], xi[j], i0, i1, yr, yi);
+        }
+    }
+}
+
+static double normArgmaxScalar(const double* re, const double* im, long n, long& maxIndex, double& maxValue) {
+    double sum = 0.0;
+    maxIndex = 0;
+    maxValue = -1.0;
+    for (long i = 0; i < n; ++i) {
+        double magnitude = re[i] * re[i] + im[i] * im[i];
+        sum += magnitude;
+        if (magnitude > maxValue) {
+            maxValue = magnitude;
+            maxIndex = i;
+        }
+    }
+    return sum;
+}
+
+#if PLANAR_HAS_X86_KERNELS
+
+// ---------------------------------------------------------------------------------------------------------------
+// AVX2 + FMA kernels (4 doubles per register)
+// ---------------------------------------------------------------------------------------------------------------
+
+__attribute__((target("avx2,fma")))
+static void gemvAVX2(const double* ar, const double* ai, long rows, long cols, long ld,
+                     const double* xr, const double* xi, double* yr, double* yi) {
+    std::fill(yr, yr + rows, 0.0);
+    std::fill(yi, yi + rows, 0.0);
+    for (long i0 = 0; i0 < rows; i0 += kRowChunk) {
+        long i1 = std::min(rows, i0 + kRowChunk);
+        long j = 0;
+        // Two columns per pass halve the loads and stores of y
+        for (; j + 1 < cols; j += 2) {
+            const double* c0r = ar + j * ld;
+            const double* c0i = ai + j * ld;
+            const double* c1r = c0r + ld;
+            const double* c1i = c0i + ld;
+            __m256d b0r = _mm256_set1_pd(xr[j]), b0i = _mm256_set1_pd(xi[j]);
+            __m256d b1r = _mm256_set1_pd(xr[j + 1]), b1i = _mm256_set1_pd(xi[j + 1]);
+            long i = i0;
+            for (; i + 4 <= i1; i += 4) {
+                __m256d sr = _mm256_loadu_pd(yr + i);
+                __m256d si = _mm256_loadu_pd(yi + i);
+                __m256d a0r = _mm256_loadu_pd(c0r + i), a0i = _mm256_loadu_pd(c0i + i);
+                __m256d a1r = _mm256_loadu_pd(c1r + i), a1i = _mm256_loadu_pd(c1i + i);
+                sr = _mm256_fmadd_pd(a0r, b0r, sr);
+                sr = _mm256_fnmadd_pd(a0i, b0i, sr);
+                si = _mm256_fmadd_pd(a0r, b0i, si);
+                si = _mm256_fmadd_pd(a0i, b0r, si);
+                sr = _mm256_fmadd_pd(a1r, b1r, sr);
+                sr = _mm256_fnmadd_pd(a1i, b1i, sr);
+                si = _mm256_fmadd_pd(a1r, b1i, si);
+                si = _mm256_fmadd_pd(a1i, b1r, si);
+                _mm256_storeu_pd(yr + i, sr);
+                _mm256_storeu_pd(yi + i, si);
+            }
+            axpyColumnScalar(c0r, c0i, xr[j], xi[j], i, i1, yr, yi);
+            axpyColumnScalar(c1r, c1i, xr[j + 1], xi[j + 1], i, i1, yr, yi);
+        }
+        for (; j < cols; ++j) {
+            const double* cr = ar + j * ld;
+            const double* ci = ai + j * ld;
+            __m256d br = _mm256_set1_pd(xr[j]), bi = _mm256_set1_pd(xi[j]);
+            long i = i0;
+            for (; i + 4 <= i1; i += 4) {
+                __m256d sr = _mm256_loadu_pd(yr + i);
+                __m256d si = _mm256_loadu_pd(yi + i);
+                __m256d vr = _mm256_loadu_pd(cr + i), vi = _mm256_loadu_pd(ci + i);
+                sr = _mm256_fnmadd_pd(vi, bi, _mm256_fmadd_pd(vr, br, sr));
+                si = _mm256_fmadd_pd(vi, br, _mm256_fmadd_pd(vr, bi, si));
+                _mm256_storeu_pd(yr + i, sr);
+                _mm256_storeu_pd(yi + i, si);
+            }
+            axpyColumnScalar(cr, ci, xr[j], xi[j], i, i1, yr, yi);
+        }
+    }
+}
+
+__attribute__((target("avx2,fma")))
+static double normArgmaxAVX2(const double* re, const double* im, long n, long& maxIndex, double& maxValue) {
+    __m256d sum = _mm256_setzero_pd();
+    __m256d best = _mm256_set1_pd(-1.0);
+    __m256d bestIndex = _mm256_setzero_pd();
+    __m256d index = _mm256_set_pd(3.0, 2.0, 1.0, 0.0);
+    const __m256d step = _mm256_set1_pd(4.0);
+    long i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d vr = _mm256_loadu_pd(re + i);
+        __m256d vi = _mm256_loadu_pd(im + i);
+        __m256d magnitude = _mm256_fmadd_pd(vi, vi, _mm256_mul_pd(vr, vr));
+        sum = _mm256_add_pd(sum, magnitude);
+        __m256d greater = _mm256_cmp_pd(magnitude, best, _CMP_GT_OQ);
+        best = _mm256_blendv_pd(best, magnitude, greater);
+        bestIndex = _mm256_blendv_pd(bestIndex, index, greater);
+        index = _mm256_add_pd(index, step);
+    }
+
+    // Lane reduction: largest value, smallest index on ties
+    alignas(32) double lanes[4], laneIndices[4], sums[4];
+    _mm256_store_pd(lanes, best);
+    _mm256_store_pd(laneIndices, bestIndex);
+    _mm256_store_pd(sums, sum);
+    double total = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    maxValue = -1.0;
+    maxIndex = 0;
+    for (int lane = 0; lane < 4; ++lane) {
+        long laneIndex = static_cast<long>(laneIndices[lane]);
+        if (lanes[lane] > maxValue || (lanes[lane] == maxValue && laneIndex < maxIndex)) {
+            maxValue = lanes[lane];
+            maxIndex = laneIndex;
+        }
+    }
+    for (; i < n; ++i) {
+        double magnitude = re[i] * re[i] + im[i] * im[i];
+        total += magnitude;
+        if (magnitude > maxValue) {
+            maxValue = magnitude;
+            maxIndex = i;
+        }
+    }
+    return total;
+}
+
+// ---------------------------------------------------------------------------------------------------------------
+// AVX-512F kernels (8 doubles per register, masked tails)
+// ---------------------------------------------------------------------------------------------------------------
+
+__attribute__((target("avx512f")))
+static void gemvAVX512(const double* ar, const double* ai, long rows, long cols, long ld,
+                       const double* xr, const double* xi, double* yr, double* yi) {
+    std::fill(yr, yr + rows, 0.0);
+    std::fill(yi, yi + rows, 0.0);
+    for (long i0 = 0; i0 < rows; i0 += kRowChunk) {
+        long i1 = std::min(rows, i0 + kRowChunk);
+        long j = 0;
+        for (; j + 1 < cols; j += 2) {
+            const double* c0r = ar + j * ld;
+            const double* c0i = ai + j * ld;
+            const double* c1r = c0r + ld;
+            const double* c1i = c0i + ld;
+            __m512d b0r = _mm512_set1_pd(xr[j]), b0i = _mm512_set1_pd(xi[j]);
+            __m512d b1r = _mm512_set1_pd(xr[j + 1]), b1i = _mm512_set1_pd(xi[j + 1]);
+            for (long i = i0; i < i1; i += 8) {
+                __mmask8 mask = i1 - i >= 8 ? __mmask8(0xFF) : __mmask8((1u << (i1 - i)) - 1u);
+                __m512d sr = _mm512_maskz_loadu_pd(mask, yr + i);
+                __m512d si = _mm512_maskz_loadu_pd(mask, yi + i);
+                __m512d a0r = _mm512_maskz_loadu_pd(mask, c0r + i), a0i = _mm512_maskz_loadu_pd(mask, c0i + i);
+                __m512d a1r = _mm512_maskz_loadu_pd(mask, c1r + i), a1i = _mm512_maskz_loadu_pd(mask, c1i + i);
+                sr = _mm512_fmadd_pd(a0r, b0r, sr);
+                sr = _mm512_fnmadd_pd(a0i, b0i, sr);
+                si = _mm512_fmadd_pd(a0r, b0i, si);
+                si = _mm512_fmadd_pd(a0i, b0r, si);
+                sr = _mm512_fmadd_pd(a1r, b1r, sr);
+                sr = _mm512_fnmadd_pd(a1i, b1i, sr);
+                si = _mm512_fmadd_pd(a1r, b1i, si);
+                si = _mm512_fmadd_pd(a1i, b1r, si);
+                _mm512_mask_storeu_pd(yr + i, mask, sr);
+                _mm512_mask_storeu_pd(yi + i, mask, si);
+            }
+        }
+        for (; j < cols; ++j) {
+            const double* cr = ar + j * ld;
+            const double* ci = ai + j * ld;
+            __m512d br = _mm512_set1_pd(xr[j]), bi = _mm512_set1_pd(xi[j]);
+            for (long i = i0; i < i1; i += 8) {
+                __mmask8 mask = i1 - i >= 8 ? __mmask8(0xFF) : __mmask8((1u << (i1 - i)) - 1u);
+                __m512d sr = _mm512_maskz_loadu_pd(mask, yr + i);
+                __m512d si = _mm512_maskz_loadu_pd(mask, yi + i);
+                __m512d vr = _mm512_maskz_loadu_pd(mask, cr + i), vi = _mm512_maskz_loadu_pd(mask, ci + i);
+                sr = _mm512_fnmadd_pd(vi, bi, _mm512_fmadd_pd(vr, br, sr));
+                si = _mm512_fmadd_pd(vi, br, _mm512_fmadd_pd(vr, bi, si));
+                _mm512_mask_storeu_pd(yr + i, mask, sr);
+                _mm512_mask_storeu_pd(yi + i, mask, si);
+            }
+        }
+    }
+}
+
+__attribute__((target("avx512f")))
+static double normArgmaxAVX512(const double* re, const double* im, long n, long& maxIndex, double& maxValue) {
+    __m512d sum = _mm512_setzero_pd();
+    __m512d best = _mm512_set1_pd(-1.0);
+    __m512d bestIndex = _mm512_setzero_pd();
+    __m512d index = _mm512_set_pd(7.0, 6.0, 5.0, 4.0, 3.0, 2.0, 1.0, 0.0);
+    const __m512d step = _mm512_set1_pd(8.0);
+    for (long i = 0; i < n; i += 8) {
+        __mmask8 mask = n - i >= 8 ? __mmask8(0xFF) : __mmask8((1u << (n - i)) - 1u);
+        __m512d vr = _mm512_maskz_loadu_pd(mask, re + i);
+        __m512d vi = _mm512_maskz_loadu_pd(mask, im + i);
+        __m512d magnitude = _mm512_fmadd_pd(vi, vi, _mm512_mul_pd(vr, vr));
+        sum = _mm512_add_pd(sum, magnitude);
+        __mmask8 greater = _mm512_mask_cmp_pd_mask(mask, magnitude, best, _CMP_GT_OQ);
+        best = _mm512_mask_blend_pd(greater, best, magnitude);
+        bestIndex = _mm512_mask_blend_pd(greater, bestIndex, index);
+        index = _mm512_add_pd(index, step);
+    }
+
+    alignas(64) double lanes[8], laneIndices[8];
+    _mm512_store_pd(lanes, best);
+    _mm512_store_pd(laneIndices, bestIndex);
+    maxValue = -1.0;
+    maxIndex = 0;
+    for (int lane = 0; lane < 8; ++lane) {
+        long laneIndex = static_cast<long>(laneIndices[lane]);
+        if (lanes[lane] > maxValue || (lanes[lane] == maxValue && laneIndex < maxIndex)) {
+            maxValue = lanes[lane];
+            maxIndex = laneIndex;
+        }
+    }
+    // Halves added as AVX registers, then the lanes. The zero-masked extract keeps GCC 12 quiet: the plain one and
+    // _mm512_reduce_add_pd start from an undefined register, reported by -Wuninitialized
+    __m256d low = _mm512_maskz_extractf64x4_pd(0xFF, sum, 0);
+    __m256d half = _mm256_add_pd(low, _mm512_maskz_extractf64x4_pd(0xFF, sum, 1));
+    __m128d pair = _mm_add_pd(_mm256_castpd256_pd128(half), _mm256_extractf128_pd(half, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+}
+
+#endif // PLANAR_HAS_X86_KERNELS
+
+// ---------------------------------------------------------------------------------------------------------------
+// Run-time dispatch
+// ---------------------------------------------------------------------------------------------------------------
+
+static bool kernelSupported(PlanarKernel kernel) {
+    switch (kernel) {
+        case PlanarKernel::Scalar:
+            return true;
+#if PLANAR_HAS_X86_KERNELS
+        case PlanarKernel::AVX2:
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        case PlanarKernel::AVX512:
+            return __builtin_cpu_supports("avx512f");
+#endif
+        default:
+            return false;
+    }
+}
+
+static PlanarKernel detectKernel() {
+    if (kernelSupported(PlanarKernel::AVX512)) return PlanarKernel::AVX512;
+    if (kernelSupported(PlanarKernel::AVX2)) return PlanarKernel::AVX2;
+    return PlanarKernel::Scalar;
+}
+
+static PlanarKernel& activeKernel() {
+    static PlanarKernel kernel = detectKernel();
+    return kernel;
+}
+
+PlanarKernel planarActiveKernel() {
+    return activeKernel();
+}
+
+bool planarSelectKernel(PlanarKernel kernel) {
+    if (!kernelSupported(kernel)) return false;
+    activeKernel() = kernel;
+    return true;
+}
+
+const char* planarKernelName(PlanarKernel kernel) {
+    switch (kernel) {
+        case PlanarKernel::AVX2: return "avx2";
+        case PlanarKernel::AVX512: return "avx512";
+        default: return "scalar";
+    }
+}
+
+void planarGemv(const double* ar, const double* ai, long rows, long cols, long ld,
+                const double* xr, const double* xi, double* yr, double* yi) {
+    switch (activeKernel()) {
+#if PLANAR_HAS_X86_KERNELS
+        case PlanarKernel::AVX512: gemvAVX512(ar, ai, rows, cols, ld, xr, xi, yr, yi); return;
+        case PlanarKernel::AVX2: gemvAVX2(ar, ai, rows, cols, ld, xr, xi, yr, yi); return;
+#endif
+        default: gemvScalar(ar, ai, rows, cols, ld, xr, xi, yr, yi); return;
+    }
+}
+
+double planarSquaredNormArgmax(const double* re, const double* im, long n, long& maxIndex, double& maxValue) {
+    switch (activeKernel()) {
+#if PLANAR_HAS_X86_KERNELS
+        case PlanarKernel::AVX512: return normArgmaxAVX512(re, im, n, maxIndex, maxValue);
+        case PlanarKernel::AVX2: return normArgmaxAVX2(re, im, n, maxIndex, maxValue);
+#endif
+        default: return normArgmaxScalar(re, im, n, maxIndex, maxValue);
+    }
+}
@@ -1,18 +1,150 @@
 #include "PlotWriter.h"
+#include "OutputBuffer.h"
+#include <fstream>
 #include <iostream>
-#include <matplotlib-cpp>
-#include <gnuplot-i>
+#include <sstream>
+#include <stdexcept>
+
+#ifdef PCSC_HAVE_MATPLOTLIB
+#include "matplotlibcpp.h"
+namespace plt = matplotlibcpp;
+#endif
+
+namespace {
+
+// "<result>, converged after <n> iterations", the title of the plot
+std::string resultTitle(const std::string& result, int iterations, bool converged) {
+    std::ostringstream title;
+    title << result << (converged ? ", converged after " : ", not converged after ") << iterations
+          << " iterations";
+    return title.str();
+}
+
+}
 
 // Constructor
-PlotWriter::PlotWriter() : Writer() {}
+PlotWriter::PlotWriter(const std::string& filename) : Writer(filename) {}
 
 // Destructor
 PlotWriter::~PlotWriter() {}
 
+void PlotWriter::setHistory(const ConvergenceHistory& history) {
+    mEntries = history.getEntries();
+}
+
+bool PlotWriter::canRender() {
+#ifdef PCSC_HAVE_MATPLOTLIB
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::string PlotWriter::getOutputFile() const {
+    if (canRender()) return mFilename;
+    std::size_t slash = mFilename.find_last_of('/');
+    std::size_t dot = mFilename.find_last_of('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) return mFilename + ".csv";
+    return mFilename.substr(0, dot) + ".csv";
+}
+
+void PlotWriter::write(double eigenvalue,
+                       const Eigen::VectorXd&,
+                       int iterations,
+                       bool converged) const {
+    std::ostringstream result;
+    result.precision(mPrecision > 0 ? mPrecision : 17);
+    result << "lambda = " << eigenvalue;
+    plot(resultTitle(result.str(), iterations, converged));
+}
+
+void PlotWriter::write(std::complex<double> eigenvalue,
+                       const Eigen::VectorXcd&,
+                       int iterations,
+                       bool converged) const {
+    std::ostringstream result;
+    result.precision(mPrecision > 0 ? mPrecision : 17);
+    result << "lambda = " << eigenvalue.real() << (eigenvalue.imag() >= 0 ? " + " : " - ")
+           << std::abs(eigenvalue.imag()) << "i";
+    plot(resultTitle(result.str(), iterations, converged));
+}
+
+void PlotWriter::writeAll(const Eigen::VectorXd& eigenvalues,
+                          const Eigen::MatrixXd&,
+                          int iterations,
+                          bool converged) const {
+    plot(resultTitle(std::to_string(eigenvalues.size()) + " eigenvalues", iterations, converged));
+}
+
+void PlotWriter::writeAll(const Eigen::VectorXcd& eigenvalues,
+                          const Eigen::MatrixXcd&,
+                          int iterations,
+                          bool converged) const {
+    plot(resultTitle(std::to_string(eigenvalues.size()) + " eigenvalues", iterations, converged));
+}
+
+void PlotWriter::plot(const std::string& title) const {
+    if (mEntries.empty()) {
+        std::cerr << "Warning: no convergence history to plot (enable it with HistoryCapacity)" << std::endl;
+    }
+#ifdef PCSC_HAVE_MATPLOTLIB
+    try {
+        std::vector<double> iterations, residuals, real, imag;
+        bool complex = false;
+        for (const ConvergenceHistory::Entry& entry : mEntries) {
+            iterations.push_back(entry.iteration);
+            residuals.push_back(entry.residual);
+            real.push_back(entry.estimate.real());
+            imag.push_back(entry.estimate.imag());
+            complex = complex || entry.estimate.imag() != 0.0;
+        }
+
+        plt::figure_size(900, 700);
+        plt::subplot(2, 1, 1);
+        plt::title(title);
+        plt::semilogy(iterations, residuals);
+        plt::ylabel("Residual");
+        plt::subplot(2, 1, 2);
+        plt::named_plot("Real part", iterations, real);
+        if (complex) {
+            plt::named_plot("Imaginary part", iterations, imag);
+            plt::legend();
+        }
+        plt::xlabel("Iteration");
+        plt::ylabel("Eigenvalue estimate");
+        plt::save(mFilename);
+        plt::close();
+        std::cout << "Convergence plot written to " << mFilename << std::endl;
+        return;
+    } catch (const std::exception& e) {
+        std::cerr << "Warning: cannot render the convergence plot (" << e.what() << "), writing it as CSV"
+                  << std::endl;
+    }
+#else
+    (void)title;
+#endif
+    writeCsv();
+}
+
+void PlotWriter::writeCsv() const {
+    std::string filename = getOutputFile();
+    if (filename == mFilename && canRender()) {
+        // Rendering failed: the CSV goes next to the image that could not be written
+        filename += ".csv";
+    }
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot open file " << filename << " for writing" << std::endl;
+        return;
+    }
 
-void PlotWriter::Write() {
-    std::cout << "Generating and saving plot of convergence..." << std::endl;
-    // --- Plotting logic placeholder ---
-    // Collect iteration data and generate a visual plot
-    // --- End placeholder ---
-}
\ No newline at end of file
+    OutputBuffer out(mPrecision);
+    out << "Iteration,Seconds,EstimateReal,EstimateImag,Residual\n";
+    for (const ConvergenceHistory::Entry& entry : mEntries) {
+        out << entry.iteration << ',' << entry.seconds << ',' << entry.estimate.real() << ','
+            << entry.estimate.imag() << ',' << entry.residual << '\n';
+    }
+    out.writeTo(file);
+    file.close();
+    std::cout << "Convergence history written to " << filename << std::endl;
+}
@@ -1,7 +1,12 @@
 #include "PowerMethod.h"
+#include "Parallel.h"
+#include "RowPartitionedMatrix.h"
+#include "PlanarComplexMatrix.h"
 #include <cmath>
 #include <iostream>
 #include <complex>
+#include <memory>
+#include <type_traits>
 
 
 //Default Constructor
@@ -20,37 +25,167 @@ template<typename Scalar>
 PowerMethod<Scalar>::PowerMethod(const Matrix& matrix, const Parameters& params)
     : Eigenvalue<Scalar>(matrix, params) {}
 
+// Constructor on the caller's storage
+template<typename Scalar>
+PowerMethod<Scalar>::PowerMethod(const MatrixMap& matrix, const Parameters& params)
+    : Eigenvalue<Scalar>(matrix, params) {}
+
+// Threads worth using for the product (Threads = 0 means one per hardware thread)
+static int productThreads(const Parameters& params, long rows, long cols) {
+    int threads = params.getThreads() < 1 ? defaultThreadCount() : params.getThreads();
+    return RowPartitionedMatrix<double>::recommendedBlockCount(rows, cols, threads);
+}
+
+// Power iteration on the planar copy of a complex matrix; same steps as PowerMethod::solve()
+static bool solvePlanar(PlanarComplexMatrix& planar, int maxIteration, double tolerance,
+                        Eigen::VectorXcd& eigenvector, std::complex<double>& eigenvalue, int& iterationCount,
+                        SolverStats& stats) {
+    PhaseTimer setup(stats.setupSeconds);
+    PlanarVector b_k(eigenvector);
+    PlanarVector b_k1;
+    std::complex<double> lambda_k = 0.0;
+    stats.bytesAllocated += sizeof(double) * 4 * eigenvector.size();
+    setup.stop();
+
+    PhaseTimer iterations(stats.iterationSeconds);
+    for (iterationCount = 1; iterationCount <= maxIteration; ++iterationCount) {
+        stats.matrixVectorProducts++;
+        Eigen::Index max_idx;
+        double squared_norm = planar.multiply(b_k, b_k1, max_idx);
+        std::complex<double> lambda_k_plus_1 = b_k1(max_idx) / b_k(max_idx);
+
+        planar.scale(b_k1, 1.0 / std::sqrt(squared_norm));
+        b_k.swap(b_k1);
+        if (std::abs(lambda_k_plus_1 - lambda_k) < tolerance) {
+            iterations.stop();
+            PhaseTimer extraction(stats.extractionSeconds);
+            eigenvalue = lambda_k_plus_1;
+            eigenvector = b_k.toComplex();
+            return true;
+        }
+        lambda_k = lambda_k_plus_1;
+    }
+    iterations.stop();
+    PhaseTimer extraction(stats.extractionSeconds);
+    eigenvalue = lambda_k;
+    eigenvector = b_k.toComplex();
+    return false;
+}
+
+template<typename Scalar>
+void PowerMethod<Scalar>::setMatrix(const Matrix& matrix) {
+    Eigenvalue<Scalar>::setMatrix(matrix);
+    mWorkspace.partitioned.reset();
+    mWorkspace.planar.reset();
+}
+
+template<typename Scalar>
+ThreadPool* PowerMethod<Scalar>::productPool(int threads) {
+    if (threads <= 1) return nullptr;
+    if (!mWorkspace.pool || mWorkspace.pool->size() != threads) {
+        // The copies were made (first touch) and are multiplied by the workers of the previous pool
+        mWorkspace.partitioned.reset();
+        mWorkspace.planar.reset();
+        mWorkspace.pool.reset(new ThreadPool(threads, this->mParams.getPinThreads()));
+    }
+    return mWorkspace.pool.get();
+}
+
 // Template to work with different Scalar types
 template<typename Scalar>
 void PowerMethod<Scalar>::solve() {
-    // Define aliases for the types inherited from the base class
-    using Vector = typename Eigenvalue<Scalar>::Vector;
+    this->mStats = SolverStats();
+    const double rows = this->mMatrix.rows();
+    const double cols = this->mMatrix.cols();
+
+    // Complex matrices in planar storage (separate real and imaginary parts) go through the SIMD kernels
+    if constexpr (std::is_same<Scalar, std::complex<double>>::value) {
+        if (this->mParams.getPlanarComplex()) {
+            // The planar copy (and its pool) is kept for the next solves
+            PhaseTimer copy(this->mStats.setupSeconds);
+            ThreadPool* pool = productPool(productThreads(this->mParams, this->mMatrix.rows(), this->mMatrix.cols()));
+            if (!mWorkspace.planar || mWorkspace.planar->rows() != this->mMatrix.rows()) {
+                mWorkspace.planar.reset(new PlanarComplexMatrix(this->mMatrix, pool));
+                this->mStats.bytesAllocated += sizeof(double) * 2 * this->mMatrix.size();
+            }
+            copy.stop();
+            this->mConverged = solvePlanar(*mWorkspace.planar, this->mMaxIteration, this->mTolerance,
+                                           this->mEigenvector, this->mEigenvalue, this->mIterationCount,
+                                           this->mStats);
+            if (!this->mConverged) {
+                std::cerr << "PowerMethod failed to converge after " << this->mMaxIteration << " iterations." << std::endl;
+            }
+            // Products on squared magnitudes: no square root per entry, the same count as the generic loop
+            this->mStats.flops = flopScale<Scalar>() * this->mStats.matrixVectorProducts * (2 * rows * cols + 4 * rows);
+            PhaseTimer extraction(this->mStats.extractionSeconds);
+            this->mStats.residual = this->measureResidual(this->mEigenvalue, this->mEigenvector);
+            return;
+        }
+    }
 
+    PhaseTimer setup(this->mStats.setupSeconds);
+    // The iterates live in the workspace: allocated once, then only swapped and overwritten by the loop
+    if (mWorkspace.current.size() != this->mMatrix.rows()) {
+        mWorkspace.current.resize(this->mMatrix.rows());
+        mWorkspace.next.resize(this->mMatrix.rows());
+        this->mStats.bytesAllocated += sizeof(Scalar) * 2 * rows;
+    }
+    Vector& b_k = mWorkspace.current;
+    Vector& b_k1 = mWorkspace.next;
     // This is handled in the base class constructor (mEigenvector is randomized and normalized)
-    Vector b_k = this->mEigenvector;
+    b_k = this->mEigenvector;
 
-    Vector b_k1;
     Scalar lambda_k = 0.0; // Previous eigenvalue approximation
 
     this->mConverged = false;
     this->mIterationCount = 0;
+    this->mHistory.start();
+
+    // Large matrices: row blocks spread over a thread pool, both kept for the next solves
+    ThreadPool* pool = productPool(productThreads(this->mParams, this->mMatrix.rows(), this->mMatrix.cols()));
+    RowPartitionedMatrix<Scalar>* partitioned = nullptr;
+    if (pool) {
+        if (!mWorkspace.partitioned || mWorkspace.partitioned->rows() != this->mMatrix.rows()) {
+            mWorkspace.partitioned.reset(new RowPartitionedMatrix<Scalar>(this->mMatrix, *pool));
+            this->mStats.bytesAllocated += sizeof(Scalar) * this->mMatrix.size();
+        }
+        partitioned = mWorkspace.partitioned.get();
+    }
+    setup.stop();
 
+    PhaseTimer iterations(this->mStats.iterationSeconds);
     for (this->mIterationCount = 1;
          this->mIterationCount <= this->mMaxIteration;
          ++this->mIterationCount)
     {
-        // calculate the matrix-by-vector product Ab
-        b_k1 = this->mMatrix * b_k;
-
-        // Find the index of the largest component (in absolute value) in b_k1
+        this->mStats.matrixVectorProducts++;
+        // calculate the matrix-by-vector product Ab, its norm and the index of its largest component
         Eigen::Index max_idx;
-        b_k1.cwiseAbs().maxCoeff(&max_idx);  // LLM
+        double squared_norm;
+        if (partitioned) {
+            squared_norm = partitioned->multiply(b_k, b_k1, max_idx);
+        } else {
+            b_k1.noalias() = this->mMatrix * b_k;
+            b_k1.cwiseAbs2().maxCoeff(&max_idx);
+            squared_norm = b_k1.squaredNorm();
+        }
 
         // Calculate the new eigenvalue approximation (Ratio of components)
         Scalar lambda_k_plus_1 = b_k1(max_idx) / b_k(max_idx);
 
-        // re normalize the vector
-        b_k = b_k1.normalized();
+        // Residual ||A b_k - lambda b_k|| of the unit iterate, only computed when recorded
+        if (this->mHistory.isEnabled()) {
+            this->mHistory.record(this->mIterationCount, lambda_k_plus_1, (b_k1 - lambda_k_plus_1 * b_k).norm());
+        }
+
+        // re normalize the vector in place, then swap the buffers
+        double norm = std::sqrt(squared_norm);
+        if (partitioned) {
+            partitioned->scale(b_k1, 1.0 / norm);
+        } else {
+            b_k1 /= norm;
+        }
+        b_k.swap(b_k1);
         // std::abs handles the magnitude for both real and complex types
         if (std::abs(lambda_k_plus_1 - lambda_k) < this->mTolerance) {
             this->mConverged = true;
@@ -63,12 +198,18 @@ void PowerMethod<Scalar>::solve() {
         lambda_k = lambda_k_plus_1;
     }
 
+    iterations.stop();
+    // Product, largest component, norm and scaling at each iteration
+    this->mStats.flops = flopScale<Scalar>() * this->mStats.matrixVectorProducts * (2 * rows * cols + 4 * rows);
+
     // If the loop finished without converging, save the last result
     if (!this->mConverged) {
         std::cerr << "PowerMethod failed to converge after " << this->mMaxIteration << " iterations." << std::endl;
         this->mEigenvalue = lambda_k;
         this->mEigenvector = b_k;
     }
+    PhaseTimer extraction(this->mStats.extractionSeconds);
+    this->mStats.residual = this->measureResidual(this->mEigenvalue, this->mEigenvector);
 }
 
 
@@ -1,10 +1,16 @@
 #include "QRMethod.h"
+#include "Parallel.h"
 #include <Eigen/QR>
 #include <Eigen/Eigenvalues>  // Pour EigenSolver
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <complex>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 
 //Default Constructor
@@ -23,6 +29,33 @@ template<typename Scalar>
 QRMethod<Scalar>::QRMethod(const Matrix& matrix, const Parameters& params)
     : Eigenvalue<Scalar>(matrix, params) {} // Appelle le constructeur de la classe mère
 
+// Constructor on the caller's storage
+template<typename Scalar>
+QRMethod<Scalar>::QRMethod(const MatrixMap& matrix, const Parameters& params)
+    : Eigenvalue<Scalar>(matrix, params) {}
+
+
+// Eigenvector of A for the k-th diagonal entry of its Schur form T = Q^* A Q: back-substitution on
+// (T - T_kk I) y = 0 with y_k = 1 and y_i = 0 below, then x = Q y. A pivot too small (a repeated eigenvalue) is
+// raised to eps |T_kk|, as LAPACK's trevc does
+template<typename Matrix, typename Vector>
+static void schurEigenvector(const Matrix& T, const Matrix& Q, int k, Eigen::Ref<Vector> x) {
+    using Scalar = typename Matrix::Scalar;
+    using Real = typename Eigen::NumTraits<Scalar>::Real;
+    const Scalar lambda = T(k, k);
+    const Real smallest = std::max(Eigen::NumTraits<Real>::epsilon() * std::abs(lambda),
+                                   std::numeric_limits<Real>::min());
+    Vector y(k + 1);
+    y(k) = Scalar(1);
+    for (int i = k - 1; i >= 0; --i) {
+        Scalar sum = T.row(i).segment(i + 1, k - i).transpose().cwiseProduct(y.segment(i + 1, k - i)).sum();
+        Scalar pivot = T(i, i) - lambda;
+        if (std::abs(pivot) < smallest) pivot = Scalar(smallest);
+        y(i) = -sum / pivot;
+    }
+    x.noalias() = Q.leftCols(k + 1) * y;
+    x /= x.norm();
+}
 
 // Templates to handle real and complex
 template<typename Scalar>
@@ -36,58 +69,112 @@ void QRMethod<Scalar>::solve() {
         return;
     }
 
-    // Start with a copy of the original matrix
-    Matrix A = this->mMatrix;
+    this->mStats = SolverStats();
     int n = this->mMatrix.rows();
+
+    // Eigenvectors: all the Schur vectors, none (Q is not accumulated), or those of the selected eigenvalues
+    const bool accumulate = this->mParams.getComputeEigenvectors();
+    std::vector<int> selected = this->mParams.getEigenvectorIndices();
+    std::sort(selected.begin(), selected.end());
+    selected.erase(std::unique(selected.begin(), selected.end()), selected.end());
+    if (!selected.empty() && (selected.front() < 1 || selected.back() > n)) {
+        throw std::runtime_error("Eigenvector index out of range 1.." + std::to_string(n));
+    }
+
+    // Start with a copy of the original matrix, in the workspace (allocated by the first solve only)
+    PhaseTimer setup(this->mStats.setupSeconds);
+    const double size = n;
+    if (mWorkspace.current.rows() != n) {
+        mWorkspace.current.resize(n, n);
+        mWorkspace.reflectors.resize(n, n);
+        mWorkspace.coefficients.resize(n);
+        mWorkspace.buffer.resize(n);
+        this->mStats.bytesAllocated = sizeof(Scalar) * (2 * size * size + 2 * size);
+    }
+    if (accumulate && mWorkspace.accumulated.rows() != n) {
+        mWorkspace.accumulated.resize(n, n);
+        this->mStats.bytesAllocated += sizeof(Scalar) * size * size;
+    }
+    Matrix& A = mWorkspace.current;
+    Matrix& H = mWorkspace.reflectors;
+    Vector& tau = mWorkspace.coefficients;
+    Scalar* buffer = mWorkspace.buffer.data();
+    A = this->mMatrix;
     //Accumulation of Q matrix for the eigenvectors
-    Matrix Q_accumulated = Matrix::Identity(n, n);
+    Matrix& Q_accumulated = mWorkspace.accumulated;
+    if (accumulate) Q_accumulated.setIdentity();
+    setup.stop();
 
     this->mConverged = false;
     this->mIterationCount = 0;
+    this->mHistory.start();
+    double max_subdiag = 0.0;
 
+    PhaseTimer iterations(this->mStats.iterationSeconds);
     for (this->mIterationCount = 1;
          this->mIterationCount <= this->mMaxIteration;
          ++this->mIterationCount) {
+        this->mStats.factorizations++;
         // 1. QR Decomposition: A_k = Q_k * R_k
-        // Use Eigen's Householder QR decomposition
-        Eigen::HouseholderQR<Matrix> qr(A);
-        Matrix Q = qr.householderQ();
-
-        // Get the upper triangular factor R from the decomposed matrix
-        // The template view ensures correct type handling for complex numbers if Scalar is complex.
-        Matrix R = qr.matrixQR().template triangularView<Eigen::Upper>();
-
+        // Householder QR in place, as Eigen's HouseholderQR does it: R in the upper triangle of H, the
+        // essential part of each Householder vector below the diagonal and its coefficient in tau
+        H = A;
+        for (int k = 0; k < n; ++k) {
+            typename Eigen::NumTraits<Scalar>::Real beta;
+            H.col(k).tail(n - k).makeHouseholderInPlace(tau(k), beta);
+            H(k, k) = beta;
+            H.bottomRightCorner(n - k, n - k - 1).applyHouseholderOnTheLeft(H.col(k).tail(n - k - 1), tau(k), buffer);
+        }
 
         // 2. Re-multiplication: A_k+1 = R_k * Q_k
-        Matrix A_next = R * Q;
-
-        Q_accumulated = Q_accumulated * Q;
+        // Q_k = H_0^* ... H_{n-1}^* is never formed: its reflectors are applied on the right of R_k and of the
+        // accumulated Q when eigenvectors are wanted. The template view ensures correct type handling for complex
+        // numbers if Scalar is complex.
+        A = H.template triangularView<Eigen::Upper>();
+        for (int k = 0; k < n; ++k) {
+            Scalar coefficient = Eigen::numext::conj(tau(k));
+            A.rightCols(n - k).applyHouseholderOnTheRight(H.col(k).tail(n - k - 1), coefficient, buffer);
+            if (accumulate) {
+                Q_accumulated.rightCols(n - k).applyHouseholderOnTheRight(H.col(k).tail(n - k - 1), coefficient,
+                                                                          buffer);
+            }
+        }
 
         // 3. Check for convergence: all sub-diagonal elements should approach zero
         // When the matrix becomes sufficiently upper-triangular, eigenvalues appear on the diagonal
 
         // Find the maximum magnitude of all sub-diagonal elements
-        double max_subdiag = 0.0;
+        max_subdiag = 0.0;
         for (int i = 0; i < n - 1; ++i) {
-            double val = std::abs(A_next(i + 1, i));  //Sub diagonal element
+            double val = std::abs(A(i + 1, i));  //Sub diagonal element
             if (val > max_subdiag) {
                 max_subdiag = val;
             }
         }
+        // The leading diagonal entry tends to the dominant eigenvalue
+        this->mHistory.record(this->mIterationCount, A(0, 0), max_subdiag);
 
         // Check if largest sub-diagonal element is below tolerance
         // std::abs handles the magnitude for both real and complex types
         if (std::abs(max_subdiag) < this->mTolerance) {
             this->mConverged = true;
-            A = A_next;  // Store the final quasi-triangular matri
-            break;
+            break;  // A holds the final quasi-triangular matrix
         }
-
-        // 4. Update for next iteration
-        A = A_next;
     }
 
+    iterations.stop();
+    // Per iteration: Householder QR (4/3 n^3), then its reflectors applied to R and to the accumulated Q (2 n^3
+    // each, none for Q without eigenvectors); nothing is allocated by the loop
+    const long performed = this->mStats.factorizations;
+    this->mStats.flops = flopScale<Scalar>() * performed * ((accumulate ? 16.0 : 10.0) / 3.0) * size * size * size;
+    this->mStats.residual = max_subdiag;
+
     // Extract all the eigenvalues of the diagonal
+    PhaseTimer extraction(this->mStats.extractionSeconds);
+    const int columns = accumulate ? n : 0;
+    if (mAllEigenvectors.rows() != n || mAllEigenvectors.cols() != columns) {
+        this->mStats.bytesAllocated += sizeof(Scalar) * (size * columns + size);
+    }
     mAllEigenvalues.resize(n);
     for (int i = 0; i < n; ++i) {
         mAllEigenvalues(i) = A(i, i);
@@ -105,9 +192,54 @@ void QRMethod<Scalar>::solve() {
     }
     this->mEigenvalue = mAllEigenvalues(max_idx);
 
-    // eigenvectors are the column of Q accumulated
-    mAllEigenvectors = Q_accumulated;
-    this->mEigenvector = Q_accumulated.col(max_idx);
+    if (!accumulate) {
+        mAllEigenvectors.resize(n, 0);
+        this->mEigenvector.resize(0);
+    } else if (selected.empty()) {
+        // eigenvectors are the column of Q accumulated
+        mAllEigenvectors = Q_accumulated;
+        this->mEigenvector = Q_accumulated.col(max_idx);
+    } else {
+        // Back-substitution needs a triangular Schur form around the column: not before convergence, nor on the
+        // 2x2 blocks that the complex conjugate pairs of a real matrix leave on the diagonal. Those columns stay zero
+        auto solvableAt = [&](int k) {
+            const bool decoupled = (k + 1 >= n || std::abs(A(k + 1, k)) < this->mTolerance) &&
+                                   (k == 0 || std::abs(A(k, k - 1)) < this->mTolerance);
+            if (this->mConverged && decoupled) return true;
+            std::cerr << "Warning: QRMethod has no eigenvector " << k + 1
+                      << " (the Schur form is not triangular there; use the complex type for complex pairs)"
+                      << std::endl;
+            return false;
+        };
+        std::vector<int> solvable;
+        for (int index : selected) {
+            if (solvableAt(index - 1)) solvable.push_back(index);
+        }
+
+        // Back-substitution for the selected columns only (k^2 + n k flops each), one column per thread
+        mAllEigenvectors.setZero(n, n);
+        parallelFor(0, static_cast<long>(solvable.size()), this->mParams.getThreads(), [&](long s) {
+            const int k = solvable[s] - 1;
+            schurEigenvector<Matrix, Vector>(A, Q_accumulated, k, mAllEigenvectors.col(k));
+        });
+        // getEigenvector() is the eigenvector of the dominant eigenvalue, also when it was not selected
+        std::vector<int> substituted = solvable;
+        if (std::binary_search(selected.begin(), selected.end(), max_idx + 1)) {
+            this->mEigenvector = mAllEigenvectors.col(max_idx);
+        } else if (solvableAt(max_idx)) {
+            this->mEigenvector.resize(n);
+            schurEigenvector<Matrix, Vector>(A, Q_accumulated, max_idx, this->mEigenvector);
+            substituted.push_back(max_idx + 1);
+        } else {
+            this->mEigenvector.setZero(n);
+        }
+        for (int index : substituted) {
+            const double k = index;
+            this->mStats.flops += flopScale<Scalar>() * (k * k + 2 * size * k);
+        }
+        this->mStats.bytesAllocated += sizeof(Scalar) * size * substituted.size();
+    }
+    extraction.stop();
 
 
     if (this->mConverged) {
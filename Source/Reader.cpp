@@ -7,30 +7,51 @@
 #include "Reader.h"
 #include <iostream>
 #include <string>
-#include <fstream>
+#include <stdexcept>
+#include <sys/stat.h>
 template<typename Scalar>
 // Constructor
-Reader<Scalar>::Reader(const std::string& fileName):mFilename(fileName),mFileType(FileType::UNKNOWN) {
-    std::ifstream file(mFilename);
-    if (!file.good()) {
+Reader<Scalar>::Reader(const std::string& fileName):mFilename(fileName),mFileType(FileType::UNKNOWN),mCompression(Compression::None) {
+    struct stat status;
+    if (::stat(mFilename.c_str(), &status) != 0) {
         throw std::runtime_error("File not found"); //check if the file exist
     }
-    file.close();
 
-    if (mFilename.find(".csv")!=std::string::npos) {
+    // Compressed files are recognized by their first bytes; their format by the name without .gz/.zst
+    mCompression = detectCompression(mFilename);
+    const std::string name = mCompression == Compression::None ? mFilename : uncompressedName(mFilename);
+
+    if (name.find(".csv")!=std::string::npos) {
         //npos check if he found something
         mFileType= FileType::CSV ;
     }
 
-    else if (mFilename.find(".txt") != std::string::npos ||
-             mFilename.find(".dat") != std::string::npos) {
+    else if (name.find(".bmat") != std::string::npos) {
+        mFileType = FileType::BINARY;
+    }
+    else if (name.find(".mtx") != std::string::npos) {
+        mFileType = FileType::MATRIX_MARKET;
+    }
+    else if (name.find(".npy") != std::string::npos ||
+             name.find(".npz") != std::string::npos) {
+        mFileType = FileType::NUMPY;
+    }
+    else if (name.find(".txt") != std::string::npos ||
+             name.find(".dat") != std::string::npos) {
         mFileType = FileType::TEXT;
              }
     else {
         mFileType = FileType::UNKNOWN;
         throw std::runtime_error ("Unknown file type" + mFilename);
     }
-    std::cout << "File :" << mFilename << "| Type: " <<GetFileTypeString() << std::endl;
+    if (mCompression != Compression::None && mFileType != FileType::CSV && mFileType != FileType::TEXT) {
+        throw std::runtime_error("Compressed input is only supported for CSV and text files: " + mFilename);
+    }
+    std::cout << "File :" << mFilename << "| Type: " <<GetFileTypeString();
+    if (mCompression != Compression::None) {
+        std::cout << " (" << compressionName(mCompression) << ")";
+    }
+    std::cout << std::endl;
 
     }
 
@@ -39,15 +60,44 @@ Reader<Scalar>::Reader(const std::string& fileName):mFilename(fileName),mFileTyp
 template<typename Scalar>
 Reader<Scalar>::~Reader(){}
 
+// Second matrix of a generalized problem: none by default
+template<typename Scalar>
+typename Reader<Scalar>::Matrix Reader<Scalar>::ReadMatrixB() {
+    return Matrix(0, 0);
+}
+
+// Row counting and row blocks: read everything by default
+template<typename Scalar>
+long Reader<Scalar>::CountMatrixRows() {
+    return ReadMatrix().rows();
+}
+
+template<typename Scalar>
+typename Reader<Scalar>::Matrix Reader<Scalar>::ReadMatrixRows(long firstRow, long rowCount) {
+    Matrix matrix = ReadMatrix();
+    if (firstRow < 0 || rowCount < 0 || firstRow + rowCount > matrix.rows()) {
+        throw std::runtime_error("Requested rows are outside the matrix");
+    }
+    return matrix.middleRows(firstRow, rowCount);
+}
+
 template<typename Scalar>
 // Get file type
 typename Reader<Scalar>::FileType Reader<Scalar>::GetFileType() const {
     return mFileType;
 }
+template<typename Scalar>
+Compression Reader<Scalar>::GetCompression() const {
+    return mCompression;
+}
+
 template<typename Scalar>
 std::string Reader<Scalar>::GetFileTypeString() const {
     if (mFileType == FileType::CSV) return "CSV";
     if (mFileType == FileType::TEXT) return "TEXT";
+    if (mFileType == FileType::BINARY) return "BINARY";
+    if (mFileType == FileType::MATRIX_MARKET) return "MATRIX_MARKET";
+    if (mFileType == FileType::NUMPY) return "NUMPY";
     return "UNKNOWN";
 
 }
@@ -0,0 +1,310 @@
+#include "ResultCache.h"
+#include "BinaryResult.h"
+#include "BinaryWriter.h"
+#include "NumpyFormat.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const char* const kEntryExtension = ".bres";
+
+// 128-bit hash of a byte stream, 8 bytes at a time on two lanes with different constants (not cryptographic:
+// it addresses entries, whose sizes and checksum are verified when read)
+class ContentHash {
+public:
+    void update(const void* data, std::size_t bytes) {
+        const char* cursor = static_cast<const char*>(data);
+        mLength += bytes;
+        if (mPending > 0) {
+            std::size_t take = std::min(bytes, sizeof(mBuffer) - mPending);
+            std::memcpy(mBuffer + mPending, cursor, take);
+            mPending += take;
+            cursor += take;
+            bytes -= take;
+            if (mPending < sizeof(mBuffer)) return;
+            consume(mBuffer);
+            mPending = 0;
+        }
+        for (; bytes >= 8; cursor += 8, bytes -= 8) consume(cursor);
+        std::memcpy(mBuffer, cursor, bytes);
+        mPending = bytes;
+    }
+
+    void update(const std::string& text) {
+        std::uint64_t length = text.size();
+        update(&length, sizeof(length));
+        update(text.data(), text.size());
+    }
+
+    std::string hex() {
+        std::memset(mBuffer + mPending, 0, sizeof(mBuffer) - mPending);
+        consume(mBuffer);
+        std::uint64_t a = finish(mLaneA ^ mLength);
+        std::uint64_t b = finish(mLaneB ^ (mLength * 0x9e3779b97f4a7c15ULL));
+        char text[33];
+        std::snprintf(text, sizeof(text), "%016llx%016llx", static_cast<unsigned long long>(a),
+                      static_cast<unsigned long long>(b));
+        return text;
+    }
+
+private:
+    static std::uint64_t rotate(std::uint64_t x, int bits) { return (x << bits) | (x >> (64 - bits)); }
+
+    // Final mix of MurmurHash3: every input bit changes half of the output bits
+    static std::uint64_t finish(std::uint64_t h) {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        return h ^ (h >> 33);
+    }
+
+    void consume(const char* bytes) {
+        std::uint64_t word;
+        std::memcpy(&word, bytes, sizeof(word));
+        mLaneA = rotate(mLaneA ^ (word * 0x87c37b91114253d5ULL), 31) * 0x4cf5ad432745937fULL;
+        mLaneB = rotate(mLaneB ^ (word * 0x9fb21c651e98df25ULL), 29) * 0xc2b2ae3d27d4eb4fULL + mLaneA;
+    }
+
+    std::uint64_t mLaneA = 0x6a09e667f3bcc908ULL;
+    std::uint64_t mLaneB = 0xbb67ae8584caa73bULL;
+    std::uint64_t mLength = 0;
+    char mBuffer[8];
+    std::size_t mPending = 0;
+};
+
+template<typename Scalar>
+void hashMatrix(ContentHash& hash, const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>& matrix) {
+    std::uint64_t sizes[2] = {static_cast<std::uint64_t>(matrix.rows()), static_cast<std::uint64_t>(matrix.cols())};
+    hash.update(sizes, sizeof(sizes));
+    hash.update(matrix.data(), sizeof(Scalar) * static_cast<std::size_t>(matrix.size()));
+}
+
+std::string checksumText(std::uint32_t checksum) {
+    char text[9];
+    std::snprintf(text, sizeof(text), "%08x", checksum);
+    return text;
+}
+
+template<typename Scalar>
+std::uint32_t checksum(const Scalar* values, std::size_t count, const Scalar* vectors, std::size_t vectorCount) {
+    std::uint32_t crc = crc32(reinterpret_cast<const char*>(values), sizeof(Scalar) * count);
+    return crc32(reinterpret_cast<const char*>(vectors), sizeof(Scalar) * vectorCount, crc);
+}
+
+bool isEntry(const std::string& name) {
+    const std::size_t length = std::strlen(kEntryExtension);
+    return name.size() > length && name.compare(name.size() - length, length, kEntryExtension) == 0 &&
+           name[0] != '.';
+}
+
+}
+
+ResultCache::ResultCache(const std::string& directory, std::uint64_t maxBytes)
+    : mDirectory(directory), mMaxBytes(maxBytes), mHits(0), mMisses(0), mStores(0), mEvictions(0), mCorrupt(0) {
+    if (::mkdir(mDirectory.c_str(), 0777) != 0 && errno != EEXIST) {
+        throw std::runtime_error("Cannot create the cache directory " + mDirectory + " (" + std::strerror(errno) + ")");
+    }
+}
+
+template<typename Scalar>
+std::string ResultCache::key(const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>& matrixA,
+                             const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>& matrixB,
+                             const Parameters& params) {
+    ContentHash hash;
+    hash.update(Eigen::NumTraits<Scalar>::IsComplex ? "complex" : "real");
+    hashMatrix(hash, matrixA);
+    hashMatrix(hash, matrixB);
+
+    // Parameters as the exact text of writeValues() (17 digits: 0.1 and 0.1000000000000001 are different problems),
+    // so that a new parameter is part of the key; only those that cannot change the result are left out
+    std::ostringstream text;
+    params.writeValues(text);
+    std::istringstream lines(text.str());
+    std::string line;
+    while (std::getline(lines, line)) {
+        const std::string name = line.substr(0, line.find(','));
+        if (name == "Threads" || name == "PinThreads" || name == "HistoryCapacity") continue;
+        hash.update(line);
+        hash.update("\n");
+    }
+    return hash.hex();
+}
+
+std::string ResultCache::entryPath(const std::string& key) const {
+    return mDirectory + "/" + key + kEntryExtension;
+}
+
+template<typename Scalar>
+bool ResultCache::load(const std::string& key, long rows, long cols, SolveResult<Scalar>& result) {
+    const std::string path = entryPath(key);
+    if (::access(path.c_str(), F_OK) != 0) {
+        mMisses++;
+        return false;
+    }
+    try {
+        BinaryResultReader entry(path);
+        const BinaryResultHeader& header = entry.header();
+        auto values = entry.MapEigenvalues<Scalar>();
+        auto vectors = entry.MapEigenvectors<Scalar>();
+        if (entry.metadata("Key") != key || entry.metadata("Rows") != std::to_string(rows) ||
+            entry.metadata("Cols") != std::to_string(cols) ||
+            entry.metadata("Checksum") != checksumText(checksum(values.data(), static_cast<std::size_t>(values.size()),
+                                                                vectors.data(),
+                                                                static_cast<std::size_t>(vectors.size())))) {
+            throw std::runtime_error("damaged entry");
+        }
+        result.eigenvalues = values;
+        result.eigenvectors = vectors;
+        result.single = entry.metadata("Pairs") == "single";
+        result.iterations = static_cast<int>(header.iterations);
+        result.converged = header.converged != 0;
+        result.solveSeconds = 0.0;
+    } catch (const std::exception&) {
+        // Truncated, overwritten or from another scalar type: removed, and solved again by the caller
+        ::unlink(path.c_str());
+        mCorrupt++;
+        mMisses++;
+        return false;
+    }
+    ::utimensat(AT_FDCWD, path.c_str(), nullptr, 0);
+    mHits++;
+    return true;
+}
+
+template<typename Scalar>
+bool ResultCache::store(const std::string& key, long rows, long cols, const std::string& algorithm,
+                        const SolveResult<Scalar>& result) {
+    const std::uint64_t bytes = sizeof(BinaryResultHeader) +
+                                sizeof(Scalar) * static_cast<std::uint64_t>(result.eigenvalues.size() +
+                                                                            result.eigenvectors.size());
+    if (mMaxBytes > 0 && bytes > mMaxBytes) return false;
+
+    // Unique temporary name per process and thread, renamed at once into place
+    std::ostringstream temporary;
+    temporary << mDirectory << "/." << key << "." << ::getpid() << "." << std::this_thread::get_id() << ".tmp";
+    try {
+        BinaryWriter writer(temporary.str(), algorithm);
+        writer.setQuiet(true);
+        writer.setMetadata("Key", key);
+        writer.setMetadata("Rows", std::to_string(rows));
+        writer.setMetadata("Cols", std::to_string(cols));
+        writer.setMetadata("Pairs", result.single ? "single" : "all");
+        writer.setMetadata("Checksum", checksumText(checksum(result.eigenvalues.data(),
+                                                             static_cast<std::size_t>(result.eigenvalues.size()),
+                                                             result.eigenvectors.data(),
+                                                             static_cast<std::size_t>(result.eigenvectors.size()))));
+        writer.setTiming("Solve", result.solveSeconds);
+        writer.writeAll(result.eigenvalues, result.eigenvectors, result.iterations, result.converged);
+    } catch (const std::exception&) {
+        std::remove(temporary.str().c_str());
+        return false;
+    }
+    if (std::rename(temporary.str().c_str(), entryPath(key).c_str()) != 0) {
+        std::remove(temporary.str().c_str());
+        return false;
+    }
+    mStores++;
+    if (mMaxBytes > 0) evict(key);
+    return true;
+}
+
+template<typename Scalar>
+SolveResult<Scalar> ResultCache::solve(const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>& matrixA,
+                                       const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>& matrixB,
+                                       const Parameters& params, bool* hit) {
+    const std::string entry = key(matrixA, matrixB, params);
+    SolveResult<Scalar> result;
+    bool found = load(entry, matrixA.rows(), matrixA.cols(), result);
+    if (hit) *hit = found;
+    if (!found) {
+        result = solveProblem<Scalar>(matrixA, matrixB, params);
+        store(entry, matrixA.rows(), matrixA.cols(), params.getAlgorithm(), result);
+    }
+    return result;
+}
+
+void ResultCache::evict(const std::string& keep) {
+    std::lock_guard<std::mutex> lock(mEvictMutex);
+    struct Entry {
+        std::string path;
+        std::uint64_t bytes;
+        struct timespec used;
+    };
+    std::vector<Entry> entries;
+    std::uint64_t total = 0;
+    if (DIR* directory = ::opendir(mDirectory.c_str())) {
+        while (dirent* item = ::readdir(directory)) {
+            std::string name = item->d_name;
+            struct stat status;
+            if (!isEntry(name) || ::stat((mDirectory + "/" + name).c_str(), &status) != 0) continue;
+            total += static_cast<std::uint64_t>(status.st_size);
+            if (name != keep + kEntryExtension) {
+                entries.push_back({mDirectory + "/" + name, static_cast<std::uint64_t>(status.st_size), status.st_mtim});
+            }
+        }
+        ::closedir(directory);
+    }
+    if (total <= mMaxBytes) return;
+
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.used.tv_sec != b.used.tv_sec ? a.used.tv_sec < b.used.tv_sec : a.used.tv_nsec < b.used.tv_nsec;
+    });
+    for (const Entry& entry : entries) {
+        if (total <= mMaxBytes) break;
+        if (::unlink(entry.path.c_str()) == 0) mEvictions++;
+        total -= entry.bytes;
+    }
+}
+
+std::uint64_t ResultCache::sizeBytes() const {
+    std::uint64_t total = 0;
+    if (DIR* directory = ::opendir(mDirectory.c_str())) {
+        while (dirent* item = ::readdir(directory)) {
+            struct stat status;
+            if (isEntry(item->d_name) && ::stat((mDirectory + "/" + item->d_name).c_str(), &status) == 0) {
+                total += static_cast<std::uint64_t>(status.st_size);
+            }
+        }
+        ::closedir(directory);
+    }
+    return total;
+}
+
+CacheStats ResultCache::stats() const {
+    CacheStats stats;
+    stats.hits = mHits;
+    stats.misses = mMisses;
+    stats.stores = mStores;
+    stats.evictions = mEvictions;
+    stats.corrupt = mCorrupt;
+    return stats;
+}
+
+template std::string ResultCache::key<double>(const Eigen::MatrixXd&, const Eigen::MatrixXd&, const Parameters&);
+template std::string ResultCache::key<std::complex<double>>(const Eigen::MatrixXcd&, const Eigen::MatrixXcd&,
+                                                            const Parameters&);
+template bool ResultCache::load<double>(const std::string&, long, long, SolveResult<double>&);
+template bool ResultCache::load<std::complex<double>>(const std::string&, long, long,
+                                                      SolveResult<std::complex<double>>&);
+template bool ResultCache::store<double>(const std::string&, long, long, const std::string&,
+                                         const SolveResult<double>&);
+template bool ResultCache::store<std::complex<double>>(const std::string&, long, long, const std::string&,
+                                                       const SolveResult<std::complex<double>>&);
+template SolveResult<double> ResultCache::solve<double>(const Eigen::MatrixXd&, const Eigen::MatrixXd&,
+                                                        const Parameters&, bool*);
+template SolveResult<std::complex<double>> ResultCache::solve<std::complex<double>>(const Eigen::MatrixXcd&,
+                                                                                    const Eigen::MatrixXcd&,
+                                                                                    const Parameters&, bool*);
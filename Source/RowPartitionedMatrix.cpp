@@ -0,0 +1,77 @@
+#include "RowPartitionedMatrix.h"
+#include <algorithm>
+
+// Minimum number of entries per block for a thread to pay off
+static const long kMinEntriesPerBlock = 32768;
+
+// Constructor
+template<typename Scalar>
+RowPartitionedMatrix<Scalar>::RowPartitionedMatrix(const Eigen::Ref<const Matrix>& matrix, ThreadPool& pool)
+    : mPool(pool),
+      mRows(matrix.rows()),
+      mCols(matrix.cols()) {
+
+    int blocks = static_cast<int>(std::max<Eigen::Index>(1, std::min<Eigen::Index>(pool.size(), mRows)));
+    mOffsets.resize(blocks + 1);
+    for (int t = 0; t <= blocks; ++t) {
+        mOffsets[t] = mRows * t / blocks;
+    }
+    mBlocks.resize(blocks);
+    mPartials.resize(blocks);
+
+    // First touch: each worker allocates and fills the block it will multiply
+    mPool.run([&](int t) {
+        if (t >= blocks) return;
+        mBlocks[t] = matrix.middleRows(mOffsets[t], mOffsets[t + 1] - mOffsets[t]);
+    });
+}
+
+template<typename Scalar>
+int RowPartitionedMatrix<Scalar>::recommendedBlockCount(long rows, long cols, int threads) {
+    long useful = std::max<long>(1, rows * cols / kMinEntriesPerBlock);
+    return static_cast<int>(std::max<long>(1, std::min<long>({useful, static_cast<long>(threads), rows})));
+}
+
+template<typename Scalar>
+typename RowPartitionedMatrix<Scalar>::RealScalar
+RowPartitionedMatrix<Scalar>::multiply(const Vector& x, Vector& y, Eigen::Index& maxIndex) {
+    y.resize(mRows);
+    const int blocks = blockCount();
+
+    mPool.run([&](int t) {
+        if (t >= blocks) return;
+        Eigen::Index offset = mOffsets[t];
+        auto segment = y.segment(offset, mOffsets[t + 1] - offset);
+        segment.noalias() = mBlocks[t] * x;
+
+        PartialResult& partial = mPartials[t];
+        partial.squaredNorm = segment.squaredNorm();
+        partial.maxMagnitude = segment.size() > 0 ? segment.cwiseAbs2().maxCoeff(&partial.maxIndex) : RealScalar(-1);
+        partial.maxIndex += offset;
+    });
+
+    // Combine the partial results in block order, so that the result does not depend on the timing
+    RealScalar squaredNorm = 0;
+    RealScalar maxMagnitude = -1;
+    maxIndex = 0;
+    for (const PartialResult& partial : mPartials) {
+        squaredNorm += partial.squaredNorm;
+        if (partial.maxMagnitude > maxMagnitude) {
+            maxMagnitude = partial.maxMagnitude;
+            maxIndex = partial.maxIndex;
+        }
+    }
+    return squaredNorm;
+}
+
+template<typename Scalar>
+void RowPartitionedMatrix<Scalar>::scale(Vector& v, RealScalar factor) {
+    const int blocks = blockCount();
+    mPool.run([&](int t) {
+        if (t >= blocks) return;
+        v.segment(mOffsets[t], mOffsets[t + 1] - mOffsets[t]) *= factor;
+    });
+}
+
+template class RowPartitionedMatrix<double>;
+template class RowPartitionedMatrix<std::complex<double>>;
@@ -20,19 +20,44 @@ template<typename Scalar>
 ShiftedInversePowerMethod<Scalar>::ShiftedInversePowerMethod(const Matrix& matrix, const Parameters& params)
     : Eigenvalue<Scalar>(matrix, params) {}
 
+// Constructor on the caller's storage
+template<typename Scalar>
+ShiftedInversePowerMethod<Scalar>::ShiftedInversePowerMethod(const MatrixMap& matrix, const Parameters& params)
+    : Eigenvalue<Scalar>(matrix, params) {}
+
 
 template<typename Scalar>
 void ShiftedInversePowerMethod<Scalar>::solve() {
     using Matrix = typename Eigenvalue<Scalar>::Matrix;
     using Vector = typename Eigenvalue<Scalar>::Vector;
 
-    // 1. Calculate the shifted matrix B = A - mu*I
+    this->mStats = SolverStats();
+    const double n = this->mMatrix.rows();
+
+    // 1. Calculate the shifted matrix B = A - mu*I, in the workspace
     // The shift (mu) is mShift. It must be cast to Scalar (for complex types).
-    Matrix B = this->mMatrix - this->mShift * Matrix::Identity(this->mMatrix.rows(), this->mMatrix.cols());
+    PhaseTimer setup(this->mStats.setupSeconds);
+    // The buffers of the workspace (B, the LU factors and the iterates) are reused by the next solve() on a
+    // matrix of the same size
+    if (mWorkspace.current.size() != this->mMatrix.rows()) {
+        mWorkspace.shifted.resize(this->mMatrix.rows(), this->mMatrix.cols());
+        mWorkspace.current.resize(this->mMatrix.rows());
+        mWorkspace.next.resize(this->mMatrix.rows());
+        this->mStats.bytesAllocated += sizeof(Scalar) * (2 * n * n + 2 * n) + sizeof(int) * n;
+    }
+    Matrix& B = mWorkspace.shifted;
+    B = this->mMatrix;
+    B.diagonal().array() -= Scalar(this->mShift);
+    setup.stop();
 
     // 2. Pre-compute the LU decomposition of B (for efficient solving of B*y = x)
     // PartialPivLU is used for solving linear systems Ax=b
-    Eigen::PartialPivLU<Matrix> lu_of_B(B);
+    PhaseTimer factorization(this->mStats.factorizationSeconds);
+    Eigen::PartialPivLU<Matrix>& lu_of_B = mWorkspace.lu;
+    lu_of_B.compute(B);
+    factorization.stop();
+    this->mStats.factorizations = 1;
+    this->mStats.flops = flopScale<Scalar>() * (2.0 / 3.0) * n * n * n;
 
     // Check if the shifted matrix is invertible (i.e., if mShift is an exact eigenvalue)
     Scalar det = lu_of_B.determinant();
@@ -42,21 +67,25 @@ void ShiftedInversePowerMethod<Scalar>::solve() {
         return;
     }
 
-    Vector x_k = this->mEigenvector; // Current vector (x_k)
-    Vector x_k_plus_1;              // Next vector (y_k+1)
+    Vector& x_k = mWorkspace.current;     // Current vector (x_k)
+    Vector& x_k_plus_1 = mWorkspace.next; // Next vector (y_k+1)
+    x_k = this->mEigenvector;
     Scalar mu_prime_k = 0.0;        // Previous dominant eigenvalue of B_inverse
 
     this->mConverged = false;
     this->mIterationCount = 0;
+    this->mHistory.start();
 
+    PhaseTimer iterations(this->mStats.iterationSeconds);
     for (this->mIterationCount = 1;
          this->mIterationCount <= this->mMaxIteration;
          ++this->mIterationCount)
     {
 
         // 1. Solve the system: B * x_k+1 = x_k
-        // This is the core Inverse Power Iteration step.
-        x_k_plus_1 = lu_of_B.solve(x_k);
+        // This is the core Inverse Power Iteration step; the solution is written into the workspace.
+        x_k_plus_1.noalias() = lu_of_B.solve(x_k);
+        this->mStats.solves++;
 
         // 2. Calculate the new dominant eigenvalue of B_inverse (mu_prime)
         // This value is 1 / (lambda_A - mu).
@@ -65,6 +94,12 @@ void ShiftedInversePowerMethod<Scalar>::solve() {
 
         Scalar mu_prime_k_plus_1 = x_k_plus_1(max_idx) / x_k(max_idx);
 
+        // Relative residual ||y - mu' x_k|| / ||y|| of the inverse iteration, only computed when recorded
+        if (this->mHistory.isEnabled()) {
+            this->mHistory.record(this->mIterationCount, this->mShift + Scalar(1.0) / mu_prime_k_plus_1,
+                                  (x_k_plus_1 - mu_prime_k_plus_1 * x_k).norm() / x_k_plus_1.norm());
+        }
+
         // 3. Normalize the vector
         x_k_plus_1.normalize();
 
@@ -81,16 +116,22 @@ void ShiftedInversePowerMethod<Scalar>::solve() {
         }
 
         // 6. Update for next iteration
-        x_k = x_k_plus_1;
+        x_k.swap(x_k_plus_1);
         mu_prime_k = mu_prime_k_plus_1;
     }
 
+    iterations.stop();
+    // Forward and back substitution, largest component, normalization and copy at each iteration
+    this->mStats.flops += flopScale<Scalar>() * this->mStats.solves * (2 * n * n + 5 * n);
+
     if (!this->mConverged) {
         std::cerr << "ShiftedInversePowerMethod failed to converge after " << this->mMaxIteration << " iterations." << std::endl;
         // Calculate the final eigenvalue result
         this->mEigenvalue = this->mShift + (Scalar(1.0) / mu_prime_k);
         this->mEigenvector = x_k;
     }
+    PhaseTimer extraction(this->mStats.extractionSeconds);
+    this->mStats.residual = this->measureResidual(this->mEigenvalue, this->mEigenvector);
 }
 
 
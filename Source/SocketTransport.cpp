@@ -0,0 +1,231 @@
+#include "SocketTransport.h"
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+static std::runtime_error socketError(const std::string& what) {
+    return std::runtime_error("SocketTransport: " + what + " (" + std::strerror(errno) + ")");
+}
+
+// Handshake sent by each connecting rank
+struct Hello {
+    int32_t rank;
+    int32_t size;
+};
+
+// Constructor
+SocketTransport::SocketTransport(const std::string& address, int rank, int size, double timeoutSeconds)
+    : mRank(rank),
+      mSize(size),
+      mUnix(false),
+      mSockets(size, -1) {
+
+    if (size < 1 || rank < 0 || rank >= size) {
+        throw std::runtime_error("SocketTransport: rank must lie in [0, size)");
+    }
+    if (address.rfind("unix:", 0) == 0) {
+        mUnix = true;
+        mHost = address.substr(5);
+        if (mHost.empty() || mHost.size() >= sizeof(sockaddr_un::sun_path)) {
+            throw std::runtime_error("SocketTransport: invalid Unix socket path in " + address);
+        }
+    } else if (address.rfind("tcp:", 0) == 0) {
+        std::string hostPort = address.substr(4);
+        std::size_t colon = hostPort.rfind(':');
+        if (colon == std::string::npos || colon == 0 || colon + 1 == hostPort.size()) {
+            throw std::runtime_error("SocketTransport: expected tcp:HOST:PORT, got " + address);
+        }
+        mHost = hostPort.substr(0, colon);
+        mPort = hostPort.substr(colon + 1);
+    } else {
+        throw std::runtime_error("SocketTransport: address must start with unix: or tcp:, got " + address);
+    }
+
+    if (size == 1) return;
+    if (rank == 0) {
+        acceptPeers(timeoutSeconds);
+    } else {
+        connectToHub(timeoutSeconds);
+    }
+}
+
+// Destructor
+SocketTransport::~SocketTransport() {
+    for (int socket : mSockets) {
+        if (socket >= 0) ::close(socket);
+    }
+    if (mUnix && mRank == 0 && mSize > 1) {
+        ::unlink(mHost.c_str());
+    }
+}
+
+void SocketTransport::acceptPeers(double timeoutSeconds) {
+    int listener;
+    if (mUnix) {
+        listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listener < 0) throw socketError("socket");
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, mHost.c_str(), sizeof(addr.sun_path) - 1);
+        ::unlink(mHost.c_str());
+        if (::bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            ::close(listener);
+            throw socketError("bind " + mHost);
+        }
+    } else {
+        addrinfo hints{};
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_flags = AI_PASSIVE;
+        addrinfo* info = nullptr;
+        if (::getaddrinfo(mHost.c_str(), mPort.c_str(), &hints, &info) != 0 || !info) {
+            throw std::runtime_error("SocketTransport: cannot resolve " + mHost);
+        }
+        listener = ::socket(info->ai_family, info->ai_socktype, info->ai_protocol);
+        if (listener < 0) {
+            ::freeaddrinfo(info);
+            throw socketError("socket");
+        }
+        int yes = 1;
+        ::setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+        int bound = ::bind(listener, info->ai_addr, info->ai_addrlen);
+        ::freeaddrinfo(info);
+        if (bound != 0) {
+            ::close(listener);
+            throw socketError("bind " + mHost + ":" + mPort);
+        }
+    }
+    if (::listen(listener, mSize) != 0) {
+        ::close(listener);
+        throw socketError("listen");
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(timeoutSeconds);
+    for (int accepted = 1; accepted < mSize; ++accepted) {
+        int remaining = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now()).count());
+        pollfd waiting{listener, POLLIN, 0};
+        if (remaining <= 0 || ::poll(&waiting, 1, remaining) <= 0) {
+            ::close(listener);
+            throw std::runtime_error("SocketTransport: timed out waiting for the other ranks");
+        }
+        int socket = ::accept(listener, nullptr, nullptr);
+        if (socket < 0) {
+            ::close(listener);
+            throw socketError("accept");
+        }
+        if (!mUnix) {
+            int yes = 1;
+            ::setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+        }
+        Hello hello{};
+        mSockets[0] = socket;  // temporarily, so that receive() can read the handshake
+        receive(0, &hello, sizeof(hello));
+        mSockets[0] = -1;
+        if (hello.size != mSize || hello.rank <= 0 || hello.rank >= mSize || mSockets[hello.rank] >= 0) {
+            ::close(socket);
+            ::close(listener);
+            throw std::runtime_error("SocketTransport: unexpected handshake from a peer");
+        }
+        mSockets[hello.rank] = socket;
+    }
+    ::close(listener);
+}
+
+void SocketTransport::connectToHub(double timeoutSeconds) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(timeoutSeconds);
+    for (;;) {
+        int socket = -1;
+        int connected = -1;
+        if (mUnix) {
+            socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+            if (socket < 0) throw socketError("socket");
+            sockaddr_un addr{};
+            addr.sun_family = AF_UNIX;
+            std::strncpy(addr.sun_path, mHost.c_str(), sizeof(addr.sun_path) - 1);
+            connected = ::connect(socket, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        } else {
+            addrinfo hints{};
+            hints.ai_family = AF_INET;
+            hints.ai_socktype = SOCK_STREAM;
+            addrinfo* info = nullptr;
+            if (::getaddrinfo(mHost.c_str(), mPort.c_str(), &hints, &info) != 0 || !info) {
+                throw std::runtime_error("SocketTransport: cannot resolve " + mHost);
+            }
+            socket = ::socket(info->ai_family, info->ai_socktype, info->ai_protocol);
+            if (socket < 0) {
+                ::freeaddrinfo(info);
+                throw socketError("socket");
+            }
+            connected = ::connect(socket, info->ai_addr, info->ai_addrlen);
+            ::freeaddrinfo(info);
+            int yes = 1;
+            ::setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+        }
+
+        if (connected == 0) {
+            mSockets[0] = socket;
+            Hello hello{static_cast<int32_t>(mRank), static_cast<int32_t>(mSize)};
+            send(0, &hello, sizeof(hello));
+            return;
+        }
+        ::close(socket);
+        if (std::chrono::steady_clock::now() >= deadline) {
+            throw socketError("cannot connect to rank 0");
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));  // rank 0 is not listening yet
+    }
+}
+
+int SocketTransport::socketFor(int peer) const {
+    if (peer < 0 || peer >= mSize || mSockets[peer] < 0) {
+        throw std::runtime_error("SocketTransport: no link between rank " + std::to_string(mRank) + " and rank " +
+                                 std::to_string(peer));
+    }
+    return mSockets[peer];
+}
+
+void SocketTransport::send(int peer, const void* data, std::size_t bytes) {
+    int socket = socketFor(peer);
+    const char* cursor = static_cast<const char*>(data);
+    std::size_t left = bytes;
+    while (left > 0) {
+        ssize_t written = ::send(socket, cursor, left, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            throw socketError("send to rank " + std::to_string(peer));
+        }
+        cursor += written;
+        left -= static_cast<std::size_t>(written);
+    }
+    mBytesSent += bytes;
+}
+
+void SocketTransport::receive(int peer, void* data, std::size_t bytes) {
+    int socket = socketFor(peer);
+    char* cursor = static_cast<char*>(data);
+    std::size_t left = bytes;
+    while (left > 0) {
+        ssize_t read = ::recv(socket, cursor, left, 0);
+        if (read == 0) {
+            throw std::runtime_error("SocketTransport: rank " + std::to_string(peer) + " closed the connection");
+        }
+        if (read < 0) {
+            if (errno == EINTR) continue;
+            throw socketError("receive from rank " + std::to_string(peer));
+        }
+        cursor += read;
+        left -= static_cast<std::size_t>(read);
+    }
+    mBytesReceived += bytes;
+}
@@ -0,0 +1,216 @@
+#include "SolveJob.h"
+#include "BinaryReader.h"
+#include "BinaryWriter.h"
+#include "BisectionMethod.h"
+#include "CSVReader.h"
+#include "GeneralizedPowerMethod.h"
+#include "GeneralizedQRMethod.h"
+#include "GeneralizedShiftedInversePowerMethod.h"
+#include "MatrixMarketReader.h"
+#include "NumpyReader.h"
+#include "NumpyWriter.h"
+#include "PowerMethod.h"
+#include "QRMethod.h"
+#include "ShiftedInversePowerMethod.h"
+#include "TextFileReader.h"
+#include "TridiagonalReader.h"
+#include "TruncatedSVD.h"
+#include <chrono>
+#include <stdexcept>
+#include <type_traits>
+
+namespace {
+
+// Solves and times the solver, then keeps its single eigenpair
+template<typename Scalar, typename Solver>
+void solveSingle(Solver& solver, SolveResult<Scalar>& result) {
+    auto start = std::chrono::steady_clock::now();
+    solver.solve();
+    result.solveSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.eigenvalues = Eigen::Matrix<Scalar, Eigen::Dynamic, 1>::Constant(1, solver.getEigenvalue());
+    result.eigenvectors = solver.getEigenvector();
+    result.single = true;
+    result.iterations = solver.getIterationCount();
+    result.converged = solver.hasConverged();
+    result.stats = solver.getStats();
+    if constexpr (std::is_base_of<Eigenvalue<Scalar>, Solver>::value) {
+        result.history = solver.getHistory();
+    }
+}
+
+// Solves and times the solver, then keeps all its eigenpairs
+template<typename Scalar, typename Solver>
+void solveAll(Solver& solver, SolveResult<Scalar>& result) {
+    auto start = std::chrono::steady_clock::now();
+    solver.solve();
+    result.solveSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.eigenvalues = solver.getAllEigenvalues();
+    result.eigenvectors = solver.getAllEigenvectors();
+    result.iterations = solver.getIterationCount();
+    result.converged = solver.hasConverged();
+    result.stats = solver.getStats();
+    if constexpr (std::is_base_of<Eigenvalue<Scalar>, Solver>::value) {
+        result.history = solver.getHistory();
+    }
+}
+
+// The tridiagonal matrix of BisectionMethod, from the dense form the readers and the server give
+template<typename MatrixA>
+TridiagonalMatrix tridiagonalPart(const MatrixA& matrix) {
+    for (Eigen::Index j = 0; j < matrix.cols(); ++j) {
+        for (Eigen::Index i = 0; i < matrix.rows(); ++i) {
+            if ((i < j - 1 || i > j + 1) && matrix(i, j) != 0.0) {
+                throw std::runtime_error("BisectionMethod requires a tridiagonal matrix");
+            }
+        }
+    }
+    return TridiagonalMatrix::fromDense(matrix);
+}
+
+// The body of both solveProblem(): MatrixA is an owned or a mapped matrix
+template<typename Scalar, typename MatrixA>
+SolveResult<Scalar> solveMatrix(const MatrixA& matrixA,
+                                const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>& matrixB,
+                                const Parameters& params) {
+    const std::string algorithm = params.getAlgorithm();
+    SolveResult<Scalar> result;
+
+    // Rectangular matrices only have singular values; the right singular vectors are the "eigenvectors" of A^H A
+    if (algorithm == "TruncatedSVD") {
+        TruncatedSVD<Scalar> svd(matrixA, params);
+        auto start = std::chrono::steady_clock::now();
+        svd.solve();
+        result.solveSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        result.eigenvalues = svd.getSingularValues().template cast<Scalar>();
+        result.eigenvectors = svd.getRightSingularVectors();
+        result.iterations = svd.getIterationCount();
+        result.converged = svd.hasConverged();
+        result.stats = svd.getStats();
+        return result;
+    }
+    if (matrixA.rows() != matrixA.cols()) {
+        throw std::runtime_error("Eigenvalue algorithms require a square matrix, use TruncatedSVD instead");
+    }
+
+    if (matrixB.size() > 0) {
+        if (algorithm == "PowerMethod") {
+            GeneralizedPowerMethod<Scalar> solver(matrixA, matrixB, params);
+            solveSingle(solver, result);
+        } else if (algorithm == "ShiftedInversePowerMethod") {
+            GeneralizedShiftedInversePowerMethod<Scalar> solver(matrixA, matrixB, params);
+            solveSingle(solver, result);
+        } else if (algorithm == "QRMethod") {
+            GeneralizedQRMethod<Scalar> solver(matrixA, matrixB, params);
+            solveAll(solver, result);
+        } else {
+            throw std::runtime_error("Unknown algorithm for a generalized problem: " + algorithm);
+        }
+        return result;
+    }
+
+    if (algorithm == "PowerMethod") {
+        PowerMethod<Scalar> solver(matrixA, params);
+        solveSingle(solver, result);
+    } else if (algorithm == "ShiftedInversePowerMethod") {
+        ShiftedInversePowerMethod<Scalar> solver(matrixA, params);
+        solveSingle(solver, result);
+    } else if (algorithm == "QRMethod") {
+        QRMethod<Scalar> solver(matrixA, params);
+        solveAll(solver, result);
+    } else if (algorithm == "BisectionMethod") {
+        if constexpr (std::is_same<Scalar, double>::value) {
+            BisectionMethod solver(tridiagonalPart(matrixA), params);
+            solveAll(solver, result);
+        } else {
+            throw std::runtime_error("BisectionMethod requires a real tridiagonal matrix");
+        }
+    } else {
+        throw std::runtime_error("Unknown algorithm: " + algorithm);
+    }
+    return result;
+}
+
+}
+
+template<typename Scalar>
+SolveResult<Scalar> solveProblem(const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>& matrixA,
+                                 const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>& matrixB,
+                                 const Parameters& params) {
+    return solveMatrix<Scalar>(matrixA, matrixB, params);
+}
+
+template<typename Scalar>
+SolveResult<Scalar> solveProblem(const Eigen::Map<const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>>& matrixA,
+                                 const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>& matrixB,
+                                 const Parameters& params) {
+    return solveMatrix<Scalar>(matrixA, matrixB, params);
+}
+
+template<typename Scalar>
+void writeResult(const SolveResult<Scalar>& result, Writer& writer) {
+    if (BinaryWriter* binary = dynamic_cast<BinaryWriter*>(&writer)) {
+        binary->setTiming("Solve", result.solveSeconds);
+    }
+    if (result.stats.totalSeconds() > 0) {
+        writer.setStats(result.stats);
+    }
+    if (result.single) {
+        const Eigen::Matrix<Scalar, Eigen::Dynamic, 1> eigenvector = result.eigenvectors.col(0);
+        writer.write(result.eigenvalues(0), eigenvector, result.iterations, result.converged);
+    } else {
+        writer.writeAll(result.eigenvalues, result.eigenvectors, result.iterations, result.converged);
+    }
+}
+
+template<typename Scalar>
+std::unique_ptr<Reader<Scalar>> createReader(const std::string& filename) {
+    if (filename.find(".bmat") != std::string::npos) {
+        return std::unique_ptr<Reader<Scalar>>(new BinaryReader<Scalar>(filename));
+    }
+    if (filename.find(".npy") != std::string::npos || filename.find(".npz") != std::string::npos) {
+        return std::unique_ptr<Reader<Scalar>>(new NumpyReader<Scalar>(filename));
+    }
+    if (filename.find(".mtx") != std::string::npos) {
+        return std::unique_ptr<Reader<Scalar>>(new MatrixMarketReader<Scalar>(filename));
+    }
+    // Labelled diagonals, expanded to their dense form by ReadMatrix()
+    if (TridiagonalReader::isTridiagonalFile(filename)) {
+        if constexpr (std::is_same<Scalar, double>::value) {
+            return std::unique_ptr<Reader<Scalar>>(new TridiagonalReader(filename));
+        } else {
+            throw std::runtime_error("Tridiagonal files hold real matrices: " + filename);
+        }
+    }
+    if (filename.find(".csv") != std::string::npos) {
+        return std::unique_ptr<Reader<Scalar>>(new CSVReader<Scalar>(filename));
+    }
+    return std::unique_ptr<Reader<Scalar>>(new TextFileReader<Scalar>(filename));
+}
+
+std::unique_ptr<Writer> createWriter(const std::string& format, const std::string& filename,
+                                     const std::string& algorithm) {
+    if (format == "csv") return std::unique_ptr<Writer>(new CSVWriter(filename));
+    if (format == "txt") return std::unique_ptr<Writer>(new TextFileWriter(filename));
+    if (format == "npz") return std::unique_ptr<Writer>(new NumpyWriter(filename));
+    if (format == "bres") return std::unique_ptr<Writer>(new BinaryWriter(filename, algorithm));
+    throw std::runtime_error("Unknown output format: " + format + " (csv, txt, npz or bres)");
+}
+
+std::string outputExtension(const std::string& format) {
+    if (format == "csv" || format == "txt" || format == "npz" || format == "bres") return "." + format;
+    throw std::runtime_error("Unknown output format: " + format + " (csv, txt, npz or bres)");
+}
+
+template SolveResult<double> solveProblem<double>(const Eigen::MatrixXd&, const Eigen::MatrixXd&, const Parameters&);
+template SolveResult<std::complex<double>> solveProblem<std::complex<double>>(const Eigen::MatrixXcd&,
+                                                                              const Eigen::MatrixXcd&,
+                                                                              const Parameters&);
+template SolveResult<double> solveProblem<double>(const Eigen::Map<const Eigen::MatrixXd>&, const Eigen::MatrixXd&,
+                                                  const Parameters&);
+template SolveResult<std::complex<double>> solveProblem<std::complex<double>>(const Eigen::Map<const Eigen::MatrixXcd>&,
+                                                                              const Eigen::MatrixXcd&,
+                                                                              const Parameters&);
+template std::unique_ptr<Reader<double>> createReader<double>(const std::string&);
+template std::unique_ptr<Reader<std::complex<double>>> createReader<std::complex<double>>(const std::string&);
+template void writeResult<double>(const SolveResult<double>&, Writer&);
+template void writeResult<std::complex<double>>(const SolveResult<std::complex<double>>&, Writer&);
@@ -0,0 +1,167 @@
+#include "SolvePipeline.h"
+#include "TextMatrixParser.h"
+#include <chrono>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace {
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// "---", possibly followed by blanks or a carriage return
+bool isDocumentSeparator(const std::string& line) {
+    if (line.compare(0, 3, "---") != 0) return false;
+    for (std::size_t i = 3; i < line.size(); ++i) {
+        if (line[i] != ' ' && line[i] != '\t' && line[i] != '\r') return false;
+    }
+    return true;
+}
+
+bool isBlank(const std::string& line) {
+    return line.find_first_not_of(" \t\r") == std::string::npos;
+}
+
+}
+
+bool readDocument(std::istream& input, std::vector<char>& text) {
+    text.clear();
+    bool content = false;
+    std::string line;
+    while (std::getline(input, line)) {
+        if (isDocumentSeparator(line)) {
+            if (content) return true;
+            text.clear();
+            continue;
+        }
+        content = content || !isBlank(line);
+        text.insert(text.end(), line.begin(), line.end());
+        text.push_back('\n');
+    }
+    if (!content) text.clear();
+    return content;
+}
+
+template<typename Scalar>
+SolvePipeline<Scalar>::SolvePipeline(const PipelineOptions& options) : mOptions(options) {
+    outputExtension(mOptions.format);
+}
+
+// The reading and writing stages run on their own threads, the solving stage on the calling thread. An
+// unexpected error in any stage closes both queues, so the other stages stop instead of waiting forever.
+template<typename Scalar>
+PipelineStats SolvePipeline<Scalar>::run(std::istream& input, std::ostream& log) {
+    auto start = std::chrono::steady_clock::now();
+    PipelineStats stats;
+    BoundedQueue<Job> parsed(mOptions.queueDepth), solved(mOptions.queueDepth);
+    std::exception_ptr readError, solveError, writeError;
+
+    auto guarded = [&](std::exception_ptr& error, auto&& stage) {
+        try {
+            stage();
+        } catch (...) {
+            error = std::current_exception();
+            parsed.close();
+            solved.close();
+        }
+    };
+
+    std::thread reader([&] { guarded(readError, [&] { readStage(input, parsed, stats); }); });
+    std::thread writer([&] { guarded(writeError, [&] { writeStage(solved, log, stats); }); });
+    guarded(solveError, [&] { solveStage(parsed, solved, stats); });
+    parsed.close();
+    reader.join();
+    writer.join();
+
+    for (const std::exception_ptr& error : {readError, solveError, writeError}) {
+        if (error) std::rethrow_exception(error);
+    }
+    stats.wallSeconds = secondsSince(start);
+    return stats;
+}
+
+template<typename Scalar>
+void SolvePipeline<Scalar>::readStage(std::istream& input, BoundedQueue<Job>& parsed, PipelineStats& stats) {
+    std::vector<char> text;
+    while (true) {
+        auto start = std::chrono::steady_clock::now();
+        if (!readDocument(input, text)) break;
+        Job job;
+        job.index = ++stats.documents;
+        try {
+            TextMatrixParser parser(std::move(text));
+            job.params = parser.parameters();
+            if (mOptions.threads >= 0) job.params.setThreads(mOptions.threads);
+            job.matrixA = parser.parse<Scalar>(TextMatrixParser::Section::A);
+            job.matrixB = parser.parse<Scalar>(TextMatrixParser::Section::B);
+            if (job.matrixA.size() == 0) {
+                throw std::runtime_error("No matrix in the document");
+            }
+        } catch (const std::exception& e) {
+            job.error = e.what();
+        }
+        text = std::vector<char>();
+        stats.readSeconds += secondsSince(start);
+        if (!parsed.push(std::move(job))) break;
+    }
+    parsed.close();
+}
+
+template<typename Scalar>
+void SolvePipeline<Scalar>::solveStage(BoundedQueue<Job>& parsed, BoundedQueue<Job>& solved, PipelineStats& stats) {
+    Job job;
+    while (parsed.pop(job)) {
+        auto start = std::chrono::steady_clock::now();
+        if (job.error.empty()) {
+            try {
+                if (!job.params.validate()) {
+                    throw std::runtime_error("Invalid parameters");
+                }
+                job.result = solveProblem<Scalar>(job.matrixA, job.matrixB, job.params);
+            } catch (const std::exception& e) {
+                job.error = e.what();
+            }
+        }
+        // The matrices are no longer needed: release them before the job waits for the writer
+        job.matrixA = Matrix();
+        job.matrixB = Matrix();
+        stats.solveSeconds += secondsSince(start);
+        if (!solved.push(std::move(job))) break;
+    }
+    solved.close();
+}
+
+template<typename Scalar>
+void SolvePipeline<Scalar>::writeStage(BoundedQueue<Job>& solved, std::ostream& log, PipelineStats& stats) {
+    Job job;
+    while (solved.pop(job)) {
+        auto start = std::chrono::steady_clock::now();
+        std::string outputFile = mOptions.outputDirectory + "/result_" + std::to_string(job.index) +
+                                 outputExtension(mOptions.format);
+        if (job.error.empty()) {
+            try {
+                std::unique_ptr<Writer> writer = createWriter(mOptions.format, outputFile, job.params.getAlgorithm());
+                writeResult(job.result, *writer);
+            } catch (const std::exception& e) {
+                job.error = e.what();
+            }
+        }
+        stats.writeSeconds += secondsSince(start);
+
+        if (job.error.empty()) {
+            stats.solved++;
+            log << "Document " << job.index << ": " << job.params.getAlgorithm() << ", "
+                << job.result.iterations << " iterations, " << (job.result.converged ? "converged" : "not converged")
+                << ", solved in " << job.result.solveSeconds << " s, written to " << outputFile << std::endl;
+        } else {
+            stats.failed++;
+            log << "Document " << job.index << " failed: " << job.error << std::endl;
+        }
+    }
+}
+
+template class SolvePipeline<double>;
+template class SolvePipeline<std::complex<double>>;
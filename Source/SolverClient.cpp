@@ -0,0 +1,98 @@
+#include "SolverClient.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+SolverClient::SolverClient(const std::string& address, double timeoutSeconds) : mSocket(-1) {
+    const std::string path = unixSocketPath(address);
+    sockaddr_un socketAddress{};
+    socketAddress.sun_family = AF_UNIX;
+    std::strncpy(socketAddress.sun_path, path.c_str(), sizeof(socketAddress.sun_path) - 1);
+
+    auto giveUp = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                                          std::chrono::duration<double>(timeoutSeconds));
+    while (true) {
+        mSocket = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (mSocket < 0) {
+            throw std::runtime_error(std::string("Solver client: cannot create a socket (") + std::strerror(errno) + ")");
+        }
+        if (::connect(mSocket, reinterpret_cast<sockaddr*>(&socketAddress), sizeof(socketAddress)) == 0) return;
+        std::string error = std::strerror(errno);
+        ::close(mSocket);
+        mSocket = -1;
+        if (std::chrono::steady_clock::now() >= giveUp) {
+            throw std::runtime_error("Solver client: cannot connect to " + path + " (" + error + ")");
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+}
+
+SolverClient::~SolverClient() {
+    if (mSocket >= 0) ::close(mSocket);
+}
+
+template<typename Scalar>
+SolveReply<Scalar> SolverClient::solve(const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>& matrixA,
+                                       const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>& matrixB,
+                                       const Parameters& params, double deadlineSeconds) {
+    std::vector<char> request = encodeRequest(matrixA, matrixB, params, deadlineSeconds);
+    // A server at its connection limit answers Busy and closes without reading the request: the reply is still
+    // there to read when the send fails
+    std::string sendError;
+    try {
+        sendFully(mSocket, request.data(), request.size());
+    } catch (const std::runtime_error& e) {
+        sendError = e.what();
+    }
+
+    SolveReplyHeader header;
+    if (!receiveFully(mSocket, &header, sizeof(header))) {
+        throw std::runtime_error(sendError.empty() ? "Solver client: the server closed the connection" : sendError);
+    }
+    if (std::memcmp(header.magic, kSolveReplyMagic, sizeof(header.magic)) != 0 ||
+        header.status > static_cast<std::uint32_t>(SolveStatus::DeadlineExceeded)) {
+        throw std::runtime_error("Solver client: malformed reply");
+    }
+
+    SolveReply<Scalar> reply;
+    reply.status = static_cast<SolveStatus>(header.status);
+    reply.queueSeconds = header.queueMicros * 1e-6;
+    reply.message.resize(header.messageBytes);
+    if (!reply.message.empty()) receiveFully(mSocket, &reply.message[0], reply.message.size());
+    if (reply.status != SolveStatus::Ok) return reply;
+
+    const std::uint32_t scalarType = Eigen::NumTraits<Scalar>::IsComplex ? kBinaryScalarComplex : kBinaryScalarReal;
+    // Eigenvectors have the size of A, or its number of columns for the right singular vectors
+    const std::uint64_t rows = static_cast<std::uint64_t>(matrixA.rows());
+    const std::uint64_t cols = static_cast<std::uint64_t>(matrixA.cols());
+    if (header.scalarType != scalarType || (header.rows != 0 && header.rows != rows && header.rows != cols) ||
+        header.count > std::max(rows, cols) || header.vectorCount > std::max(rows, cols)) {
+        throw std::runtime_error("Solver client: reply does not match the request");
+    }
+    SolveResult<Scalar>& result = reply.result;
+    result.eigenvalues.resize(static_cast<Eigen::Index>(header.count));
+    result.eigenvectors.resize(static_cast<Eigen::Index>(header.rows), static_cast<Eigen::Index>(header.vectorCount));
+    if (result.eigenvalues.size() > 0) {
+        receiveFully(mSocket, result.eigenvalues.data(), sizeof(Scalar) * result.eigenvalues.size());
+    }
+    if (result.eigenvectors.size() > 0) {
+        receiveFully(mSocket, result.eigenvectors.data(), sizeof(Scalar) * result.eigenvectors.size());
+    }
+    result.single = (header.flags & kReplySinglePair) != 0;
+    result.iterations = header.iterations;
+    result.converged = header.converged != 0;
+    result.solveSeconds = header.solveMicros * 1e-6;
+    return reply;
+}
+
+template SolveReply<double> SolverClient::solve<double>(const Eigen::MatrixXd&, const Eigen::MatrixXd&,
+                                                        const Parameters&, double);
+template SolveReply<std::complex<double>> SolverClient::solve<std::complex<double>>(const Eigen::MatrixXcd&,
+                                                                                    const Eigen::MatrixXcd&,
+                                                                                    const Parameters&, double);
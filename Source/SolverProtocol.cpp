@@ -0,0 +1,140 @@
+#include "SolverProtocol.h"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+const char* statusName(SolveStatus status) {
+    switch (status) {
+        case SolveStatus::Ok: return "ok";
+        case SolveStatus::Failed: return "failed";
+        case SolveStatus::Busy: return "busy";
+        case SolveStatus::DeadlineExceeded: return "deadline exceeded";
+    }
+    return "unknown";
+}
+
+void sendFully(int socket, const void* data, std::size_t bytes) {
+    const char* cursor = static_cast<const char*>(data);
+    while (bytes > 0) {
+        ssize_t written = ::send(socket, cursor, bytes, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error(std::string("Solver socket: send failed (") + std::strerror(errno) + ")");
+        }
+        cursor += written;
+        bytes -= static_cast<std::size_t>(written);
+    }
+}
+
+bool receiveFully(int socket, void* data, std::size_t bytes) {
+    char* cursor = static_cast<char*>(data);
+    std::size_t received = 0;
+    while (received < bytes) {
+        ssize_t read = ::recv(socket, cursor + received, bytes - received, 0);
+        if (read == 0) {
+            if (received == 0) return false;
+            throw std::runtime_error("Solver socket: connection closed in the middle of a message");
+        }
+        if (read < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error(std::string("Solver socket: receive failed (") + std::strerror(errno) + ")");
+        }
+        received += static_cast<std::size_t>(read);
+    }
+    return true;
+}
+
+Parameters parseParameterText(const std::string& text) {
+    Parameters params;
+    std::istringstream lines(text);
+    std::string line;
+    while (std::getline(lines, line)) {
+        std::size_t comma = line.find(',');
+        if (comma == std::string::npos) continue;
+        params.setValue(line.substr(0, comma), line.substr(comma + 1));
+    }
+    return params;
+}
+
+std::string unixSocketPath(const std::string& address) {
+    std::string path = address.compare(0, 5, "unix:") == 0 ? address.substr(5) : address;
+    if (path.empty() || path.size() >= sizeof(sockaddr_un::sun_path)) {
+        throw std::runtime_error("Invalid Unix socket path: " + address);
+    }
+    return path;
+}
+
+template<typename Scalar>
+std::vector<char> encodeRequest(const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>& matrixA,
+                                const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>& matrixB,
+                                const Parameters& params, double deadlineSeconds) {
+    std::ostringstream text;
+    params.writeValues(text);
+    const std::string parameters = text.str();
+
+    SolveRequestHeader header{};
+    std::memcpy(header.magic, kSolveRequestMagic, sizeof(header.magic));
+    header.version = kSolverProtocolVersion;
+    header.scalarType = Eigen::NumTraits<Scalar>::IsComplex ? kBinaryScalarComplex : kBinaryScalarReal;
+    header.rows = static_cast<std::uint64_t>(matrixA.rows());
+    header.cols = static_cast<std::uint64_t>(matrixA.cols());
+    header.rowsB = static_cast<std::uint64_t>(matrixB.rows());
+    header.deadlineMillis = deadlineSeconds > 0 ? static_cast<std::uint32_t>(std::max(1.0, std::ceil(deadlineSeconds * 1e3))) : 0;
+    header.parameterBytes = static_cast<std::uint32_t>(parameters.size());
+
+    const std::size_t bytesA = sizeof(Scalar) * static_cast<std::size_t>(matrixA.size());
+    const std::size_t bytesB = sizeof(Scalar) * static_cast<std::size_t>(matrixB.size());
+    std::vector<char> message(sizeof(header) + parameters.size() + bytesA + bytesB);
+    char* out = message.data();
+    std::memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+    std::memcpy(out, parameters.data(), parameters.size());
+    out += parameters.size();
+    if (bytesA > 0) std::memcpy(out, matrixA.data(), bytesA);
+    if (bytesB > 0) std::memcpy(out + bytesA, matrixB.data(), bytesB);
+    return message;
+}
+
+template<typename Scalar>
+std::vector<char> encodeReply(const SolveReply<Scalar>& reply) {
+    const bool ok = reply.status == SolveStatus::Ok;
+    const SolveResult<Scalar>& result = reply.result;
+
+    SolveReplyHeader header{};
+    std::memcpy(header.magic, kSolveReplyMagic, sizeof(header.magic));
+    header.status = static_cast<std::uint32_t>(reply.status);
+    header.scalarType = Eigen::NumTraits<Scalar>::IsComplex ? kBinaryScalarComplex : kBinaryScalarReal;
+    header.count = ok ? static_cast<std::uint64_t>(result.eigenvalues.size()) : 0;
+    header.rows = ok ? static_cast<std::uint64_t>(result.eigenvectors.rows()) : 0;
+    header.vectorCount = ok ? static_cast<std::uint64_t>(result.eigenvectors.cols()) : 0;
+    header.iterations = result.iterations;
+    header.converged = result.converged ? 1 : 0;
+    header.solveMicros = static_cast<std::uint32_t>(std::min(result.solveSeconds * 1e6, 4e9));
+    header.queueMicros = static_cast<std::uint32_t>(std::min(reply.queueSeconds * 1e6, 4e9));
+    header.messageBytes = static_cast<std::uint32_t>(reply.message.size());
+    header.flags = ok && result.single ? kReplySinglePair : 0;
+
+    const std::size_t valueBytes = sizeof(Scalar) * header.count;
+    const std::size_t vectorBytes = sizeof(Scalar) * header.rows * header.vectorCount;
+    std::vector<char> message(sizeof(header) + reply.message.size() + valueBytes + vectorBytes);
+    char* out = message.data();
+    std::memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+    std::memcpy(out, reply.message.data(), reply.message.size());
+    out += reply.message.size();
+    if (valueBytes > 0) std::memcpy(out, result.eigenvalues.data(), valueBytes);
+    if (vectorBytes > 0) std::memcpy(out + valueBytes, result.eigenvectors.data(), vectorBytes);
+    return message;
+}
+
+template std::vector<char> encodeRequest<double>(const Eigen::MatrixXd&, const Eigen::MatrixXd&, const Parameters&,
+                                                 double);
+template std::vector<char> encodeRequest<std::complex<double>>(const Eigen::MatrixXcd&, const Eigen::MatrixXcd&,
+                                                               const Parameters&, double);
+template std::vector<char> encodeReply<double>(const SolveReply<double>&);
+template std::vector<char> encodeReply<std::complex<double>>(const SolveReply<std::complex<double>>&);
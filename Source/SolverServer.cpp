@@ -0,0 +1,306 @@
+#include "SolverServer.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <stdexcept>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+void sendStatus(int socket, SolveStatus status, const std::string& message) {
+    SolveReply<double> reply;
+    reply.status = status;
+    reply.message = message;
+    std::vector<char> bytes = encodeReply(reply);
+    sendFully(socket, bytes.data(), bytes.size());
+}
+
+// Reads and drops the body of a refused request, a block at a time, so that the connection stays usable
+void discardFully(int socket, std::uint64_t bytes) {
+    char block[65536];
+    while (bytes > 0) {
+        std::size_t size = static_cast<std::size_t>(std::min<std::uint64_t>(bytes, sizeof(block)));
+        if (!receiveFully(socket, block, size)) {
+            throw std::runtime_error("Solver socket: connection closed in the middle of a message");
+        }
+        bytes -= size;
+    }
+}
+
+// A place among the pending requests, given back when the request ends before reaching the pool
+class PendingSlot {
+public:
+    explicit PendingSlot(std::atomic<std::size_t>& pending) : mPending(pending), mHeld(true) {}
+    ~PendingSlot() {
+        if (mHeld) mPending--;
+    }
+    PendingSlot(const PendingSlot&) = delete;
+    PendingSlot& operator=(const PendingSlot&) = delete;
+
+    // The task submitted to the pool gives the place back when it ends
+    void handOver() { mHeld = false; }
+
+private:
+    std::atomic<std::size_t>& mPending;
+    bool mHeld;
+};
+
+// A request solved on the pool; shared by the connection thread and the task, which may outlive the wait
+template<typename Scalar>
+struct PendingSolve {
+    Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> matrixA, matrixB;
+    Parameters params;
+    Clock::time_point received, deadline;
+    bool hasDeadline = false;
+    SolveReply<Scalar> reply;
+    std::promise<void> done;
+};
+
+}
+
+SolverServer::SolverServer(const ServerOptions& options)
+    : mOptions(options), mPath(unixSocketPath(options.address)), mListener(-1), mWakeup{-1, -1}, mStopping(false),
+      mPool(options.workers), mPending(0), mConnectionCount(0), mRequests(0), mSolved(0), mFailed(0), mRejected(0),
+      mExpired(0), mCached(0) {
+    if (!mOptions.cacheDirectory.empty()) {
+        mCache.reset(new ResultCache(mOptions.cacheDirectory, mOptions.cacheBytes));
+    }
+    mListener = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (mListener < 0) {
+        throw std::runtime_error(std::string("Solver server: cannot create a socket (") + std::strerror(errno) + ")");
+    }
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, mPath.c_str(), sizeof(address.sun_path) - 1);
+    ::unlink(mPath.c_str());
+    if (::bind(mListener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(mListener, 128) != 0 || ::pipe(mWakeup) != 0) {
+        std::string error = std::strerror(errno);
+        ::close(mListener);
+        throw std::runtime_error("Solver server: cannot listen on " + mPath + " (" + error + ")");
+    }
+}
+
+SolverServer::~SolverServer() {
+    stop();
+    ::close(mListener);
+    // Wakes the connection threads blocked in recv(); each socket is closed once its thread is gone
+    std::lock_guard<std::mutex> lock(mConnectionsMutex);
+    for (Connection& connection : mConnections) ::shutdown(connection.socket, SHUT_RDWR);
+    for (Connection& connection : mConnections) {
+        connection.thread.join();
+        ::close(connection.socket);
+    }
+    mConnections.clear();
+    mPool.wait();
+    ::close(mWakeup[0]);
+    ::close(mWakeup[1]);
+    ::unlink(mPath.c_str());
+}
+
+void SolverServer::serve() {
+    pollfd sources[2] = {{mListener, POLLIN, 0}, {mWakeup[0], POLLIN, 0}};
+    while (!mStopping) {
+        if (::poll(sources, 2, -1) < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error(std::string("Solver server: poll failed (") + std::strerror(errno) + ")");
+        }
+        if (mStopping || sources[1].revents != 0) break;
+        if ((sources[0].revents & POLLIN) == 0) continue;
+
+        int socket = ::accept4(mListener, nullptr, nullptr, SOCK_CLOEXEC);
+        if (socket < 0) continue;
+        mConnectionCount++;
+        reapConnections();
+        std::lock_guard<std::mutex> lock(mConnectionsMutex);
+        // Beyond the limit, no thread is started: Busy, then the connection is closed
+        if (mConnections.size() >= mOptions.maxConnections) {
+            mRejected++;
+            try {
+                sendStatus(socket, SolveStatus::Busy,
+                           "Server busy: " + std::to_string(mOptions.maxConnections) + " connections open");
+            } catch (const std::exception&) {
+            }
+            ::close(socket);
+            continue;
+        }
+        mConnections.emplace_back();
+        Connection& connection = mConnections.back();
+        connection.socket = socket;
+        connection.thread = std::thread(&SolverServer::serveConnection, this, std::ref(connection));
+    }
+}
+
+void SolverServer::stop() {
+    mStopping = true;
+    const char byte = 0;
+    ssize_t written = ::write(mWakeup[1], &byte, 1);
+    (void)written;
+}
+
+ServerStats SolverServer::stats() const {
+    ServerStats stats;
+    stats.connections = mConnectionCount;
+    stats.requests = mRequests;
+    stats.solved = mSolved;
+    stats.failed = mFailed;
+    stats.rejected = mRejected;
+    stats.expired = mExpired;
+    stats.cached = mCached;
+    return stats;
+}
+
+void SolverServer::reapConnections() {
+    std::lock_guard<std::mutex> lock(mConnectionsMutex);
+    for (auto it = mConnections.begin(); it != mConnections.end();) {
+        if (it->done) {
+            it->thread.join();
+            ::close(it->socket);
+            it = mConnections.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void SolverServer::serveConnection(Connection& connection) {
+    try {
+        SolveRequestHeader header;
+        while (!mStopping && receiveFully(connection.socket, &header, sizeof(header))) {
+            mRequests++;
+            if (std::memcmp(header.magic, kSolveRequestMagic, sizeof(header.magic)) != 0 ||
+                header.version != kSolverProtocolVersion) {
+                mFailed++;
+                sendStatus(connection.socket, SolveStatus::Failed, "Not a solver request of version " +
+                                                                       std::to_string(kSolverProtocolVersion));
+                break;
+            }
+            bool keep;
+            if (header.scalarType == kBinaryScalarReal) {
+                keep = answer<double>(connection.socket, header);
+            } else if (header.scalarType == kBinaryScalarComplex) {
+                keep = answer<std::complex<double>>(connection.socket, header);
+            } else {
+                mFailed++;
+                sendStatus(connection.socket, SolveStatus::Failed, "Unknown scalar type");
+                keep = false;
+            }
+            if (!keep) break;
+        }
+    } catch (const std::exception&) {
+        // The client is gone or sent a truncated request: only this connection is dropped
+    }
+    connection.done = true;
+}
+
+template<typename Scalar>
+bool SolverServer::answer(int socket, const SolveRequestHeader& header) {
+    const Clock::time_point received = Clock::now();
+
+    // Sizes are checked before anything is allocated: the body of a refused request is not read
+    const std::uint64_t limit = std::uint64_t(1) << 31;
+    bool fits = header.rows < limit && header.cols < limit && header.rowsB < limit &&
+                header.parameterBytes <= mOptions.maxRequestBytes;
+    if (fits) {
+        std::uint64_t elements = header.rows * header.cols + header.rowsB * header.rowsB;
+        fits = elements <= (mOptions.maxRequestBytes - header.parameterBytes) / sizeof(Scalar);
+    }
+    if (!fits) {
+        mFailed++;
+        sendStatus(socket, SolveStatus::Failed,
+                   "Request too large (limit " + std::to_string(mOptions.maxRequestBytes) + " bytes)");
+        return false;
+    }
+
+    // Admission before anything is allocated or read: the memory held by the requests is bounded by maxPending
+    if (mPending.fetch_add(1) >= mOptions.maxPending) {
+        mPending--;
+        mRejected++;
+        discardFully(socket, header.parameterBytes +
+                             sizeof(Scalar) * (header.rows * header.cols + header.rowsB * header.rowsB));
+        sendStatus(socket, SolveStatus::Busy,
+                   "Server busy: " + std::to_string(mOptions.maxPending) + " requests pending");
+        return true;
+    }
+    PendingSlot slot(mPending);
+
+    auto job = std::make_shared<PendingSolve<Scalar>>();
+    std::string parameterText(header.parameterBytes, '\0');
+    job->matrixA.resize(static_cast<Eigen::Index>(header.rows), static_cast<Eigen::Index>(header.cols));
+    job->matrixB.resize(static_cast<Eigen::Index>(header.rowsB), static_cast<Eigen::Index>(header.rowsB));
+    if (!receiveFully(socket, &parameterText[0], parameterText.size()) && !parameterText.empty()) return false;
+    if (job->matrixA.size() > 0 && !receiveFully(socket, job->matrixA.data(), sizeof(Scalar) * job->matrixA.size())) {
+        return false;
+    }
+    if (job->matrixB.size() > 0 && !receiveFully(socket, job->matrixB.data(), sizeof(Scalar) * job->matrixB.size())) {
+        return false;
+    }
+
+    try {
+        job->params = parseParameterText(parameterText);
+    } catch (const std::exception& e) {
+        mFailed++;
+        sendStatus(socket, SolveStatus::Failed, std::string("Invalid parameters: ") + e.what());
+        return true;
+    }
+    job->params.setThreads(mOptions.solverThreads);
+    job->received = received;
+    double deadlineSeconds = header.deadlineMillis > 0 ? header.deadlineMillis * 1e-3 : mOptions.defaultDeadlineSeconds;
+    job->hasDeadline = deadlineSeconds > 0;
+    if (job->hasDeadline) {
+        job->deadline = received + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(deadlineSeconds));
+    }
+
+    std::future<void> done = job->done.get_future();
+    mPool.submit([this, job] {
+        Clock::time_point start = Clock::now();
+        job->reply.queueSeconds = std::chrono::duration<double>(start - job->received).count();
+        if (job->hasDeadline && start >= job->deadline) {
+            job->reply.status = SolveStatus::DeadlineExceeded;
+            job->reply.message = "Deadline passed before a worker was free";
+        } else {
+            try {
+                if (!job->params.validate()) {
+                    throw std::runtime_error("Invalid parameters");
+                }
+                if (mCache) {
+                    bool hit = false;
+                    job->reply.result = mCache->solve(job->matrixA, job->matrixB, job->params, &hit);
+                    mCached += hit;
+                } else {
+                    job->reply.result = solveProblem<Scalar>(job->matrixA, job->matrixB, job->params);
+                }
+                job->reply.status = SolveStatus::Ok;
+            } catch (const std::exception& e) {
+                job->reply.status = SolveStatus::Failed;
+                job->reply.message = e.what();
+            }
+        }
+        mPending--;
+        job->done.set_value();
+    });
+    slot.handOver();
+
+    if (job->hasDeadline && done.wait_until(job->deadline) != std::future_status::ready) {
+        mExpired++;
+        sendStatus(socket, SolveStatus::DeadlineExceeded, "Deadline passed while solving");
+        return true;
+    }
+    done.wait();
+
+    switch (job->reply.status) {
+        case SolveStatus::Ok: mSolved++; break;
+        case SolveStatus::DeadlineExceeded: mExpired++; break;
+        default: mFailed++; break;
+    }
+    std::vector<char> reply = encodeReply(job->reply);
+    sendFully(socket, reply.data(), reply.size());
+    return true;
+}
+
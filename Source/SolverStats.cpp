@@ -0,0 +1,57 @@
+#include "SolverStats.h"
+
+SolverStats& SolverStats::operator+=(const SolverStats& other) {
+    setupSeconds += other.setupSeconds;
+    factorizationSeconds += other.factorizationSeconds;
+    iterationSeconds += other.iterationSeconds;
+    extractionSeconds += other.extractionSeconds;
+    matrixVectorProducts += other.matrixVectorProducts;
+    solves += other.solves;
+    factorizations += other.factorizations;
+    flops += other.flops;
+    bytesAllocated += other.bytesAllocated;
+    return *this;
+}
+
+double SolverStats::totalSeconds() const {
+    return setupSeconds + factorizationSeconds + iterationSeconds + extractionSeconds;
+}
+
+std::vector<std::pair<std::string, double>> SolverStats::fields() const {
+    return {{"SetupSeconds", setupSeconds},
+            {"FactorizationSeconds", factorizationSeconds},
+            {"IterationSeconds", iterationSeconds},
+            {"ExtractionSeconds", extractionSeconds},
+            {"MatrixVectorProducts", double(matrixVectorProducts)},
+            {"Solves", double(solves)},
+            {"Factorizations", double(factorizations)},
+            {"EstimatedFlops", flops},
+            {"BytesAllocated", double(bytesAllocated)},
+            {"Residual", residual}};
+}
+
+void printStats(std::ostream& out, const SolverStats& stats) {
+    out << "Time: " << stats.totalSeconds() << " s (setup " << stats.setupSeconds << " s, factorization "
+        << stats.factorizationSeconds << " s, iterations " << stats.iterationSeconds << " s, extraction "
+        << stats.extractionSeconds << " s)" << std::endl;
+    out << "Operations: " << stats.matrixVectorProducts << " matrix-vector products, " << stats.solves
+        << " solves, " << stats.factorizations << " factorizations, ~" << stats.flops / 1e9 << " GFLOP";
+    if (stats.totalSeconds() > 0) out << " (" << stats.flops / 1e9 / stats.totalSeconds() << " GFLOP/s)";
+    out << std::endl;
+    out << "Memory: ~" << stats.bytesAllocated / 1024.0 << " KiB allocated" << std::endl;
+    out << "Residual: " << stats.residual << std::endl;
+}
+
+PhaseTimer::PhaseTimer(double& seconds)
+    : mSeconds(seconds), mStart(std::chrono::steady_clock::now()), mRunning(true) {}
+
+PhaseTimer::~PhaseTimer() {
+    stop();
+}
+
+void PhaseTimer::stop() {
+    if (mRunning) {
+        mSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - mStart).count();
+        mRunning = false;
+    }
+}
@@ -0,0 +1,93 @@
+#include "StreamingMatrix.h"
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+// Seconds elapsed since `start`
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Constructor
+template<typename Scalar>
+StreamingMatrix<Scalar>::StreamingMatrix(PanelSource<Scalar>& source) : mSource(source) {}
+
+template<typename Scalar>
+void StreamingMatrix<Scalar>::multiply(const Matrix& X, Matrix& Y) {
+    if (X.rows() != mSource.cols()) {
+        throw std::runtime_error("StreamingMatrix: block size does not match the matrix");
+    }
+    Y.resize(mSource.rows(), X.cols());
+
+    // Slot k % 2 holds panel k once `filled[k % 2]` is set; `first` is -1 after the last panel
+    std::mutex mutex;
+    std::condition_variable changed;
+    bool filled[2] = {false, false};
+    long first[2] = {-1, -1};
+    std::exception_ptr failure;
+    double readSeconds = 0.0;
+
+    mSource.rewind();
+    std::thread prefetch([&]() {
+        for (int k = 0;; ++k) {
+            const int slot = k % 2;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                changed.wait(lock, [&]() { return !filled[slot]; });
+            }
+            long row = -1;
+            auto start = std::chrono::steady_clock::now();
+            try {
+                row = mSource.nextPanel(mBuffers[slot]);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                failure = std::current_exception();
+            }
+            readSeconds += secondsSince(start);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                first[slot] = row;
+                filled[slot] = true;
+            }
+            changed.notify_all();
+            if (row < 0) return;
+        }
+    });
+
+    for (int k = 0;; ++k) {
+        const int slot = k % 2;
+        long row;
+        {
+            auto start = std::chrono::steady_clock::now();
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [&]() { return filled[slot]; });
+            mTimings.stallSeconds += secondsSince(start);
+            row = first[slot];
+        }
+        if (row < 0) break;
+
+        auto start = std::chrono::steady_clock::now();
+        const Matrix& panel = mBuffers[slot];
+        Y.middleRows(row, panel.rows()).noalias() = panel * X;
+        mTimings.computeSeconds += secondsSince(start);
+        mTimings.panels++;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            filled[slot] = false;
+        }
+        changed.notify_all();
+    }
+    prefetch.join();
+
+    mTimings.readSeconds += readSeconds;
+    mTimings.products++;
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
+
+template class StreamingMatrix<double>;
+template class StreamingMatrix<std::complex<double>>;
@@ -0,0 +1,161 @@
+#include "StreamingPowerMethod.h"
+#include <Eigen/Eigenvalues>
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+// Converts a Ritz value or vector entry to the scalar type of the solver (real part for real matrices)
+template<typename Scalar>
+static Scalar fromComplex(const std::complex<double>& value) {
+    if constexpr (std::is_same<Scalar, double>::value) {
+        return value.real();
+    } else {
+        return value;
+    }
+}
+
+// Constructor
+template<typename Scalar>
+StreamingPowerMethod<Scalar>::StreamingPowerMethod(StreamingMatrix<Scalar>& matrix, const Parameters& params)
+    : mMatrix(matrix),
+      mMaxIteration(params.getMaxIterations()),
+      mTolerance(params.getTolerance()),
+      mBlockSize(params.getNumValues()),
+      mConverged(false),
+      mIterationCount(0) {}
+
+template<typename Scalar>
+void StreamingPowerMethod<Scalar>::solve() {
+    if (mMatrix.rows() != mMatrix.cols()) {
+        throw std::runtime_error("StreamingPowerMethod requires a square matrix");
+    }
+    if (mBlockSize < 1 || mBlockSize > mMatrix.rows()) {
+        throw std::runtime_error("StreamingPowerMethod: the block size must lie between 1 and the matrix size");
+    }
+    mConverged = false;
+    if (mBlockSize == 1) {
+        solveVector();
+    } else {
+        solveBlock();
+    }
+}
+
+template<typename Scalar>
+void StreamingPowerMethod<Scalar>::solveVector() {
+    const long n = mMatrix.rows();
+    Matrix b_k = Matrix::Random(n, 1);
+    b_k.normalize();
+
+    Matrix b_k1;
+    Scalar lambda_k = 0.0;
+
+    for (mIterationCount = 1; mIterationCount <= mMaxIteration; ++mIterationCount) {
+        mMatrix.multiply(b_k, b_k1);
+
+        Eigen::Index max_idx, col;
+        b_k1.cwiseAbs2().maxCoeff(&max_idx, &col);
+        Scalar lambda_k_plus_1 = b_k1(max_idx, 0) / b_k(max_idx, 0);
+
+        b_k = b_k1.normalized();
+        if (std::abs(lambda_k_plus_1 - lambda_k) < mTolerance) {
+            mConverged = true;
+            lambda_k = lambda_k_plus_1;
+            break;
+        }
+        lambda_k = lambda_k_plus_1;
+    }
+
+    if (!mConverged) {
+        std::cerr << "StreamingPowerMethod failed to converge after " << mMaxIteration << " iterations." << std::endl;
+        mIterationCount = mMaxIteration;
+    }
+    mEigenvalues = Vector::Constant(1, lambda_k);
+    mEigenvectors = b_k;
+}
+
+template<typename Scalar>
+void StreamingPowerMethod<Scalar>::solveBlock() {
+    const long n = mMatrix.rows();
+    const int b = mBlockSize;
+
+    // Orthonormal start block
+    Matrix X = Matrix::Random(n, b);
+    X = Eigen::HouseholderQR<Matrix>(X).householderQ() * Matrix::Identity(n, b);
+
+    Matrix Y, H;
+    Eigen::VectorXcd previous = Eigen::VectorXcd::Zero(b);
+    Eigen::VectorXcd theta;
+    Eigen::MatrixXcd W;
+
+    for (mIterationCount = 1; mIterationCount <= mMaxIteration; ++mIterationCount) {
+        if (mIterationCount > 1) {
+            X = Eigen::HouseholderQR<Matrix>(Y).householderQ() * Matrix::Identity(n, b);
+        }
+        mMatrix.multiply(X, Y);
+
+        // Rayleigh-Ritz on span(X), sorted by decreasing magnitude
+        H.noalias() = X.adjoint() * Y;
+        Eigen::ComplexEigenSolver<Eigen::MatrixXcd> ritz(H.template cast<std::complex<double>>());
+        std::vector<int> order(b);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](int i, int j) {
+            return std::abs(ritz.eigenvalues()(i)) > std::abs(ritz.eigenvalues()(j));
+        });
+        theta.resize(b);
+        W.resize(b, b);
+        for (int k = 0; k < b; ++k) {
+            theta(k) = ritz.eigenvalues()(order[k]);
+            W.col(k) = ritz.eigenvectors().col(order[k]);
+        }
+
+        if ((theta - previous).cwiseAbs().maxCoeff() < mTolerance) {
+            mConverged = true;
+            break;
+        }
+        previous = theta;
+    }
+
+    if (!mConverged) {
+        std::cerr << "StreamingPowerMethod failed to converge after " << mMaxIteration << " iterations." << std::endl;
+        mIterationCount = mMaxIteration;
+    }
+
+    // Ritz vectors X W, X being the block of the last product
+    Eigen::MatrixXcd vectors = X.template cast<std::complex<double>>() * W;
+    mEigenvalues.resize(b);
+    mEigenvectors.resize(n, b);
+    bool complexPair = false;
+    for (int k = 0; k < b; ++k) {
+        // Rotate the vector so that its largest entry is real before dropping imaginary parts
+        Eigen::Index largest;
+        vectors.col(k).cwiseAbs2().maxCoeff(&largest);
+        vectors.col(k) *= std::conj(vectors(largest, k)) / std::abs(vectors(largest, k));
+
+        mEigenvalues(k) = fromComplex<Scalar>(theta(k));
+        complexPair = complexPair || std::abs(theta(k) - std::complex<double>(mEigenvalues(k))) > mTolerance;
+        for (long i = 0; i < n; ++i) mEigenvectors(i, k) = fromComplex<Scalar>(vectors(i, k));
+        mEigenvectors.col(k).normalize();
+    }
+    if (complexPair) {
+        std::cerr << "StreamingPowerMethod: complex Ritz values on a real matrix, only their real parts are kept." << std::endl;
+    }
+}
+
+template<typename Scalar>
+void StreamingPowerMethod<Scalar>::reportTimings(std::ostream& out) const {
+    const StreamingTimings& timings = mMatrix.getTimings();
+    out << "\nPasses  panels  read [s]  compute [s]  stall [s]" << std::endl;
+    out << std::setw(6) << timings.products << std::setw(8) << timings.panels
+        << std::setw(10) << std::fixed << std::setprecision(4) << timings.readSeconds
+        << std::setw(13) << timings.computeSeconds
+        << std::setw(11) << timings.stallSeconds << std::endl;
+    out.unsetf(std::ios::floatfield);
+    out << std::setprecision(6);
+}
+
+template class StreamingPowerMethod<double>;
+template class StreamingPowerMethod<std::complex<double>>;
@@ -0,0 +1,464 @@
+#include "TextMatrixParser.h"
+#include "Decompressor.h"
+#include "Parallel.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <iomanip>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+// Characters separating two values of a row
+static inline bool isSeparator(char c) {
+    return c == ',' || c == ';' || c == ' ' || c == '\t' || c == '\r';
+}
+
+// Reads a real number, with an optional leading '+' (std::from_chars does not accept it); null on failure
+static inline const char* readValue(const char* cursor, const char* end, double& value) {
+    if (cursor < end && *cursor == '+') ++cursor;
+    std::from_chars_result result = std::from_chars(cursor, end, value);
+    return result.ec == std::errc() ? result.ptr : nullptr;
+}
+
+// Imaginary unit: 'i' or 'j' not followed by a letter ("inf" is a number)
+static inline bool isImaginaryUnit(const char* cursor, const char* end) {
+    return cursor < end && (*cursor == 'i' || *cursor == 'j') &&
+           (cursor + 1 == end || !std::isalpha(static_cast<unsigned char>(cursor[1])));
+}
+
+// Signed coefficient of a complex literal; a lone sign before the imaginary unit means 1
+static inline const char* readCoefficient(const char* cursor, const char* end, double& value) {
+    double sign = 1.0;
+    if (cursor < end && (*cursor == '+' || *cursor == '-')) {
+        sign = *cursor == '-' ? -1.0 : 1.0;
+        ++cursor;
+    }
+    if (isImaginaryUnit(cursor, end)) {
+        value = sign;
+        return cursor;
+    }
+    std::from_chars_result result = std::from_chars(cursor, end, value);
+    if (result.ec != std::errc()) return nullptr;
+    value *= sign;
+    return result.ptr;
+}
+
+static inline const char* skipBlanks(const char* cursor, const char* end) {
+    while (cursor < end && (*cursor == ' ' || *cursor == '\t')) ++cursor;
+    return cursor;
+}
+
+// Reads a complex literal: "a", "a+bi", "a-bj", "bi", "-i" or "(a,b)"; null on failure, never throws
+static const char* readValue(const char* cursor, const char* end, std::complex<double>& value) {
+    double real = 0.0, imag = 0.0;
+    if (cursor < end && *cursor == '(') {
+        cursor = readValue(skipBlanks(cursor + 1, end), end, real);
+        if (!cursor) return nullptr;
+        cursor = skipBlanks(cursor, end);
+        if (cursor == end || *cursor != ',') return nullptr;
+        cursor = readValue(skipBlanks(cursor + 1, end), end, imag);
+        if (!cursor) return nullptr;
+        cursor = skipBlanks(cursor, end);
+        if (cursor == end || *cursor != ')') return nullptr;
+        value = std::complex<double>(real, imag);
+        return cursor + 1;
+    }
+
+    cursor = readCoefficient(cursor, end, real);
+    if (!cursor) return nullptr;
+    if (isImaginaryUnit(cursor, end)) {
+        value = std::complex<double>(0.0, real);
+        return cursor + 1;
+    }
+    if (cursor < end && (*cursor == '+' || *cursor == '-')) {
+        cursor = readCoefficient(cursor, end, imag);
+        if (!cursor || !isImaginaryUnit(cursor, end)) return nullptr;
+        ++cursor;
+    }
+    value = std::complex<double>(real, imag);
+    return cursor;
+}
+
+// Stores a row given as real/imaginary column pairs
+template<typename Scalar, typename Row>
+static void storePairs(Row&& row, const double* values) {
+    if constexpr (Eigen::NumTraits<Scalar>::IsComplex) {
+        for (Eigen::Index j = 0; j < row.size(); ++j) {
+            row(j) = Scalar(values[2 * j], values[2 * j + 1]);
+        }
+    }
+}
+
+// Removes blanks at both ends
+static std::string_view trimmed(std::string_view text) {
+    std::size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string_view::npos) return {};
+    std::size_t last = text.find_last_not_of(" \t\r");
+    return text.substr(first, last - first + 1);
+}
+
+namespace {
+
+// Rows and section markers found in one chunk of the file
+struct ChunkIndex {
+    std::vector<std::size_t> rows;
+    // Number of rows seen before each "MatrixB" line
+    std::vector<std::size_t> matrixB;
+    // Offset of the "Algorithm" line, if the chunk holds it (the scan stops there)
+    std::size_t parameters = std::string_view::npos;
+    std::size_t rowsBeforeParameters = 0;
+};
+
+// Scans the lines in [begin, end), looking at their first character
+void indexChunk(const char* data, std::size_t begin, std::size_t end, ChunkIndex& chunk) {
+    std::size_t position = begin;
+    while (position < end) {
+        const char* newline = static_cast<const char*>(std::memchr(data + position, '\n', end - position));
+        std::size_t lineEnd = newline ? static_cast<std::size_t>(newline - data) : end;
+
+        std::size_t first = position;
+        while (first < lineEnd && (data[first] == ' ' || data[first] == '\t' || data[first] == '\r')) ++first;
+        position = lineEnd + 1;
+        if (first == lineEnd) continue;
+
+        if (std::isalpha(static_cast<unsigned char>(data[first]))) {
+            std::string_view line(data + first, lineEnd - first);
+            if (line.find("Algorithm") != std::string_view::npos) {
+                chunk.parameters = first;
+                chunk.rowsBeforeParameters = chunk.rows.size();
+                return;
+            }
+            if (line.compare(0, 7, "MatrixB") == 0) {
+                chunk.matrixB.push_back(chunk.rows.size());
+                continue;
+            }
+        }
+        chunk.rows.push_back(first);
+    }
+}
+
+// Runs task(t) for t in [0, workers), on the calling thread alone when there is one worker
+void runWorkers(int workers, const std::function<void(int)>& task) {
+    if (workers <= 1) {
+        task(0);
+        return;
+    }
+    ThreadPool pool(workers);
+    pool.run(task);
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Appends the rows of the chunks to their section in file order, up to the parameter section
+void mergeChunks(const std::vector<ChunkIndex>& chunks, std::vector<std::size_t>& rowsA, std::vector<std::size_t>& rowsB,
+                 std::size_t& parametersOffset) {
+    std::vector<std::size_t>* rows = &rowsA;
+    for (const ChunkIndex& chunk : chunks) {
+        std::size_t last = chunk.parameters != std::string_view::npos ? chunk.rowsBeforeParameters : chunk.rows.size();
+        std::size_t copied = 0;
+        for (std::size_t marker : chunk.matrixB) {
+            rows->insert(rows->end(), chunk.rows.begin() + copied, chunk.rows.begin() + marker);
+            copied = marker;
+            rows = &rowsB;
+        }
+        rows->insert(rows->end(), chunk.rows.begin() + copied, chunk.rows.begin() + last);
+        if (chunk.parameters != std::string_view::npos) {
+            parametersOffset = chunk.parameters;
+            break;
+        }
+    }
+}
+
+} // namespace
+
+// Constructor: a plain file is mapped and its chunks are indexed in parallel, a compressed one is indexed as
+// it is decompressed
+TextMatrixParser::TextMatrixParser(const std::string& filename, int threads)
+    : mData(nullptr), mSize(0), mParametersOffset(0), mThreads(threads < 1 ? defaultThreadCount() : threads) {
+    auto start = std::chrono::steady_clock::now();
+    if (detectCompression(filename) != Compression::None) {
+        loadCompressed(filename);
+        mTimings.indexSeconds = secondsSince(start);
+        return;
+    }
+
+    mFile = MappedFile(filename);
+    mData = mFile.data();
+    mSize = mFile.size();
+    mFile.advise(MappedFile::Access::Sequential);
+    indexText();
+    mTimings.indexSeconds = secondsSince(start);
+}
+
+// Constructor: a document already in memory, e.g. one of the documents of a stream
+TextMatrixParser::TextMatrixParser(std::vector<char> text, int threads)
+    : mBuffer(std::move(text)), mData(mBuffer.data()), mSize(mBuffer.size()), mParametersOffset(0),
+      mThreads(threads < 1 ? defaultThreadCount() : threads) {
+    auto start = std::chrono::steady_clock::now();
+    indexText();
+    mTimings.indexSeconds = secondsSince(start);
+}
+
+void TextMatrixParser::indexText() {
+    const char* data = mData;
+    const std::size_t size = mSize;
+    mParametersOffset = size;
+
+    // Chunk boundaries, moved to the start of the next line
+    const int workers = workersFor(size);
+    std::vector<std::size_t> bounds(workers + 1, size);
+    bounds[0] = 0;
+    for (int t = 1; t < workers; ++t) {
+        std::size_t position = std::max(bounds[t - 1], size / workers * t);
+        const void* newline = position < size ? std::memchr(data + position, '\n', size - position) : nullptr;
+        bounds[t] = newline ? static_cast<const char*>(newline) - data + 1 : size;
+    }
+
+    std::vector<ChunkIndex> chunks(workers);
+    runWorkers(workers, [&](int t) { indexChunk(data, bounds[t], bounds[t + 1], chunks[t]); });
+    mergeChunks(chunks, mRowsA, mRowsB, mParametersOffset);
+}
+
+// The chunks of decompressed text are appended to the buffer and their complete lines are indexed while the
+// background thread decompresses the next ones
+void TextMatrixParser::loadCompressed(const std::string& filename) {
+    Decompressor input(filename);
+    mBuffer.reserve(input.sizeHint());
+
+    std::vector<ChunkIndex> index(1);
+    std::size_t indexed = 0;
+    std::vector<char> chunk;
+    while (input.next(chunk)) {
+        mBuffer.insert(mBuffer.end(), chunk.begin(), chunk.end());
+        if (index[0].parameters != std::string_view::npos) continue;
+        std::size_t lineEnd = mBuffer.size();
+        while (lineEnd > indexed && mBuffer[lineEnd - 1] != '\n') --lineEnd;
+        if (lineEnd > indexed) {
+            indexChunk(mBuffer.data(), indexed, lineEnd, index[0]);
+            indexed = lineEnd;
+        }
+    }
+    if (index[0].parameters == std::string_view::npos) {
+        indexChunk(mBuffer.data(), indexed, mBuffer.size(), index[0]);
+    }
+
+    mData = mBuffer.data();
+    mSize = mBuffer.size();
+    mParametersOffset = mSize;
+    mergeChunks(index, mRowsA, mRowsB, mParametersOffset);
+    mTimings.compressedBytes = input.compressedSize();
+}
+
+int TextMatrixParser::workersFor(std::size_t bytes) const {
+    std::size_t chunks = std::max<std::size_t>(1, bytes / kMinimumChunkBytes);
+    return static_cast<int>(std::min<std::size_t>(mThreads, chunks));
+}
+
+const std::vector<std::size_t>& TextMatrixParser::rowOffsets(Section section) const {
+    return section == Section::A ? mRowsA : mRowsB;
+}
+
+long TextMatrixParser::rows(Section section) const {
+    return static_cast<long>(rowOffsets(section).size());
+}
+
+long TextMatrixParser::cols(Section section) const {
+    const std::vector<std::size_t>& offsets = rowOffsets(section);
+    return offsets.empty() ? 0 : parseLine<double>(offsets[0], nullptr, 0, 0);
+}
+
+template<typename Value>
+long TextMatrixParser::parseLine(std::size_t offset, Value* values, long capacity, long row) const {
+    const char* cursor = mData + offset;
+    const char* end = mData + mSize;
+    long count = 0;
+
+    while (cursor < end && *cursor != '\n') {
+        if (isSeparator(*cursor)) {
+            ++cursor;
+            continue;
+        }
+        const char* token = cursor;
+        Value value;
+        cursor = readValue(cursor, end, value);
+        // A complex literal must end with its token; the rest of a real token is ignored, as std::stod did
+        if (cursor && std::is_same<Value, std::complex<double>>::value && cursor < end && *cursor != '\n' &&
+            !isSeparator(*cursor)) {
+            cursor = nullptr;
+        }
+        if (!cursor) {
+            const char* tokenEnd = token;
+            while (tokenEnd < end && *tokenEnd != '\n' && !isSeparator(*tokenEnd)) ++tokenEnd;
+            throw std::runtime_error("Invalid value '" + std::string(token, tokenEnd) + "' in matrix row " +
+                                     std::to_string(row));
+        }
+        if (count < capacity) {
+            values[count] = value;
+        }
+        ++count;
+        while (cursor < end && *cursor != '\n' && !isSeparator(*cursor)) ++cursor;
+    }
+    return count;
+}
+
+template<typename Scalar>
+Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> TextMatrixParser::parse(Section section, long firstRow,
+                                                                              long rowCount) {
+    using Matrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+    using Value = typename std::conditional<Eigen::NumTraits<Scalar>::IsComplex, std::complex<double>, double>::type;
+    auto start = std::chrono::steady_clock::now();
+    const std::vector<std::size_t>& offsets = rowOffsets(section);
+    const long total = static_cast<long>(offsets.size());
+    if (rowCount < 0) {
+        rowCount = total - firstRow;
+    }
+    if (firstRow < 0 || rowCount < 0 || firstRow + rowCount > total) {
+        throw std::runtime_error("Requested rows are outside the matrix");
+    }
+    if (rowCount == 0) {
+        return Matrix(0, 0);
+    }
+
+    // Values per line: complex literals, or real numbers read two by two for column pairs
+    const bool pairs = Eigen::NumTraits<Scalar>::IsComplex && parameters().getComplexPairs();
+    const long width = pairs ? parseLine<double>(offsets[0], nullptr, 0, 0)
+                             : parseLine<Value>(offsets[0], nullptr, 0, 0);
+    if (pairs && width % 2 != 0) {
+        throw std::runtime_error("A matrix of real/imaginary column pairs needs an even number of columns");
+    }
+    const long cols = pairs ? width / 2 : width;
+
+    // Each thread parses a contiguous block of rows, about the same number of bytes for all
+    const char* data = mData;
+    const std::size_t size = mSize;
+    auto endOfRow = [&](long row) {
+        const void* newline = std::memchr(data + offsets[row], '\n', size - offsets[row]);
+        return newline ? static_cast<std::size_t>(static_cast<const char*>(newline) - data) : size;
+    };
+    const std::size_t first = offsets[firstRow];
+    const std::size_t bytes = endOfRow(firstRow + rowCount - 1) - first;
+    const int workers = static_cast<int>(std::min<long>(workersFor(bytes), rowCount));
+    std::vector<long> bounds(workers + 1, firstRow + rowCount);
+    bounds[0] = firstRow;
+    for (int t = 1; t < workers; ++t) {
+        std::size_t target = first + bytes / workers * t;
+        long row = static_cast<long>(std::lower_bound(offsets.begin() + firstRow, offsets.begin() + firstRow + rowCount,
+                                                      target) - offsets.begin());
+        bounds[t] = std::max(bounds[t - 1], row);
+    }
+
+    Matrix matrix(rowCount, cols);
+    std::vector<std::exception_ptr> errors(workers);
+    mTimings.threadRows.assign(workers, 0);
+    mTimings.threadBytes.assign(workers, 0);
+    mTimings.threadSeconds.assign(workers, 0.0);
+
+    auto checkedParse = [&](long row, auto* values) {
+        long count = parseLine(offsets[row], values, width, row);
+        if (count != width) {
+            throw std::runtime_error("Inconsistent row sizes in matrix at row " + std::to_string(row) + " (" +
+                                     std::to_string(count) + " values instead of " + std::to_string(width) + ")");
+        }
+    };
+    runWorkers(workers, [&](int t) {
+        auto threadStart = std::chrono::steady_clock::now();
+        try {
+            if (pairs) {
+                std::vector<double> values(width);
+                for (long row = bounds[t]; row < bounds[t + 1]; ++row) {
+                    checkedParse(row, values.data());
+                    storePairs<Scalar>(matrix.row(row - firstRow), values.data());
+                }
+            } else {
+                std::vector<Value> values(width);
+                for (long row = bounds[t]; row < bounds[t + 1]; ++row) {
+                    checkedParse(row, values.data());
+                    for (long j = 0; j < cols; ++j) {
+                        matrix(row - firstRow, j) = values[j];
+                    }
+                }
+            }
+        } catch (...) {
+            errors[t] = std::current_exception();
+        }
+        if (bounds[t + 1] > bounds[t]) {
+            mTimings.threadRows[t] = bounds[t + 1] - bounds[t];
+            mTimings.threadBytes[t] = endOfRow(bounds[t + 1] - 1) - offsets[bounds[t]];
+        }
+        mTimings.threadSeconds[t] = secondsSince(threadStart);
+    });
+    mTimings.parseSeconds = secondsSince(start);
+
+    // The blocks are in file order: the first error found is the first faulty row
+    for (const std::exception_ptr& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+    return matrix;
+}
+
+void TextMatrixParser::reportTimings(std::ostream& out) const {
+    std::size_t bytes = 0;
+    for (std::size_t b : mTimings.threadBytes) bytes += b;
+    const double megabytes = bytes / 1e6;
+    out << "\nParsed " << std::fixed << std::setprecision(2) << megabytes << " MB in " << std::setprecision(4)
+        << mTimings.parseSeconds << " s on " << mTimings.threadBytes.size() << " thread(s): " << std::setprecision(1)
+        << megabytes / mTimings.parseSeconds << " MB/s (indexing " << std::setprecision(4) << mTimings.indexSeconds
+        << " s)" << std::endl;
+    if (mTimings.compressedBytes > 0) {
+        out << "Decompressed from " << std::setprecision(2) << mTimings.compressedBytes / 1e6 << " MB to "
+            << mSize / 1e6 << " MB while indexing" << std::endl;
+    }
+    out << "Thread      rows        MB   seconds      MB/s" << std::endl;
+    for (std::size_t t = 0; t < mTimings.threadBytes.size(); ++t) {
+        double threadMegabytes = mTimings.threadBytes[t] / 1e6;
+        double seconds = mTimings.threadSeconds[t];
+        out << std::setw(6) << t << std::setw(10) << mTimings.threadRows[t] << std::setw(10) << std::setprecision(2)
+            << threadMegabytes << std::setw(10) << std::setprecision(4) << seconds << std::setw(10)
+            << std::setprecision(1) << (seconds > 0 ? threadMegabytes / seconds : 0.0) << std::endl;
+    }
+    out.unsetf(std::ios::floatfield);
+    out << std::setprecision(6);
+}
+
+Parameters TextMatrixParser::parameters() const {
+    Parameters params;
+    const char* data = mData;
+    const std::size_t size = mSize;
+
+    std::size_t position = mParametersOffset;
+    while (position < size) {
+        const char* newline = static_cast<const char*>(std::memchr(data + position, '\n', size - position));
+        std::size_t end = newline ? static_cast<std::size_t>(newline - data) : size;
+        std::string_view line = trimmed(std::string_view(data + position, end - position));
+        position = end + 1;
+        if (line.empty()) continue;
+
+        // Name and value: "Name,Value", "Name;Value;", "Name: Value" or "Name Value"
+        std::string_view name, value;
+        std::size_t delimiter = line.find_first_of(":,;");
+        if (delimiter != std::string_view::npos) {
+            name = line.substr(0, delimiter);
+            value = line.substr(delimiter + 1);
+            std::size_t next = value.find(line[delimiter]);
+            if (next != std::string_view::npos) value = value.substr(0, next);
+        } else {
+            std::size_t blank = line.find_first_of(" \t");
+            name = line.substr(0, blank);
+            value = blank == std::string_view::npos ? std::string_view() : line.substr(blank);
+        }
+        params.setValue(std::string(trimmed(name)), std::string(trimmed(value)));
+    }
+    return params;
+}
+
+template Eigen::MatrixXd TextMatrixParser::parse<double>(Section, long, long);
+template Eigen::MatrixXcd TextMatrixParser::parse<std::complex<double>>(Section, long, long);
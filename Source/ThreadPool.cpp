@@ -0,0 +1,105 @@
+#include "ThreadPool.h"
+#include "Parallel.h"
+#include <atomic>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Rotation of the CPUs of each new pinned pool, so that pools living at the same time (batch jobs, server
+// requests) do not all pin their workers to the same CPUs
+static std::atomic<int> nextPoolOffset(0);
+
+bool pinCurrentThread(int index, int count, int offset) {
+#ifdef __linux__
+    int cpus = defaultThreadCount();
+    if (count < 1) count = 1;
+    // Spread: worker t gets CPU t * cpus / count (plain round robin when there are more workers than CPUs),
+    // shifted by the offset of the pool
+    int cpu = count <= cpus ? static_cast<int>(static_cast<long>(index) * cpus / count) : index % cpus;
+    cpu = (cpu + offset % cpus + cpus) % cpus;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)index;
+    (void)count;
+    (void)offset;
+    return false;
+#endif
+}
+
+// Constructor
+ThreadPool::ThreadPool(int threads, bool pinThreads)
+    : mThreads(threads < 1 ? defaultThreadCount() : threads),
+      mPinThreads(pinThreads),
+      mPinOffset(pinThreads ? nextPoolOffset.fetch_add(1) : 0),
+      mTask(nullptr),
+      mInvoke(nullptr),
+      mGeneration(0),
+      mPending(0),
+      mStop(false) {
+
+    // The calling thread is not pinned: it belongs to the caller, which may run other pools after this one
+    mWorkers.reserve(mThreads - 1);
+    for (int t = 1; t < mThreads; ++t) {
+        mWorkers.emplace_back(&ThreadPool::workerLoop, this, t);
+    }
+}
+
+// Destructor
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mStart.notify_all();
+    for (auto& worker : mWorkers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::workerLoop(int index) {
+    if (mPinThreads) {
+        pinCurrentThread(index, mThreads, mPinOffset);
+    }
+    unsigned long seen = 0;
+    for (;;) {
+        const void* task;
+        void (*invoke)(const void*, int);
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mStart.wait(lock, [&] { return mStop || mGeneration != seen; });
+            if (mStop) return;
+            seen = mGeneration;
+            task = mTask;
+            invoke = mInvoke;
+        }
+        invoke(task, index);
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (--mPending == 0) mDone.notify_one();
+        }
+    }
+}
+
+void ThreadPool::runTask(void (*invoke)(const void*, int), const void* task) {
+    if (mThreads == 1) {
+        invoke(task, 0);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mTask = task;
+        mInvoke = invoke;
+        mPending = mThreads - 1;
+        ++mGeneration;
+    }
+    mStart.notify_all();
+
+    invoke(task, 0);
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mDone.wait(lock, [&] { return mPending == 0; });
+}
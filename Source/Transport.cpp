@@ -0,0 +1,67 @@
+#include "Transport.h"
+#include <cstring>
+#include <numeric>
+
+// Destructor
+Transport::~Transport() {}
+
+// Collectives through rank 0
+void Transport::allGather(const void* local, void* global, const std::vector<std::size_t>& bytesPerRank) {
+    const int ranks = size();
+    char* out = static_cast<char*>(global);
+    std::size_t total = std::accumulate(bytesPerRank.begin(), bytesPerRank.end(), std::size_t(0));
+
+    if (rank() != 0) {
+        send(0, local, bytesPerRank[rank()]);
+        receive(0, out, total);
+        return;
+    }
+
+    std::size_t offset = 0;
+    for (int r = 0; r < ranks; ++r) {
+        if (r == 0) {
+            std::memcpy(out, local, bytesPerRank[0]);
+        } else {
+            receive(r, out + offset, bytesPerRank[r]);
+        }
+        offset += bytesPerRank[r];
+    }
+    for (int r = 1; r < ranks; ++r) {
+        send(r, out, total);
+    }
+}
+
+void Transport::allReduceSum(double* values, int count) {
+    const int ranks = size();
+    std::size_t bytes = sizeof(double) * count;
+
+    if (rank() != 0) {
+        send(0, values, bytes);
+        receive(0, values, bytes);
+        return;
+    }
+
+    std::vector<double> contribution(count);
+    for (int r = 1; r < ranks; ++r) {
+        receive(r, contribution.data(), bytes);
+        for (int i = 0; i < count; ++i) values[i] += contribution[i];
+    }
+    for (int r = 1; r < ranks; ++r) {
+        send(r, values, bytes);
+    }
+}
+
+void Transport::broadcast(void* data, std::size_t bytes) {
+    if (rank() != 0) {
+        receive(0, data, bytes);
+        return;
+    }
+    for (int r = 1; r < size(); ++r) {
+        send(r, data, bytes);
+    }
+}
+
+void Transport::barrier() {
+    double token = 0.0;
+    allReduceSum(&token, 1);
+}
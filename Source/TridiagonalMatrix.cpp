@@ -0,0 +1,65 @@
+#include "TridiagonalMatrix.h"
+#include <stdexcept>
+
+// Default Constructor
+TridiagonalMatrix::TridiagonalMatrix() {}
+
+// Constructor
+TridiagonalMatrix::TridiagonalMatrix(const Eigen::VectorXd& lower,
+                                     const Eigen::VectorXd& diagonal,
+                                     const Eigen::VectorXd& upper)
+    : mLower(lower), mDiagonal(diagonal), mUpper(upper) {
+    Eigen::Index offDiagonal = diagonal.size() > 0 ? diagonal.size() - 1 : 0;
+    if (lower.size() != offDiagonal || upper.size() != offDiagonal) {
+        throw std::invalid_argument("Tridiagonal matrix: off-diagonals must have n-1 entries");
+    }
+}
+
+TridiagonalMatrix TridiagonalMatrix::fromDense(const Eigen::MatrixXd& matrix) {
+    if (matrix.rows() != matrix.cols()) {
+        throw std::invalid_argument("Tridiagonal matrix: dense input must be square");
+    }
+    Eigen::Index n = matrix.rows();
+    Eigen::VectorXd lower(n > 0 ? n - 1 : 0);
+    Eigen::VectorXd upper(n > 0 ? n - 1 : 0);
+    for (Eigen::Index i = 0; i + 1 < n; ++i) {
+        lower(i) = matrix(i + 1, i);
+        upper(i) = matrix(i, i + 1);
+    }
+    return TridiagonalMatrix(lower, matrix.diagonal(), upper);
+}
+
+bool TridiagonalMatrix::isSymmetric() const {
+    return mLower == mUpper;
+}
+
+bool TridiagonalMatrix::isSymmetrizable() const {
+    for (Eigen::Index i = 0; i < mLower.size(); ++i) {
+        double product = mLower(i) * mUpper(i);
+        if (product < 0.0) return false;
+        // One zero and one non-zero entry gives a non-diagonalizable block
+        if (product == 0.0 && (mLower(i) != 0.0 || mUpper(i) != 0.0)) return false;
+    }
+    return true;
+}
+
+Eigen::VectorXd TridiagonalMatrix::multiply(const Eigen::VectorXd& x) const {
+    Eigen::Index n = mDiagonal.size();
+    Eigen::VectorXd y = mDiagonal.cwiseProduct(x);
+    for (Eigen::Index i = 0; i + 1 < n; ++i) {
+        y(i) += mUpper(i) * x(i + 1);
+        y(i + 1) += mLower(i) * x(i);
+    }
+    return y;
+}
+
+Eigen::MatrixXd TridiagonalMatrix::toDense() const {
+    Eigen::Index n = mDiagonal.size();
+    Eigen::MatrixXd dense = Eigen::MatrixXd::Zero(n, n);
+    dense.diagonal() = mDiagonal;
+    for (Eigen::Index i = 0; i + 1 < n; ++i) {
+        dense(i + 1, i) = mLower(i);
+        dense(i, i + 1) = mUpper(i);
+    }
+    return dense;
+}
@@ -0,0 +1,124 @@
+#include "TridiagonalReader.h"
+#include "CSVReader.h"
+#include "TextFileReader.h"
+#include <fstream>
+#include <iostream>
+#include <cctype>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+// The label at the start of a line, e.g. "Diagonal" in "Diagonal,2,2,2"; labelEnd is set past it
+static std::string lineLabel(const std::string& line, std::size_t& labelEnd) {
+    std::size_t start = 0;
+    while (start < line.size() && std::isspace(static_cast<unsigned char>(line[start]))) start++;
+    labelEnd = start;
+    while (labelEnd < line.size() && std::isalpha(static_cast<unsigned char>(line[labelEnd]))) labelEnd++;
+    return line.substr(start, labelEnd - start);
+}
+
+// Parse every number following the label of a line like "Diagonal,2,2,2"
+static Eigen::VectorXd parseDiagonal(const std::string& line, std::size_t labelEnd) {
+    std::vector<double> values;
+    const char* cursor = line.c_str() + labelEnd;
+    const char* end = line.c_str() + line.size();
+
+    while (cursor < end) {
+        // Skip delimiters and whitespace
+        while (cursor < end && (*cursor == ',' || *cursor == ';' || std::isspace(static_cast<unsigned char>(*cursor)))) {
+            ++cursor;
+        }
+        if (cursor >= end) break;
+
+        char* next = nullptr;
+        double value = std::strtod(cursor, &next);
+        if (next == cursor) {
+            throw std::runtime_error("Invalid value in tridiagonal file: " + line.substr(cursor - line.c_str(), 20));
+        }
+        values.push_back(value);
+        cursor = next;
+    }
+    return Eigen::Map<Eigen::VectorXd>(values.data(), values.size());
+}
+
+// Constructor
+TridiagonalReader::TridiagonalReader(const std::string& filename)
+    : Reader<double>(filename) {
+    if (mCompression != Compression::None) {
+        throw std::runtime_error("Compressed tridiagonal files are not supported: " + filename);
+    }
+    std::cout << "Tridiagonal file: " << filename << std::endl;
+}
+
+// Destructor
+TridiagonalReader::~TridiagonalReader() {}
+
+bool TridiagonalReader::isTridiagonalFile(const std::string& filename) {
+    std::ifstream file(filename);
+    std::string line;
+    while (std::getline(file, line)) {
+        std::size_t labelEnd;
+        std::string label = lineLabel(line, labelEnd);
+        if (label.empty() && line.find_first_not_of(" \t\r") == std::string::npos) continue;
+        return label == "Lower" || label == "Diagonal" || label == "Upper";
+    }
+    return false;
+}
+
+TridiagonalMatrix TridiagonalReader::ReadTridiagonal() {
+    std::ifstream file(this->mFilename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Opening tridiagonal file failed");
+    }
+
+    Eigen::VectorXd lower, diagonal, upper;
+    bool hasLower = false, hasDiagonal = false, hasUpper = false;
+    std::string line;
+
+    while (std::getline(file, line)) {
+        std::size_t labelEnd;
+        std::string label = lineLabel(line, labelEnd);
+
+        if (label == "Lower") {
+            lower = parseDiagonal(line, labelEnd);
+            hasLower = true;
+        } else if (label == "Diagonal") {
+            diagonal = parseDiagonal(line, labelEnd);
+            hasDiagonal = true;
+        } else if (label == "Upper") {
+            upper = parseDiagonal(line, labelEnd);
+            hasUpper = true;
+        } else if (label == "Algorithm") {
+            break;  // Stop because the parameters begin
+        }
+    }
+    file.close();
+
+    if (!hasDiagonal) {
+        throw std::runtime_error("No Diagonal line found in tridiagonal file");
+    }
+    if (!hasLower) {
+        lower = Eigen::VectorXd::Zero(diagonal.size() > 0 ? diagonal.size() - 1 : 0);
+    }
+    if (!hasUpper) {
+        upper = lower;  // Symmetric matrix
+    }
+
+    try {
+        return TridiagonalMatrix(lower, diagonal, upper);
+    } catch (const std::invalid_argument& e) {
+        throw std::runtime_error(e.what());
+    }
+}
+
+TridiagonalReader::Matrix TridiagonalReader::ReadMatrix() {
+    return ReadTridiagonal().toDense();
+}
+
+Parameters TridiagonalReader::ReadParameters() {
+    // The parameter section has the same layout as in the dense files
+    if (this->GetFileType() == FileType::CSV) {
+        return CSVReader<double>(this->mFilename).ReadParameters();
+    }
+    return TextFileReader<double>(this->mFilename).ReadParameters();
+}
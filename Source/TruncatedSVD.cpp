@@ -0,0 +1,199 @@
+#include "TruncatedSVD.h"
+#include <Eigen/SVD>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+// Random entries in [-1, 1] (real and imaginary parts for complex types)
+static void fillRandom(Eigen::Ref<Eigen::VectorXd> v, std::mt19937& generator) {
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    for (Eigen::Index i = 0; i < v.size(); ++i) v(i) = uniform(generator);
+}
+
+static void fillRandom(Eigen::Ref<Eigen::VectorXcd> v, std::mt19937& generator) {
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    for (Eigen::Index i = 0; i < v.size(); ++i) v(i) = std::complex<double>(uniform(generator), uniform(generator));
+}
+
+// Constructor
+template<typename Scalar>
+TruncatedSVD<Scalar>::TruncatedSVD(const Matrix& matrix, const Parameters& params)
+    : mMatrix(matrix),
+      mNumValues(params.getNumValues()),
+      mSubspaceSize(0),
+      mTolerance(params.getTolerance()),
+      mMaxIteration(params.getMaxIterations()),
+      mConverged(false),
+      mIterationCount(0),
+      mProductCount(0),
+      mSeed(2025u) {}
+
+// Destructor
+template<typename Scalar>
+TruncatedSVD<Scalar>::~TruncatedSVD() {}
+
+// Setters
+template<typename Scalar>
+void TruncatedSVD<Scalar>::setNumValues(int numValues) {
+    mNumValues = numValues;
+}
+
+template<typename Scalar>
+void TruncatedSVD<Scalar>::setSubspaceSize(int subspaceSize) {
+    mSubspaceSize = subspaceSize;
+}
+
+template<typename Scalar>
+void TruncatedSVD<Scalar>::randomOrthogonal(const Matrix& basis, int count, Eigen::Ref<Vector> column) {
+    std::mt19937 generator(mSeed++);
+    Vector v(column.size());
+    fillRandom(v, generator);
+    for (int pass = 0; pass < 2; ++pass) {
+        v -= basis.leftCols(count) * (basis.leftCols(count).adjoint() * v);
+    }
+    column = v.normalized();
+}
+
+template<typename Scalar>
+void TruncatedSVD<Scalar>::solve() {
+    const int m = mMatrix.rows();
+    const int n = mMatrix.cols();
+    const int maxRank = std::min(m, n);
+    const RealScalar breakdown = 1e-14 * std::max<RealScalar>(RealScalar(1), mMatrix.norm());
+
+    mConverged = false;
+    mIterationCount = 0;
+    mProductCount = 0;
+    mStats = SolverStats();
+
+    if (maxRank == 0 || mNumValues <= 0) {
+        std::cerr << "TruncatedSVD requires a non-empty matrix and NumValues >= 1." << std::endl;
+        return;
+    }
+    const int k = std::min(mNumValues, maxRank);
+    int p = mSubspaceSize > 0 ? mSubspaceSize : std::max(2 * k, k + 10);
+    p = std::min(std::max(p, k), maxRank);
+
+    // Bases U (m x p), V (n x p) and projected matrix B (p x p) with A V = U B
+    PhaseTimer setup(mStats.setupSeconds);
+    Matrix U = Matrix::Zero(m, p);
+    Matrix V = Matrix::Zero(n, p);
+    Matrix B = Matrix::Zero(p, p);
+    Vector w(m), r(n);
+    RealScalar beta = 0;
+
+    randomOrthogonal(V, 0, V.col(0));
+    int kStart = 0;
+    setup.stop();
+    mStats.bytesAllocated = sizeof(Scalar) * (double(m + n) * (p + 1) + double(p) * p);
+
+    PhaseTimer iterations(mStats.iterationSeconds);
+    for (mIterationCount = 1; mIterationCount <= mMaxIteration; ++mIterationCount) {
+        // 1. Extend the bidiagonalization from column kStart to p-1
+        for (int j = kStart; j < p; ++j) {
+            w.noalias() = mMatrix * V.col(j);
+            mProductCount++;
+            // Orthogonalize against the previous left vectors, recording the coefficients in B (twice for stability)
+            for (int pass = 0; pass < 2 && j > 0; ++pass) {
+                Vector coefficients = U.leftCols(j).adjoint() * w;
+                w.noalias() -= U.leftCols(j) * coefficients;
+                B.col(j).head(j) += coefficients;
+            }
+            RealScalar alpha = w.norm();
+            if (alpha > breakdown) {
+                U.col(j) = w / alpha;
+            } else {
+                alpha = 0;  // A v_j lies in span(U): continue with any orthogonal direction
+                randomOrthogonal(U, j, U.col(j));
+            }
+            B(j, j) = alpha;
+
+            r.noalias() = mMatrix.adjoint() * U.col(j);
+            mProductCount++;
+            for (int pass = 0; pass < 2; ++pass) {
+                r.noalias() -= V.leftCols(j + 1) * (V.leftCols(j + 1).adjoint() * r);
+            }
+            beta = r.norm();
+            if (j + 1 < p) {
+                if (beta > breakdown) {
+                    V.col(j + 1) = r / beta;
+                } else {
+                    randomOrthogonal(V, j + 1, V.col(j + 1));
+                }
+            }
+        }
+
+        // U spans the whole column space (p = m < n): with the residual direction added to V, the projection
+        // [B, U^H A r] is exact and its singular triplets are those of A
+        if (p == maxRank && beta > breakdown) {
+            Matrix extendedV(n, p + 1);
+            extendedV << V, r / beta;
+            Vector lastColumn = mMatrix * extendedV.col(p);
+            mProductCount++;
+            Matrix extendedB(p, p + 1);
+            extendedB << B, U.adjoint() * lastColumn;
+
+            Eigen::JacobiSVD<Matrix> exact(extendedB, Eigen::ComputeThinU | Eigen::ComputeThinV);
+            mSingularValues = exact.singularValues().head(k);
+            mLeftVectors = U * exact.matrixU().leftCols(k);
+            mRightVectors = extendedV * exact.matrixV().leftCols(k);
+            mConverged = true;
+            break;
+        }
+
+        // 2. Singular values of the small projected matrix
+        Eigen::JacobiSVD<Matrix> svd(B, Eigen::ComputeFullU | Eigen::ComputeFullV);
+        const RealVector& sigma = svd.singularValues();
+        const Matrix& X = svd.matrixU();
+        const Matrix& Y = svd.matrixV();
+
+        // Residual of each Ritz triplet: ||A^H u_i - sigma_i v_i|| = beta * |X(p-1, i)|
+        mConverged = true;
+        RealScalar reference = std::max(sigma(0), breakdown);
+        mStats.residual = 0.0;
+        for (int i = 0; i < k; ++i) {
+            mStats.residual = std::max<double>(mStats.residual, beta * std::abs(X(p - 1, i)) / reference);
+            if (beta * std::abs(X(p - 1, i)) > mTolerance * reference) {
+                mConverged = false;
+            }
+        }
+
+        if (mConverged || mIterationCount == mMaxIteration || p == maxRank) {
+            mSingularValues = sigma.head(k);
+            mLeftVectors = U * X.leftCols(k);
+            mRightVectors = V * Y.leftCols(k);
+            mConverged = mConverged || p == maxRank;  // V spans the whole row space: the triplets are exact
+            break;
+        }
+
+        // 3. Thick restart: keep the k best Ritz vectors, continue from the residual direction
+        U.leftCols(k) = U * X.leftCols(k);
+        V.leftCols(k) = V * Y.leftCols(k);
+        if (beta > breakdown) {
+            V.col(k) = r / beta;
+        } else {
+            randomOrthogonal(V, k, V.col(k));
+        }
+        B.setZero();
+        for (int i = 0; i < k; ++i) {
+            B(i, i) = sigma(i);
+        }
+        kStart = k;
+    }
+
+    iterations.stop();
+    // Each product with A or A^H is followed by two Gram-Schmidt passes against at most p + 1 vectors
+    mStats.matrixVectorProducts = mProductCount;
+    mStats.flops = flopScale<Scalar>() * mProductCount * (2.0 * m * n + 8.0 * std::max(m, n) * (p + 1));
+
+    if (mConverged) {
+        std::cout << "TruncatedSVD converged after " << mIterationCount << " restart cycle(s), "
+                  << mProductCount << " products with A and A^H." << std::endl;
+    } else {
+        std::cerr << "TruncatedSVD failed to converge after " << mMaxIteration << " restart cycles." << std::endl;
+    }
+}
+
+template class TruncatedSVD<double>;
+template class TruncatedSVD<std::complex<double>>;
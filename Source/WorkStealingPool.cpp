@@ -0,0 +1,122 @@
+#include "WorkStealingPool.h"
+#include "Parallel.h"
+
+namespace {
+
+// Pool and index of the worker running on this thread, so that tasks submitted by a task stay on its worker
+thread_local const WorkStealingPool* tPool = nullptr;
+thread_local int tIndex = -1;
+
+}
+
+// Constructor
+WorkStealingPool::WorkStealingPool(int threads)
+    : mQueued(0), mPending(0), mStopping(false), mNext(0), mStolen(0) {
+    const int count = threads < 1 ? defaultThreadCount() : threads;
+    mDeques.reserve(count);
+    for (int t = 0; t < count; ++t) {
+        mDeques.emplace_back(new TaskDeque());
+    }
+    mWorkers.reserve(count);
+    for (int t = 0; t < count; ++t) {
+        mWorkers.emplace_back(&WorkStealingPool::workerLoop, this, t);
+    }
+}
+
+// Destructor
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mIdle.wait(lock, [this] { return mPending == 0; });
+        mStopping = true;
+    }
+    mWork.notify_all();
+    for (std::thread& worker : mWorkers) {
+        worker.join();
+    }
+}
+
+void WorkStealingPool::submit(std::function<void()> task) {
+    const int count = static_cast<int>(mDeques.size());
+    const int index = tPool == this ? tIndex : static_cast<int>(mNext.fetch_add(1) % count);
+    // Counted before it is visible, so that a worker finishing it at once never takes mPending below zero
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mPending++;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mDeques[index]->mutex);
+        mDeques[index]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mQueued++;
+    }
+    mWork.notify_one();
+}
+
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mIdle.wait(lock, [this] { return mPending == 0; });
+    if (mError) {
+        std::exception_ptr error = mError;
+        mError = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+bool WorkStealingPool::take(int index, std::function<void()>& task) {
+    {
+        TaskDeque& own = *mDeques[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.front());
+            own.tasks.pop_front();
+            return true;
+        }
+    }
+    // Victims are visited from the next worker on, so that the thieves do not all target worker 0
+    const int count = static_cast<int>(mDeques.size());
+    for (int k = 1; k < count; ++k) {
+        TaskDeque& victim = *mDeques[(index + k) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.back());
+            victim.tasks.pop_back();
+            mStolen++;
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::workerLoop(int index) {
+    tPool = this;
+    tIndex = index;
+    std::function<void()> task;
+    while (true) {
+        if (take(index, task)) {
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mQueued--;
+            }
+            std::exception_ptr error;
+            try {
+                task();
+            } catch (...) {
+                error = std::current_exception();
+            }
+            task = nullptr;
+
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (error && !mError) mError = error;
+            if (--mPending == 0) mIdle.notify_all();
+            continue;
+        }
+
+        // Nothing to take: sleep until a task is queued (it may be taken by another worker first)
+        std::unique_lock<std::mutex> lock(mMutex);
+        mWork.wait(lock, [this] { return mQueued > 0 || mStopping; });
+        if (mStopping && mQueued == 0) return;
+    }
+}
@@ -1,9 +1,88 @@
 #include "Writer.h"
+#include "OutputBuffer.h"
+#include "Parallel.h"
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <vector>
 
+namespace {
 
-Writer::Writer(const std::string& filename) : mFilename(filename) {}
+// Values formatted by one thread before its text is written: a few MB of text
+const long kValuesPerBlock = 1L << 18;
+
+// "a + bi" or "a - bi", as the text files always wrote complex values
+void appendComplex(OutputBuffer& out, std::complex<double> value) {
+    out << value.real();
+    if (value.imag() >= 0) {
+        out << " + " << value.imag() << "i";
+    } else {
+        out << " - " << -value.imag() << "i";
+    }
+}
+
+// Formats the lines [0, count) with format(line, out) and writes them in order. Large outputs are cut into blocks
+// of consecutive lines formatted in parallel, one buffer per thread, written one after the other; only one round
+// of blocks is in memory at a time.
+template<typename Format>
+void writeLines(std::ostream& file, long count, long valuesPerLine, int precision, int threads, Format format) {
+    const long linesPerBlock = std::max<long>(1, kValuesPerBlock / std::max<long>(valuesPerLine, 1));
+    const long blocks = (count + linesPerBlock - 1) / linesPerBlock;
+    const int workers = static_cast<int>(std::min<long>(threads < 1 ? defaultThreadCount() : threads, blocks));
+    if (workers <= 0) return;
+
+    std::vector<OutputBuffer> buffers(workers, OutputBuffer(precision));
+    for (long first = 0; first < blocks; first += workers) {
+        const long round = std::min<long>(workers, blocks - first);
+        parallelFor(0, round, workers, [&](long b) {
+            const long begin = (first + b) * linesPerBlock;
+            const long end = std::min(count, begin + linesPerBlock);
+            for (long line = begin; line < end; ++line) format(line, buffers[b]);
+        });
+        for (long b = 0; b < round; ++b) buffers[b].writeTo(file);
+    }
+}
+
+// Rows of a matrix, comma separated
+template<typename Part>
+void writeCsvRows(std::ostream& file, long rows, long cols, int precision, int threads, Part part) {
+    writeLines(file, rows, cols, precision, threads, [&](long i, OutputBuffer& out) {
+        for (long j = 0; j < cols; ++j) {
+            out << part(i, j);
+            if (j < cols - 1) out << ',';
+        }
+        out << '\n';
+    });
+}
+
+// The statistics of the solve after the results: a title line, then one "<name><separator><value>" line each
+void writeStats(std::ostream& file, const SolverStats& stats, int precision, const char* title, const char* indent,
+                const char* separator) {
+    OutputBuffer out(precision);
+    out << '\n' << title << '\n';
+    for (const auto& field : stats.fields()) {
+        out << indent << field.first << separator << field.second << '\n';
+    }
+    out.writeTo(file);
+}
+
+}
+
+Writer::Writer(const std::string& filename)
+    : mFilename(filename), mPrecision(OutputBuffer::kStreamPrecision), mThreads(0), mHasStats(false) {}
+
+void Writer::setPrecision(int digits) {
+    mPrecision = digits;
+}
+
+void Writer::setThreads(int threads) {
+    mThreads = threads;
+}
+
+void Writer::setStats(const SolverStats& stats) {
+    mStats = stats;
+    mHasStats = true;
+}
 
 CSVWriter::CSVWriter(const std::string& filename) : Writer(filename) {}
 
@@ -19,16 +98,19 @@ void CSVWriter::write(double eigenvalue,
     }
 
     // Write header
-    file << "Eigenvalue,Iterations,Converged" << std::endl;
-    file << eigenvalue << "," << iterations << "," << (converged ? "Yes" : "No") << std::endl;
-    file << std::endl;
+    OutputBuffer out(mPrecision);
+    out << "Eigenvalue,Iterations,Converged\n";
+    out << eigenvalue << "," << iterations << "," << (converged ? "Yes" : "No") << '\n';
+    out << '\n';
 
     // Write eigenvector
-    file << "Eigenvector Components" << std::endl;
-    for (int i = 0; i < eigenvector.size(); ++i) {
-        file << eigenvector(i) << std::endl;
-    }
+    out << "Eigenvector Components\n";
+    out.writeTo(file);
+    writeLines(file, eigenvector.size(), 1, mPrecision, mThreads, [&](long i, OutputBuffer& line) {
+        line << eigenvector(i) << '\n';
+    });
 
+    if (mHasStats) writeStats(file, mStats, mPrecision, "Solver Statistics", "", ",");
     file.close();
     std::cout << "Results written to " << mFilename << std::endl;
 }
@@ -45,17 +127,20 @@ void CSVWriter::write(std::complex<double> eigenvalue,
     }
 
     // Write header
-    file << "Eigenvalue_Real,Eigenvalue_Imag,Iterations,Converged" << std::endl;
-    file << eigenvalue.real() << "," << eigenvalue.imag() << ","
-         << iterations << "," << (converged ? "Yes" : "No") << std::endl;
-    file << std::endl;
+    OutputBuffer out(mPrecision);
+    out << "Eigenvalue_Real,Eigenvalue_Imag,Iterations,Converged\n";
+    out << eigenvalue.real() << "," << eigenvalue.imag() << ","
+        << iterations << "," << (converged ? "Yes" : "No") << '\n';
+    out << '\n';
 
     // Write eigenvector
-    file << "Eigenvector_Real,Eigenvector_Imag" << std::endl;
-    for (int i = 0; i < eigenvector.size(); ++i) {
-        file << eigenvector(i).real() << "," << eigenvector(i).imag() << std::endl;
-    }
+    out << "Eigenvector_Real,Eigenvector_Imag\n";
+    out.writeTo(file);
+    writeLines(file, eigenvector.size(), 2, mPrecision, mThreads, [&](long i, OutputBuffer& line) {
+        line << eigenvector(i).real() << "," << eigenvector(i).imag() << '\n';
+    });
 
+    if (mHasStats) writeStats(file, mStats, mPrecision, "Solver Statistics", "", ",");
     file.close();
     std::cout << "Results written to " << mFilename << std::endl;
 }
@@ -72,28 +157,26 @@ void CSVWriter::writeAll(const Eigen::VectorXd& eigenvalues,
         return;
     }
 
-    file << "QR METHOD - ALL EIGENVALUES AND EIGENVECTORS" << std::endl;
-    file << "Iterations," << iterations << std::endl;
-    file << "Converged," << (converged ? "Yes" : "No") << std::endl;
-    file << std::endl;
+    OutputBuffer out(mPrecision);
+    out << "QR METHOD - ALL EIGENVALUES AND EIGENVECTORS\n";
+    out << "Iterations," << iterations << '\n';
+    out << "Converged," << (converged ? "Yes" : "No") << '\n';
+    out << '\n';
 
     // Write all eigenvalues
-    file << "All Eigenvalues" << std::endl;
-    for (int i = 0; i < eigenvalues.size(); ++i) {
-        file << "lambda_" << (i+1) << "," << eigenvalues(i) << std::endl;
+    out << "All Eigenvalues\n";
+    for (long i = 0; i < eigenvalues.size(); ++i) {
+        out << "lambda_" << (i+1) << "," << eigenvalues(i) << '\n';
     }
-    file << std::endl;
+    out << '\n';
 
     // Write all eigenvectors
-    file << "All Eigenvectors (columns)" << std::endl;
-    for (int i = 0; i < eigenvectors.rows(); ++i) {
-        for (int j = 0; j < eigenvectors.cols(); ++j) {
-            file << eigenvectors(i, j);
-            if (j < eigenvectors.cols() - 1) file << ",";
-        }
-        file << std::endl;
-    }
+    out << "All Eigenvectors (columns)\n";
+    out.writeTo(file);
+    writeCsvRows(file, eigenvectors.rows(), eigenvectors.cols(), mPrecision, mThreads,
+                 [&](long i, long j) { return eigenvectors(i, j); });
 
+    if (mHasStats) writeStats(file, mStats, mPrecision, "Solver Statistics", "", ",");
     file.close();
     std::cout << "All results written to " << mFilename << std::endl;
 }
@@ -109,40 +192,33 @@ void CSVWriter::writeAll(const Eigen::VectorXcd& eigenvalues,
         return;
     }
 
-    file << "QR METHOD - ALL EIGENVALUES AND EIGENVECTORS (COMPLEX)" << std::endl;
-    file << "Iterations," << iterations << std::endl;
-    file << "Converged," << (converged ? "Yes" : "No") << std::endl;
-    file << std::endl;
+    OutputBuffer out(mPrecision);
+    out << "QR METHOD - ALL EIGENVALUES AND EIGENVECTORS (COMPLEX)\n";
+    out << "Iterations," << iterations << '\n';
+    out << "Converged," << (converged ? "Yes" : "No") << '\n';
+    out << '\n';
 
     // Write all eigenvalues
-    file << "Eigenvalue_Index,Real_Part,Imaginary_Part" << std::endl;
-    for (int i = 0; i < eigenvalues.size(); ++i) {
-        file << "lambda_" << (i+1) << ","
-             << eigenvalues(i).real() << ","
-             << eigenvalues(i).imag() << std::endl;
+    out << "Eigenvalue_Index,Real_Part,Imaginary_Part\n";
+    for (long i = 0; i < eigenvalues.size(); ++i) {
+        out << "lambda_" << (i+1) << ","
+            << eigenvalues(i).real() << ","
+            << eigenvalues(i).imag() << '\n';
     }
-    file << std::endl;
+    out << '\n';
 
     // Write all eigenvectors
-    file << "All Eigenvectors (Real parts)" << std::endl;
-    for (int i = 0; i < eigenvectors.rows(); ++i) {
-        for (int j = 0; j < eigenvectors.cols(); ++j) {
-            file << eigenvectors(i, j).real();
-            if (j < eigenvectors.cols() - 1) file << ",";
-        }
-        file << std::endl;
-    }
-    file << std::endl;
+    out << "All Eigenvectors (Real parts)\n";
+    out.writeTo(file);
+    writeCsvRows(file, eigenvectors.rows(), eigenvectors.cols(), mPrecision, mThreads,
+                 [&](long i, long j) { return eigenvectors(i, j).real(); });
 
-    file << "All Eigenvectors (Imaginary parts)" << std::endl;
-    for (int i = 0; i < eigenvectors.rows(); ++i) {
-        for (int j = 0; j < eigenvectors.cols(); ++j) {
-            file << eigenvectors(i, j).imag();
-            if (j < eigenvectors.cols() - 1) file << ",";
-        }
-        file << std::endl;
-    }
+    out << "\nAll Eigenvectors (Imaginary parts)\n";
+    out.writeTo(file);
+    writeCsvRows(file, eigenvectors.rows(), eigenvectors.cols(), mPrecision, mThreads,
+                 [&](long i, long j) { return eigenvectors(i, j).imag(); });
 
+    if (mHasStats) writeStats(file, mStats, mPrecision, "Solver Statistics", "", ",");
     file.close();
     std::cout << "All results written to " << mFilename << std::endl;
 }
@@ -164,24 +240,26 @@ void TextFileWriter::write(double eigenvalue,
     }
 
     // Write title
-
-    file << "     EIGENVALUE COMPUTATION RESULTS     " << std::endl;
+    OutputBuffer out(mPrecision);
+    out << "     EIGENVALUE COMPUTATION RESULTS     \n";
 
 
     // Write convergence status
-    file << "Convergence Status: " << (converged ? "CONVERGED" : "NOT CONVERGED") << std::endl;
-    file << "Number of Iterations: " << iterations << std::endl << std::endl;
+    out << "Convergence Status: " << (converged ? "CONVERGED" : "NOT CONVERGED") << '\n';
+    out << "Number of Iterations: " << iterations << "\n\n";
 
     // Write eigenvalue
-    file << "Dominant Eigenvalue: " << eigenvalue << std::endl << std::endl;
+    out << "Dominant Eigenvalue: " << eigenvalue << "\n\n";
 
     // Write eigenvector
-    file << "Corresponding Eigenvector:" << std::endl;
-    for (int i = 0; i < eigenvector.size(); ++i) {
-        file << "  v[" << i << "] = " << eigenvector(i) << std::endl;
-    }
+    out << "Corresponding Eigenvector:\n";
+    out.writeTo(file);
+    writeLines(file, eigenvector.size(), 1, mPrecision, mThreads, [&](long i, OutputBuffer& line) {
+        line << "  v[" << i << "] = " << eigenvector(i) << '\n';
+    });
 
 
+    if (mHasStats) writeStats(file, mStats, mPrecision, "SOLVER STATISTICS:", "  ", ": ");
     file.close();
     std::cout << "Results written to " << mFilename << std::endl;
 }
@@ -198,32 +276,28 @@ void TextFileWriter::write(std::complex<double> eigenvalue,
     }
 
     // Write title
-
-    file << "     EIGENVALUE COMPUTATION RESULTS     " << std::endl;
+    OutputBuffer out(mPrecision);
+    out << "     EIGENVALUE COMPUTATION RESULTS     \n";
 
     // Write convergence status
-    file << "Convergence Status: " << (converged ? "CONVERGED" : "NOT CONVERGED") << std::endl;
-    file << "Number of Iterations: " << iterations << std::endl << std::endl;
+    out << "Convergence Status: " << (converged ? "CONVERGED" : "NOT CONVERGED") << '\n';
+    out << "Number of Iterations: " << iterations << "\n\n";
 
     // Write eigenvalue
-    file << "Dominant Eigenvalue: " << eigenvalue.real();
-    if (eigenvalue.imag() >= 0) {
-        file << " + " << eigenvalue.imag() << "i" << std::endl << std::endl;
-    } else {
-        file << " - " << -eigenvalue.imag() << "i" << std::endl << std::endl;
-    }
+    out << "Dominant Eigenvalue: ";
+    appendComplex(out, eigenvalue);
+    out << "\n\n";
 
     // Write eigenvector
-    file << "Corresponding Eigenvector:" << std::endl;
-    for (int i = 0; i < eigenvector.size(); ++i) {
-        file << "  v[" << i << "] = " << eigenvector(i).real();
-        if (eigenvector(i).imag() >= 0) {
-            file << " + " << eigenvector(i).imag() << "i" << std::endl;
-        } else {
-            file << " - " << -eigenvector(i).imag() << "i" << std::endl;
-        }
-    }
-
+    out << "Corresponding Eigenvector:\n";
+    out.writeTo(file);
+    writeLines(file, eigenvector.size(), 2, mPrecision, mThreads, [&](long i, OutputBuffer& line) {
+        line << "  v[" << i << "] = ";
+        appendComplex(line, eigenvector(i));
+        line << '\n';
+    });
+
+    if (mHasStats) writeStats(file, mStats, mPrecision, "SOLVER STATISTICS:", "  ", ": ");
     file.close();
     std::cout << "Results written to " << mFilename << std::endl;
 }
@@ -238,26 +312,30 @@ void TextFileWriter::writeAll(const Eigen::VectorXd& eigenvalues,
         return;
     }
 
-    file << "  QR METHOD - ALL EIGENVALUES/VECTORS  " << std::endl;
+    OutputBuffer out(mPrecision);
+    out << "  QR METHOD - ALL EIGENVALUES/VECTORS  \n";
 
 
-    file << "Convergence Status: " << (converged ? "CONVERGED" : "NOT CONVERGED") << std::endl;
-    file << "Number of Iterations: " << iterations << std::endl << std::endl;
+    out << "Convergence Status: " << (converged ? "CONVERGED" : "NOT CONVERGED") << '\n';
+    out << "Number of Iterations: " << iterations << "\n\n";
 
-    file << "ALL EIGENVALUES:" << std::endl;
-    for (int i = 0; i < eigenvalues.size(); ++i) {
-        file << "  lambda_" << (i+1) << " = " << eigenvalues(i) << std::endl;
+    out << "ALL EIGENVALUES:\n";
+    for (long i = 0; i < eigenvalues.size(); ++i) {
+        out << "  lambda_" << (i+1) << " = " << eigenvalues(i) << '\n';
     }
-    file << std::endl;
-
-    file << "ALL EIGENVECTORS:" << std::endl;
-    for (int i = 0; i < eigenvectors.cols(); ++i) {
-        file << "\nEigenvector v_" << (i+1) << ":" << std::endl;
-        for (int j = 0; j < eigenvectors.rows(); ++j) {
-            file << "  v[" << j << "] = " << eigenvectors(j, i) << std::endl;
+    out << '\n';
+
+    // One block of lines per eigenvector
+    out << "ALL EIGENVECTORS:\n";
+    out.writeTo(file);
+    writeLines(file, eigenvectors.cols(), eigenvectors.rows(), mPrecision, mThreads, [&](long i, OutputBuffer& line) {
+        line << "\nEigenvector v_" << (i+1) << ":\n";
+        for (long j = 0; j < eigenvectors.rows(); ++j) {
+            line << "  v[" << j << "] = " << eigenvectors(j, i) << '\n';
         }
-    }
+    });
 
+    if (mHasStats) writeStats(file, mStats, mPrecision, "SOLVER STATISTICS:", "  ", ": ");
     file.close();
     std::cout << "All results written to " << mFilename << std::endl;
 }
@@ -274,37 +352,35 @@ void TextFileWriter::writeAll(const Eigen::VectorXcd& eigenvalues,
         return;
     }
 
-    file << "  QR METHOD - ALL EIGENVALUES/VECTORS  " << std::endl;
-    file << "           (COMPLEX NUMBERS)           " << std::endl;
+    OutputBuffer out(mPrecision);
+    out << "  QR METHOD - ALL EIGENVALUES/VECTORS  \n";
+    out << "           (COMPLEX NUMBERS)           \n";
 
 
-    file << "Convergence Status: " << (converged ? "CONVERGED" : "NOT CONVERGED") << std::endl;
-    file << "Number of Iterations: " << iterations << std::endl << std::endl;
+    out << "Convergence Status: " << (converged ? "CONVERGED" : "NOT CONVERGED") << '\n';
+    out << "Number of Iterations: " << iterations << "\n\n";
 
-    file << "ALL EIGENVALUES:" << std::endl;
-    for (int i = 0; i < eigenvalues.size(); ++i) {
-        file << "  lambda_" << (i+1) << " = " << eigenvalues(i).real();
-        if (eigenvalues(i).imag() >= 0) {
-            file << " + " << eigenvalues(i).imag() << "i" << std::endl;
-        } else {
-            file << " - " << -eigenvalues(i).imag() << "i" << std::endl;
-        }
+    out << "ALL EIGENVALUES:\n";
+    for (long i = 0; i < eigenvalues.size(); ++i) {
+        out << "  lambda_" << (i+1) << " = ";
+        appendComplex(out, eigenvalues(i));
+        out << '\n';
     }
-    file << std::endl;
-
-    file << "ALL EIGENVECTORS:" << std::endl;
-    for (int i = 0; i < eigenvectors.cols(); ++i) {
-        file << "\nEigenvector v_" << (i+1) << ":" << std::endl;
-        for (int j = 0; j < eigenvectors.rows(); ++j) {
-            file << "  v[" << j << "] = " << eigenvectors(j, i).real();
-            if (eigenvectors(j, i).imag() >= 0) {
-                file << " + " << eigenvectors(j, i).imag() << "i" << std::endl;
-            } else {
-                file << " - " << -eigenvectors(j, i).imag() << "i" << std::endl;
-            }
+    out << '\n';
+
+    out << "ALL EIGENVECTORS:\n";
+    out.writeTo(file);
+    writeLines(file, eigenvectors.cols(), 2 * eigenvectors.rows(), mPrecision, mThreads,
+               [&](long i, OutputBuffer& line) {
+        line << "\nEigenvector v_" << (i+1) << ":\n";
+        for (long j = 0; j < eigenvectors.rows(); ++j) {
+            line << "  v[" << j << "] = ";
+            appendComplex(line, eigenvectors(j, i));
+            line << '\n';
         }
-    }
+    });
 
+    if (mHasStats) writeStats(file, mStats, mPrecision, "SOLVER STATISTICS:", "  ", ": ");
     file.close();
     std::cout << "All results written to " << mFilename << std::endl;
-}
\ No newline at end of file
+}
@@ -0,0 +1,382 @@
+//
+// Benchmark of the eigensolvers on synthetic matrices, written as JSON to follow the performance between versions
+//
+// Usage: bench_eigensolvers [--sizes 16,32,64] [--algorithms PowerMethod,ShiftedInversePowerMethod,QRMethod,EigenSolver]
+//                           [--generators random,symmetric,clustered,nonnormal,complex] [--repeats 3]
+//                           [--max-iterations 2000] [--tolerance 1e-10] [--threads N] [--seed 1] [--output FILE | -]
+//
+
+#include "PowerMethod.h"
+#include "QRMethod.h"
+#include "ShiftedInversePowerMethod.h"
+#include <Eigen/Eigenvalues>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+
+namespace {
+
+struct BenchOptions {
+    std::vector<int> sizes = {16, 32, 64};
+    std::vector<std::string> algorithms = {"PowerMethod", "ShiftedInversePowerMethod", "QRMethod", "EigenSolver"};
+    std::vector<std::string> generators = {"random", "symmetric", "clustered", "nonnormal", "complex"};
+    int repeats = 3;
+    int maxIterations = 2000;
+    double tolerance = 1e-10;
+    int threads = 1;
+    unsigned seed = 1;
+    std::string output = "bench_eigensolvers.json";
+};
+
+// One measured run: the median wall time over the repeats, the rest from the last repeat
+struct Measure {
+    double seconds = 0.0;
+    double minSeconds = 0.0;
+    int iterations = 0;
+    bool converged = false;
+    double flops = 0.0;
+    double residual = 0.0;
+    long peakRssKb = 0;
+};
+
+std::vector<std::string> splitList(const std::string& text) {
+    std::vector<std::string> items;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+BenchOptions parseOptions(int argc, char* argv[]) {
+    BenchOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (i + 1 >= argc) throw std::runtime_error("Missing value after " + argument);
+        std::string value = argv[++i];
+        if (argument == "--sizes") {
+            options.sizes.clear();
+            for (const std::string& size : splitList(value)) options.sizes.push_back(std::stoi(size));
+        } else if (argument == "--algorithms") {
+            options.algorithms = splitList(value);
+        } else if (argument == "--generators") {
+            options.generators = splitList(value);
+        } else if (argument == "--repeats") {
+            options.repeats = std::max(1, std::stoi(value));
+        } else if (argument == "--max-iterations") {
+            options.maxIterations = std::stoi(value);
+        } else if (argument == "--tolerance") {
+            options.tolerance = std::stod(value);
+        } else if (argument == "--threads") {
+            options.threads = std::stoi(value);
+        } else if (argument == "--seed") {
+            options.seed = static_cast<unsigned>(std::stoul(value));
+        } else if (argument == "--output") {
+            options.output = value;
+        } else {
+            throw std::runtime_error("Unknown option: " + argument);
+        }
+    }
+    return options;
+}
+
+// ====================================
+// Générateurs de matrices
+// ====================================
+
+// Random orthogonal (unitary) matrix: Q factor of a random matrix
+template<typename Scalar>
+Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> randomOrthogonal(int n) {
+    using Matrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+    return Eigen::HouseholderQR<Matrix>(Matrix::Random(n, n)).householderQ();
+}
+
+// Q diag(values) Q^H: normal, with the given spectrum
+template<typename Scalar>
+Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> withSpectrum(const Eigen::Matrix<Scalar, Eigen::Dynamic, 1>& values) {
+    auto Q = randomOrthogonal<Scalar>(static_cast<int>(values.size()));
+    return Q * values.asDiagonal() * Q.adjoint();
+}
+
+// Eigenvalues 1..10 and a dominant 20: a clear gap for the power methods
+Eigen::MatrixXd symmetricMatrix(int n) {
+    Eigen::VectorXd values = Eigen::VectorXd::LinSpaced(n, 1, 10);
+    values(n - 1) = 20;
+    return withSpectrum<double>(values);
+}
+
+// Eigenvalues within 1e-3 of 1 and a dominant 1.01: slow for the power methods, hard to separate for QR
+Eigen::MatrixXd clusteredMatrix(int n) {
+    Eigen::VectorXd values = Eigen::VectorXd::LinSpaced(n, 1, 1.001);
+    values(n - 1) = 1.01;
+    return withSpectrum<double>(values);
+}
+
+// S (D + N) S^-1 with a strictly upper triangular N as large as D: real spectrum 1..n/2 and n, far from normal
+Eigen::MatrixXd nonNormalMatrix(int n) {
+    Eigen::VectorXd values = Eigen::VectorXd::LinSpaced(n, 1, std::max(1.0, n / 2.0));
+    values(n - 1) = n;
+    Eigen::MatrixXd T = Eigen::MatrixXd(values.asDiagonal()) +
+                        Eigen::MatrixXd(Eigen::MatrixXd::Random(n, n).triangularView<Eigen::StrictlyUpper>()) * (n / 4.0);
+    Eigen::MatrixXd S = Eigen::MatrixXd::Identity(n, n) + 0.5 * Eigen::MatrixXd::Random(n, n) / std::sqrt(double(n));
+    return S * T * S.inverse();
+}
+
+// Normal complex matrix with eigenvalues on a spiral and a dominant 20 + 20i
+Eigen::MatrixXcd complexMatrix(int n) {
+    Eigen::VectorXcd values(n);
+    for (int k = 0; k < n; ++k) {
+        double radius = 1.0 + 9.0 * k / std::max(1, n - 1);
+        values(k) = std::polar(radius, 0.7 * k);
+    }
+    values(n - 1) = std::complex<double>(20, 20);
+    return withSpectrum<std::complex<double>>(values);
+}
+
+// ====================================
+// Mesures : RSS maximale, flops estimés, résidus
+// ====================================
+
+// Resets the peak resident set of the process (Linux 4.0 and later), so the next peak is the one of the solve
+void resetPeakRss() {
+    std::ofstream clear("/proc/self/clear_refs");
+    if (clear) clear << "5";
+}
+
+long peakRssKb() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) return std::atol(line.c_str() + 6);
+    }
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+// Floating-point operations of Eigen's solver, counted as in LAPACK (a complex multiply-add is 8 real
+// operations): Hessenberg reduction, Francis steps and eigenvectors (Golub and Van Loan). The solvers of the
+// project count their own in SolverStats
+double eigenSolverFlops(double n, bool complex) {
+    return (complex ? 4.0 : 1.0) * 25.0 * n * n * n;
+}
+
+// Largest ||A v - lambda v|| / (||A|| ||v||) over the pairs. Zero columns are eigenvectors the solver could not
+// compute (QRMethod on a 2x2 block or without convergence) and are skipped; NaN when none is left
+template<typename MatrixA, typename Values, typename Vectors>
+double relativeResidual(const MatrixA& A, const Values& values, const Vectors& vectors) {
+    const double norm = A.norm();
+    double worst = std::numeric_limits<double>::quiet_NaN();
+    for (Eigen::Index k = 0; k < values.size(); ++k) {
+        Eigen::VectorXcd v = vectors.col(k).template cast<std::complex<double>>();
+        if (v.isZero(0)) continue;
+        Eigen::VectorXcd r = A.template cast<std::complex<double>>() * v - std::complex<double>(values(k)) * v;
+        double residual = norm > 0 ? r.norm() / (norm * v.norm()) : std::numeric_limits<double>::infinity();
+        worst = std::isnan(worst) ? residual : std::max(worst, residual);
+    }
+    return worst;
+}
+
+// Discards what the solvers print while they are timed
+class Silence {
+public:
+    Silence() : mOut(std::cout.rdbuf(nullptr)), mErr(std::cerr.rdbuf(nullptr)) {}
+    ~Silence() {
+        std::cout.rdbuf(mOut);
+        std::cerr.rdbuf(mErr);
+    }
+
+private:
+    std::streambuf* mOut;
+    std::streambuf* mErr;
+};
+
+template<typename Scalar>
+Measure runOnce(const std::string& algorithm, const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>& A,
+                const BenchOptions& options) {
+    Parameters params;
+    params.setMaxIterations(options.maxIterations);
+    params.setTolerance(options.tolerance);
+    params.setThreads(options.threads);
+    params.setShift(0.1);
+    const bool complex = Eigen::NumTraits<Scalar>::IsComplex;
+
+    Measure measure;
+    resetPeakRss();
+    auto start = std::chrono::steady_clock::now();
+    // The time and the peak memory of the solve alone, before the residual allocates its own vectors
+    auto stop = [&]() {
+        measure.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        measure.peakRssKb = peakRssKb();
+    };
+    if (algorithm == "PowerMethod" || algorithm == "ShiftedInversePowerMethod") {
+        std::unique_ptr<Eigenvalue<Scalar>> solver;
+        if (algorithm == "PowerMethod") {
+            solver.reset(new PowerMethod<Scalar>(A, params));
+        } else {
+            solver.reset(new ShiftedInversePowerMethod<Scalar>(A, params));
+        }
+        {
+            Silence silence;
+            solver->solve();
+        }
+        stop();
+        measure.iterations = solver->getIterationCount();
+        measure.converged = solver->hasConverged();
+        measure.flops = solver->getStats().flops;
+        Eigen::Matrix<Scalar, Eigen::Dynamic, 1> value(1);
+        value(0) = solver->getEigenvalue();
+        measure.residual = relativeResidual(A, value, solver->getEigenvector());
+    } else if (algorithm == "QRMethod") {
+        // Every true eigenvector through the selective mode: the default columns are Schur vectors, whose
+        // residual says nothing about the accuracy
+        std::vector<int> indices(A.rows());
+        std::iota(indices.begin(), indices.end(), 1);
+        params.setEigenvectorIndices(indices);
+        QRMethod<Scalar> solver(A, params);
+        {
+            Silence silence;
+            solver.solve();
+        }
+        stop();
+        measure.iterations = solver.getIterationCount();
+        measure.converged = solver.hasConverged();
+        measure.flops = solver.getStats().flops;
+        measure.residual = relativeResidual(A, solver.getAllEigenvalues(), solver.getAllEigenvectors());
+    } else if (algorithm == "EigenSolver") {
+        // Eigen's own dense solver, as the baseline
+        if constexpr (Eigen::NumTraits<Scalar>::IsComplex) {
+            Eigen::ComplexEigenSolver<Eigen::MatrixXcd> solver(A);
+            stop();
+            measure.converged = solver.info() == Eigen::Success;
+            measure.residual = relativeResidual(A, solver.eigenvalues(), solver.eigenvectors());
+        } else {
+            Eigen::EigenSolver<Eigen::MatrixXd> solver(A);
+            stop();
+            measure.converged = solver.info() == Eigen::Success;
+            measure.residual = relativeResidual(A, solver.eigenvalues(), solver.eigenvectors());
+        }
+        measure.iterations = 0;
+        measure.flops = eigenSolverFlops(static_cast<double>(A.rows()), complex);
+    } else {
+        throw std::runtime_error("Unknown algorithm: " + algorithm);
+    }
+    return measure;
+}
+
+template<typename Scalar>
+Measure run(const std::string& algorithm, const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>& A,
+            const BenchOptions& options) {
+    std::vector<double> times;
+    Measure measure;
+    for (int r = 0; r < options.repeats; ++r) {
+        measure = runOnce<Scalar>(algorithm, A, options);
+        times.push_back(measure.seconds);
+    }
+    std::sort(times.begin(), times.end());
+    measure.seconds = times[times.size() / 2];
+    measure.minSeconds = times.front();
+    return measure;
+}
+
+// ====================================
+// Sortie JSON
+// ====================================
+std::string jsonNumber(double value) {
+    if (!std::isfinite(value)) return "null";
+    std::ostringstream text;
+    text.precision(6);
+    text << value;
+    return text.str();
+}
+
+std::string timestamp() {
+    std::time_t now = std::time(nullptr);
+    char text[32];
+    std::strftime(text, sizeof(text), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+    return text;
+}
+
+void writeRecord(std::ostream& out, bool first, const std::string& generator, int n, const std::string& algorithm,
+                 const std::string& scalar, const Measure& m) {
+    const double perIteration = m.iterations > 0 ? m.seconds / m.iterations : std::numeric_limits<double>::quiet_NaN();
+    const double gflops = m.seconds > 0 ? m.flops / m.seconds * 1e-9 : std::numeric_limits<double>::quiet_NaN();
+    out << (first ? "\n" : ",\n") << "    {\"generator\": \"" << generator << "\", \"n\": " << n
+        << ", \"algorithm\": \"" << algorithm << "\", \"scalar\": \"" << scalar
+        << "\", \"wall_seconds\": " << jsonNumber(m.seconds) << ", \"min_seconds\": " << jsonNumber(m.minSeconds)
+        << ", \"iterations\": " << m.iterations << ", \"seconds_per_iteration\": " << jsonNumber(perIteration)
+        << ", \"converged\": " << (m.converged ? "true" : "false") << ", \"gflops\": " << jsonNumber(gflops)
+        << ", \"residual\": " << jsonNumber(m.residual) << ", \"peak_rss_kb\": " << m.peakRssKb << "}";
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        BenchOptions options = parseOptions(argc, argv);
+        std::srand(options.seed);
+
+        std::ofstream file;
+        if (options.output != "-") {
+            file.open(options.output);
+            if (!file) throw std::runtime_error("Cannot write " + options.output);
+        }
+        std::ostream& out = options.output == "-" ? std::cout : file;
+
+        out << "{\n  \"benchmark\": \"bench_eigensolvers\",\n  \"format\": 1,\n  \"timestamp\": \"" << timestamp()
+            << "\",\n  \"compiler\": \"" << __VERSION__ << "\",\n  \"eigen\": \"" << EIGEN_WORLD_VERSION << "."
+            << EIGEN_MAJOR_VERSION << "." << EIGEN_MINOR_VERSION << "\",\n  \"repeats\": " << options.repeats
+            << ",\n  \"max_iterations\": " << options.maxIterations << ",\n  \"tolerance\": "
+            << jsonNumber(options.tolerance) << ",\n  \"threads\": " << options.threads << ",\n  \"seed\": "
+            << options.seed << ",\n  \"results\": [";
+
+        bool first = true;
+        for (const std::string& generator : options.generators) {
+            for (int n : options.sizes) {
+                Eigen::MatrixXd real;
+                Eigen::MatrixXcd complex;
+                if (generator == "random") {
+                    real = Eigen::MatrixXd::Random(n, n);
+                } else if (generator == "symmetric") {
+                    real = symmetricMatrix(n);
+                } else if (generator == "clustered") {
+                    real = clusteredMatrix(n);
+                } else if (generator == "nonnormal") {
+                    real = nonNormalMatrix(n);
+                } else if (generator == "complex") {
+                    complex = complexMatrix(n);
+                } else {
+                    throw std::runtime_error("Unknown generator: " + generator);
+                }
+
+                for (const std::string& algorithm : options.algorithms) {
+                    Measure measure = complex.size() > 0 ? run<std::complex<double>>(algorithm, complex, options)
+                                                         : run<double>(algorithm, real, options);
+                    writeRecord(out, first, generator, n, algorithm, complex.size() > 0 ? "complex" : "real", measure);
+                    first = false;
+                    std::cerr << generator << " n=" << n << " " << algorithm << ": " << measure.seconds << " s, "
+                              << measure.iterations << " iterations, residual " << measure.residual << std::endl;
+                }
+            }
+        }
+        out << "\n  ]\n}\n";
+        if (options.output != "-") std::cerr << "Results written to " << options.output << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "  ERROR" << std::endl;
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
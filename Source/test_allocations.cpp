@@ -0,0 +1,147 @@
+//
+// Test of the solver workspaces: once the first solve() has allocated them, the iterations of PowerMethod,
+// ShiftedInversePowerMethod and QRMethod do not allocate, even while recording their convergence or running the
+// products on several threads, which a counting allocator checks
+//
+
+#include "PowerMethod.h"
+#include "QRMethod.h"
+#include "ShiftedInversePowerMethod.h"
+#include "TestHelpers.h"
+#include <algorithm>
+#include <atomic>
+#include <complex>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// Every heap allocation of the process (operator new and Eigen both end in malloc) goes through these glibc
+// entry points, which count it
+extern "C" {
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t count, std::size_t size);
+void* __libc_realloc(void* pointer, std::size_t size);
+}
+
+static std::atomic<long> allocationCount(0);
+
+extern "C" void* malloc(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+extern "C" void* calloc(std::size_t count, std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void* pointer, std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_realloc(pointer, size);
+}
+
+template<typename Solver>
+long countedSolve(Solver& solver) {
+    long before = allocationCount.load();
+    solver.solve();
+    return allocationCount.load() - before;
+}
+
+// A zero tolerance is never reached, so the solver runs exactly its maximum number of iterations: the same count
+// of allocations for 5 and 50 iterations means none in the loop, and a second solve() reuses the workspace
+template<typename Solver>
+bool allocationFree(const std::string& name, Solver& solver) {
+    solver.setTolerance(0.0);
+    solver.setMaxIteration(5);
+    long cold = countedSolve(solver);
+    long few = countedSolve(solver);
+    solver.setMaxIteration(50);
+    long many = countedSolve(solver);
+    std::cout << name << ": " << cold << " allocations for the first solve, " << few << " for 5 iterations, "
+              << many << " for 50 iterations" << std::endl;
+    return many == few && few < cold;
+}
+
+// With a convergence history smaller than the iteration count, the ring buffer wraps without allocating
+template<typename Scalar>
+bool test_solvers(const std::string& type, int historyCapacity) {
+    Eigen::VectorXd values = Eigen::VectorXd::LinSpaced(40, 1, 10);
+    values(39) = 20;
+    auto A = withEigenvalues<Scalar>(values);
+    Parameters params;
+    params.setThreads(1);
+    params.setShift(19.5);
+    params.setHistoryCapacity(historyCapacity);
+
+    PowerMethod<Scalar> power(A, params);
+    ShiftedInversePowerMethod<Scalar> sipm(A, params);
+    QRMethod<Scalar> qr(A, params);
+    bool ok = allocationFree("PowerMethod<" + type + ">", power);
+    ok = allocationFree("ShiftedInversePowerMethod<" + type + ">", sipm) && ok;
+    ok = allocationFree("QRMethod<" + type + ">", qr) && ok;
+    return ok;
+}
+
+// The parallel products of PowerMethod (row blocks, or planar complex storage) hand their tasks to the pool
+// without allocating either, and the pool and the copies of the matrix are kept by the second solve()
+bool test_threaded() {
+    Eigen::VectorXd values = Eigen::VectorXd::LinSpaced(400, 1, 10);
+    values(399) = 20;
+    Parameters params;
+    params.setThreads(4);
+    PowerMethod<double> real(withEigenvalues<double>(values), params);
+    bool ok = allocationFree("PowerMethod<double>, 4 threads", real);
+
+    params.setPlanarComplex(true);
+    PowerMethod<std::complex<double>> planar(withEigenvalues<std::complex<double>>(values), params);
+    ok = allocationFree("PowerMethod<complex>, planar, 4 threads", planar) && ok;
+    return ok;
+}
+
+// The in-place QR steps still converge to the known eigenvalues, with orthonormal eigenvectors for a symmetric
+// matrix, and a solve() on a matrix of another size resizes the workspace
+bool test_results() {
+    Eigen::VectorXd values(6);
+    values << -3, 1, 2, 5, 8, 13;
+    Parameters params;
+    params.setMaxIterations(10000);
+    params.setTolerance(1e-12);
+    QRMethod<double> qr(withEigenvalues<double>(values), params);
+    qr.solve();
+    Eigen::VectorXd found = qr.getAllEigenvalues();
+    std::sort(found.data(), found.data() + found.size());
+    Eigen::MatrixXd V = qr.getAllEigenvectors();
+    bool ok = qr.hasConverged() && (found - values).norm() < 1e-8 &&
+              (V.transpose() * V - Eigen::MatrixXd::Identity(6, 6)).norm() < 1e-10;
+
+    Eigen::VectorXd smaller(3);
+    smaller << 1, 4, 9;
+    qr.setMatrix(withEigenvalues<double>(smaller));
+    qr.solve();
+    found = qr.getAllEigenvalues();
+    std::sort(found.data(), found.data() + found.size());
+    ok = ok && qr.hasConverged() && (found - smaller).norm() < 1e-8;
+    std::cout << "QRMethod eigenvalues: " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+int main() {
+    bool ok = true;
+    try {
+        ok = test_solvers<double>("double", 0) && ok;
+        ok = test_solvers<std::complex<double>>("complex", 0) && ok;
+        ok = test_solvers<double>("double, recorded", 16) && ok;
+        ok = test_threaded() && ok;
+        ok = test_results() && ok;
+    } catch (const std::exception& e) {
+        std::cout << "Unexpected error: " << e.what() << std::endl;
+        ok = false;
+    }
+
+    if (ok) {
+        std::cout << "Test succeed" << std::endl;
+        return 0;
+    }
+    std::cout << "Test failed" << std::endl;
+    return 1;
+}
@@ -0,0 +1,215 @@
+//
+// Test of the batch mode: work-stealing pool, inputs from patterns and manifests, one result file per input
+//
+
+#include "BatchRunner.h"
+#include "BinaryMatrix.h"
+#include "BinaryResult.h"
+#include "TestHelpers.h"
+#include "WorkStealingPool.h"
+#include <atomic>
+#include <chrono>
+#include <complex>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+std::string csv(const Eigen::MatrixXd& A, const std::string& algorithm) {
+    std::ostringstream text;
+    text.precision(17);
+    for (int i = 0; i < A.rows(); ++i) {
+        for (int j = 0; j < A.cols(); ++j) text << (j > 0 ? "," : "") << A(i, j);
+        text << "\n";
+    }
+    text << "Algorithm," << algorithm << "\nMaxIterations,10000\nTolerance,1e-10\n";
+    return text.str();
+}
+
+// Every task runs once, also tasks submitted by tasks; an exception reaches wait(); idle workers steal
+bool test_pool() {
+    std::atomic<int> runs(0);
+    WorkStealingPool pool(4);
+    for (int i = 0; i < 1000; ++i) {
+        pool.submit([&] {
+            runs++;
+            if (runs % 100 == 0) pool.submit([&] { runs++; });
+        });
+    }
+    pool.wait();
+    bool ok = runs == 1010;
+
+    // One long task per worker dealt first, then short ones: the workers done early take the short ones
+    for (int i = 0; i < 4; ++i) {
+        pool.submit([i] { std::this_thread::sleep_for(std::chrono::milliseconds(i == 0 ? 200 : 1)); });
+    }
+    for (int i = 0; i < 40; ++i) pool.submit([] { std::this_thread::sleep_for(std::chrono::milliseconds(2)); });
+    pool.wait();
+    ok = ok && pool.stolenCount() > 0;
+
+    pool.submit([] { throw std::runtime_error("task error"); });
+    try {
+        pool.wait();
+        ok = false;
+    } catch (const std::runtime_error& e) {
+        ok = ok && std::string(e.what()) == "task error";
+    }
+    std::cout << "Pool: " << runs << " runs, " << pool.stolenCount() << " stolen, " << (ok ? "ok" : "mismatch")
+              << std::endl;
+    return ok;
+}
+
+// Patterns, manifests with comments, result names without directory and extensions
+bool test_inputs(const std::string& directory) {
+    writeFile(directory + "/a.csv", "1\n");
+    writeFile(directory + "/b.csv", "1\n");
+    writeFile(directory + "/c.txt", "1\n");
+    writeFile(directory + "/list", "# inputs\n\n  " + directory + "/c.txt \n" + directory + "/*.csv\n");
+
+    std::vector<std::string> inputs = expandInputs({"@" + directory + "/list", directory + "/a.csv"});
+    bool ok = inputs == std::vector<std::string>{directory + "/c.txt", directory + "/a.csv", directory + "/b.csv",
+                                                 directory + "/a.csv"};
+    ok = ok && resultName("../data/matrix.csv.gz", ".bres") == "result_matrix.bres" &&
+         resultName("m", ".csv") == "result_m.csv";
+    try {
+        expandInputs({directory + "/*.none"});
+        ok = false;
+    } catch (const std::runtime_error& e) {
+        std::cout << "Rejected: " << e.what() << std::endl;
+    }
+    for (const char* name : {"/a.csv", "/b.csv", "/c.txt", "/list"}) std::remove((directory + name).c_str());
+    std::cout << "Inputs: " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+// Each input gets its own result, the algorithm can be replaced, a faulty input does not stop the others
+bool test_batch(const std::string& directory) {
+    Eigen::VectorXd values(5);
+    values << 1, 2, 3, 4, 10;
+    Eigen::MatrixXd A = withEigenvalues(values);
+    writeFile(directory + "/first.csv", csv(A, "QRMethod"));
+    writeFile(directory + "/second.txt", csv(A, "QRMethod"));
+    writeFile(directory + "/broken.csv", "1,2\n3\nAlgorithm,QRMethod\n");
+
+    BatchOptions options;
+    options.outputDirectory = directory;
+    options.format = "bres";
+    options.algorithm = "PowerMethod";
+    options.jobs = 2;
+    std::ostringstream log;
+    BatchStats stats = BatchRunner<double>(options).run(
+        {directory + "/first.csv", directory + "/second.txt", directory + "/broken.csv"}, log);
+    std::cout << log.str();
+
+    bool ok = stats.jobs == 3 && stats.solved == 2 && stats.failed == 1;
+    for (const char* name : {"/result_first.bres", "/result_second.bres"}) {
+        BinaryResultReader result(directory + name);
+        ok = ok && result.metadata("Algorithm") == "PowerMethod" && result.header().count == 1 &&
+             std::abs(result.MapEigenvalues<double>()(0) - 10) < 1e-6;
+    }
+    ok = ok && access((directory + "/result_broken.bres").c_str(), F_OK) != 0;
+    for (const char* name : {"/first.csv", "/second.txt", "/broken.csv", "/result_first.bres", "/result_second.bres"}) {
+        std::remove((directory + name).c_str());
+    }
+    std::cout << "Batch: " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+// Labelled diagonals are read by the tridiagonal reader and solved by BisectionMethod, in a .csv or a .txt file;
+// they are refused as complex matrices
+bool test_tridiagonal(const std::string& directory) {
+    const std::string text = "Lower,-1,-1,-1\nDiagonal,2,2,2,2\nAlgorithm,BisectionMethod\nTolerance,1e-12\n"
+                             "IndexLow,1\nIndexHigh,2\n";
+    writeFile(directory + "/laplacian.csv", text);
+    writeFile(directory + "/laplacian.txt", "\n" + text);
+
+    BatchOptions options;
+    options.outputDirectory = directory;
+    options.format = "bres";
+    options.jobs = 2;
+    std::ostringstream log;
+    BatchStats stats = BatchRunner<double>(options).run({directory + "/laplacian.csv", directory + "/laplacian.txt"},
+                                                        log);
+    BatchStats complexStats = BatchRunner<std::complex<double>>(options).run({directory + "/laplacian.csv"}, log);
+    std::cout << log.str();
+
+    // The eigenvalues of the 1D Laplacian of size 4 are 2 - 2 cos(k pi / 5)
+    bool ok = stats.solved == 2 && complexStats.failed == 1;
+    if (ok) {
+        BinaryResultReader result(directory + "/result_laplacian.bres");
+        Eigen::VectorXd found = result.MapEigenvalues<double>();
+        ok = result.metadata("Algorithm") == "BisectionMethod" && found.size() == 2;
+        for (int k = 1; ok && k <= 2; ++k) {
+            ok = std::abs(found(k - 1) - (2 - 2 * std::cos(k * M_PI / 5))) < 1e-10;
+        }
+    }
+    for (const char* name : {"/laplacian.csv", "/laplacian.txt", "/result_laplacian.bres",
+                             "/result_laplacian_2.bres"}) {
+        std::remove((directory + name).c_str());
+    }
+    std::cout << "Tridiagonal batch: " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+// Two large jobs among many small ones: the large ones start first and the small ones fill the other workers
+bool benchmark_mixed(const std::string& directory, int large, int small) {
+    Eigen::VectorXd values = Eigen::VectorXd::LinSpaced(large, 1, large);
+    values(large - 1) = 2 * large;
+    Parameters params;
+    params.setAlgorithm("PowerMethod");
+    params.setTolerance(1e-10);
+    std::vector<std::string> inputs;
+    for (int i = 0; i < small; ++i) {
+        inputs.push_back(directory + "/small_" + std::to_string(i) + ".csv");
+        writeFile(inputs.back(), csv(withEigenvalues(Eigen::VectorXd::LinSpaced(10, 1, 10)), "QRMethod"));
+        if (i == small / 2) {
+            for (int k = 0; k < 2; ++k) {
+                inputs.push_back(directory + "/large_" + std::to_string(k) + ".bmat");
+                BinaryMatrixWriter::write(inputs.back(), withEigenvalues(values), &params);
+            }
+        }
+    }
+
+    BatchOptions options;
+    options.outputDirectory = directory;
+    options.jobs = 4;
+    std::ostringstream log;
+    BatchStats stats = BatchRunner<double>(options).run(inputs, log);
+    std::cout << stats.jobs << " jobs (2 of " << large << "x" << large << ", " << small << " of 10x10) on " << options.jobs
+              << " workers: job time " << stats.jobSeconds << " s, wall " << stats.wallSeconds << " s, "
+              << stats.stolen << " stolen" << std::endl;
+    for (const std::string& input : inputs) {
+        std::remove(input.c_str());
+        std::remove((directory + "/" + resultName(input, ".csv")).c_str());
+    }
+    return stats.solved == stats.jobs;
+}
+
+int main() {
+    bool ok = true;
+    std::string directory;
+    try {
+        directory = temporaryDirectory("batch");
+        ok = test_pool() && ok;
+        ok = test_inputs(directory) && ok;
+        ok = test_batch(directory) && ok;
+        ok = test_tridiagonal(directory) && ok;
+        ok = benchmark_mixed(directory, 800, 200) && ok;
+    } catch (const std::exception& e) {
+        std::cout << "Unexpected error: " << e.what() << std::endl;
+        ok = false;
+    }
+    if (!directory.empty()) rmdir(directory.c_str());
+
+    if (ok) {
+        std::cout << "Test succeed" << std::endl;
+        return 0;
+    }
+    std::cout << "Test failed" << std::endl;
+    return 1;
+}
@@ -0,0 +1,227 @@
+//
+// Test of the binary matrix format: writer, mapped reader, zero-copy solvers and streamed panels
+//
+
+#include "BinaryReader.h"
+#include "CSVReader.h"
+#include "PanelSource.h"
+#include "PowerMethod.h"
+#include "StreamingPowerMethod.h"
+#include "TestHelpers.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+
+// Gives access to the matrix the solver works on
+struct PowerMethodProbe : PowerMethod<double> {
+    using PowerMethod<double>::PowerMethod;
+    const double* matrixData() const { return this->mMatrix.data(); }
+};
+
+std::string temporary(const std::string& suffix) {
+    return "/tmp/pcsc_test_binary_" + std::to_string(getpid()) + suffix;
+}
+
+// Real round trip with parameters; the solver uses the mapped pages in place
+bool test_real(const std::string& filename) {
+    Eigen::MatrixXd A = withEigenvalues(geometricSpectrum(120, 0.85));
+    Parameters params;
+    params.setAlgorithm("QRMethod");
+    params.setTolerance(1e-11);
+    params.setMaxIterations(321);
+    params.setNumValues(3);
+    BinaryMatrixWriter::write(filename, A, &params);
+
+    BinaryReader<double> reader(filename);
+    Parameters read = reader.ReadParameters();
+    BinaryReader<double>::MatrixMap view = reader.MapMatrix();
+    bool ok = view == A && reader.ReadMatrix() == A && reader.ReadMatrixRows(5, 7) == A.middleRows(5, 7) &&
+              read.getAlgorithm() == "QRMethod" && read.getTolerance() == 1e-11 &&
+              read.getMaxIterations() == 321 && read.getNumValues() == 3 &&
+              reinterpret_cast<std::uintptr_t>(view.data()) % kBinaryMatrixAlignment == 0;
+
+    Parameters pmParams;
+    pmParams.setTolerance(1e-10);
+    PowerMethodProbe pm(view, pmParams);
+    pm.solve();
+    PowerMethod<double> reference(A, pmParams);
+    reference.solve();
+    ok = ok && pm.matrixData() == view.data() && std::abs(pm.getEigenvalue() - reference.getEigenvalue()) < 1e-8;
+
+    std::cout << "Real round trip: " << (ok ? "ok" : "mismatch") << ", eigenvalue " << pm.getEigenvalue()
+              << " computed on the mapped pages" << std::endl;
+    return ok;
+}
+
+// Complex round trip, and real data read as complex
+bool test_complex(const std::string& filename) {
+    Eigen::MatrixXcd A = Eigen::MatrixXcd::Random(31, 17);
+    BinaryMatrixWriter::write(filename, A);
+    BinaryReader<std::complex<double>> reader(filename);
+    bool ok = reader.MapMatrix() == A && reader.ReadParameters().getAlgorithm() == "PowerMethod";
+
+    // A complex file cannot be read as real
+    try {
+        BinaryReader<double> realReader(filename);
+        realReader.ReadMatrix();
+        ok = false;
+    } catch (const std::runtime_error&) {}
+
+    Eigen::MatrixXd B = Eigen::MatrixXd::Random(9, 9);
+    BinaryMatrixWriter::write(filename, B);
+    BinaryReader<std::complex<double>> converting(filename);
+    ok = ok && converting.ReadMatrix() == B.cast<std::complex<double>>();
+    try {
+        converting.MapMatrix();
+        ok = false;
+    } catch (const std::runtime_error&) {}
+
+    std::cout << "Complex round trip: " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+// Row-major data written by another producer
+bool test_row_major(const std::string& filename) {
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> A = Eigen::MatrixXd::Random(6, 4);
+    BinaryMatrixHeader header{};
+    std::memcpy(header.magic, kBinaryMatrixMagic, sizeof(header.magic));
+    header.version = kBinaryMatrixVersion;
+    header.scalarType = kBinaryScalarReal;
+    header.rows = 6;
+    header.cols = 4;
+    header.storageOrder = 1;
+    header.dataOffset = sizeof(header);
+    {
+        std::ofstream file(filename, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(A.data()), sizeof(double) * A.size());
+    }
+    BinaryReader<double> reader(filename);
+    Eigen::MatrixXd expected = A;
+    bool ok = reader.ReadMatrix() == expected && reader.ReadMatrixRows(2, 3) == expected.middleRows(2, 3);
+    try {
+        reader.MapMatrix();
+        ok = false;
+    } catch (const std::runtime_error&) {}
+    std::cout << "Row-major file: " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+// Truncated files, foreign files and headers with out-of-range offsets are rejected
+bool test_corrupted(const std::string& filename) {
+    BinaryMatrixWriter::write(filename, Eigen::MatrixXd::Random(50, 50).eval());
+    truncate(filename.c_str(), 1000);
+    int rejected = 0;
+    try {
+        BinaryReader<double> reader(filename);
+    } catch (const std::runtime_error& e) {
+        std::cout << "Truncated file: " << e.what() << std::endl;
+        rejected++;
+    }
+    {
+        std::ofstream file(filename, std::ios::binary);
+        file << std::string(100, 'x');
+    }
+    try {
+        BinaryReader<double> reader(filename);
+    } catch (const std::runtime_error& e) {
+        std::cout << "Foreign file: " << e.what() << std::endl;
+        rejected++;
+    }
+
+    // Offsets near 2^64 that would wrap the end of the data or of the parameters back into the file
+    const std::uint64_t wrapping = ~std::uint64_t(0) - kBinaryMatrixAlignment + 1;
+    for (std::size_t field : {offsetof(BinaryMatrixHeader, dataOffset), offsetof(BinaryMatrixHeader, parameterBytes)}) {
+        BinaryMatrixWriter::write(filename, Eigen::MatrixXd::Random(4, 4).eval());
+        {
+            std::fstream file(filename, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(static_cast<std::streamoff>(field));
+            file.write(reinterpret_cast<const char*>(&wrapping), sizeof(wrapping));
+        }
+        try {
+            BinaryReader<double> reader(filename);
+        } catch (const std::runtime_error& e) {
+            std::cout << "Corrupted header: " << e.what() << std::endl;
+            rejected++;
+        }
+    }
+    return rejected == 4;
+}
+
+// Streamed Power Method on mapped panels
+bool test_panels(const std::string& filename) {
+    Eigen::MatrixXd A = withEigenvalues(geometricSpectrum(200, 0.85));
+    BinaryMatrixWriter::write(filename, A);
+    Parameters params;
+    params.setTolerance(1e-10);
+    BinaryPanelSource<double> source(filename, 23);
+    StreamingMatrix<double> matrix(source);
+    StreamingPowerMethod<double> spm(matrix, params);
+    spm.solve();
+    PowerMethod<double> reference(A, params);
+    reference.solve();
+    std::cout << "Mapped panels: eigenvalue " << spm.getEigenvalue() << " (in memory " << reference.getEigenvalue()
+              << ")" << std::endl;
+    return spm.hasConverged() && std::abs(spm.getEigenvalue() - reference.getEigenvalue()) < 1e-8;
+}
+
+// Load time of the same matrix from CSV and from the binary format
+void compare_load_times(const std::string& csv, const std::string& binary, int n) {
+    Eigen::MatrixXd A = Eigen::MatrixXd::Random(n, n);
+    {
+        std::ofstream file(csv);
+        file << std::setprecision(17);
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) file << A(i, j) << (j + 1 < n ? "," : "\n");
+        }
+        file << "Algorithm,PowerMethod\n";
+    }
+    BinaryMatrixWriter::write(binary, A);
+
+    auto start = std::chrono::steady_clock::now();
+    CSVReader<double> csvReader(csv);
+    Eigen::MatrixXd fromText = csvReader.ReadMatrix();
+    double csvSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    BinaryReader<double> binaryReader(binary);
+    double sum = binaryReader.MapMatrix().sum();  // touches every page
+    double binarySeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << n << "x" << n << " load: CSV " << csvSeconds << " s, binary (mapped, all pages touched) "
+              << binarySeconds << " s" << (std::abs(sum - fromText.sum()) < 1e-6 ? "" : " (MISMATCH)") << std::endl;
+}
+
+int main() {
+    std::string binary = temporary(".bmat");
+    std::string csv = temporary(".csv");
+
+    bool ok = true;
+    try {
+        ok = test_real(binary) && ok;
+        ok = test_complex(binary) && ok;
+        ok = test_row_major(binary) && ok;
+        ok = test_corrupted(binary) && ok;
+        ok = test_panels(binary) && ok;
+        compare_load_times(csv, binary, 1000);
+    } catch (const std::exception& e) {
+        std::cout << "Unexpected error: " << e.what() << std::endl;
+        ok = false;
+    }
+    std::remove(binary.c_str());
+    std::remove(csv.c_str());
+
+    if (ok) {
+        std::cout << "Test succeed" << std::endl;
+        return 0;
+    }
+    std::cout << "Test failed" << std::endl;
+    return 1;
+}
@@ -0,0 +1,128 @@
+//
+// Test of the binary result format: header and metadata, aligned blocks read back in place, errors and throughput
+//
+
+#include "BinaryResult.h"
+#include "BinaryWriter.h"
+#include "QRMethod.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+
+std::string temporary(const std::string& suffix) {
+    return "/tmp/pcsc_test_binarywriter_" + std::to_string(getpid()) + suffix;
+}
+
+// A QR result written with its algorithm and timing is read back exactly, in place
+bool test_roundtrip(const std::string& bres) {
+    Eigen::MatrixXd A = Eigen::MatrixXd::Random(8, 8);
+    A = A + A.transpose().eval();
+    Parameters params;
+    params.setAlgorithm("QRMethod");
+    QRMethod<double> qr(A, params);
+    auto start = std::chrono::steady_clock::now();
+    qr.solve();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    Eigen::VectorXd values = qr.getAllEigenvalues().real();
+    Eigen::MatrixXd vectors = qr.getAllEigenvectors().real();
+
+    BinaryWriter writer(bres, "QRMethod");
+    writer.setTiming("Solve", seconds);
+    writer.writeAll(values, vectors, qr.getIterationCount(), qr.hasConverged());
+
+    BinaryResultReader reader(bres);
+    const BinaryResultHeader& header = reader.header();
+    bool ok = header.count == 8 && header.rows == 8 && header.vectorCount == 8 &&
+              header.iterations == qr.getIterationCount() && header.converged == (qr.hasConverged() ? 1u : 0u) &&
+              reader.metadata("Algorithm") == "QRMethod" && std::stod(reader.metadata("SolveSeconds")) == seconds &&
+              reader.metadata("Tolerance").empty() && reader.MapEigenvalues<double>() == values &&
+              reader.MapEigenvectors<double>() == vectors &&
+              reinterpret_cast<std::uintptr_t>(reader.MapEigenvectors<double>().data()) % kBinaryMatrixAlignment == 0;
+
+    // Single complex pairs: one eigenvalue and one column, without metadata
+    Eigen::VectorXcd vector = Eigen::VectorXcd::Random(5);
+    BinaryWriter(bres).write(std::complex<double>(2, -1), vector, 17, false);
+    BinaryResultReader single(bres);
+    ok = ok && single.header().metadataBytes == 0 && single.header().converged == 0 &&
+         single.MapEigenvalues<std::complex<double>>()(0) == std::complex<double>(2, -1) &&
+         single.MapEigenvectors<std::complex<double>>() == vector;
+    try {
+        single.MapEigenvectors<double>();
+        ok = false;
+    } catch (const std::runtime_error& e) {
+        std::cout << "Rejected: " << e.what() << std::endl;
+    }
+    std::cout << "Round trip: " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+// Truncated files and other formats are rejected
+bool test_errors(const std::string& bres) {
+    Eigen::VectorXd values = Eigen::VectorXd::Ones(4);
+    Eigen::MatrixXd vectors = Eigen::MatrixXd::Identity(4, 4);
+    BinaryWriter(bres).writeAll(values, vectors, 1, true);
+    std::ifstream in(bres, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+
+    int rejected = 0;
+    for (const std::string& content : {bytes.substr(0, bytes.size() - 8), bytes.substr(0, 100),
+                                       std::string("PCSCMAT\x1a") + bytes.substr(8)}) {
+        std::ofstream(bres, std::ios::binary) << content;
+        try {
+            BinaryResultReader reader(bres);
+        } catch (const std::runtime_error& e) {
+            std::cout << "Rejected: " << e.what() << std::endl;
+            rejected++;
+        }
+    }
+    return rejected == 3;
+}
+
+// Writing a large eigenvector matrix through the mapping, against the text writer
+bool benchmark_writeAll(const std::string& bres, const std::string& csv, int n) {
+    Eigen::VectorXd values = Eigen::VectorXd::Random(n);
+    Eigen::MatrixXd vectors = Eigen::MatrixXd::Random(n, n);
+
+    auto start = std::chrono::steady_clock::now();
+    BinaryWriter(bres, "QRMethod").writeAll(values, vectors, 1, true);
+    double binarySeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    CSVWriter(csv).writeAll(values, vectors, 1, true);
+    double textSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    BinaryResultReader reader(bres);
+    std::ifstream text(csv, std::ios::binary | std::ios::ate);
+    std::cout << n << "x" << n << " result: binary " << (reader.header().vectorsOffset + 8.0 * n * n) / 1e6
+              << " MB in " << binarySeconds << " s, CSV " << static_cast<double>(text.tellg()) / 1e6 << " MB in " << textSeconds << " s"
+              << std::endl;
+    return reader.MapEigenvectors<double>() == vectors;
+}
+
+int main() {
+    std::string bres = temporary(".bres");
+    std::string csv = temporary(".csv");
+
+    bool ok = true;
+    try {
+        ok = test_roundtrip(bres) && ok;
+        ok = test_errors(bres) && ok;
+        ok = benchmark_writeAll(bres, csv, 2000) && ok;
+    } catch (const std::exception& e) {
+        std::cout << "Unexpected error: " << e.what() << std::endl;
+        ok = false;
+    }
+    std::remove(bres.c_str());
+    std::remove(csv.c_str());
+
+    if (ok) {
+        std::cout << "Test succeed" << std::endl;
+        return 0;
+    }
+    std::cout << "Test failed" << std::endl;
+    return 1;
+}
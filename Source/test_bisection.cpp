@@ -0,0 +1,147 @@
+//
+// Test of the Sturm bisection + inverse iteration solver for tridiagonal matrices
+//
+
+#include "TridiagonalReader.h"
+#include "BisectionMethod.h"
+#include <Eigen/Eigenvalues>
+#include <iostream>
+#include <cmath>
+#include <sstream>
+
+// Compare the selected eigenpairs with Eigen's dense symmetric solver
+bool test_small_file(const std::string& filename) {
+    TridiagonalReader reader(filename);
+    TridiagonalMatrix matrix = reader.ReadTridiagonal();
+    Parameters params = reader.ReadParameters();
+
+    BisectionMethod solver(matrix, params);
+    solver.solve();
+
+    Eigen::VectorXd eigenvalues = solver.getAllEigenvalues();
+    Eigen::MatrixXd eigenvectors = solver.getAllEigenvectors();
+    std::cout << "Selected eigenvalues: " << eigenvalues.transpose() << std::endl;
+
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> reference(matrix.toDense());
+    int first = params.getIndexLow() - 1;
+    if (eigenvalues.size() != params.getIndexHigh() - params.getIndexLow() + 1) {
+        std::cout << "Wrong number of eigenvalues" << std::endl;
+        return false;
+    }
+
+    double max_error = 0.0;
+    for (int k = 0; k < eigenvalues.size(); ++k) {
+        max_error = std::max(max_error, std::abs(eigenvalues(k) - reference.eigenvalues()(first + k)));
+        Eigen::VectorXd v = eigenvectors.col(k);
+        max_error = std::max(max_error, (matrix.multiply(v) - eigenvalues(k) * v).norm());
+    }
+    std::cout << "Maximum error against dense solver: " << max_error << std::endl;
+    return solver.hasConverged() && max_error < 1e-8;
+}
+
+// Non-symmetric matrix with lower(i) * upper(i) > 0: real spectrum through a diagonal similarity
+bool test_nonsymmetric() {
+    Eigen::VectorXd lower(4), diagonal(5), upper(4);
+    lower << 1, 2, 0.5, 3;
+    diagonal << 1, -2, 4, 0, 3;
+    upper << 4, 0.5, 2, 1;
+    TridiagonalMatrix matrix(lower, diagonal, upper);
+
+    Parameters params;
+    params.setTolerance(1e-12);
+    BisectionMethod solver(matrix, params);
+    solver.solve();
+
+    double max_error = 0.0;
+    for (int k = 0; k < solver.getAllEigenvalues().size(); ++k) {
+        Eigen::VectorXd v = solver.getAllEigenvectors().col(k);
+        max_error = std::max(max_error, (matrix.multiply(v) - solver.getAllEigenvalues()(k) * v).norm());
+    }
+    std::cout << "Non-symmetric residual: " << max_error << std::endl;
+    return solver.getAllEigenvalues().size() == 5 && max_error < 1e-8;
+}
+
+// Large 1D Laplacian with known spectrum 2 - 2cos(k pi / (n+1)), selected by value range
+bool test_large_laplacian(int n) {
+    Eigen::VectorXd off = Eigen::VectorXd::Constant(n - 1, -1.0);
+    TridiagonalMatrix matrix(off, Eigen::VectorXd::Constant(n, 2.0), off);
+
+    const double pi = std::acos(-1.0);
+    auto exact = [&](int k) { return 2.0 - 2.0 * std::cos(k * pi / (n + 1)); };
+
+    Parameters params;
+    params.setTolerance(1e-14);
+    params.setValueRange(0.0, 0.5 * (exact(4) + exact(5)));  // the four smallest eigenvalues
+    BisectionMethod solver(matrix, params);
+    solver.solve();
+
+    Eigen::VectorXd eigenvalues = solver.getAllEigenvalues();
+    if (eigenvalues.size() != 4) {
+        std::cout << "Wrong number of eigenvalues in value range: " << eigenvalues.size() << std::endl;
+        return false;
+    }
+    double max_error = 0.0;
+    for (int k = 0; k < 4; ++k) {
+        max_error = std::max(max_error, std::abs(eigenvalues(k) - exact(k + 1)));
+        Eigen::VectorXd v = solver.getAllEigenvectors().col(k);
+        max_error = std::max(max_error, (matrix.multiply(v) - eigenvalues(k) * v).norm());
+    }
+    std::cout << "Laplacian n=" << n << " maximum error: " << max_error << std::endl;
+    return max_error < 1e-8;
+}
+
+// Every eigenpair of a 1D Laplacian: neighbours are closer than 1e-3 ||T|| across the whole spectrum, which used
+// to make a single serial cluster; the split clusters still give orthonormal vectors
+bool test_dense_spectrum(int n) {
+    Eigen::VectorXd off = Eigen::VectorXd::Constant(n - 1, -1.0);
+    TridiagonalMatrix matrix(off, Eigen::VectorXd::Constant(n, 2.0), off);
+
+    Parameters params;
+    params.setTolerance(1e-14);
+    params.setThreads(4);
+    BisectionMethod solver(matrix, params);
+    solver.solve();
+
+    Eigen::MatrixXd V = solver.getAllEigenvectors();
+    double orthogonality = (V.transpose() * V - Eigen::MatrixXd::Identity(n, n)).cwiseAbs().maxCoeff();
+    // Each inverse iteration task allocates 7 vectors of n (see BisectionMethod::solve)
+    double fixed = static_cast<double>(n) * (n * sizeof(double) + sizeof(double) + sizeof(int));
+    double tasks = (solver.getStats().bytesAllocated - fixed) / (7.0 * n * sizeof(double));
+    std::cout << "Dense spectrum n=" << n << ": " << tasks << " inverse iteration tasks, orthogonality "
+              << orthogonality << ", residual " << solver.getStats().residual << std::endl;
+    return solver.hasConverged() && tasks >= n / 64 && orthogonality < 1e-8 && solver.getStats().residual < 1e-8;
+}
+
+// An index range needs both ends: IndexHigh without IndexLow is refused rather than dropped when written
+bool test_index_range() {
+    Parameters params;
+    bool ok = params.validate();
+    params.setIndexRange(0, 3);
+    ok = ok && !params.validate();
+    params.setValue("IndexLow", "2");
+    std::ostringstream text;
+    params.writeValues(text);
+    ok = ok && params.validate() && text.str().find("IndexLow,2\nIndexHigh,3\n") != std::string::npos;
+    std::cout << "Index range: " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+int main() {
+    try {
+        bool small = test_small_file("../data/test_matrix_tridiagonal.csv");
+        bool nonsymmetric = test_nonsymmetric();
+        bool large = test_large_laplacian(100000);
+        bool dense = test_dense_spectrum(2000);
+        bool range = test_index_range();
+
+        if (small && nonsymmetric && large && dense && range) {
+            std::cout << "Test succeed" << std::endl;
+            return 0;
+        }
+        std::cout << "Test failed" << std::endl;
+        return 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Error " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,225 @@
+//
+// Test of the result cache: keys, entries read back, damaged entries, LRU size cap, batches with duplicates
+//
+
+#include "BatchRunner.h"
+#include "BinaryMatrix.h"
+#include "ResultCache.h"
+#include "TestHelpers.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <dirent.h>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+void removeDirectory(const std::string& directory) {
+    if (DIR* listing = opendir(directory.c_str())) {
+        while (dirent* item = readdir(listing)) {
+            std::string name = item->d_name;
+            if (name == "." || name == "..") continue;
+            if (item->d_type == DT_DIR) {
+                removeDirectory(directory + "/" + name);
+            } else {
+                std::remove((directory + "/" + name).c_str());
+            }
+        }
+        closedir(listing);
+    }
+    rmdir(directory.c_str());
+}
+
+Parameters parameters(const std::string& algorithm) {
+    Parameters params;
+    params.setAlgorithm(algorithm);
+    params.setMaxIterations(10000);
+    params.setTolerance(1e-10);
+    return params;
+}
+
+// The key changes with any value of the matrices, the parameters of the solve and the scalar type
+bool test_keys() {
+    Eigen::MatrixXd A = Eigen::MatrixXd::Random(8, 8);
+    Eigen::MatrixXd none;
+    Parameters params = parameters("QRMethod");
+    const std::string key = ResultCache::key<double>(A, none, params);
+
+    Eigen::MatrixXd changed = A;
+    changed(7, 7) = std::nextafter(changed(7, 7), 2.0);
+    Parameters tolerance = params;
+    tolerance.setTolerance(1e-11);
+    Parameters iterations = params;
+    iterations.setMaxIterations(9999);
+    Parameters shift = params;
+    shift.setShift(0.5);
+    Parameters threads = params;
+    threads.setThreads(3);
+    threads.setHistoryCapacity(100);
+    Parameters eigenvectors = params;
+    eigenvectors.setEigenvectors("None");
+    Parameters indices = params;
+    indices.setIndexRange(1, 3);
+    Parameters pairs = params;
+    pairs.setComplexPairs(true);
+
+    bool ok = key.size() == 32 && key == ResultCache::key<double>(Eigen::MatrixXd(A), none, params) &&
+              key == ResultCache::key<double>(A, none, threads) &&
+              key != ResultCache::key<double>(changed, none, params) &&
+              key != ResultCache::key<double>(A, none, tolerance) &&
+              key != ResultCache::key<double>(A, none, iterations) &&
+              key != ResultCache::key<double>(A, none, shift) &&
+              key != ResultCache::key<double>(A, none, eigenvectors) &&
+              key != ResultCache::key<double>(A, none, indices) &&
+              key != ResultCache::key<double>(A, none, pairs) &&
+              key != ResultCache::key<double>(A, none, parameters("PowerMethod")) &&
+              key != ResultCache::key<double>(A, Eigen::MatrixXd::Identity(8, 8), params) &&
+              key != ResultCache::key<double>(Eigen::Map<Eigen::MatrixXd>(A.data(), 4, 16), none, params) &&
+              key != ResultCache::key<std::complex<double>>(A.cast<std::complex<double>>(), Eigen::MatrixXcd(), params);
+    std::cout << "Keys: " << key << ", " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+// Entries are read back as written; damaged entries are removed and never served
+bool test_entries(const std::string& directory) {
+    ResultCache cache(directory + "/entries");
+    Eigen::VectorXd values(5);
+    values << 1, 2, 3, 4, 10;
+    Eigen::MatrixXd A = withEigenvalues(values);
+    Parameters params = parameters("QRMethod");
+
+    bool hit = true;
+    SolveResult<double> solved = cache.solve<double>(A, Eigen::MatrixXd(), params, &hit);
+    bool ok = !hit;
+    SolveResult<double> served = cache.solve<double>(A, Eigen::MatrixXd(), params, &hit);
+    ok = ok && hit && served.eigenvalues == solved.eigenvalues && served.eigenvectors == solved.eigenvectors &&
+         served.iterations == solved.iterations && served.converged == solved.converged && !served.single;
+
+    params.setAlgorithm("PowerMethod");
+    Eigen::MatrixXcd C = A.cast<std::complex<double>>();
+    SolveResult<std::complex<double>> single = cache.solve<std::complex<double>>(C, Eigen::MatrixXcd(), params);
+    SolveResult<std::complex<double>> singleServed = cache.solve<std::complex<double>>(C, Eigen::MatrixXcd(), params,
+                                                                                       &hit);
+    ok = ok && hit && singleServed.single && singleServed.eigenvalues == single.eigenvalues;
+
+    // A flipped bit in the eigenvectors, a truncated file, an entry of other sizes
+    const std::string key = ResultCache::key<double>(A, Eigen::MatrixXd(), parameters("QRMethod"));
+    const std::string path = directory + "/entries/" + key + ".bres";
+    SolveResult<double> result;
+    ok = ok && !cache.load<double>(key, 5, 4, result);
+    cache.store<double>(key, 5, 5, "QRMethod", solved);
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekg(-3, std::ios::end);
+        char byte = static_cast<char>(file.get());
+        file.seekp(-3, std::ios::end);
+        file.put(static_cast<char>(byte ^ 0x10));
+    }
+    ok = ok && !cache.load<double>(key, 5, 5, result) && access(path.c_str(), F_OK) != 0;
+    cache.store<double>(key, 5, 5, "QRMethod", solved);
+    ok = ok && truncate(path.c_str(), 200) == 0 && !cache.load<double>(key, 5, 5, result);
+    cache.store<double>(key, 5, 5, "QRMethod", solved);
+    ok = ok && cache.load<double>(key, 5, 5, result);
+
+    CacheStats stats = cache.stats();
+    std::cout << "Entries: " << stats.hits << " hits, " << stats.misses << " misses, " << stats.corrupt
+              << " damaged, " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok && stats.corrupt == 3;
+}
+
+// Over the cap, the least recently used entries go first
+bool test_lru(const std::string& directory) {
+    Parameters params = parameters("QRMethod");
+    std::vector<Eigen::MatrixXd> matrices;
+    for (int i = 0; i < 4; ++i) matrices.push_back(withEigenvalues(Eigen::VectorXd::LinSpaced(20, 1, 20 + i)));
+
+    // The size of one entry, then a cap of three entries
+    std::uint64_t entryBytes;
+    {
+        ResultCache probe(directory + "/probe");
+        probe.solve<double>(matrices[0], Eigen::MatrixXd(), params);
+        entryBytes = probe.sizeBytes();
+    }
+    ResultCache cache(directory + "/lru", 3 * entryBytes);
+    for (int i = 0; i < 3; ++i) {
+        cache.solve<double>(matrices[i], Eigen::MatrixXd(), params);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    bool hit;
+    cache.solve<double>(matrices[0], Eigen::MatrixXd(), params, &hit);  // 0 used again: 1 is now the oldest
+    bool ok = hit;
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    cache.solve<double>(matrices[3], Eigen::MatrixXd(), params);
+
+    bool kept[4];
+    for (int i = 0; i < 4; ++i) {
+        SolveResult<double> result;
+        kept[i] = cache.load<double>(ResultCache::key<double>(matrices[i], Eigen::MatrixXd(), params), 20, 20, result);
+    }
+    ok = ok && kept[0] && !kept[1] && kept[2] && kept[3] && cache.stats().evictions == 1 &&
+         cache.sizeBytes() <= 3 * entryBytes;
+    std::cout << "LRU: " << cache.stats().evictions << " evicted, " << cache.sizeBytes() << " bytes of "
+              << 3 * entryBytes << ", " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+// Identical inputs of a batch are solved once; a second run is served by the cache
+bool test_batch(const std::string& directory, int size) {
+    Eigen::VectorXd values = Eigen::VectorXd::LinSpaced(size, 1, size);
+    values(size - 1) = 2 * size;
+    Parameters params = parameters("QRMethod");
+    std::vector<std::string> inputs;
+    Eigen::MatrixXd A = withEigenvalues(values);
+    for (int i = 0; i < 4; ++i) {
+        inputs.push_back(directory + "/copy_" + std::to_string(i) + ".bmat");
+        BinaryMatrixWriter::write(inputs.back(), A, &params);
+    }
+    inputs.push_back(directory + "/other.bmat");
+    BinaryMatrixWriter::write(inputs.back(), withEigenvalues(values), &params);
+
+    BatchOptions options;
+    options.outputDirectory = directory;
+    options.format = "bres";
+    options.jobs = 2;
+    options.cacheDirectory = directory + "/batch_cache";
+    std::ostringstream log;
+    BatchStats first = BatchRunner<double>(options).run(inputs, log);
+    BatchStats second = BatchRunner<double>(options).run(inputs, log);
+    std::cout << log.str();
+
+    bool ok = first.solved == 5 && first.duplicates == 3 && first.cached == 0 && second.solved == 5 &&
+              second.cached == 2 && second.duplicates == 3;
+    std::cout << size << "x" << size << " QR: first run " << first.wallSeconds << " s, second run (cache) "
+              << second.wallSeconds << " s, " << (ok ? "ok" : "mismatch") << std::endl;
+    for (const std::string& input : inputs) {
+        std::remove(input.c_str());
+        std::remove((directory + "/" + resultName(input, ".bres")).c_str());
+    }
+    return ok;
+}
+
+int main() {
+    bool ok = true;
+    std::string directory;
+    try {
+        directory = temporaryDirectory("cache");
+        ok = test_keys() && ok;
+        ok = test_entries(directory) && ok;
+        ok = test_lru(directory) && ok;
+        ok = test_batch(directory, 30) && ok;
+    } catch (const std::exception& e) {
+        std::cout << "Unexpected error: " << e.what() << std::endl;
+        ok = false;
+    }
+    if (!directory.empty()) removeDirectory(directory);
+
+    if (ok) {
+        std::cout << "Test succeed" << std::endl;
+        return 0;
+    }
+    std::cout << "Test failed" << std::endl;
+    return 1;
+}
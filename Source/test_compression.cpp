@@ -0,0 +1,248 @@
+//
+// Test of compressed inputs: gzip CSV/text files decompressed on a background thread while they are indexed
+//
+
+#include "CSVReader.h"
+#include "Decompressor.h"
+#include "TestHelpers.h"
+#include "TextFileReader.h"
+#include "TextMatrixParser.h"
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#ifdef PCSC_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef PCSC_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+std::string temporary(const std::string& suffix) {
+    return "/tmp/pcsc_test_compression_" + std::to_string(getpid()) + suffix;
+}
+
+#ifdef PCSC_HAVE_ZLIB
+// One gzip member holding the text, as written by gzip
+std::string gzip(const std::string& text, int level = Z_DEFAULT_COMPRESSION) {
+    z_stream stream{};
+    deflateInit2(&stream, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+    std::string out(deflateBound(&stream, static_cast<uLong>(text.size())) + 32, '\0');
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(text.data()));
+    stream.avail_in = static_cast<uInt>(text.size());
+    stream.next_out = reinterpret_cast<Bytef*>(&out[0]);
+    stream.avail_out = static_cast<uInt>(out.size());
+    deflate(&stream, Z_FINISH);
+    out.resize(stream.total_out);
+    deflateEnd(&stream);
+    return out;
+}
+
+// The compressed files give the same matrices and parameters as the plain ones
+bool test_readers(const std::string& csv, const std::string& text) {
+    const std::string content = "1.5,-2,3e-3\n4,+5.25,-6e2\nMatrixB\n1,0,0\n0,1,0\nAlgorithm,QRMethod\nMaxIterations,77\n";
+    writeFile(csv, content);
+    writeFile(csv + ".gz", gzip(content));
+    CSVReader<double> plain(csv);
+    CSVReader<double> compressed(csv + ".gz");
+    Parameters params = compressed.ReadParameters();
+    bool ok = compressed.GetCompression() == Compression::Gzip && plain.GetCompression() == Compression::None &&
+              compressed.ReadMatrix() == plain.ReadMatrix() && compressed.ReadMatrixB() == plain.ReadMatrixB() &&
+              params.getAlgorithm() == "QRMethod" && params.getMaxIterations() == 77;
+
+    // Recognized by its bytes: the suffix only gives the format, and complex literals are read as well
+    const std::string complex = "1+2i 3\n-4i 5.5\n";
+    writeFile(text + ".gz", gzip(complex));
+    writeFile(text, complex);
+    ok = ok && TextFileReader<std::complex<double>>(text + ".gz").ReadMatrix() ==
+                   TextFileReader<std::complex<double>>(text).ReadMatrix();
+
+    std::cout << "Readers: " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+// Concatenated members (pigz, "cat a.gz b.gz") and chunks smaller than a line
+bool test_stream(const std::string& gz) {
+    std::string text;
+    for (int i = 0; i < 20000; ++i) text += std::to_string(i) + "," + std::to_string(-i) + "\n";
+    writeFile(gz, gzip(text.substr(0, 100001)) + gzip(text.substr(100001), 1));
+
+    Decompressor input(gz, 777, 2);
+    std::string inflated;
+    std::vector<char> chunk;
+    std::size_t chunks = 0;
+    while (input.next(chunk)) {
+        inflated.append(chunk.begin(), chunk.end());
+        chunks++;
+    }
+    bool ok = inflated == text && chunks == (text.size() + 776) / 777 && !input.next(chunk) && chunk.empty();
+
+    // A consumer leaving early stops the thread
+    {
+        Decompressor early(gz, 100, 1);
+        ok = ok && early.next(chunk) && chunk.size() == 100;
+    }
+
+    TextMatrixParser parser(gz);
+    ok = ok && parser.rows(TextMatrixParser::Section::A) == 20000 && parser.size() == text.size() &&
+         parser.parse<double>(TextMatrixParser::Section::A)(19999, 1) == -19999;
+    std::cout << "Stream: " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+// NUL padding after the last member is ignored, as by gzip -d; a member after the padding is not
+bool test_padding(const std::string& gz) {
+    const std::string text = "1,2\n3,4\nAlgorithm,QRMethod\n";
+    writeFile(gz, gzip(text) + std::string(512, '\0'));
+    bool ok = CSVReader<double>(gz).ReadMatrix() == (Eigen::MatrixXd(2, 2) << 1, 2, 3, 4).finished();
+
+    writeFile(gz, gzip(text) + std::string(512, '\0') + gzip(text));
+    try {
+        CSVReader<double>(gz).ReadMatrix();
+        ok = false;
+    } catch (const std::runtime_error& e) {
+        std::cout << "Rejected: " << e.what() << std::endl;
+    }
+    std::cout << "Padding: " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+// Truncated and corrupted files are rejected with a message, other formats cannot be compressed
+bool test_errors(const std::string& gz, const std::string& binary) {
+    std::string compressed = gzip("1,2\n3,4\n");
+    std::string corrupted = compressed;
+    corrupted[12] = static_cast<char>(corrupted[12] ^ 0x5a);
+    int rejected = 0;
+    for (const std::string& bytes : {compressed.substr(0, compressed.size() - 12), corrupted}) {
+        writeFile(gz, bytes);
+        try {
+            CSVReader<double>(gz).ReadMatrix();
+        } catch (const std::runtime_error& e) {
+            std::cout << "Rejected: " << e.what() << std::endl;
+            rejected++;
+        }
+    }
+    writeFile(binary, compressed);
+    try {
+        CSVReader<double> reader(binary);
+    } catch (const std::runtime_error& e) {
+        std::cout << "Rejected: " << e.what() << std::endl;
+        rejected++;
+    }
+    std::remove(binary.c_str());
+    return rejected == 3;
+}
+
+// Reading a large matrix from the plain file and from the compressed one
+bool benchmark_throughput(const std::string& csv, int n) {
+    Eigen::MatrixXd A = Eigen::MatrixXd::Random(n, n);
+    std::ostringstream text;
+    text << std::setprecision(17);
+    for (long i = 0; i < A.rows(); ++i) {
+        for (long j = 0; j < A.cols(); ++j) text << (j ? "," : "") << A(i, j);
+        text << "\n";
+    }
+    writeFile(csv, text.str());
+    writeFile(csv + ".gz", gzip(text.str(), 1));
+
+    auto start = std::chrono::steady_clock::now();
+    Eigen::MatrixXd plain = CSVReader<double>(csv).ReadMatrix();
+    double plainSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    TextMatrixParser parser(csv + ".gz");
+    Eigen::MatrixXd compressed = parser.parse<double>(TextMatrixParser::Section::A);
+    double compressedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double megabytes = text.str().size() / 1e6;
+    std::cout << n << "x" << n << " matrix, " << megabytes << " MB (" << readFile(csv + ".gz").size() / 1e6
+              << " MB compressed): plain " << megabytes / plainSeconds << " MB/s, gzip "
+              << megabytes / compressedSeconds << " MB/s" << std::endl;
+    parser.reportTimings(std::cout);
+    std::remove((csv + ".gz").c_str());
+    return plain == A && compressed == A;
+}
+#endif
+
+#ifdef PCSC_HAVE_ZSTD
+// One zstd frame holding the text, as written by zstd
+std::string zstd(const std::string& text, int level = 3) {
+    std::string compressed(ZSTD_compressBound(text.size()), '\0');
+    std::size_t size = ZSTD_compress(&compressed[0], compressed.size(), text.data(), text.size(), level);
+    if (ZSTD_isError(size)) throw std::runtime_error(ZSTD_getErrorName(size));
+    compressed.resize(size);
+    return compressed;
+}
+
+// Concatenated frames in chunks smaller than a line, a CSV reader on a .csv.zst file, and a truncated frame
+bool test_zstd(const std::string& zst) {
+    std::string text;
+    for (int i = 0; i < 20000; ++i) text += std::to_string(i) + "," + std::to_string(-i) + "\n";
+    std::string compressed = zstd(text.substr(0, 100001)) + zstd(text.substr(100001), 1);
+    writeFile(zst, compressed);
+
+    Decompressor input(zst, 777, 2);
+    std::string inflated;
+    std::vector<char> chunk;
+    while (input.next(chunk)) inflated.append(chunk.begin(), chunk.end());
+    Eigen::MatrixXd A = CSVReader<double>(zst).ReadMatrix();
+    bool ok = input.compression() == Compression::Zstd && inflated == text && A.rows() == 20000 &&
+              A(19999, 1) == -19999;
+
+    writeFile(zst, compressed.substr(0, compressed.size() - 10));
+    try {
+        CSVReader<double>(zst).ReadMatrix();
+        ok = false;
+    } catch (const std::runtime_error& e) {
+        std::cout << "Rejected: " << e.what() << std::endl;
+    }
+    std::cout << "zstd: " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+#endif
+
+int main() {
+    std::string csv = temporary(".csv");
+    std::string text = temporary(".txt");
+    std::string gz = temporary(".csv.gz");
+
+    bool ok = true;
+    try {
+#ifdef PCSC_HAVE_ZLIB
+        ok = test_readers(csv, text) && ok;
+        ok = test_stream(gz) && ok;
+        ok = test_padding(gz) && ok;
+        ok = test_errors(gz, temporary(".bmat.gz")) && ok;
+        ok = benchmark_throughput(csv, 1000) && ok;
+#else
+        // Without zlib, gzip files are recognized and rejected with a message
+        writeFile(gz, std::string("\x1f\x8b\x08\x00", 4));
+        try {
+            CSVReader<double>(gz).ReadMatrix();
+            ok = false;
+        } catch (const std::runtime_error& e) {
+            std::cout << "Rejected: " << e.what() << std::endl;
+        }
+#endif
+#ifdef PCSC_HAVE_ZSTD
+        ok = test_zstd(temporary(".csv.zst")) && ok;
+#endif
+    } catch (const std::exception& e) {
+        std::cout << "Unexpected error: " << e.what() << std::endl;
+        ok = false;
+    }
+    for (const std::string& file : {csv, text, csv + ".gz", text + ".gz", gz, temporary(".csv.zst")}) {
+        std::remove(file.c_str());
+    }
+
+    if (ok) {
+        std::cout << "Test succeed" << std::endl;
+        return 0;
+    }
+    std::cout << "Test failed" << std::endl;
+    return 1;
+}
@@ -0,0 +1,150 @@
+//
+// Test of the distributed Power Method: the ranks are forked processes connected by SocketTransport
+//
+
+#include "CSVReader.h"
+#include "DistributedPowerMethod.h"
+#include "SocketTransport.h"
+#include <Eigen/Eigenvalues>
+#include <cstdio>
+#include <iostream>
+#include <netinet/in.h>
+#include <random>
+#include <string>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Runs body(rank) on `ranks` processes (rank 0 in the caller) and returns true if all of them returned true
+template <typename Body>
+bool run_ranks(int ranks, Body body) {
+    std::vector<pid_t> children;
+    for (int rank = 1; rank < ranks; ++rank) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            bool ok = false;
+            try {
+                ok = body(rank);
+            } catch (const std::exception& e) {
+                std::cerr << "Rank " << rank << ": " << e.what() << std::endl;
+            }
+            std::fflush(nullptr);
+            _exit(ok ? 0 : 1);
+        }
+        children.push_back(pid);
+    }
+
+    bool ok = false;
+    try {
+        ok = body(0);
+    } catch (const std::exception& e) {
+        std::cerr << "Rank 0: " << e.what() << std::endl;
+    }
+    for (pid_t pid : children) {
+        int status = 0;
+        waitpid(pid, &status, 0);
+        ok = ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+    return ok;
+}
+
+// A free TCP port on the loopback interface
+int free_port() {
+    int probe = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    bind(probe, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    socklen_t length = sizeof(addr);
+    getsockname(probe, reinterpret_cast<sockaddr*>(&addr), &length);
+    close(probe);
+    return ntohs(addr.sin_port);
+}
+
+bool test_row_reader() {
+    CSVReader<double> reader("../data/test_matrix_distributed.csv");
+    Eigen::MatrixXd full = reader.ReadMatrix();
+    Eigen::MatrixXd block = reader.ReadMatrixRows(2, 3);
+    bool ok = reader.CountMatrixRows() == full.rows() && block.isApprox(full.middleRows(2, 3));
+    std::cout << "Row block reader: " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+// Each rank reads its own rows of the file; Unix-domain sockets
+bool test_file(int ranks) {
+    std::string address = "unix:/tmp/pcsc_test_distributed_" + std::to_string(getpid()) + ".sock";
+    CSVReader<double> reader("../data/test_matrix_distributed.csv");
+    Eigen::MatrixXd A = reader.ReadMatrix();
+    Parameters params = reader.ReadParameters();
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> reference(A);
+    double expected = reference.eigenvalues().cwiseAbs().maxCoeff();
+
+    return run_ranks(ranks, [&](int rank) {
+        SocketTransport transport(address, rank, ranks, 10.0);
+        CSVReader<double> localReader("../data/test_matrix_distributed.csv");
+        DistributedMatrix<double> matrix = DistributedMatrix<double>::fromReader(localReader, transport);
+        DistributedPowerMethod<double> pm(matrix, params);
+        pm.solve();
+        pm.reportTimings(std::cout);
+
+        double error = std::abs(pm.getEigenvalue() - expected);
+        if (rank == 0) {
+            std::cout << ranks << " ranks (unix): eigenvalue " << pm.getEigenvalue() << ", expected " << expected
+                      << ", " << pm.getIterationCount() << " iterations" << std::endl;
+        }
+        return pm.hasConverged() && error < 1e-8 && matrix.localRows().rows() < A.rows();
+    });
+}
+
+// Complex random matrix generated identically on every rank and sliced; TCP on the loopback interface
+bool test_tcp(int ranks, int n) {
+    std::string address = "tcp:127.0.0.1:" + std::to_string(free_port());
+
+    return run_ranks(ranks, [&](int rank) {
+        std::mt19937 generator(7);
+        std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+        Eigen::MatrixXcd A(n, n);
+        for (int j = 0; j < n; ++j)
+            for (int i = 0; i < n; ++i) A(i, j) = std::complex<double>(uniform(generator), uniform(generator));
+        A(0, 0) += std::complex<double>(4.0 * n, 1.0 * n);
+
+        SocketTransport transport(address, rank, ranks, 10.0);
+        long first, count;
+        DistributedMatrix<std::complex<double>>::rowRange(n, rank, ranks, first, count);
+        DistributedMatrix<std::complex<double>> matrix(A.middleRows(first, count), n, transport);
+
+        // Distributed inner product against the serial one
+        Eigen::VectorXcd a = Eigen::VectorXcd::Constant(n, std::complex<double>(1.0, 2.0));
+        Eigen::VectorXcd b = A.col(3);
+        std::complex<double> dot = matrix.dot(a.segment(first, count), b.segment(first, count));
+        double dotError = std::abs(dot - a.dot(b));
+
+        Parameters params;
+        params.setTolerance(1e-10);
+        DistributedPowerMethod<std::complex<double>> pm(matrix, params);
+        pm.solve();
+        pm.reportTimings(std::cout);
+
+        Eigen::VectorXcd v = pm.getEigenvector();
+        double residual = (A * v - pm.getEigenvalue() * v).norm() / std::abs(pm.getEigenvalue());
+        if (rank == 0) {
+            std::cout << ranks << " ranks (tcp): eigenvalue " << pm.getEigenvalue() << ", relative residual "
+                      << residual << ", dot error " << dotError << std::endl;
+        }
+        return pm.hasConverged() && residual < 1e-8 && dotError < 1e-10;
+    });
+}
+
+int main() {
+    bool ok = test_row_reader();
+    ok = test_file(3) && ok;
+    ok = test_tcp(4, 300) && ok;
+
+    if (ok) {
+        std::cout << "Test succeed" << std::endl;
+        return 0;
+    }
+    std::cout << "Test failed" << std::endl;
+    return 1;
+}
@@ -0,0 +1,192 @@
+//
+// Test of the eigenvector modes of QRMethod: eigenvalues only (no accumulated Q), and true eigenvectors of selected
+// eigenvalues by back-substitution on the Schur form, refused where it is not triangular
+//
+
+#include "GeneralizedQRMethod.h"
+#include "QRMethod.h"
+#include "TestHelpers.h"
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// ||A x - lambda x|| for the eigenvalue at the same index
+template<typename Matrix, typename Vector>
+double residual(const Matrix& A, const Vector& eigenvalues, const Matrix& eigenvectors, int index) {
+    return (A * eigenvectors.col(index) - eigenvalues(index) * eigenvectors.col(index)).norm();
+}
+
+// The same eigenvalues with and without eigenvectors, for less work and memory when Q is not accumulated
+bool test_eigenvalues_only() {
+    Eigen::VectorXd values(6);
+    values << 1, 2, 4, 8, 16, 32;
+    Eigen::MatrixXd A = nonsymmetric<double>(values);
+    Parameters params;
+    params.setMaxIterations(10000);
+    params.setTolerance(1e-12);
+
+    QRMethod<double> all(A, params);
+    all.solve();
+    params.setComputeEigenvectors(false);
+    QRMethod<double> none(A, params);
+    none.solve();
+
+    bool ok = all.hasConverged() && none.hasConverged() &&
+              none.getIterationCount() == all.getIterationCount() &&
+              none.getAllEigenvalues() == all.getAllEigenvalues() &&
+              none.getAllEigenvectors().cols() == 0 && none.getEigenvector().size() == 0 &&
+              none.getStats().flops < all.getStats().flops &&
+              none.getStats().bytesAllocated < all.getStats().bytesAllocated;
+    std::cout << "Eigenvalues only: " << none.getStats().flops << " flops instead of " << all.getStats().flops
+              << ", " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+// The selected columns are unit eigenvectors, even where the Schur vector is not one; the others are zero
+bool test_selected() {
+    Eigen::VectorXd values(6);
+    values << 1, 2, 4, 8, 16, 32;
+    Eigen::MatrixXd A = nonsymmetric<double>(values);
+    Parameters params;
+    params.setMaxIterations(10000);
+    params.setTolerance(1e-12);
+
+    QRMethod<double> schur(A, params);
+    schur.solve();
+    params.setEigenvectorIndices({5, 2});
+    QRMethod<double> selected(A, params);
+    selected.solve();
+
+    Eigen::VectorXd found = selected.getAllEigenvalues();
+    Eigen::MatrixXd V = selected.getAllEigenvectors();
+    bool ok = selected.hasConverged() && V.cols() == 6;
+    for (int i = 0; i < 6; ++i) {
+        if (i == 1 || i == 4) {
+            ok = ok && std::abs(V.col(i).norm() - 1) < 1e-12 && residual(A, found, V, i) < 1e-8 * found.norm();
+        } else {
+            ok = ok && V.col(i).isZero(0);
+        }
+    }
+    double schurResidual = residual(A, found, schur.getAllEigenvectors(), 4);
+    ok = ok && schurResidual > 1e-3;
+
+    // The dominant eigenvalue 32 is not selected: its eigenvector is still the one of getEigenvector()
+    Eigen::Index dominant;
+    found.cwiseAbs().maxCoeff(&dominant);
+    Eigen::VectorXd x = selected.getEigenvector();
+    ok = ok && dominant != 1 && dominant != 4 && std::abs(x.norm() - 1) < 1e-12 &&
+         (A * x - found(dominant) * x).norm() < 1e-8 * found.norm() && V.col(dominant).isZero(0);
+
+    // Every eigenvector, on four threads
+    params.setEigenvectorIndices({1, 2, 3, 4, 5, 6});
+    params.setThreads(4);
+    QRMethod<double> threaded(A, params);
+    threaded.solve();
+    for (int i = 0; i < 6; ++i) {
+        ok = ok && residual(A, threaded.getAllEigenvalues(), threaded.getAllEigenvectors(), i) < 1e-8 * found.norm();
+    }
+    std::cout << "Selected eigenvectors: Schur vector residual " << schurResidual << ", "
+              << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+// Complex eigenvalues of distinct magnitudes, and an index out of range
+bool test_complex() {
+    Eigen::VectorXcd values(5);
+    for (int i = 0; i < 5; ++i) values(i) = std::polar(std::pow(2.0, i), 0.7 * i);
+    Eigen::MatrixXcd A = nonsymmetric<std::complex<double>>(values);
+    Parameters params;
+    params.setMaxIterations(10000);
+    params.setTolerance(1e-12);
+    params.setEigenvectors("1 4");
+    QRMethod<std::complex<double>> qr(A, params);
+    qr.solve();
+    bool ok = qr.hasConverged() &&
+              residual(A, qr.getAllEigenvalues(), qr.getAllEigenvectors(), 0) < 1e-8 &&
+              residual(A, qr.getAllEigenvalues(), qr.getAllEigenvectors(), 3) < 1e-8;
+
+    params.setEigenvectors("6");
+    QRMethod<std::complex<double>> outOfRange(A, params);
+    try {
+        outOfRange.solve();
+        ok = false;
+    } catch (const std::runtime_error&) {
+    }
+    std::cout << "Complex eigenvectors: " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+// A real matrix with a complex conjugate pair: the QR Method keeps a 2x2 block and does not converge, and no
+// eigenvector is made up from it
+bool test_complex_pair() {
+    Eigen::MatrixXd D(3, 3);
+    D << 0, -1, 0,
+         1, 0, 0,
+         0, 0, 3;
+    Eigen::MatrixXd S = Eigen::MatrixXd::Random(3, 3) + 2.0 * Eigen::MatrixXd::Identity(3, 3);
+    Eigen::MatrixXd A = S * D * S.inverse();
+    Parameters params;
+    params.setMaxIterations(500);
+    params.setTolerance(1e-12);
+    params.setEigenvectors("1 2");
+    QRMethod<double> qr(A, params);
+    qr.solve();
+    Eigen::MatrixXd V = qr.getAllEigenvectors();
+    bool ok = !qr.hasConverged() && V.cols() == 3 && V.isZero(0);
+    std::cout << "Complex pair of a real matrix: " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+// The Eigenvectors parameter as the input files write it, and a generalized problem without eigenvectors
+bool test_parameters() {
+    Parameters params;
+    bool ok = params.getEigenvectors() == "All";
+    params.setValue("Eigenvectors", "2 5");
+    std::ostringstream text;
+    params.writeValues(text);
+    ok = ok && params.getEigenvectorIndices() == std::vector<int>({2, 5}) &&
+         text.str().find("Eigenvectors,2 5\n") != std::string::npos && params.validate();
+    params.setValue("Eigenvectors", "None");
+    ok = ok && !params.getComputeEigenvectors() && params.getEigenvectors() == "None";
+    try {
+        params.setValue("Eigenvectors", "first");
+        ok = false;
+    } catch (const std::invalid_argument&) {
+    }
+
+    Eigen::MatrixXd M = Eigen::MatrixXd::Random(8, 8);
+    Eigen::MatrixXd A = M + M.transpose();
+    Eigen::MatrixXd B = M * M.transpose() + 8 * Eigen::MatrixXd::Identity(8, 8);
+    params.setTolerance(1e-10);
+    params.setMaxIterations(10000);
+    GeneralizedQRMethod<double> generalized(A, B, params);
+    generalized.solve();
+    ok = ok && generalized.getAllEigenvalues().size() == 8 && generalized.getAllEigenvectors().cols() == 0;
+    std::cout << "Parameters: " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+int main() {
+    bool ok = true;
+    try {
+        ok = test_eigenvalues_only() && ok;
+        ok = test_selected() && ok;
+        ok = test_complex() && ok;
+        ok = test_complex_pair() && ok;
+        ok = test_parameters() && ok;
+    } catch (const std::exception& e) {
+        std::cout << "Unexpected error: " << e.what() << std::endl;
+        ok = false;
+    }
+
+    if (ok) {
+        std::cout << "Test succeed" << std::endl;
+        return 0;
+    }
+    std::cout << "Test failed" << std::endl;
+    return 1;
+}
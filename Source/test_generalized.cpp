@@ -0,0 +1,139 @@
+//
+// Test of the generalized eigenvalue solvers (A x = lambda B x)
+//
+
+#include "CSVReader.h"
+#include "GeneralizedPowerMethod.h"
+#include "GeneralizedShiftedInversePowerMethod.h"
+#include "GeneralizedQRMethod.h"
+#include <iostream>
+#include <complex>
+
+template <typename Matrix, typename Vector, typename Scalar>
+double residual(const Matrix& A, const Matrix& B, const Vector& x, Scalar lambda) {
+    return (A * x - lambda * (B * x)).norm() / x.norm();
+}
+
+// Symmetric-definite pair read from a file: Cholesky reduction, power and shift-invert variants
+bool test_symmetric_definite(const std::string& filename) {
+    CSVReader<double> reader(filename);
+    Eigen::MatrixXd A = reader.ReadMatrix();
+    Eigen::MatrixXd B = reader.ReadMatrixB();
+    Parameters params = reader.ReadParameters();
+
+    if (B.rows() != 3 || B.cols() != 3) {
+        std::cout << "Matrix B was not read" << std::endl;
+        return false;
+    }
+
+    GeneralizedQRMethod<double> qr(A, B, params);
+    qr.solve();
+    double max_error = 0.0;
+    for (int i = 0; i < qr.getAllEigenvalues().size(); ++i) {
+        max_error = std::max(max_error, residual(A, B, Eigen::VectorXd(qr.getAllEigenvectors().col(i)),
+                                                 qr.getAllEigenvalues()(i)));
+    }
+    std::cout << "Cholesky path eigenvalues: " << qr.getAllEigenvalues().transpose()
+              << "  (symmetric-definite: " << qr.isSymmetricDefinite() << ")" << std::endl;
+
+    GeneralizedPowerMethod<double> pm(A, B, params);
+    pm.solve();
+    max_error = std::max(max_error, residual(A, B, pm.getEigenvector(), pm.getEigenvalue()));
+    std::cout << "Power method eigenvalue: " << pm.getEigenvalue() << std::endl;
+
+    GeneralizedShiftedInversePowerMethod<double> sipm(A, B, params);
+    sipm.solve();
+    sipm.solve();  // second call reuses the cached factorization
+    max_error = std::max(max_error, residual(A, B, sipm.getEigenvector(), sipm.getEigenvalue()));
+    std::cout << "Shift-invert eigenvalue (shift " << params.getShift() << "): " << sipm.getEigenvalue() << std::endl;
+
+    std::cout << "Symmetric-definite maximum residual: " << max_error << std::endl;
+    return qr.isSymmetricDefinite() && max_error < 1e-6;
+}
+
+// Non-symmetric real pair with real spectrum {1, 2, 3, 5}: QZ path
+bool test_general_real() {
+    Eigen::MatrixXd S(4, 4), B(4, 4);
+    S << 1, 2, 0, 1,
+         0, 1, 3, 0,
+         1, 0, 1, 2,
+         2, 1, 0, 1;
+    B << 3, 1, 0, 2,
+         1, 4, 1, 0,
+         0, 2, 5, 1,
+         1, 0, 1, 3;
+    Eigen::VectorXd d(4);
+    d << 1, 2, 3, 5;
+    Eigen::MatrixXd A = B * S * d.asDiagonal() * S.inverse();
+
+    GeneralizedQRMethod<double> qz(A, B, Parameters());
+    qz.solve();
+    double max_error = 0.0;
+    for (int i = 0; i < 4; ++i) {
+        max_error = std::max(max_error, residual(A, B, Eigen::VectorXd(qz.getAllEigenvectors().col(i)),
+                                                 qz.getAllEigenvalues()(i)));
+    }
+    std::cout << "QZ path eigenvalues: " << qz.getAllEigenvalues().transpose() << std::endl;
+    std::cout << "QZ path maximum residual: " << max_error << std::endl;
+    return !qz.isSymmetricDefinite() && max_error < 1e-8;
+}
+
+// Real pair with the complex eigenvalues +-i: the real result keeps their real parts and reports no convergence,
+// the complex type finds them
+bool test_general_real_complex_eigenvalues() {
+    Eigen::MatrixXd A(3, 3), B(3, 3);
+    A << 0, -1, 0,
+         1, 0, 0,
+         0, 0, 3;
+    B << 2, 1, 0,
+         0, 1, 1,
+         1, 0, 3;
+    A = B * A;
+
+    GeneralizedQRMethod<double> qz(A, B, Parameters());
+    qz.solve();
+    GeneralizedQRMethod<std::complex<double>> complex(A.cast<std::complex<double>>(), B.cast<std::complex<double>>(),
+                                                      Parameters());
+    complex.solve();
+    int pairs = 0;
+    for (int i = 0; i < 3; ++i) {
+        if (std::abs(std::abs(complex.getAllEigenvalues()(i).imag()) - 1.0) < 1e-8) ++pairs;
+    }
+    std::cout << "QZ path with complex eigenvalues converged: " << (qz.hasConverged() ? "Yes" : "No") << std::endl;
+    return !qz.hasConverged() && complex.hasConverged() && pairs == 2;
+}
+
+// General complex pair
+bool test_general_complex() {
+    Eigen::MatrixXcd A = Eigen::MatrixXcd::Random(5, 5);
+    Eigen::MatrixXcd B = Eigen::MatrixXcd::Random(5, 5) + 5.0 * Eigen::MatrixXcd::Identity(5, 5);
+
+    GeneralizedQRMethod<std::complex<double>> solver(A, B, Parameters());
+    solver.solve();
+    double max_error = 0.0;
+    for (int i = 0; i < 5; ++i) {
+        max_error = std::max(max_error, residual(A, B, Eigen::VectorXcd(solver.getAllEigenvectors().col(i)),
+                                                 solver.getAllEigenvalues()(i)));
+    }
+    std::cout << "Complex pair maximum residual: " << max_error << std::endl;
+    return max_error < 1e-8;
+}
+
+int main() {
+    try {
+        bool symmetric = test_symmetric_definite("../data/test_matrix_generalized.csv");
+        bool real = test_general_real();
+        bool realComplexEigenvalues = test_general_real_complex_eigenvalues();
+        bool complex = test_general_complex();
+
+        if (symmetric && real && realComplexEigenvalues && complex) {
+            std::cout << "Test succeed" << std::endl;
+            return 0;
+        }
+        std::cout << "Test failed" << std::endl;
+        return 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Error " << e.what() << std::endl;
+        return 1;
+    }
+}
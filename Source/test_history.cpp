@@ -0,0 +1,162 @@
+//
+// Test of the convergence history: ring buffer, traces recorded by the solvers, PlotWriter and ConsoleWriter
+//
+
+#include "ConsoleWriter.h"
+#include "ConvergenceHistory.h"
+#include "GeneralizedQRMethod.h"
+#include "PlotWriter.h"
+#include "PowerMethod.h"
+#include "QRMethod.h"
+#include "ShiftedInversePowerMethod.h"
+#include "TestHelpers.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+std::string temporary(const std::string& suffix) {
+    return "/tmp/pcsc_test_history_" + std::to_string(getpid()) + suffix;
+}
+
+// The last iterations are kept, oldest first; nothing is recorded while disabled
+bool test_ring_buffer() {
+    ConvergenceHistory history;
+    history.record(1, 1.0, 1.0);
+    bool ok = !history.isEnabled() && history.size() == 0 && history.getRecordedCount() == 0;
+
+    history.setCapacity(4);
+    for (int i = 1; i <= 10; ++i) history.record(i, std::complex<double>(i, -i), 1.0 / i);
+    std::vector<ConvergenceHistory::Entry> entries = history.getEntries();
+    ok = ok && history.size() == 4 && history.getRecordedCount() == 10 && entries.size() == 4;
+    for (std::size_t k = 0; ok && k < entries.size(); ++k) {
+        ok = entries[k].iteration == static_cast<int>(7 + k) && entries[k].estimate.imag() == -entries[k].iteration &&
+             (k == 0 || entries[k].seconds >= entries[k - 1].seconds);
+    }
+
+    history.start();
+    history.record(1, 2.0, 0.5);
+    ok = ok && history.size() == 1 && history.getEntries()[0].estimate == std::complex<double>(2.0, 0.0);
+    history.setCapacity(0);
+    history.record(2, 2.0, 0.5);
+    ok = ok && !history.isEnabled() && history.size() == 0;
+    std::cout << "Ring buffer: " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+// One entry per iteration, converging to the returned eigenvalue; the QR trace ends at the final sub-diagonal
+bool test_solvers() {
+    Eigen::VectorXd values = Eigen::VectorXd::LinSpaced(20, 1, 10);
+    values(19) = 20;
+    Eigen::MatrixXd A = withEigenvalues(values);
+    Parameters params;
+    params.setMaxIterations(10000);
+    params.setTolerance(1e-10);
+    params.setShift(19.5);
+
+    PowerMethod<double> quiet(A, params);
+    quiet.solve();
+    bool ok = !quiet.getHistory().isEnabled() && quiet.getHistory().size() == 0;
+
+    params.setHistoryCapacity(100000);
+    PowerMethod<double> power(A, params);
+    power.solve();
+    std::vector<ConvergenceHistory::Entry> trace = power.getHistory().getEntries();
+    ok = ok && power.hasConverged() && static_cast<int>(trace.size()) == power.getIterationCount() &&
+         trace.back().residual < trace.front().residual && trace.back().residual < 1e-3 &&
+         std::abs(trace.back().estimate.real() - power.getEigenvalue()) < 1e-12;
+
+    ShiftedInversePowerMethod<double> sipm(A, params);
+    sipm.solve();
+    ok = ok && static_cast<int>(sipm.getHistory().size()) == sipm.getIterationCount() &&
+         std::abs(sipm.getHistory().getEntries().back().estimate.real() - 20) < 1e-6;
+
+    QRMethod<double> qr(A, params);
+    qr.solve();
+    ok = ok && static_cast<int>(qr.getHistory().size()) == qr.getIterationCount() &&
+         qr.getHistory().getEntries().back().residual == qr.getStats().residual;
+
+    // A capacity below the iteration count keeps the last iterations
+    PowerMethod<double> wrapped(A, params);
+    wrapped.setHistoryCapacity(5);
+    wrapped.solve();
+    trace = wrapped.getHistory().getEntries();
+    ok = ok && trace.size() == 5 && trace.back().iteration == wrapped.getIterationCount() &&
+         static_cast<int>(wrapped.getHistory().getRecordedCount()) == wrapped.getIterationCount();
+
+    // The generalized QR method reports the trace of its inner QR iterations
+    Eigen::MatrixXd M = Eigen::MatrixXd::Random(20, 20);
+    Eigen::MatrixXd B = M * M.transpose() + 20 * Eigen::MatrixXd::Identity(20, 20);
+    GeneralizedQRMethod<double> generalized(A, B, params);
+    generalized.solve();
+    ok = ok && static_cast<int>(generalized.getHistory().size()) == generalized.getIterationCount();
+
+    std::cout << "Solvers: power " << power.getIterationCount() << " iterations, QR " << qr.getHistory().size()
+              << " entries, " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+// Without matplotlib the plot is a CSV file next to the image; the console writer prints the results and statistics
+bool test_writers() {
+    Eigen::VectorXd values(5);
+    values << 1, 2, 3, 4, 9;
+    Parameters params;
+    params.setHistoryCapacity(1000);
+    PowerMethod<double> power(withEigenvalues(values), params);
+    power.solve();
+
+    std::string image = temporary(".png");
+    PlotWriter plot(image);
+    plot.setHistory(power.getHistory());
+    plot.write(power.getEigenvalue(), power.getEigenvector(), power.getIterationCount(), power.hasConverged());
+    bool ok = true;
+    if (!PlotWriter::canRender()) {
+        ok = plot.getOutputFile() == temporary(".csv");
+        std::ifstream file(plot.getOutputFile());
+        std::string line;
+        int lines = 0;
+        std::getline(file, line);
+        ok = ok && line == "Iteration,Seconds,EstimateReal,EstimateImag,Residual";
+        while (std::getline(file, line)) lines++;
+        ok = ok && lines == power.getIterationCount();
+    }
+    std::remove(plot.getOutputFile().c_str());
+
+    std::ostringstream text;
+    ConsoleWriter console(text);
+    console.write(power.getEigenvalue(), power.getEigenvector(), power.getIterationCount(), power.hasConverged());
+    ok = ok && text.str().find("Converged: Yes") != std::string::npos &&
+         text.str().find("v[4] = ") != std::string::npos && text.str().find("statistics") == std::string::npos;
+
+    text.str("");
+    console.setStats(power.getStats());
+    Eigen::VectorXcd complexValues(2);
+    complexValues << std::complex<double>(1, 2), std::complex<double>(1, -2);
+    console.writeAll(complexValues, Eigen::MatrixXcd::Identity(2, 2), 3, true);
+    ok = ok && text.str().find("Eigenvalue 2: 1 - 2i") != std::string::npos &&
+         text.str().find("  MatrixVectorProducts: ") != std::string::npos;
+    std::cout << "Writers: " << (PlotWriter::canRender() ? "rendered" : "CSV fallback") << ", "
+              << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+int main() {
+    bool ok = true;
+    try {
+        ok = test_ring_buffer() && ok;
+        ok = test_solvers() && ok;
+        ok = test_writers() && ok;
+    } catch (const std::exception& e) {
+        std::cout << "Unexpected error: " << e.what() << std::endl;
+        ok = false;
+    }
+
+    if (ok) {
+        std::cout << "Test succeed" << std::endl;
+        return 0;
+    }
+    std::cout << "Test failed" << std::endl;
+    return 1;
+}
@@ -0,0 +1,155 @@
+//
+// Test of the Matrix Market reader: every format, field and symmetry, CSR structure and errors
+//
+
+#include "MatrixMarketReader.h"
+#include "PowerMethod.h"
+#include "TestHelpers.h"
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+
+using Complex = std::complex<double>;
+
+std::string temporary() {
+    return "/tmp/pcsc_test_matrixmarket_" + std::to_string(getpid()) + ".mtx";
+}
+
+// CSR invariants: increasing offsets, sorted and unique columns in each row
+template<typename Sparse>
+bool is_canonical_csr(const Sparse& matrix) {
+    if (!matrix.isCompressed()) return false;
+    for (Eigen::Index r = 0; r < matrix.outerSize(); ++r) {
+        for (int k = matrix.outerIndexPtr()[r] + 1; k < matrix.outerIndexPtr()[r + 1]; ++k) {
+            if (matrix.innerIndexPtr()[k - 1] >= matrix.innerIndexPtr()[k]) return false;
+        }
+    }
+    return true;
+}
+
+// General coordinate file: unsorted entries, duplicates summed, empty rows
+bool test_coordinate_general(const std::string& filename) {
+    writeFile(filename, "%%MatrixMarket matrix coordinate real general\n% comment\n\n4 3 5\n"
+                         "3 3 1.5\n1 2 -2\n3 1 4e1\n1 2 0.5\n4 3 +7\n");
+    MatrixMarketReader<double> reader(filename);
+    MatrixMarketReader<double>::SparseMatrix A = reader.ReadSparse();
+    Eigen::MatrixXd expected = Eigen::MatrixXd::Zero(4, 3);
+    expected(2, 2) = 1.5;
+    expected(0, 1) = -1.5;
+    expected(2, 0) = 40;
+    expected(3, 2) = 7;
+    bool ok = A.nonZeros() == 4 && is_canonical_csr(A) && Eigen::MatrixXd(A) == expected &&
+              reader.ReadMatrix() == expected && reader.CountMatrixRows() == 4 &&
+              reader.ReadMatrixRows(2, 2) == expected.bottomRows(2);
+    std::cout << "Coordinate general: " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+// Symmetric, skew-symmetric and Hermitian files are mirrored
+bool test_symmetries(const std::string& filename) {
+    writeFile(filename, "%%MatrixMarket matrix coordinate real symmetric\n3 3 3\n1 1 2\n3 1 5\n2 2 1\n");
+    Eigen::MatrixXd symmetric = MatrixMarketReader<double>(filename).ReadMatrix();
+    writeFile(filename, "%%MatrixMarket matrix coordinate integer skew-symmetric\n3 3 2\n2 1 3\n3 2 -4\n");
+    Eigen::MatrixXd skew = MatrixMarketReader<double>(filename).ReadMatrix();
+    writeFile(filename, "%%MatrixMarket matrix coordinate complex hermitian\n2 2 3\n1 1 1 0\n2 1 2 -3\n2 2 4 0\n");
+    Eigen::MatrixXcd hermitian = MatrixMarketReader<Complex>(filename).ReadMatrix();
+    writeFile(filename, "%%MatrixMarket matrix coordinate pattern symmetric\n3 3 2\n2 1\n3 3\n");
+    MatrixMarketReader<double>::SparseMatrix pattern = MatrixMarketReader<double>(filename).ReadSparse();
+
+    Eigen::Matrix3d expectedSkew;
+    expectedSkew << 0, -3, 0, 3, 0, 4, 0, -4, 0;
+    Eigen::Matrix2cd expectedHermitian;
+    expectedHermitian << Complex(1, 0), Complex(2, 3), Complex(2, -3), Complex(4, 0);
+    bool ok = symmetric == symmetric.transpose() && symmetric(0, 2) == 5 && symmetric(2, 0) == 5 &&
+              symmetric.sum() == 13 && skew == expectedSkew && hermitian == expectedHermitian &&
+              pattern.nonZeros() == 3 && pattern.coeff(0, 1) == 1 && pattern.coeff(1, 0) == 1 &&
+              pattern.coeff(2, 2) == 1 && is_canonical_csr(pattern);
+    std::cout << "Symmetries: " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+// Dense array files, column by column
+bool test_array(const std::string& filename) {
+    writeFile(filename, "%%MatrixMarket matrix array real general\n2 3\n1\n4\n2\n0\n3\n6\n");
+    Eigen::MatrixXd general = MatrixMarketReader<double>(filename).ReadMatrix();
+    writeFile(filename, "%%MatrixMarket matrix array complex symmetric\n2 2\n1 1\n2 0\n3 -1\n");
+    Eigen::MatrixXcd symmetric = MatrixMarketReader<Complex>(filename).ReadMatrix();
+    writeFile(filename, "%%MatrixMarket matrix array real skew-symmetric\n3 3\n1\n2\n3\n");
+    Eigen::MatrixXd skew = MatrixMarketReader<double>(filename).ReadMatrix();
+
+    Eigen::MatrixXd expectedGeneral(2, 3);
+    expectedGeneral << 1, 2, 3, 4, 0, 6;
+    Eigen::Matrix2cd expectedSymmetric;
+    expectedSymmetric << Complex(1, 1), Complex(2, 0), Complex(2, 0), Complex(3, -1);
+    Eigen::Matrix3d expectedSkew;
+    expectedSkew << 0, -1, -2, 1, 0, -3, 2, 3, 0;
+    bool ok = general == expectedGeneral && symmetric == expectedSymmetric && skew == expectedSkew;
+    std::cout << "Array: " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+// Malformed files are rejected with a message
+bool test_errors(const std::string& filename) {
+    const char* files[] = {
+        "1 2 3\n",
+        "%%MatrixMarket matrix coordinate real diagonal\n2 2 1\n1 1 1\n",
+        "%%MatrixMarket matrix array pattern general\n2 2\n",
+        "%%MatrixMarket matrix coordinate real general\n2 2 3\n1 1 1\n2 2 1\n",
+        "%%MatrixMarket matrix coordinate real general\n2 2 1\n3 1 1\n",
+        "%%MatrixMarket matrix coordinate real symmetric\n2 2 1\n1 2 1\n",
+        "%%MatrixMarket matrix coordinate real general\n2 2 1\n1 1 x\n",
+        "%%MatrixMarket matrix coordinate complex general\n2 2 1\n1 1 1 1\n",
+        "%%MatrixMarket matrix coordinate real general\n2 2 3000000000\n1 1 1\n",
+    };
+    int rejected = 0;
+    for (const char* content : files) {
+        writeFile(filename, content);
+        try {
+            MatrixMarketReader<double>(filename).ReadSparse();
+        } catch (const std::runtime_error& e) {
+            std::cout << "Rejected: " << e.what() << std::endl;
+            rejected++;
+        }
+    }
+    return rejected == 9;
+}
+
+// The data file, its parameters and a solve on it
+bool test_data_file() {
+    MatrixMarketReader<double> reader("../data/test_matrix_sparse.mtx");
+    Parameters params = reader.ReadParameters();
+    Eigen::MatrixXd A = reader.ReadMatrix();
+    PowerMethod<double> pm(A, params);
+    pm.solve();
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> reference(A);
+    bool ok = A.rows() == 5 && A == A.transpose() && A(0, 0) == 6 && params.getAlgorithm() == "PowerMethod" &&
+              params.getMaxIterations() == 5000 && params.getTolerance() == 1e-10 &&
+              std::abs(pm.getEigenvalue() - reference.eigenvalues().maxCoeff()) < 1e-6;
+    std::cout << "Data file: dominant eigenvalue " << pm.getEigenvalue() << " (" << (ok ? "ok" : "mismatch") << ")"
+              << std::endl;
+    return ok;
+}
+
+int main() {
+    std::string filename = temporary();
+    bool ok = true;
+    try {
+        ok = test_coordinate_general(filename) && ok;
+        ok = test_symmetries(filename) && ok;
+        ok = test_array(filename) && ok;
+        ok = test_errors(filename) && ok;
+        ok = test_data_file() && ok;
+    } catch (const std::exception& e) {
+        std::cout << "Unexpected error: " << e.what() << std::endl;
+        ok = false;
+    }
+    std::remove(filename.c_str());
+
+    if (ok) {
+        std::cout << "Test succeed" << std::endl;
+        return 0;
+    }
+    std::cout << "Test failed" << std::endl;
+    return 1;
+}
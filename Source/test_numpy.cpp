@@ -0,0 +1,206 @@
+//
+// Test of the NumPy formats: .npy headers, C and Fortran order, .npz archives and the result writer
+//
+
+#include "NumpyFormat.h"
+#include "NumpyReader.h"
+#include "NumpyWriter.h"
+#include "QRMethod.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+
+std::string temporary(const std::string& suffix) {
+    return "/tmp/pcsc_test_numpy_" + std::to_string(getpid()) + suffix;
+}
+
+// An array as np.save writes it: C order unless asked otherwise
+template<typename MatrixType>
+void write_npy(const std::string& filename, const MatrixType& matrix, const char* descr, bool fortranOrder) {
+    std::string header = makeNpyHeader(descr, fortranOrder, {static_cast<std::uint64_t>(matrix.rows()),
+                                                             static_cast<std::uint64_t>(matrix.cols())});
+    std::ofstream file(filename, std::ios::binary);
+    file.write(header.data(), static_cast<std::streamsize>(header.size()));
+    for (long k = 0; k < matrix.size(); ++k) {
+        long i = fortranOrder ? k % matrix.rows() : k / matrix.cols();
+        long j = fortranOrder ? k / matrix.rows() : k % matrix.cols();
+        auto value = matrix(i, j);
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+}
+
+// Headers written by makeNpyHeader are those of NumPy, and are parsed back
+bool test_header() {
+    std::string header = makeNpyHeader(kNpyReal, false, {3, 4});
+    NpyHeader parsed = parseNpyHeader(header.data(), header.size() + 12 * sizeof(double));
+    std::string vector = makeNpyHeader(kNpyComplex, true, {5});
+    NpyHeader parsedVector = parseNpyHeader(vector.data(), vector.size() + 5 * 16);
+    bool ok = header.size() % kNpyAlignment == 0 &&
+              header.find("{'descr': '<f8', 'fortran_order': False, 'shape': (3, 4), }") == 10 &&
+              vector.find("'shape': (5,), }") != std::string::npos && parsed.descr == "<f8" && !parsed.fortranOrder &&
+              parsed.shape == std::vector<std::uint64_t>{3, 4} && parsed.dataOffset == header.size() &&
+              parsedVector.fortranOrder && parsedVector.shape == std::vector<std::uint64_t>{5} &&
+              crc32("123456789", 9) == 0xcbf43926u;
+
+    // Truncated data and malformed headers are rejected
+    int rejected = 0;
+    std::string broken = header;
+    broken[20] = 'x';
+    for (const std::string& bytes : {header, std::string("\x93NUMPX\x01\x00", 8) + header.substr(8), broken}) {
+        try {
+            parseNpyHeader(bytes.data(), bytes.size());
+        } catch (const std::runtime_error& e) {
+            std::cout << "Rejected: " << e.what() << std::endl;
+            rejected++;
+        }
+    }
+    std::cout << "Headers: " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok && rejected == 3;
+}
+
+// Fortran order is mapped in place, C order is transposed by a copy
+bool test_orders(const std::string& npy) {
+    Eigen::MatrixXd A = Eigen::MatrixXd::Random(5, 3);
+
+    NpyMatrixWriter::write(npy, A);
+    NumpyReader<double> fortran(npy);
+    bool ok = fortran.isMappable() && fortran.MapMatrix() == A && fortran.ReadMatrix() == A &&
+              fortran.ReadMatrixRows(1, 3) == A.middleRows(1, 3) && fortran.CountMatrixRows() == 5 &&
+              reinterpret_cast<std::uintptr_t>(fortran.MapMatrix().data()) % kNpyAlignment == 0;
+
+    write_npy(npy, A, kNpyReal, false);
+    NumpyReader<double> c(npy);
+    ok = ok && !c.isMappable() && c.ReadMatrix() == A && c.ReadMatrixRows(2, 3) == A.bottomRows(3);
+    try {
+        c.MapMatrix();
+        ok = false;
+    } catch (const std::runtime_error& e) {
+        std::cout << "Rejected: " << e.what() << std::endl;
+    }
+
+    // Real arrays are read as complex; complex arrays are not read as real
+    NumpyReader<std::complex<double>> widened(npy);
+    ok = ok && !widened.isMappable() && widened.ReadMatrix() == A.cast<std::complex<double>>();
+    Eigen::MatrixXcd C = Eigen::MatrixXcd::Random(4, 4);
+    write_npy(npy, C, kNpyComplex, false);
+    ok = ok && NumpyReader<std::complex<double>>(npy).ReadMatrix() == C;
+    NpyMatrixWriter::write(npy, C);
+    ok = ok && NumpyReader<std::complex<double>>(npy).MapMatrix() == C;
+    try {
+        NumpyReader<double>(npy).ReadMatrix();
+        ok = false;
+    } catch (const std::runtime_error& e) {
+        std::cout << "Rejected: " << e.what() << std::endl;
+    }
+
+    std::cout << "C and Fortran orders: " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+// Archive written like np.savez (Zip64 local headers) with A, B and the parameters
+bool test_archive() {
+    NumpyReader<double> reader("../data/test_matrix_numpy.npz");
+    Eigen::MatrixXd A = reader.ReadMatrix();
+    Eigen::MatrixXd B = reader.ReadMatrixB();
+    Parameters params = reader.ReadParameters();
+    bool ok = A.rows() == 3 && A(1, 0) == 2 && A(0, 1) == 1 && B(0, 1) == 0.5 && B(2, 2) == 1 &&
+              params.getAlgorithm() == "QRMethod" && params.getMaxIterations() == 1000 &&
+              params.getTolerance() == 1e-10;
+    ok = ok && NumpyReader<double>("../data/test_matrix_numpy.npz", "B").ReadMatrix() == B;
+    try {
+        NumpyReader<double>("../data/test_matrix_numpy.npz", "C");
+        ok = false;
+    } catch (const std::runtime_error& e) {
+        std::cout << "Rejected: " << e.what() << std::endl;
+    }
+    std::cout << "Archive: " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+// Results written to an archive are read back in place, aligned
+bool test_writer(const std::string& npz) {
+    Eigen::MatrixXd A = Eigen::MatrixXd::Random(6, 6);
+    A = A + A.transpose().eval();
+    Parameters params;
+    params.setAlgorithm("QRMethod");
+    QRMethod<double> qr(A, params);
+    qr.solve();
+    Eigen::VectorXd values = qr.getAllEigenvalues().real();
+    Eigen::MatrixXd vectors = qr.getAllEigenvectors().real();
+    NumpyWriter(npz).writeAll(values, vectors, qr.getIterationCount(), qr.hasConverged());
+
+    MappedFile file(npz);
+    std::vector<NpzEntry> entries = listNpzEntries(file.data(), file.size());
+    bool ok = entries.size() == 4 && entries[0].name == "eigenvalues" && entries[3].name == "converged";
+    for (const NpzEntry& entry : entries) {
+        NpyHeader header = parseNpyHeader(file.data() + entry.offset, entry.size);
+        ok = ok && entry.method == 0 && (entry.offset + header.dataOffset) % kNpyAlignment == 0;
+    }
+    NpyHeader iterations = parseNpyHeader(file.data() + entries[2].offset, entries[2].size);
+    std::int64_t count;
+    std::memcpy(&count, file.data() + entries[2].offset + iterations.dataOffset, sizeof(count));
+    ok = ok && iterations.descr == "<i8" && iterations.shape.empty() && count == qr.getIterationCount();
+
+    NumpyReader<double> eigenvectors(npz, "eigenvectors");
+    NumpyReader<double> eigenvalues(npz, "eigenvalues");
+    ok = ok && eigenvectors.isMappable() && eigenvectors.MapMatrix() == vectors &&
+         eigenvalues.MapMatrix().col(0) == values;
+
+    // Single pairs are archives of one eigenvalue and one column
+    Eigen::VectorXcd vector = Eigen::VectorXcd::Random(4);
+    NumpyWriter(npz).write(std::complex<double>(1, -2), vector, 12, false);
+    NumpyReader<std::complex<double>> single(npz, "eigenvectors");
+    ok = ok && single.MapMatrix() == vector && NumpyReader<std::complex<double>>(npz, "eigenvalues").ReadMatrix()(0, 0) ==
+                                                std::complex<double>(1, -2);
+    std::cout << "Writer: " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+// Loading a large array: mapped in place, copied from C order, and parsed from CSV
+bool benchmark_loading(const std::string& npy, int n) {
+    Eigen::MatrixXd A = Eigen::MatrixXd::Random(n, n);
+    NpyMatrixWriter::write(npy, A);
+
+    auto start = std::chrono::steady_clock::now();
+    NumpyReader<double> fortran(npy);
+    double trace = fortran.MapMatrix().trace();
+    double mapped = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    write_npy(npy, A, kNpyReal, false);
+    start = std::chrono::steady_clock::now();
+    Eigen::MatrixXd copied = NumpyReader<double>(npy).ReadMatrix();
+    double copy = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << n << "x" << n << " array: mapped in " << mapped << " s, copied from C order in " << copy << " s"
+              << std::endl;
+    return trace == A.trace() && copied == A;
+}
+
+int main() {
+    std::string npy = temporary(".npy");
+    std::string npz = temporary(".npz");
+
+    bool ok = true;
+    try {
+        ok = test_header() && ok;
+        ok = test_orders(npy) && ok;
+        ok = test_archive() && ok;
+        ok = test_writer(npz) && ok;
+        ok = benchmark_loading(npy, 2000) && ok;
+    } catch (const std::exception& e) {
+        std::cout << "Unexpected error: " << e.what() << std::endl;
+        ok = false;
+    }
+    std::remove(npy.c_str());
+    std::remove(npz.c_str());
+
+    if (ok) {
+        std::cout << "Test succeed" << std::endl;
+        return 0;
+    }
+    std::cout << "Test failed" << std::endl;
+    return 1;
+}
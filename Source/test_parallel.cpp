@@ -0,0 +1,166 @@
+//
+// Test of the thread pool and of the row-partitioned matrix-vector product used by PowerMethod
+//
+
+#include "Parallel.h"
+#include "PowerMethod.h"
+#include "RowPartitionedMatrix.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <chrono>
+#include <complex>
+#include <iostream>
+#include <vector>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Every worker runs the task exactly once per call
+bool test_pool() {
+    ThreadPool pool(4);
+    std::atomic<int> calls(0);
+    std::atomic<int> indices(0);
+    for (int repeat = 0; repeat < 100; ++repeat) {
+        pool.run([&](int t) {
+            calls++;
+            indices += t;
+        });
+    }
+    bool ok = calls == 400 && indices == 100 * (0 + 1 + 2 + 3);
+    std::cout << "ThreadPool: " << calls << " calls" << (ok ? "" : " (expected 400)") << std::endl;
+    return ok;
+}
+
+// Pinned pools leave the affinity of the calling thread alone, and two pools living at the same time pin their
+// workers to different CPUs
+bool test_pinning() {
+    bool ok = true;
+#ifdef __linux__
+    cpu_set_t before, after;
+    pthread_getaffinity_np(pthread_self(), sizeof(before), &before);
+    // CPU of the worker 1 of each pool, -1 where pinning is not allowed (e.g. a restricted cpuset)
+    int cpus[2] = {-1, -1};
+    {
+        ThreadPool first(2, true);
+        ThreadPool second(2, true);
+        ThreadPool* pools[2] = {&first, &second};
+        for (int p = 0; p < 2; ++p) {
+            pools[p]->run([&](int t) {
+                cpu_set_t mask;
+                if (t == 1 && pthread_getaffinity_np(pthread_self(), sizeof(mask), &mask) == 0 &&
+                    CPU_COUNT(&mask) == 1) {
+                    cpus[p] = sched_getcpu();
+                }
+            });
+        }
+    }
+    pthread_getaffinity_np(pthread_self(), sizeof(after), &after);
+    ok = CPU_EQUAL(&before, &after) && (defaultThreadCount() < 2 || cpus[0] < 0 || cpus[0] != cpus[1]);
+#endif
+    std::cout << "Pinning: " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+// Parallel product, norm and argmax against the serial Eigen expressions
+template <typename Scalar>
+bool test_product(int rows, int cols, int threads) {
+    using Matrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+    using Vector = Eigen::Matrix<Scalar, Eigen::Dynamic, 1>;
+    Matrix A = Matrix::Random(rows, cols);
+    Vector x = Vector::Random(cols);
+
+    ThreadPool pool(threads);
+    RowPartitionedMatrix<Scalar> partitioned(A, pool);
+    Vector y;
+    Eigen::Index index;
+    double squaredNorm = partitioned.multiply(x, y, index);
+
+    Vector expected = A * x;
+    Eigen::Index expectedIndex;
+    expected.cwiseAbs2().maxCoeff(&expectedIndex);
+    double error = (y - expected).norm() / expected.norm();
+    double normError = std::abs(squaredNorm - expected.squaredNorm()) / expected.squaredNorm();
+
+    std::cout << rows << "x" << cols << " on " << partitioned.blockCount() << " block(s): error " << error
+              << ", norm error " << normError << ", argmax " << index << "/" << expectedIndex << std::endl;
+    return error < 1e-13 && normError < 1e-13 && index == expectedIndex;
+}
+
+// Same dominant eigenpair with one thread and with several
+bool test_power_method() {
+    int n = 400;
+    Eigen::MatrixXd B = Eigen::MatrixXd::Random(n, n);
+    Eigen::MatrixXd A = B + B.transpose();
+    A(0, 0) += 10.0 * n;  // well separated dominant eigenvalue
+
+    Parameters params;
+    params.setTolerance(1e-10);
+    params.setThreads(1);
+    PowerMethod<double> serial(A, params);
+    serial.solve();
+
+    params.setThreads(4);
+    PowerMethod<double> parallel(A, params);
+    parallel.solve();
+
+    double difference = std::abs(serial.getEigenvalue() - parallel.getEigenvalue()) / std::abs(serial.getEigenvalue());
+    double residual = (A * parallel.getEigenvector() - parallel.getEigenvalue() * parallel.getEigenvector()).norm();
+    std::cout << "PowerMethod 1 vs 4 threads: relative difference " << difference << ", residual " << residual
+              << std::endl;
+    bool ok = parallel.hasConverged() && difference < 1e-9 && residual < 1e-4 * std::abs(parallel.getEigenvalue());
+
+    // The next solves reuse the pool and the row blocks, until setMatrix() drops them
+    const double copyBytes = sizeof(double) * A.size();
+    ok = ok && parallel.getStats().bytesAllocated >= copyBytes;
+    parallel.solve();
+    ok = ok && parallel.getStats().bytesAllocated < copyBytes;
+    parallel.setMatrix(2.0 * A);
+    parallel.solve();
+    ok = ok && parallel.getStats().bytesAllocated >= copyBytes &&
+         std::abs(parallel.getEigenvalue() - 2.0 * serial.getEigenvalue()) < 1e-8 * std::abs(parallel.getEigenvalue());
+    return ok;
+}
+
+// Time of one product for 1, 2, 4, ... 64 threads (informative, not checked)
+void report_scaling(int n) {
+    Eigen::MatrixXd A = Eigen::MatrixXd::Random(n, n);
+    Eigen::VectorXd x = Eigen::VectorXd::Random(n), y;
+    const int repeats = 20;
+    double reference = 0.0;
+
+    std::cout << "\nScaling of y = A x, n = " << n << " (" << n * double(n) * 8.0 / 1e6 << " MB), "
+              << std::thread::hardware_concurrency() << " hardware thread(s)" << std::endl;
+    std::cout << "threads  time/product [ms]  GB/s  speedup" << std::endl;
+    for (int threads = 1; threads <= 64; threads *= 2) {
+        ThreadPool pool(threads);
+        RowPartitionedMatrix<double> partitioned(A, pool);
+        Eigen::Index index;
+        partitioned.multiply(x, y, index);  // warm-up
+
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r) partitioned.multiply(x, y, index);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / repeats;
+        if (threads == 1) reference = seconds;
+
+        std::cout << threads << "  " << seconds * 1e3 << "  " << n * double(n) * 8.0 / seconds / 1e9 << "  "
+                  << reference / seconds << std::endl;
+    }
+}
+
+int main() {
+    bool ok = test_pool();
+    ok = test_pinning() && ok;
+    ok = test_product<double>(1000, 300, 4) && ok;
+    ok = test_product<double>(7, 5, 16) && ok;  // more threads than rows
+    ok = test_product<std::complex<double>>(513, 200, 3) && ok;
+    ok = test_power_method() && ok;
+    report_scaling(2048);
+
+    if (ok) {
+        std::cout << "Test succeed" << std::endl;
+        return 0;
+    }
+    std::cout << "Test failed" << std::endl;
+    return 1;
+}
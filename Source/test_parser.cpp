@@ -0,0 +1,245 @@
+//
+// Test of the mapped CSV/text parser: delimiters, sections, parameters, errors and multithreaded throughput
+//
+
+#include "CSVReader.h"
+#include "TestHelpers.h"
+#include "TextFileReader.h"
+#include "TextMatrixParser.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+std::string temporary(const std::string& suffix) {
+    return "/tmp/pcsc_test_parser_" + std::to_string(getpid()) + suffix;
+}
+
+// The same matrix and parameters written with each delimiter give the same result
+bool test_delimiters(const std::string& csv, const std::string& text) {
+    Eigen::MatrixXd expected(2, 3);
+    expected << 1.5, -2, 3e-3, 4, +5.25, -6e2;
+
+    writeFile(csv, "1.5,-2,3e-3\n4,+5.25,-6e2\nAlgorithm,QRMethod\nMaxIterations,77\nTolerance,1e-9\n");
+    Eigen::MatrixXd fromCommas = CSVReader<double>(csv).ReadMatrix();
+    writeFile(csv, " 1.5 ; -2 ; 3e-3 \r\n\r\n4;+5.25;-6e2\r\nAlgorithm;QRMethod;\r\nMaxIterations;77;\r\nTolerance;1e-9;\r\n");
+    CSVReader<double> semicolons(csv);
+    Eigen::MatrixXd fromSemicolons = semicolons.ReadMatrix();
+    Parameters semicolonParams = semicolons.ReadParameters();
+
+    writeFile(text, "1.5  -2\t3e-3\n\n4 +5.25 -6e2\nAlgorithm: QRMethod\nMaxIterations: 77\nTolerance 1e-9\n");
+    TextFileReader<double> blanks(text);
+
+    bool ok = fromCommas == expected && fromSemicolons == expected && blanks.ReadMatrix() == expected &&
+              semicolons.CountMatrixRows() == 2 && semicolonParams.getAlgorithm() == "QRMethod" && semicolonParams.getMaxIterations() == 77 &&
+              semicolonParams.getTolerance() == 1e-9;
+    Parameters blankParams = blanks.ReadParameters();
+    ok = ok && blankParams.getAlgorithm() == "QRMethod" && blankParams.getMaxIterations() == 77 &&
+         blankParams.getTolerance() == 1e-9;
+    std::cout << "Delimiters: " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+// Files of the data directory
+bool test_data_files() {
+    CSVReader<double> generalized("../data/test_matrix_generalized.csv");
+    Eigen::MatrixXd A = generalized.ReadMatrix();
+    Eigen::MatrixXd B = generalized.ReadMatrixB();
+    Parameters params = generalized.ReadParameters();
+    bool ok = A.rows() == 3 && A(0, 0) == 4 && A(2, 2) == 2 && B.rows() == 3 && B(0, 1) == 0.5 &&
+              params.getAlgorithm() == "QRMethod" && params.getShift() == 1.0;
+
+    TextFileReader<std::complex<double>> shift("../data/test_matrix_shift.txt");
+    Eigen::MatrixXcd C = shift.ReadMatrix();
+    ok = ok && C.rows() == 3 && C(1, 2) == std::complex<double>(-1, 0) && shift.ReadMatrixB().size() == 0 &&
+         shift.ReadParameters().getShift() == 2.5;
+
+    // Complex literals keep their real part
+    CSVReader<double> power("../data/test_matrix_power.csv");
+    Eigen::MatrixXd D = power.ReadMatrix();
+    ok = ok && D.rows() == 3 && D.cols() == 3 && D(2, 2) == 17 && power.ReadMatrixRows(1, 2) == D.bottomRows(2);
+
+    std::cout << "Data files: " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+// Malformed files are rejected with a message
+bool test_errors(const std::string& csv) {
+    int rejected = 0;
+    const char* files[] = {"1,2,3\n4,5\nAlgorithm,PowerMethod\n", "1,2\n3,abc\n", "Algorithm,PowerMethod\n"};
+    for (const char* content : files) {
+        writeFile(csv, content);
+        try {
+            CSVReader<double> reader(csv);
+            reader.ReadMatrix();
+        } catch (const std::runtime_error& e) {
+            std::cout << "Rejected: " << e.what() << std::endl;
+            rejected++;
+        }
+    }
+
+    writeFile(csv, "1,2\n3,4\n");
+    CSVReader<double> reader(csv);
+    try {
+        reader.ReadMatrixRows(1, 2);
+    } catch (const std::runtime_error& e) {
+        std::cout << "Rejected: " << e.what() << std::endl;
+        rejected++;
+    }
+    return rejected == 4 && reader.ReadParameters().getAlgorithm() == "PowerMethod";
+}
+
+// Large CSV file; the rows listed in shortRows lose their last value
+void write_large(const std::string& csv, const Eigen::MatrixXd& A, const std::vector<long>& shortRows = {}) {
+    std::ofstream file(csv);
+    file << std::setprecision(17);
+    for (long i = 0; i < A.rows(); ++i) {
+        bool isShort = std::find(shortRows.begin(), shortRows.end(), i) != shortRows.end();
+        long cols = isShort ? A.cols() - 1 : A.cols();
+        for (long j = 0; j < cols; ++j) file << A(i, j) << (j + 1 < cols ? "," : "\n");
+        if (i == A.rows() / 2) file << "\n";
+    }
+    file << "MatrixB\n1,2\n3,4\nAlgorithm,PowerMethod\nNumValues,2\n";
+}
+
+// Parsing speed on a large generated file, on 1 to 16 threads
+bool test_throughput(const std::string& csv, int n) {
+    Eigen::MatrixXd A = Eigen::MatrixXd::Random(n, n);
+    write_large(csv, A);
+
+    bool ok = true;
+    for (int threads : {1, 2, 4, 8, 16}) {
+        auto start = std::chrono::steady_clock::now();
+        TextMatrixParser parser(csv, threads);
+        Eigen::MatrixXd parsed = parser.parse<double>(TextMatrixParser::Section::A);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        ok = ok && parsed == A && parser.parse<double>(TextMatrixParser::Section::B) == (Eigen::Matrix2d() << 1, 2, 3, 4).finished() &&
+             parser.parse<double>(TextMatrixParser::Section::A, 123, 456) == A.middleRows(123, 456) &&
+             parser.parameters().getNumValues() == 2;
+        std::cout << "\n" << n << "x" << n << " CSV (" << parser.size() / 1e6 << " MB) loaded in " << seconds
+                  << " s with at most " << threads << " thread(s)";
+        parser.parse<double>(TextMatrixParser::Section::A);
+        parser.reportTimings(std::cout);
+    }
+    return ok;
+}
+
+// Complex literals in every accepted form, and real/imaginary column pairs
+bool test_complex_literals(const std::string& csv, const std::string& text) {
+    using Complex = std::complex<double>;
+    Eigen::MatrixXcd expected(2, 3);
+    expected << Complex(1, 2), Complex(3, -4), Complex(-5.5, 0), Complex(0, 2), Complex(0, -1), Complex(1e-3, 2e3);
+
+    writeFile(csv, "1+2i, 3-4j, -5.5\n(0,2);-i;(1e-3, +2e3)\nAlgorithm,QRMethod\n");
+    Eigen::MatrixXcd literals = CSVReader<Complex>(csv).ReadMatrix();
+    writeFile(text, "1 2  3 -4  -5.5 0\n0 2 0 -1 1e-3 2e3\nAlgorithm QRMethod\nComplexPairs 1\n");
+    Eigen::MatrixXcd pairs = TextFileReader<Complex>(text).ReadMatrix();
+
+    TextFileReader<Complex> qr("../data/test_matrix_qr.txt");
+    Eigen::MatrixXcd fromData = qr.ReadMatrix();
+    bool ok = literals == expected && pairs == expected && fromData(0, 0) == Complex(1, 2) &&
+              fromData(2, 2) == Complex(17, 18);
+
+    // Malformed literals are rejected, not truncated
+    int rejected = 0;
+    for (const char* row : {"1+2\n", "1+2ix\n", "(1,2\n", "(1;2)\n", "2i3\n"}) {
+        writeFile(csv, row);
+        try {
+            CSVReader<Complex>(csv).ReadMatrix();
+        } catch (const std::runtime_error& e) {
+            std::cout << "Rejected: " << e.what() << std::endl;
+            rejected++;
+        }
+    }
+    std::cout << "Complex literals: " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok && rejected == 5;
+}
+
+// Throughput of the complex formats against real numbers, for the same number of matrix entries
+bool benchmark_complex(const std::string& csv, int n) {
+    Eigen::MatrixXcd A = Eigen::MatrixXcd::Random(n, n);
+    auto write = [&](int format) {
+        std::ofstream file(csv);
+        file << std::setprecision(17);
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                double re = A(i, j).real(), im = A(i, j).imag();
+                if (format == 0) file << re;
+                if (format == 1) file << re << (im < 0 ? "" : "+") << im << "i";
+                if (format == 2) file << "(" << re << "," << im << ")";
+                if (format == 3) file << re << "," << im;
+                file << (j + 1 < n ? "," : "\n");
+            }
+        }
+        file << "Algorithm,PowerMethod\n" << (format == 3 ? "ComplexPairs,1\n" : "");
+    };
+
+    bool ok = true;
+    const char* names[] = {"real a", "complex a+bi", "complex (a,b)", "real/imaginary pairs"};
+    for (int format = 0; format < 4; ++format) {
+        write(format);
+        TextMatrixParser parser(csv, 1);
+        double seconds;
+        if (format == 0) {
+            Eigen::MatrixXd parsed = parser.parse<double>(TextMatrixParser::Section::A);
+            seconds = parser.getTimings().parseSeconds;
+            ok = ok && parsed == A.real();
+        } else {
+            Eigen::MatrixXcd parsed = parser.parse<std::complex<double>>(TextMatrixParser::Section::A);
+            seconds = parser.getTimings().parseSeconds;
+            ok = ok && parsed == A;
+        }
+        std::cout << std::setw(22) << names[format] << ": " << std::setw(8) << parser.size() / 1e6 / seconds
+                  << " MB/s, " << std::setw(8) << n * n / seconds / 1e6 << " M entries/s" << std::endl;
+    }
+    return ok;
+}
+
+// A faulty row is reported by the thread that parses it; the first one of the file wins
+bool test_chunk_validation(const std::string& csv, int n) {
+    Eigen::MatrixXd A = Eigen::MatrixXd::Random(n, n);
+    write_large(csv, A, {n - 10, n / 3});
+    TextMatrixParser parser(csv, 4);
+    try {
+        parser.parse<double>(TextMatrixParser::Section::A);
+    } catch (const std::runtime_error& e) {
+        std::string expected = "at row " + std::to_string(n / 3) + " ";
+        std::cout << "Rejected on " << parser.getTimings().threadBytes.size() << " threads: " << e.what() << std::endl;
+        return std::string(e.what()).find(expected) != std::string::npos;
+    }
+    return false;
+}
+
+int main() {
+    std::string csv = temporary(".csv");
+    std::string text = temporary(".txt");
+
+    bool ok = true;
+    try {
+        ok = test_delimiters(csv, text) && ok;
+        ok = test_data_files() && ok;
+        ok = test_errors(csv) && ok;
+        ok = test_throughput(csv, 1000) && ok;
+        ok = test_chunk_validation(csv, 1000) && ok;
+        ok = test_complex_literals(csv, text) && ok;
+        ok = benchmark_complex(csv, 700) && ok;
+    } catch (const std::exception& e) {
+        std::cout << "Unexpected error: " << e.what() << std::endl;
+        ok = false;
+    }
+    std::remove(csv.c_str());
+    std::remove(text.c_str());
+
+    if (ok) {
+        std::cout << "Test succeed" << std::endl;
+        return 0;
+    }
+    std::cout << "Test failed" << std::endl;
+    return 1;
+}
@@ -0,0 +1,138 @@
+//
+// Test of the stream mode: documents split on "---" lines, bounded queues, stages overlapping, faulty documents
+//
+
+#include "BinaryResult.h"
+#include "BoundedQueue.h"
+#include "SolvePipeline.h"
+#include "TestHelpers.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// A symmetric matrix as a document, with its parameters
+std::string document(const Eigen::MatrixXd& A, const std::string& algorithm) {
+    std::ostringstream text;
+    text.precision(17);
+    for (int i = 0; i < A.rows(); ++i) {
+        for (int j = 0; j < A.cols(); ++j) text << (j > 0 ? "," : "") << A(i, j);
+        text << "\n";
+    }
+    text << "Algorithm," << algorithm << "\nMaxIterations,10000\nTolerance,1e-10\n";
+    return text.str();
+}
+
+// Items come out in order, push waits for room, pop ends after close
+bool test_queue() {
+    BoundedQueue<int> queue(2);
+    std::thread producer([&] {
+        for (int i = 0; i < 1000; ++i) queue.push(i);
+        queue.close();
+    });
+    int expected = 0, item;
+    bool ok = true;
+    while (queue.pop(item)) ok = ok && item == expected++;
+    producer.join();
+    ok = ok && expected == 1000 && !queue.push(0);
+    std::cout << "Queue: " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+// Separators with blanks or CR, blank documents skipped, last document without a separator
+bool test_split() {
+    std::istringstream input("---\n1,2\n3,4\n---\r\n\n  \n--- \n5\n");
+    std::vector<char> text;
+    bool ok = readDocument(input, text) && std::string(text.begin(), text.end()) == "1,2\n3,4\n";
+    ok = ok && readDocument(input, text) && std::string(text.begin(), text.end()) == "5\n";
+    ok = ok && !readDocument(input, text) && text.empty();
+    std::cout << "Split: " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+// Three good documents around a faulty one: the results are in their own files, the faulty one is reported
+bool test_documents(const std::string& directory) {
+    Eigen::VectorXd valuesA(6), valuesC(5);
+    valuesA << -3, 1, 2, 4, 7, 9;
+    valuesC << 1, 2, 3, 4, 10;
+    Eigen::MatrixXd A = withEigenvalues(valuesA), C = withEigenvalues(valuesC);
+    std::string stream = document(A, "QRMethod") + "---\n1,2\n3,x\nAlgorithm,QRMethod\n---\n" +
+                         document(C, "PowerMethod") + "---\n" + document(A, "NoSuchMethod");
+    std::istringstream input(stream);
+
+    PipelineOptions options;
+    options.outputDirectory = directory;
+    options.format = "bres";
+    options.queueDepth = 1;
+    std::ostringstream log;
+    PipelineStats stats = SolvePipeline<double>(options).run(input, log);
+    std::cout << log.str();
+
+    BinaryResultReader first(directory + "/result_1.bres");
+    Eigen::VectorXd values = first.MapEigenvalues<double>();
+    std::sort(values.data(), values.data() + values.size());
+    BinaryResultReader third(directory + "/result_3.bres");
+    double dominant = third.MapEigenvalues<double>()(0);
+
+    bool ok = stats.documents == 4 && stats.solved == 2 && stats.failed == 2 &&
+              (values - valuesA).norm() < 1e-8 && std::abs(dominant - 10) < 1e-6 &&
+              first.metadata("Algorithm") == "QRMethod" && !first.metadata("SolveSeconds").empty() &&
+              log.str().find("Document 2 failed") != std::string::npos &&
+              log.str().find("Document 4 failed: Unknown algorithm") != std::string::npos &&
+              access((directory + "/result_2.bres").c_str(), F_OK) != 0;
+    std::cout << "Documents: " << (ok ? "ok" : "mismatch") << std::endl;
+    for (int i = 1; i <= 4; ++i) std::remove((directory + "/result_" + std::to_string(i) + ".bres").c_str());
+    return ok;
+}
+
+// Many medium documents: the stage times add up to more than the wall time when the stages overlap
+bool benchmark_stream(const std::string& directory, int documents, int n) {
+    Eigen::VectorXd values = Eigen::VectorXd::LinSpaced(n, 1, n);
+    values(n - 1) = 2 * n;
+    std::string stream;
+    for (int i = 0; i < documents; ++i) {
+        stream += (i > 0 ? "---\n" : "") + document(withEigenvalues(values), "PowerMethod");
+    }
+    std::istringstream input(stream);
+
+    PipelineOptions options;
+    options.outputDirectory = directory;
+    options.format = "csv";
+    std::ostringstream log;
+    PipelineStats stats = SolvePipeline<double>(options).run(input, log);
+    std::cout << documents << " documents " << n << "x" << n << ": read " << stats.readSeconds << " s, solve "
+              << stats.solveSeconds << " s, write " << stats.writeSeconds << " s, wall " << stats.wallSeconds
+              << " s (sequential " << stats.readSeconds + stats.solveSeconds + stats.writeSeconds << " s)"
+              << std::endl;
+    for (int i = 1; i <= documents; ++i) std::remove((directory + "/result_" + std::to_string(i) + ".csv").c_str());
+    return stats.solved == documents;
+}
+
+int main() {
+    bool ok = true;
+    std::string directory;
+    try {
+        directory = temporaryDirectory("pipeline");
+        ok = test_queue() && ok;
+        ok = test_split() && ok;
+        ok = test_documents(directory) && ok;
+        ok = benchmark_stream(directory, 40, 400) && ok;
+    } catch (const std::exception& e) {
+        std::cout << "Unexpected error: " << e.what() << std::endl;
+        ok = false;
+    }
+    if (!directory.empty()) rmdir(directory.c_str());
+
+    if (ok) {
+        std::cout << "Test succeed" << std::endl;
+        return 0;
+    }
+    std::cout << "Test failed" << std::endl;
+    return 1;
+}
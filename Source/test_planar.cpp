@@ -0,0 +1,123 @@
+//
+// Test of the planar complex kernels (scalar, AVX2, AVX-512) and of the planar PowerMethod
+//
+
+#include "PlanarComplexMatrix.h"
+#include "PlanarKernels.h"
+#include "PowerMethod.h"
+#include <chrono>
+#include <complex>
+#include <iostream>
+
+// Product, norm and argmax of the active kernel against Eigen on interleaved data
+bool test_kernel(int rows, int cols) {
+    Eigen::MatrixXcd A = Eigen::MatrixXcd::Random(rows, cols);
+    Eigen::VectorXcd x = Eigen::VectorXcd::Random(cols);
+    Eigen::VectorXcd expected = A * x;
+    Eigen::Index expectedIndex;
+    expected.cwiseAbs2().maxCoeff(&expectedIndex);
+
+    ThreadPool pool(3);
+    PlanarComplexMatrix planar(A, &pool);
+    PlanarVector y;
+    Eigen::Index index;
+    double squaredNorm = planar.multiply(PlanarVector(x), y, index);
+
+    double error = (y.toComplex() - expected).norm() / expected.norm();
+    double normError = std::abs(squaredNorm - expected.squaredNorm()) / expected.squaredNorm();
+    std::cout << "  " << rows << "x" << cols << ": error " << error << ", norm error " << normError
+              << ", argmax " << index << "/" << expectedIndex << std::endl;
+    return error < 1e-13 && normError < 1e-13 && index == expectedIndex;
+}
+
+// Ties of the argmax go to the smallest index, whatever the vector width
+bool test_ties() {
+    Eigen::VectorXd re = Eigen::VectorXd::Zero(37), im = Eigen::VectorXd::Zero(37);
+    re(5) = 3.0;
+    im(13) = -3.0;
+    re(30) = 3.0;
+    long index;
+    double value;
+    planarSquaredNormArgmax(re.data(), im.data(), re.size(), index, value);
+    return index == 5 && value == 9.0;
+}
+
+// Planar and interleaved PowerMethod agree
+bool test_power_method() {
+    int n = 300;
+    Eigen::MatrixXcd A = Eigen::MatrixXcd::Random(n, n);
+    A(0, 0) += std::complex<double>(5.0 * n, 2.0 * n);  // well separated dominant eigenvalue
+
+    Parameters params;
+    params.setTolerance(1e-10);
+    PowerMethod<std::complex<double>> interleaved(A, params);
+    interleaved.solve();
+
+    params.setPlanarComplex(true);
+    PowerMethod<std::complex<double>> planar(A, params);
+    planar.solve();
+
+    double difference = std::abs(planar.getEigenvalue() - interleaved.getEigenvalue()) / std::abs(interleaved.getEigenvalue());
+    double residual = (A * planar.getEigenvector() - planar.getEigenvalue() * planar.getEigenvector()).norm();
+    std::cout << "PowerMethod planar vs interleaved: relative difference " << difference << ", residual " << residual
+              << std::endl;
+    return planar.hasConverged() && difference < 1e-9 && residual < 1e-6 * std::abs(planar.getEigenvalue());
+}
+
+// Single-thread product time of each kernel against Eigen's interleaved product (informative, not checked)
+void report_throughput(int n) {
+    Eigen::MatrixXcd A = Eigen::MatrixXcd::Random(n, n);
+    Eigen::VectorXcd x = Eigen::VectorXcd::Random(n), y(n);
+    const int repeats = 10;
+    double bytes = 16.0 * n * double(n);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r) {
+        y.noalias() = A * x;
+        Eigen::Index index;
+        y.cwiseAbs().maxCoeff(&index);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / repeats;
+    std::cout << "\nProduct + argmax, n = " << n << std::endl;
+    std::cout << "  interleaved (Eigen, cwiseAbs): " << seconds * 1e3 << " ms, " << bytes / seconds / 1e9 << " GB/s" << std::endl;
+
+    PlanarComplexMatrix planar(A);
+    PlanarVector px(x), py;
+    for (PlanarKernel kernel : {PlanarKernel::Scalar, PlanarKernel::AVX2, PlanarKernel::AVX512}) {
+        if (!planarSelectKernel(kernel)) continue;
+        start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r) {
+            Eigen::Index index;
+            planar.multiply(px, py, index);
+        }
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / repeats;
+        std::cout << "  planar " << planarKernelName(kernel) << ": " << seconds * 1e3 << " ms, "
+                  << bytes / seconds / 1e9 << " GB/s" << std::endl;
+    }
+}
+
+int main() {
+    bool ok = true;
+    PlanarKernel best = planarActiveKernel();
+    for (PlanarKernel kernel : {PlanarKernel::Scalar, PlanarKernel::AVX2, PlanarKernel::AVX512}) {
+        if (!planarSelectKernel(kernel)) {
+            std::cout << "Kernel " << planarKernelName(kernel) << " not supported on this CPU" << std::endl;
+            continue;
+        }
+        std::cout << "Kernel " << planarKernelName(kernel) << std::endl;
+        ok = test_kernel(37, 29) && ok;
+        ok = test_kernel(1000, 333) && ok;
+        ok = test_kernel(5, 1) && ok;
+        ok = test_ties() && ok;
+    }
+    planarSelectKernel(best);
+    ok = test_power_method() && ok;
+    report_throughput(1500);
+
+    if (ok) {
+        std::cout << "Test succeed" << std::endl;
+        return 0;
+    }
+    std::cout << "Test failed" << std::endl;
+    return 1;
+}
@@ -0,0 +1,221 @@
+//
+// Test of the solver server: round trips over the socket, errors, admission control, deadlines, throughput
+//
+
+#include "SolverClient.h"
+#include "SolverServer.h"
+#include "TestHelpers.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+std::string socketPath() {
+    return "/tmp/pcsc_test_server_" + std::to_string(getpid()) + ".sock";
+}
+
+// Eigenvalues n and -n: the power method never converges and runs all its iterations
+Eigen::MatrixXd neverConverging(int n) {
+    Eigen::VectorXd values = Eigen::VectorXd::LinSpaced(n, 1, n - 1);
+    values(0) = -n;
+    values(n - 1) = n;
+    return withEigenvalues(values);
+}
+
+Parameters parameters(const std::string& algorithm, int maxIterations) {
+    Parameters params;
+    params.setAlgorithm(algorithm);
+    params.setMaxIterations(maxIterations);
+    params.setTolerance(1e-10);
+    return params;
+}
+
+// The reply holds what solveProblem() gives in process, for real and complex matrices
+bool test_round_trip(const std::string& address) {
+    SolverClient client(address);
+    Eigen::VectorXd values(6);
+    values << 1, 2, 3, 4, 5, 20;
+    Eigen::MatrixXd A = withEigenvalues(values);
+    Parameters params = parameters("QRMethod", 10000);
+
+    SolveReply<double> reply = client.solve<double>(A, Eigen::MatrixXd(), params);
+    SolveResult<double> expected = solveProblem<double>(A, Eigen::MatrixXd(), params);
+    bool ok = reply.status == SolveStatus::Ok && !reply.result.single && reply.result.converged &&
+              reply.result.eigenvalues == expected.eigenvalues && reply.result.eigenvectors == expected.eigenvectors;
+
+    params.setAlgorithm("PowerMethod");
+    Eigen::MatrixXcd C = A.cast<std::complex<double>>() * std::complex<double>(0, 1);
+    SolveReply<std::complex<double>> complexReply = client.solve<std::complex<double>>(C, Eigen::MatrixXcd(), params);
+    ok = ok && complexReply.status == SolveStatus::Ok && complexReply.result.single &&
+         std::abs(complexReply.result.eigenvalues(0) - std::complex<double>(0, 20)) < 1e-6;
+
+    std::cout << "Round trip: " << reply.result.iterations << " iterations in " << reply.result.solveSeconds
+              << " s, waited " << reply.queueSeconds << " s, " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+// Solver errors come back as Failed replies and the connection stays usable
+bool test_errors(const std::string& address) {
+    SolverClient client(address);
+    Eigen::MatrixXd A = withEigenvalues(Eigen::VectorXd::LinSpaced(4, 1, 4));
+    SolveReply<double> dense = client.solve<double>(A, Eigen::MatrixXd(), parameters("BisectionMethod", 100));
+    Parameters negative = parameters("QRMethod", 100);
+    negative.setTolerance(-1);
+    SolveReply<double> invalid = client.solve<double>(A, Eigen::MatrixXd(), negative);
+    SolveReply<double> rectangular = client.solve<double>(Eigen::MatrixXd::Ones(3, 2), Eigen::MatrixXd(),
+                                                          parameters("QRMethod", 100));
+    SolveReply<double> after = client.solve<double>(A, Eigen::MatrixXd(), parameters("QRMethod", 1000));
+    bool ok = dense.status == SolveStatus::Failed && !dense.message.empty() &&
+              invalid.status == SolveStatus::Failed &&
+              rectangular.status == SolveStatus::Failed && after.status == SolveStatus::Ok;
+    std::cout << "Errors: \"" << dense.message << "\", \"" << invalid.message << "\", \"" << rectangular.message
+              << "\", " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+// With one request admitted at a time, the next requests during a long solve are refused at once; a request
+// whose deadline passes gets DeadlineExceeded without waiting for the end of its solve
+bool test_admission(const std::string& address) {
+    Eigen::MatrixXd slow = neverConverging(80);
+    SolveReply<double> first;
+    std::thread longRequest([&] {
+        SolverClient client(address);
+        first = client.solve<double>(slow, Eigen::MatrixXd(), parameters("PowerMethod", 300000), 0.1);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    SolverClient client(address);
+    auto start = std::chrono::steady_clock::now();
+    SolveReply<double> second = client.solve<double>(slow, Eigen::MatrixXd(), parameters("PowerMethod", 10));
+    double refusal = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    // The refused matrices are read and dropped: the next request on the connection is understood
+    SolveReply<double> again = client.solve<double>(slow, Eigen::MatrixXd(), parameters("PowerMethod", 10));
+    longRequest.join();
+
+    bool ok = second.status == SolveStatus::Busy && again.status == SolveStatus::Busy &&
+              first.status == SolveStatus::DeadlineExceeded;
+    std::cout << "Admission: second request " << statusName(second.status) << " after " << refusal
+              << " s, first " << statusName(first.status) << ", " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+// Beyond the connection limit a client is answered Busy without a thread; a connection closed frees its place
+bool test_connection_limit(const std::string& address) {
+    Eigen::MatrixXd A = withEigenvalues(Eigen::VectorXd::LinSpaced(4, 1, 4));
+    SolveReply<double> refused, later;
+    {
+        SolverClient first(address);
+        SolveReply<double> admitted = first.solve<double>(A, Eigen::MatrixXd(), parameters("QRMethod", 1000));
+        SolverClient second(address);
+        refused = second.solve<double>(A, Eigen::MatrixXd(), parameters("QRMethod", 1000));
+        if (admitted.status != SolveStatus::Ok) return false;
+    }
+    // The closed connection is reaped at the next accept, once its thread has seen the end of the stream
+    for (int attempt = 0; attempt < 100; ++attempt) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        SolverClient client(address);
+        later = client.solve<double>(A, Eigen::MatrixXd(), parameters("QRMethod", 1000));
+        if (later.status != SolveStatus::Busy) break;
+    }
+    bool ok = refused.status == SolveStatus::Busy && later.status == SolveStatus::Ok;
+    std::cout << "Connection limit: \"" << refused.message << "\", then " << statusName(later.status) << ", "
+              << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+// Many small requests from several connections: throughput and latency
+bool benchmark_throughput(const std::string& address, int clients, int requests) {
+    // A dominant eigenvalue well apart: the solve is short and the time goes to the protocol
+    Eigen::VectorXd values = Eigen::VectorXd::LinSpaced(16, 1, 16);
+    values(15) = 100;
+    Eigen::MatrixXd A = withEigenvalues(values);
+    Parameters params = parameters("PowerMethod", 10000);
+    std::vector<std::vector<double>> latencies(clients);
+    std::vector<int> solved(clients, 0);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int c = 0; c < clients; ++c) {
+        threads.emplace_back([&, c] {
+            SolverClient client(address);
+            for (int r = 0; r < requests; ++r) {
+                auto sent = std::chrono::steady_clock::now();
+                SolveReply<double> reply;
+                do {
+                    reply = client.solve<double>(A, Eigen::MatrixXd(), params);
+                } while (reply.status == SolveStatus::Busy);
+                latencies[c].push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - sent).count());
+                solved[c] += reply.status == SolveStatus::Ok;
+            }
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<double> all;
+    for (const std::vector<double>& part : latencies) all.insert(all.end(), part.begin(), part.end());
+    std::sort(all.begin(), all.end());
+    int total = 0;
+    for (int count : solved) total += count;
+    std::cout << total << " requests of 16x16 from " << clients << " connections: " << total / wall
+              << " requests/s, latency median " << all[all.size() / 2] * 1e3 << " ms, p99 "
+              << all[all.size() * 99 / 100] * 1e3 << " ms" << std::endl;
+    return total == clients * requests;
+}
+
+int main() {
+    bool ok = true;
+    try {
+        ServerOptions options;
+        options.address = "unix:" + socketPath();
+        options.workers = 4;
+        {
+            SolverServer server(options);
+            std::thread serving([&] { server.serve(); });
+            ok = test_round_trip(options.address) && ok;
+            ok = test_errors(options.address) && ok;
+            ok = benchmark_throughput(options.address, 4, 250) && ok;
+            server.stop();
+            serving.join();
+            ServerStats stats = server.stats();
+            std::cout << stats.connections << " connections, " << stats.requests << " requests, " << stats.solved
+                      << " solved, " << stats.failed << " failed" << std::endl;
+        }
+        ok = ok && access(socketPath().c_str(), F_OK) != 0;
+
+        options.workers = 1;
+        options.maxPending = 1;
+        {
+            SolverServer server(options);
+            std::thread serving([&] { server.serve(); });
+            ok = test_admission(options.address) && ok;
+            server.stop();
+            serving.join();
+            ok = ok && server.stats().rejected == 2 && server.stats().expired == 1;
+        }
+
+        options.maxPending = 64;
+        options.maxConnections = 1;
+        {
+            SolverServer server(options);
+            std::thread serving([&] { server.serve(); });
+            ok = test_connection_limit(options.address) && ok;
+            server.stop();
+            serving.join();
+        }
+    } catch (const std::exception& e) {
+        std::cout << "Unexpected error: " << e.what() << std::endl;
+        ok = false;
+    }
+
+    if (ok) {
+        std::cout << "Test succeed" << std::endl;
+        return 0;
+    }
+    std::cout << "Test failed" << std::endl;
+    return 1;
+}
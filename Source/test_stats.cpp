@@ -0,0 +1,224 @@
+//
+// Test of the solver statistics: counts and phases of each solver, and the statistics written by the writers
+//
+
+#include "BinaryResult.h"
+#include "BisectionMethod.h"
+#include "BinaryWriter.h"
+#include "GeneralizedPowerMethod.h"
+#include "GeneralizedQRMethod.h"
+#include "GeneralizedShiftedInversePowerMethod.h"
+#include "MappedFile.h"
+#include "NumpyFormat.h"
+#include "NumpyWriter.h"
+#include "PowerMethod.h"
+#include "QRMethod.h"
+#include "ShiftedInversePowerMethod.h"
+#include "SolveJob.h"
+#include "TestHelpers.h"
+#include "TruncatedSVD.h"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+
+std::string temporary(const std::string& suffix) {
+    return "/tmp/pcsc_test_stats_" + std::to_string(getpid()) + suffix;
+}
+
+Parameters parameters(int maxIterations) {
+    Parameters params;
+    params.setMaxIterations(maxIterations);
+    params.setTolerance(1e-10);
+    params.setThreads(1);
+    return params;
+}
+
+// The phases add up to at most the wall time of solve(), and none is negative
+template<typename Solver>
+bool timed(Solver& solver, double& wall) {
+    auto start = std::chrono::steady_clock::now();
+    solver.solve();
+    wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const SolverStats& stats = solver.getStats();
+    return stats.setupSeconds >= 0 && stats.factorizationSeconds >= 0 && stats.iterationSeconds > 0 &&
+           stats.extractionSeconds >= 0 && stats.totalSeconds() <= wall;
+}
+
+// One product per iteration and one for the residual; one factorization and one solve per iteration for the
+// shifted inverse method; one QR factorization per QR iteration
+bool test_counts() {
+    Eigen::VectorXd values = Eigen::VectorXd::LinSpaced(30, 1, 10);
+    values(29) = 20;
+    Eigen::MatrixXd A = withEigenvalues(values);
+    double wall;
+
+    PowerMethod<double> power(A, parameters(10000));
+    bool ok = timed(power, wall);
+    const SolverStats& p = power.getStats();
+    ok = ok && power.hasConverged() && p.matrixVectorProducts == power.getIterationCount() + 1 && p.solves == 0 &&
+         p.factorizations == 0 && p.residual < 1e-4 && p.flops > 2.0 * 30 * 30 * power.getIterationCount() &&
+         p.bytesAllocated >= 2 * 30 * sizeof(double);
+    std::cout << "PowerMethod: " << power.getIterationCount() << " iterations, " << p.matrixVectorProducts
+              << " products, residual " << p.residual << std::endl;
+
+    Parameters shifted = parameters(10000);
+    shifted.setShift(19.5);
+    ShiftedInversePowerMethod<double> sipm(A, shifted);
+    ok = timed(sipm, wall) && ok;
+    const SolverStats& s = sipm.getStats();
+    ok = ok && sipm.hasConverged() && s.factorizations == 1 && s.solves == sipm.getIterationCount() &&
+         s.matrixVectorProducts == 1 && s.residual < 1e-6 && s.factorizationSeconds > 0;
+    std::cout << "ShiftedInversePowerMethod: " << s.solves << " solves, " << s.factorizations
+              << " factorization, residual " << s.residual << std::endl;
+
+    QRMethod<double> qr(A, parameters(10000));
+    ok = timed(qr, wall) && ok;
+    const SolverStats& q = qr.getStats();
+    ok = ok && qr.hasConverged() && q.factorizations == qr.getIterationCount() && q.residual < 1e-10 &&
+         q.bytesAllocated < 5 * 30 * 30 * sizeof(double);
+    std::cout << "QRMethod: " << q.factorizations << " factorizations, ~" << q.flops / 1e6 << " MFLOP, ~"
+              << q.bytesAllocated / 1024 << " KiB, residual " << q.residual << std::endl;
+
+    // The statistics are those of the last solve, which reuses the workspace of the first one
+    qr.setMaxIteration(3);
+    qr.solve();
+    ok = ok && qr.getStats().factorizations == 3 && qr.getStats().bytesAllocated == 0;
+    return ok;
+}
+
+// Factorizations of B are counted once, then reused from the cache by the next solves
+bool test_generalized() {
+    Eigen::VectorXd values = Eigen::VectorXd::LinSpaced(12, 1, 5);
+    values(11) = 10;
+    Eigen::MatrixXd A = withEigenvalues(values);
+    Eigen::MatrixXd M = Eigen::MatrixXd::Random(12, 12);
+    Eigen::MatrixXd B = M * M.transpose() + 12 * Eigen::MatrixXd::Identity(12, 12);
+
+    GeneralizedPowerMethod<double> power(A, B, parameters(10000));
+    power.solve();
+    SolverStats first = power.getStats();
+    const int iterations = power.getIterationCount();
+    power.solve();
+    SolverStats second = power.getStats();
+    bool ok = power.hasConverged() && first.factorizations == 1 && second.factorizations == 0 &&
+              first.solves == iterations && first.residual < 1e-5;
+
+    Parameters shifted = parameters(10000);
+    shifted.setShift(0.5);
+    GeneralizedShiftedInversePowerMethod<double> sipm(A, B, shifted);
+    sipm.solve();
+    ok = ok && sipm.getStats().factorizations == 1 && sipm.getStats().solves == sipm.getIterationCount();
+
+    GeneralizedQRMethod<double> qr(A, B, parameters(10000));
+    qr.solve();
+    const SolverStats& q = qr.getStats();
+    ok = ok && qr.hasConverged() && q.factorizations > qr.getIterationCount() && q.residual < 1e-6;
+    std::cout << "Generalized: power " << first.factorizations << " then " << second.factorizations
+              << " factorization(s), " << first.solves << " solves in " << iterations
+              << " iterations, residual " << first.residual << ", QR residual " << q.residual << std::endl;
+    return ok;
+}
+
+// One Sturm count per bisection step, one LU per eigenvector of the inverse iteration
+bool test_bisection() {
+    const int n = 200;
+    TridiagonalMatrix matrix(Eigen::VectorXd::Constant(n - 1, 0.5), Eigen::VectorXd::LinSpaced(n, 1, n),
+                             Eigen::VectorXd::Constant(n - 1, 0.5));
+    Parameters params = parameters(200);
+    params.setIndexRange(1, 5);
+    BisectionMethod bisection(matrix, params);
+    bisection.solve();
+    const SolverStats& stats = bisection.getStats();
+    return bisection.hasConverged() && stats.factorizations > 5 * 10 && stats.solves >= 5 &&
+           stats.matrixVectorProducts == 5 && stats.residual < 1e-8 && stats.iterationSeconds > 0;
+}
+
+// Products of the truncated SVD, as counted by the solver
+bool test_svd() {
+    Eigen::MatrixXd A = Eigen::MatrixXd::Random(60, 20);
+    Parameters params = parameters(100);
+    params.setNumValues(3);
+    TruncatedSVD<double> svd(A, params);
+    svd.solve();
+    const SolverStats& stats = svd.getStats();
+    return svd.hasConverged() && stats.matrixVectorProducts == svd.getProductCount() && stats.flops > 0 &&
+           stats.iterationSeconds > 0;
+}
+
+// The statistics follow the results in the text formats, as metadata in the binary format and as two arrays in
+// the NumPy archive; they are only written when set
+bool test_writers() {
+    Eigen::VectorXd values(4);
+    values << 1, 2, 3, 8;
+    Eigen::MatrixXd A = withEigenvalues(values);
+    Parameters params = parameters(1000);
+    params.setAlgorithm("QRMethod");
+    SolveResult<double> result = solveProblem<double>(A, Eigen::MatrixXd(), params);
+    bool ok = result.stats.factorizations == result.iterations && result.stats.totalSeconds() > 0;
+
+    std::string csv = temporary(".csv"), txt = temporary(".txt"), bres = temporary(".bres"), npz = temporary(".npz");
+    CSVWriter csvWriter(csv);
+    writeResult(result, csvWriter);
+    TextFileWriter textWriter(txt);
+    writeResult(result, textWriter);
+    BinaryWriter binaryWriter(bres, "QRMethod");
+    writeResult(result, binaryWriter);
+    NumpyWriter numpyWriter(npz);
+    writeResult(result, numpyWriter);
+
+    std::string expected = "Factorizations," + std::to_string(result.iterations) + "\n";
+    ok = ok && readFile(csv).find("\nSolver Statistics\nSetupSeconds,") != std::string::npos &&
+         readFile(csv).find(expected) != std::string::npos &&
+         readFile(txt).find("  Factorizations: " + std::to_string(result.iterations) + "\n") != std::string::npos;
+
+    BinaryResultReader reader(bres);
+    ok = ok && std::stod(reader.metadata("Factorizations")) == result.iterations &&
+         std::stod(reader.metadata("Residual")) == result.stats.residual &&
+         std::stod(reader.metadata("IterationSeconds")) == result.stats.iterationSeconds;
+
+    MappedFile archive(npz);
+    std::vector<NpzEntry> entries = listNpzEntries(archive.data(), archive.size());
+    bool hasStats = false, hasNames = false;
+    for (const NpzEntry& entry : entries) {
+        hasStats = hasStats || entry.name == "stats";
+        hasNames = hasNames || entry.name == "stats_names";
+    }
+    ok = ok && hasStats && hasNames;
+
+    // A result without statistics (from a cache or a server) is written as before
+    SolveResult<double> bare = result;
+    bare.stats = SolverStats();
+    CSVWriter bareWriter(csv);
+    writeResult(bare, bareWriter);
+    ok = ok && readFile(csv).find("Solver Statistics") == std::string::npos;
+
+    std::remove(csv.c_str());
+    std::remove(txt.c_str());
+    std::remove(bres.c_str());
+    std::remove(npz.c_str());
+    std::cout << "Writers: " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+int main() {
+    bool ok = true;
+    try {
+        ok = test_counts() && ok;
+        ok = test_generalized() && ok;
+        ok = test_bisection() && ok;
+        ok = test_svd() && ok;
+        ok = test_writers() && ok;
+    } catch (const std::exception& e) {
+        std::cout << "Unexpected error: " << e.what() << std::endl;
+        ok = false;
+    }
+
+    if (ok) {
+        std::cout << "Test succeed" << std::endl;
+        return 0;
+    }
+    std::cout << "Test failed" << std::endl;
+    return 1;
+}
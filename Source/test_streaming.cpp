@@ -0,0 +1,192 @@
+//
+// Test of the out-of-core Power Method: the matrix is streamed from a file in row panels at every iteration
+//
+
+#include "CSVReader.h"
+#include "PowerMethod.h"
+#include "StreamingPowerMethod.h"
+#include "TestHelpers.h"
+#include <Eigen/Eigenvalues>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+
+// Writes a matrix in the CSV input format, with the given separator
+void write_matrix(const std::string& filename, const Eigen::MatrixXd& A, char separator) {
+    std::ofstream file(filename);
+    file << std::setprecision(17);
+    for (int i = 0; i < A.rows(); ++i) {
+        for (int j = 0; j < A.cols(); ++j) {
+            file << A(i, j) << (j + 1 < A.cols() ? std::string(1, separator) : "\n");
+        }
+    }
+    file << "Algorithm,PowerMethod\nOutOfCore,1\n";
+}
+
+// Streamed product against the in-memory one, for an odd panel height
+bool test_product(const std::string& filename, const Eigen::MatrixXd& A) {
+    TextPanelSource<double> source(filename, 17);
+    StreamingMatrix<double> matrix(source);
+    Eigen::MatrixXd X = Eigen::MatrixXd::Random(A.cols(), 3);
+    Eigen::MatrixXd Y;
+    matrix.multiply(X, Y);
+    matrix.multiply(X, Y);
+
+    double error = (Y - A * X).norm() / (A * X).norm();
+    bool ok = error < 1e-14 && matrix.getTimings().products == 2 &&
+              matrix.getTimings().panels == 2 * ((A.rows() + 16) / 17);
+    std::cout << "Streamed product: relative error " << error << ", " << matrix.getTimings().panels
+              << " panels" << std::endl;
+    return ok;
+}
+
+// Single vector: same result as the in-memory PowerMethod
+bool test_vector(const std::string& filename, const Eigen::MatrixXd& A) {
+    Parameters params;
+    params.setTolerance(1e-10);
+    params.setMaxIterations(2000);
+
+    TextPanelSource<double> source(filename, 32);
+    StreamingMatrix<double> matrix(source);
+    StreamingPowerMethod<double> spm(matrix, params);
+    spm.solve();
+    spm.reportTimings(std::cout);
+
+    PowerMethod<double> pm(A, params);
+    pm.solve();
+
+    Eigen::VectorXd v = spm.getEigenvector();
+    double residual = (A * v - spm.getEigenvalue() * v).norm() / std::abs(spm.getEigenvalue());
+    std::cout << "Streamed Power Method: " << spm.getEigenvalue() << " (in memory " << pm.getEigenvalue() << "), "
+              << spm.getIterationCount() << " passes, residual " << residual << std::endl;
+    return spm.hasConverged() && std::abs(spm.getEigenvalue() - pm.getEigenvalue()) < 1e-8 && residual < 1e-4;
+}
+
+// Block of 4 vectors: the 4 eigenvalues of largest magnitude
+bool test_block(const std::string& filename, const Eigen::MatrixXd& A) {
+    Parameters params;
+    params.setTolerance(1e-10);
+    params.setMaxIterations(2000);
+    params.setNumValues(4);
+
+    TextPanelSource<double> source(filename);
+    StreamingMatrix<double> matrix(source);
+    StreamingPowerMethod<double> spm(matrix, params);
+    spm.solve();
+
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> reference(A);
+    Eigen::VectorXd expected = reference.eigenvalues().reverse().head(4);
+    Eigen::VectorXd values = spm.getAllEigenvalues();
+    Eigen::MatrixXd V = spm.getAllEigenvectors();
+    double residual = (A * V - V * values.asDiagonal()).norm() / values(0);
+    std::cout << "Streamed block power iteration: " << values.transpose() << ", " << spm.getIterationCount()
+              << " passes, residual " << residual << std::endl;
+    return spm.hasConverged() && (values - expected).cwiseAbs().maxCoeff() < 1e-8 && residual < 1e-4;
+}
+
+// Complex scalar type on a real file (the text readers keep real values)
+bool test_complex(const std::string& filename, const Eigen::MatrixXd& A) {
+    Parameters params;
+    params.setTolerance(1e-10);
+    params.setMaxIterations(2000);
+    params.setNumValues(2);
+
+    TextPanelSource<std::complex<double>> source(filename, 50);
+    StreamingMatrix<std::complex<double>> matrix(source);
+    StreamingPowerMethod<std::complex<double>> spm(matrix, params);
+    spm.solve();
+
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> reference(A);
+    double expected = reference.eigenvalues().maxCoeff();
+    std::cout << "Complex streamed block: " << spm.getAllEigenvalues().transpose() << std::endl;
+    return spm.hasConverged() && std::abs(spm.getEigenvalue() - expected) < 1e-8;
+}
+
+// Complex literals, (a,b) and a+bi, are parsed as by the in-memory readers
+bool test_complex_literals(const std::string& filename) {
+    const int n = 40;
+    Eigen::MatrixXcd C = Eigen::MatrixXcd::Random(n, n);
+    {
+        std::ofstream file(filename);
+        file << std::setprecision(17);
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                if ((i + j) % 2 == 0) {
+                    file << "(" << C(i, j).real() << "," << C(i, j).imag() << ")";
+                } else {
+                    file << C(i, j).real() << (C(i, j).imag() < 0 ? "-" : "+") << std::abs(C(i, j).imag()) << "i";
+                }
+                file << (j + 1 < n ? "," : "\n");
+            }
+        }
+        file << "Algorithm,PowerMethod\nOutOfCore,1\n";
+    }
+    TextPanelSource<std::complex<double>> source(filename, 7);
+    StreamingMatrix<std::complex<double>> matrix(source);
+    Eigen::MatrixXcd X = Eigen::MatrixXcd::Random(n, 2);
+    Eigen::MatrixXcd Y;
+    matrix.multiply(X, Y);
+    double error = (Y - C * X).norm() / (C * X).norm();
+    std::cout << "Streamed complex literals: " << source.cols() << " columns, relative error " << error << std::endl;
+    return source.rows() == n && source.cols() == n && error < 1e-14;
+}
+
+// A malformed row is reported by the prefetch thread and rethrown by the product
+bool test_error(const std::string& filename) {
+    {
+        std::ofstream file(filename);
+        file << "1,2,3\n4,5,6\n7,8\n";
+    }
+    TextPanelSource<double> source(filename, 1);
+    StreamingMatrix<double> matrix(source);
+    Eigen::MatrixXd X = Eigen::MatrixXd::Ones(3, 1), Y;
+    try {
+        matrix.multiply(X, Y);
+    } catch (const std::runtime_error& e) {
+        std::cout << "Malformed file: " << e.what() << std::endl;
+        return true;
+    }
+    return false;
+}
+
+int main() {
+    const int n = 300;
+    // Eigenvalues n 0.85^i (ratio 0.85 between neighbours)
+    Eigen::MatrixXd A = withEigenvalues(geometricSpectrum(n, 0.85));
+    std::string csv = "/tmp/pcsc_test_streaming_" + std::to_string(getpid()) + ".csv";
+    std::string txt = "/tmp/pcsc_test_streaming_" + std::to_string(getpid()) + ".txt";
+    write_matrix(csv, A, ',');
+    write_matrix(txt, A, ' ');
+
+    bool ok = true;
+    try {
+        ok = test_product(csv, A) && ok;
+        ok = test_product(txt, A) && ok;
+        ok = test_vector(csv, A) && ok;
+        ok = test_block(txt, A) && ok;
+        ok = test_complex(csv, A) && ok;
+        ok = test_complex_literals(txt) && ok;
+
+        // Parameters of the file
+        CSVReader<double> reader(csv);
+        ok = reader.ReadParameters().getOutOfCore() && ok;
+
+        ok = test_error(csv) && ok;
+    } catch (const std::exception& e) {
+        std::cout << "Unexpected error: " << e.what() << std::endl;
+        ok = false;
+    }
+    std::remove(csv.c_str());
+    std::remove(txt.c_str());
+
+    if (ok) {
+        std::cout << "Test succeed" << std::endl;
+        return 0;
+    }
+    std::cout << "Test failed" << std::endl;
+    return 1;
+}
@@ -0,0 +1,95 @@
+//
+// Test of the truncated SVD (restarted Golub-Kahan-Lanczos bidiagonalization)
+//
+
+#include "CSVReader.h"
+#include "TruncatedSVD.h"
+#include <Eigen/SVD>
+#include <iostream>
+#include <random>
+#include <complex>
+
+// Largest error on the singular values and on the two residuals A v - s u, A^H u - s v
+template <typename Scalar>
+double check(const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>& A, const TruncatedSVD<Scalar>& svd) {
+    Eigen::JacobiSVD<Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>> reference(A);
+    auto sigma = svd.getSingularValues();
+    auto U = svd.getLeftSingularVectors();
+    auto V = svd.getRightSingularVectors();
+
+    double max_error = 0.0;
+    for (int i = 0; i < sigma.size(); ++i) {
+        max_error = std::max(max_error, std::abs(sigma(i) - reference.singularValues()(i)));
+        max_error = std::max(max_error, (A * V.col(i) - sigma(i) * U.col(i)).norm());
+        max_error = std::max(max_error, (A.adjoint() * U.col(i) - sigma(i) * V.col(i)).norm());
+    }
+    return max_error / reference.singularValues()(0);
+}
+
+bool test_file(const std::string& filename) {
+    CSVReader<double> reader(filename);
+    Eigen::MatrixXd A = reader.ReadMatrix();
+    Parameters params = reader.ReadParameters();
+
+    TruncatedSVD<double> svd(A, params);
+    svd.solve();
+    double error = check(A, svd);
+    std::cout << "Singular values of the " << A.rows() << "x" << A.cols() << " file matrix: "
+              << svd.getSingularValues().transpose() << "  (error " << error << ")" << std::endl;
+    return svd.getSingularValues().size() == params.getNumValues() && error < 1e-8;
+}
+
+bool test_random_real(int m, int n, int k) {
+    std::mt19937 generator(42);
+    std::normal_distribution<double> normal;
+    Eigen::MatrixXd A(m, n);
+    for (int i = 0; i < m; ++i)
+        for (int j = 0; j < n; ++j) A(i, j) = normal(generator);
+
+    Parameters params;
+    params.setNumValues(k);
+    params.setTolerance(1e-10);
+    TruncatedSVD<double> svd(A, params);
+    svd.setSubspaceSize(k + 6);  // small subspace to force restarts
+    svd.solve();
+    double error = check(A, svd);
+    std::cout << "Random " << m << "x" << n << ", k=" << k << ": " << svd.getIterationCount()
+              << " restart cycle(s), error " << error << std::endl;
+    return svd.hasConverged() && error < 1e-8;
+}
+
+bool test_random_complex(int m, int n, int k) {
+    std::mt19937 generator(7);
+    std::normal_distribution<double> normal;
+    Eigen::MatrixXcd A(m, n);
+    for (int i = 0; i < m; ++i)
+        for (int j = 0; j < n; ++j) A(i, j) = std::complex<double>(normal(generator), normal(generator));
+
+    Parameters params;
+    params.setNumValues(k);
+    params.setTolerance(1e-10);
+    TruncatedSVD<std::complex<double>> svd(A, params);
+    svd.solve();
+    double error = check(A, svd);
+    std::cout << "Complex " << m << "x" << n << ", k=" << k << ": error " << error << std::endl;
+    return svd.hasConverged() && error < 1e-8;
+}
+
+int main() {
+    try {
+        bool file = test_file("../data/test_matrix_svd.csv");
+        bool tall = test_random_real(120, 50, 4);
+        bool wide = test_random_real(30, 90, 3);
+        bool complex = test_random_complex(60, 40, 3);
+
+        if (file && tall && wide && complex) {
+            std::cout << "Test succeed" << std::endl;
+            return 0;
+        }
+        std::cout << "Test failed" << std::endl;
+        return 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Error " << e.what() << std::endl;
+        return 1;
+    }
+}
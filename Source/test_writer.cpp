@@ -0,0 +1,205 @@
+//
+// Test of the CSV and text writers: same bytes as the stream formatting, parallel blocks, precision and throughput
+//
+
+#include "OutputBuffer.h"
+#include "TestHelpers.h"
+#include "Writer.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+std::string temporary(const std::string& suffix) {
+    return "/tmp/pcsc_test_writer_" + std::to_string(getpid()) + suffix;
+}
+
+// The layouts as written with std::ostream and std::endl before the buffered writers
+std::string stream_csv(const Eigen::VectorXcd& values, const Eigen::MatrixXcd& vectors, int iterations) {
+    std::ostringstream file;
+    file << "QR METHOD - ALL EIGENVALUES AND EIGENVECTORS (COMPLEX)" << std::endl;
+    file << "Iterations," << iterations << std::endl;
+    file << "Converged," << "Yes" << std::endl;
+    file << std::endl;
+    file << "Eigenvalue_Index,Real_Part,Imaginary_Part" << std::endl;
+    for (int i = 0; i < values.size(); ++i) {
+        file << "lambda_" << (i+1) << "," << values(i).real() << "," << values(i).imag() << std::endl;
+    }
+    file << std::endl;
+    file << "All Eigenvectors (Real parts)" << std::endl;
+    for (int i = 0; i < vectors.rows(); ++i) {
+        for (int j = 0; j < vectors.cols(); ++j) {
+            file << vectors(i, j).real();
+            if (j < vectors.cols() - 1) file << ",";
+        }
+        file << std::endl;
+    }
+    file << std::endl;
+    file << "All Eigenvectors (Imaginary parts)" << std::endl;
+    for (int i = 0; i < vectors.rows(); ++i) {
+        for (int j = 0; j < vectors.cols(); ++j) {
+            file << vectors(i, j).imag();
+            if (j < vectors.cols() - 1) file << ",";
+        }
+        file << std::endl;
+    }
+    return file.str();
+}
+
+std::string stream_text(const Eigen::VectorXd& values, const Eigen::MatrixXd& vectors, int iterations) {
+    std::ostringstream file;
+    file << "  QR METHOD - ALL EIGENVALUES/VECTORS  " << std::endl;
+    file << "Convergence Status: " << "NOT CONVERGED" << std::endl;
+    file << "Number of Iterations: " << iterations << std::endl << std::endl;
+    file << "ALL EIGENVALUES:" << std::endl;
+    for (int i = 0; i < values.size(); ++i) {
+        file << "  lambda_" << (i+1) << " = " << values(i) << std::endl;
+    }
+    file << std::endl;
+    file << "ALL EIGENVECTORS:" << std::endl;
+    for (int i = 0; i < vectors.cols(); ++i) {
+        file << "\nEigenvector v_" << (i+1) << ":" << std::endl;
+        for (int j = 0; j < vectors.rows(); ++j) {
+            file << "  v[" << j << "] = " << vectors(j, i) << std::endl;
+        }
+    }
+    return file.str();
+}
+
+std::string stream_single(std::complex<double> value, const Eigen::VectorXcd& vector) {
+    std::ostringstream file;
+    file << "     EIGENVALUE COMPUTATION RESULTS     " << std::endl;
+    file << "Convergence Status: " << "CONVERGED" << std::endl;
+    file << "Number of Iterations: " << 3 << std::endl << std::endl;
+    file << "Dominant Eigenvalue: " << value.real();
+    if (value.imag() >= 0) {
+        file << " + " << value.imag() << "i" << std::endl << std::endl;
+    } else {
+        file << " - " << -value.imag() << "i" << std::endl << std::endl;
+    }
+    file << "Corresponding Eigenvector:" << std::endl;
+    for (int i = 0; i < vector.size(); ++i) {
+        file << "  v[" << i << "] = " << vector(i).real();
+        if (vector(i).imag() >= 0) {
+            file << " + " << vector(i).imag() << "i" << std::endl;
+        } else {
+            file << " - " << -vector(i).imag() << "i" << std::endl;
+        }
+    }
+    return file.str();
+}
+
+// Values whose formatting differs between methods if anything is off
+Eigen::MatrixXd awkward(long rows, long cols) {
+    Eigen::MatrixXd A = Eigen::MatrixXd::Random(rows, cols);
+    const double specials[] = {0.0, -0.0, 1e-300, -4.9e-324, 1e300, 123456789.0, 0.1, 100000.0, 1000000.0, 1.0 / 3,
+                               std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(),
+                               std::numeric_limits<double>::quiet_NaN()};
+    for (long k = 0; k < static_cast<long>(sizeof(specials) / sizeof(double)) && k < A.size(); ++k) {
+        A(k % rows, k / rows) = specials[k];
+    }
+    return A;
+}
+
+// Small and large results (the large ones are formatted by several threads) give the bytes of the old writers
+bool test_layouts(const std::string& csv, const std::string& text) {
+    bool ok = true;
+    for (long n : {4L, 700L}) {
+        Eigen::VectorXcd values(n);
+        values.real() = awkward(n, 1).col(0);
+        values.imag() = Eigen::VectorXd::Random(n);
+        Eigen::MatrixXcd vectors(n, n);
+        vectors.real() = awkward(n, n);
+        vectors.imag() = Eigen::MatrixXd::Random(n, n) * 1e5;
+
+        CSVWriter csvWriter(csv);
+        csvWriter.setThreads(4);
+        csvWriter.writeAll(values, vectors, 42, true);
+        ok = ok && readFile(csv) == stream_csv(values, vectors, 42);
+
+        TextFileWriter textWriter(text);
+        textWriter.setThreads(3);
+        textWriter.writeAll(Eigen::VectorXd(values.real()), Eigen::MatrixXd(vectors.real()), 7, false);
+        ok = ok && readFile(text) == stream_text(values.real(), vectors.real(), 7);
+
+        textWriter.write(values(0), vectors.col(0), 3, true);
+        ok = ok && readFile(text) == stream_single(values(0), vectors.col(0));
+        std::cout << n << "x" << n << " layouts: " << (ok ? "ok" : "mismatch") << std::endl;
+    }
+    return ok;
+}
+
+// Precision 0 writes the shortest text reading back to the same double
+bool test_precision() {
+    OutputBuffer shortest(0), fixed(3), stream;
+    const double values[] = {0.1, 1.0 / 3, 2.5e-310, 6.02214076e23, -1.0};
+    bool ok = true;
+    for (double value : values) {
+        shortest.clear();
+        shortest << value;
+        ok = ok && std::strtod(std::string(shortest.data(), shortest.size()).c_str(), nullptr) == value;
+    }
+    fixed << 1.0 / 3 << ' ' << 12345.0 << ' ' << -7L;
+    stream << 1.0 / 3 << ',' << 1e-5 << ',' << 1e16;
+    ok = ok && std::string(fixed.data(), fixed.size()) == "0.333 1.23e+04 -7" &&
+         std::string(stream.data(), stream.size()) == "0.333333,1e-05,1e+16";
+    std::cout << "Precision: " << (ok ? "ok" : "mismatch") << std::endl;
+    return ok;
+}
+
+// Writing a large eigenvector matrix with the stream formatting and with the writer
+bool benchmark_writeAll(const std::string& csv, int n) {
+    Eigen::VectorXd values = Eigen::VectorXd::Random(n);
+    Eigen::MatrixXd vectors = Eigen::MatrixXd::Random(n, n);
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::ofstream file(csv);
+        for (int i = 0; i < vectors.rows(); ++i) {
+            for (int j = 0; j < vectors.cols(); ++j) {
+                file << vectors(i, j);
+                if (j < vectors.cols() - 1) file << ",";
+            }
+            file << std::endl;
+        }
+    }
+    double streamSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    CSVWriter(csv).writeAll(values, vectors, 1, true);
+    double bufferedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << n << "x" << n << " eigenvectors: std::endl " << streamSeconds << " s, buffered " << bufferedSeconds
+              << " s (x" << streamSeconds / bufferedSeconds << ")" << std::endl;
+    return bufferedSeconds > 0;
+}
+
+int main() {
+    std::string csv = temporary(".csv");
+    std::string text = temporary(".txt");
+
+    bool ok = true;
+    try {
+        ok = test_layouts(csv, text) && ok;
+        ok = test_precision() && ok;
+        ok = benchmark_writeAll(csv, 2000) && ok;
+    } catch (const std::exception& e) {
+        std::cout << "Unexpected error: " << e.what() << std::endl;
+        ok = false;
+    }
+    std::remove(csv.c_str());
+    std::remove(text.c_str());
+
+    if (ok) {
+        std::cout << "Test succeed" << std::endl;
+        return 0;
+    }
+    std::cout << "Test failed" << std::endl;
+    return 1;
+}
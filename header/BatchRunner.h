@@ -0,0 +1,155 @@
+#ifndef BATCHRUNNER_H
+#define BATCHRUNNER_H
+
+#include "ResultCache.h"
+#include "SolveJob.h"
+#include <cstdint>
+#include <future>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * \brief Settings of a \c BatchRunner.
+ */
+struct BatchOptions {
+    /**
+     * \brief Directory of the result files, named after their input (see \c resultName()).
+     */
+    std::string outputDirectory = ".";
+
+    /**
+     * \brief Output format: \c csv, \c txt, \c npz or \c bres.
+     */
+    std::string format = "csv";
+
+    /**
+     * \brief Algorithm replacing the one of every input, if not empty.
+     */
+    std::string algorithm;
+
+    /**
+     * \brief Jobs solved at the same time; values below 1 mean \c defaultThreadCount().
+     */
+    int jobs = 0;
+
+    /**
+     * \brief Threads of each solver, replacing the \c Threads parameter of the inputs. -1 keeps it when the batch
+     * runs one job at a time and uses 1 otherwise, the parallelism then coming from the jobs.
+     */
+    int threads = -1;
+
+    /**
+     * \brief Directory of a \c ResultCache serving the problems already solved by earlier runs; none if empty.
+     */
+    std::string cacheDirectory;
+
+    /**
+     * \brief Size cap of the cache; 0 for none.
+     */
+    std::uint64_t cacheBytes = 0;
+};
+
+/**
+ * \brief Counts and times of a \c BatchRunner run.
+ */
+struct BatchStats {
+    long jobs = 0;
+    long solved = 0;
+    long failed = 0;
+
+    /**
+     * \brief Jobs run by another worker than the one they were dealt to.
+     */
+    long stolen = 0;
+
+    /**
+     * \brief Jobs served by the cache, and jobs given the result of an identical problem of the same batch.
+     */
+    long cached = 0;
+    long duplicates = 0;
+
+    /**
+     * \brief Sum of the times of the jobs (read, solve, write), and wall time of the batch.
+     */
+    double jobSeconds = 0.0;
+    double wallSeconds = 0.0;
+};
+
+/**
+ * \brief Expands the inputs given on the command line into a list of files.
+ * \details An argument holding \c *, \c ? or \c [ is a glob pattern, expanded in sorted order (a pattern that
+ * matches nothing is an error); an argument \c \@FILE names a manifest with one input per line, blank lines and
+ * lines starting with \c # being ignored (manifest lines may be patterns too); any other argument is a file.
+ * \throw std::runtime_error If a manifest cannot be read or a pattern matches no file.
+ */
+std::vector<std::string> expandInputs(const std::vector<std::string>& arguments);
+
+/**
+ * \brief Name of the result file of an input: \c result_ followed by the input name without directory,
+ * compression suffix and extension, then \c extension (\c ../data/matrix.csv.gz gives \c result_matrix.csv).
+ * \details The prefix keeps the inputs safe when the results are written to the directory of the inputs.
+ */
+std::string resultName(const std::string& input, const std::string& extension);
+
+/**
+ * \class BatchRunner
+ * \brief Solves many input files without any question, each into its own result file.
+ *
+ * \details Every input is a job: it is read with the reader of its format, solved with \c solveProblem() and
+ * written with the writer of the output format. The jobs run on a \c WorkStealingPool, submitted from the largest
+ * input file to the smallest: the long jobs start first, and the workers that finish early take the short jobs
+ * left to the others, so a batch mixing 10x10 and 5000x5000 matrices does not end with one worker alone on a
+ * backlog. A job that fails is reported on the log and does not stop the others.
+ *
+ * Identical problems (same matrices and same parameters, see \c ResultCache::key()) are solved once per batch:
+ * the first job solves, the others wait for its result and write it to their own file. With a cache directory,
+ * problems solved by earlier runs are not solved again.
+ * \tparam Scalar \c double or \c std::complex<double>.
+ */
+template<typename Scalar>
+class BatchRunner {
+public:
+    /**
+     * \brief Constructs the runner.
+     * \throw std::runtime_error For an unknown output format.
+     */
+    explicit BatchRunner(const BatchOptions& options);
+
+    /**
+     * \brief Solves all the inputs.
+     * \param inputs The input files (see \c expandInputs()).
+     * \param log Receives one line per job, as the jobs finish.
+     * \return The counts and times of the batch.
+     */
+    BatchStats run(const std::vector<std::string>& inputs, std::ostream& log);
+
+private:
+    /**
+     * \brief Results of the batch by problem key, each set by the first job of its problem.
+     */
+    struct Solutions {
+        std::map<std::string, std::shared_future<SolveResult<Scalar>>> byKey;
+        std::mutex mutex;
+        ResultCache* cache = nullptr;
+    };
+
+    /**
+     * \brief Where the result of a job came from.
+     */
+    enum class Origin { Solved, Cached, Duplicate };
+
+    /**
+     * \brief Reads, solves and writes one input.
+     * \return The algorithm, iterations and convergence, for the log.
+     * \throw std::runtime_error On any failure of the job.
+     */
+    std::string runJob(const std::string& input, const std::string& outputFile, int threads, Solutions& solutions,
+                       Origin& origin) const;
+
+    BatchOptions mOptions;
+};
+
+#endif // BATCHRUNNER_H
@@ -0,0 +1,128 @@
+#ifndef BINARYMATRIX_H
+#define BINARYMATRIX_H
+
+#include "Parameters.h"
+#include <Eigen/Dense>
+#include <complex>
+#include <cstdint>
+#include <string>
+
+/**
+ * \brief Fixed 64-byte header at the start of a binary matrix file (\c .bmat).
+ *
+ * \details Layout of the file, all integers little-endian:
+ * - this header;
+ * - \c parameterBytes bytes of parameters as \c Name,Value text lines (the syntax of the CSV files), possibly none;
+ * - padding up to \c dataOffset, a multiple of \c kBinaryMatrixAlignment;
+ * - \c rows x \c cols raw scalars in the given storage order (complex values as real, imaginary pairs).
+ *
+ * Because the data is aligned and stored exactly as Eigen lays it out, a reader can map the file and use it in
+ * place. \sa BinaryReader \sa BinaryMatrixWriter
+ */
+struct BinaryMatrixHeader {
+    /**
+     * \brief \c kBinaryMatrixMagic.
+     */
+    char magic[8];
+
+    /**
+     * \brief Format version, \c kBinaryMatrixVersion.
+     */
+    std::uint32_t version;
+
+    /**
+     * \brief 1 for float64, 2 for complex128.
+     */
+    std::uint32_t scalarType;
+
+    /**
+     * \brief Size of the matrix.
+     */
+    std::uint64_t rows, cols;
+
+    /**
+     * \brief 0 for column-major (Eigen's default), 1 for row-major.
+     */
+    std::uint32_t storageOrder;
+
+    /**
+     * \brief Reserved, 0.
+     */
+    std::uint32_t flags;
+
+    /**
+     * \brief Length of the parameter text that follows the header.
+     */
+    std::uint64_t parameterBytes;
+
+    /**
+     * \brief Offset of the first scalar from the start of the file.
+     */
+    std::uint64_t dataOffset;
+
+    /**
+     * \brief Reserved, 0.
+     */
+    std::uint64_t reserved;
+};
+
+static_assert(sizeof(BinaryMatrixHeader) == 64, "BinaryMatrixHeader must stay 64 bytes");
+
+/**
+ * \brief First bytes of every binary matrix file.
+ */
+constexpr char kBinaryMatrixMagic[8] = {'P', 'C', 'S', 'C', 'M', 'A', 'T', '\x1a'};
+
+/**
+ * \brief Current format version.
+ */
+constexpr std::uint32_t kBinaryMatrixVersion = 1;
+
+/**
+ * \brief Alignment of the data block, enough for AVX-512 loads.
+ */
+constexpr std::uint64_t kBinaryMatrixAlignment = 64;
+
+/**
+ * \brief \c scalarType of real (float64) data.
+ */
+constexpr std::uint32_t kBinaryScalarReal = 1;
+
+/**
+ * \brief \c scalarType of complex (complex128) data.
+ */
+constexpr std::uint32_t kBinaryScalarComplex = 2;
+
+/**
+ * \class BinaryMatrixWriter
+ * \brief Writes matrices (and optionally their parameters) in the binary matrix format.
+ *
+ * \details Converting a CSV input once with this writer makes every later run start without any parsing:
+ * \c BinaryReader maps the file and hands the data to the solvers in place.
+ */
+class BinaryMatrixWriter {
+public:
+    /**
+     * \brief Writes a real matrix.
+     * \param filename The output file, replaced if it exists.
+     * \param matrix The matrix, stored column-major.
+     * \param params Parameters stored with the matrix, or nullptr for none.
+     * \throw std::runtime_error If the file cannot be written.
+     */
+    static void write(const std::string& filename, const Eigen::MatrixXd& matrix, const Parameters* params = nullptr);
+
+    /**
+     * \brief Writes a complex matrix.
+     * \copydetails write(const std::string&, const Eigen::MatrixXd&, const Parameters*)
+     */
+    static void write(const std::string& filename, const Eigen::MatrixXcd& matrix, const Parameters* params = nullptr);
+
+private:
+    /**
+     * \brief Writes the header, the parameters and \c bytes bytes of column-major data.
+     */
+    static void writeFile(const std::string& filename, std::uint32_t scalarType, long rows, long cols,
+                          const void* data, std::size_t bytes, const Parameters* params);
+};
+
+#endif // BINARYMATRIX_H
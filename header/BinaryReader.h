@@ -0,0 +1,107 @@
+#ifndef BINARYREADER_H
+#define BINARYREADER_H
+
+#include "BinaryMatrix.h"
+#include "MappedFile.h"
+#include "Reader.h"
+
+/**
+ * \tparam Scalar The numeric type of the matrix elements (e.g., \c double, \c std::complex<double>).
+ * \class BinaryReader
+ * \brief Reads matrices in the binary matrix format (\c .bmat) by mapping the file in memory.
+ *
+ * \details Opening the reader only maps the file and checks its header: nothing is parsed. \c MapMatrix() then
+ * gives the matrix in place, as an \c Eigen::Map over the mapped pages, which the solvers of the \c Eigenvalue
+ * hierarchy accept without copying it. Loading is therefore bound by page faults, and processes that map the
+ * same file share its pages in the page cache. \c ReadMatrix() still returns an owned copy, for callers that
+ * need one (or when the file holds another scalar type or row-major data).
+ * \sa BinaryMatrixWriter
+ */
+template<typename Scalar>
+class BinaryReader : public Reader<Scalar> {
+public:
+    /**
+     * \brief Type alias for the matrix type.
+     */
+    using Matrix = typename Reader<Scalar>::Matrix;
+
+    /**
+     * \brief Read-only view of the mapped matrix.
+     */
+    using MatrixMap = Eigen::Map<const Matrix>;
+
+    /**
+     * \brief Maps the file and validates its header.
+     * \param filename The \c .bmat file.
+     * \throw std::runtime_error If the file cannot be mapped, is not a binary matrix file or is truncated.
+     */
+    BinaryReader(const std::string& filename);
+
+    /**
+     * \brief Destructor; unmaps the file, after which the views of \c MapMatrix() are invalid.
+     */
+    ~BinaryReader() override;
+
+    /**
+     * \brief The matrix, in place in the mapped file (no parsing, no copy).
+     * \details The view is valid as long as the reader exists.
+     * \throw std::runtime_error If the file holds another scalar type or row-major data (use \c ReadMatrix()).
+     */
+    MatrixMap MapMatrix() const;
+
+    /**
+     * \brief Copies the matrix out of the mapped file, converting real data to complex and row-major data
+     * to column-major as needed.
+     * \throw std::runtime_error If complex data is read as real.
+     */
+    Matrix ReadMatrix() override;
+
+    /**
+     * \brief Number of rows, from the header.
+     */
+    long CountMatrixRows() override;
+
+    /**
+     * \brief Copies only the rows \c firstRow .. \c firstRow + \c rowCount - 1; the other pages are never touched
+     * for row-major data.
+     */
+    Matrix ReadMatrixRows(long firstRow, long rowCount) override;
+
+    /**
+     * \brief Reads the parameters stored after the header (default parameters if there are none).
+     */
+    Parameters ReadParameters() override;
+
+    /**
+     * \brief The header of the file.
+     */
+    const BinaryMatrixHeader& header() const { return mHeader; }
+
+private:
+    /**
+     * \brief Copies the block of rows [firstRow, firstRow + rowCount) into an owned matrix.
+     */
+    Matrix copyRows(long firstRow, long rowCount) const;
+
+    /**
+     * \brief The mapped file.
+     */
+    MappedFile mFile;
+
+    /**
+     * \brief Copy of the header.
+     */
+    BinaryMatrixHeader mHeader;
+};
+
+/**
+ * \brief Type alias for a BinaryReader specialized for real-valued matrices.
+ */
+using BinaryReaderReal = BinaryReader<double>;
+
+/**
+ * \brief Type alias for a BinaryReader specialized for complex-valued matrices.
+ */
+using BinaryReaderComplex = BinaryReader<std::complex<double>>;
+
+#endif // BINARYREADER_H
@@ -0,0 +1,140 @@
+#ifndef BINARYRESULT_H
+#define BINARYRESULT_H
+
+#include "BinaryMatrix.h"
+#include "MappedFile.h"
+#include <Eigen/Dense>
+#include <cstdint>
+#include <string>
+
+/**
+ * \brief Fixed 128-byte header at the start of a binary result file (\c .bres), written by \c BinaryWriter.
+ *
+ * \details Layout of the file, all integers little-endian:
+ * - this header;
+ * - \c metadataBytes bytes of metadata as \c Name,Value text lines (\c Algorithm, then timings such as
+ *   \c SolveSeconds, then any other line, such as the key of a \c ResultCache entry, then the \c SolverStats
+ *   fields if they were set), possibly none;
+ * - padding up to \c valuesOffset, then \c count raw eigenvalues;
+ * - padding up to \c vectorsOffset, then the \c rows x \c vectorCount eigenvector matrix in column-major order.
+ *
+ * Both blocks start on a \c kBinaryMatrixAlignment boundary and complex values are stored as real, imaginary
+ * pairs, so the eigenvectors can be mapped and used in place. \sa BinaryWriter \sa BinaryResultReader
+ */
+struct BinaryResultHeader {
+    /**
+     * \brief \c kBinaryResultMagic.
+     */
+    char magic[8];
+
+    /**
+     * \brief Format version, \c kBinaryResultVersion.
+     */
+    std::uint32_t version;
+
+    /**
+     * \brief \c kBinaryScalarReal or \c kBinaryScalarComplex, as in the binary matrix format.
+     */
+    std::uint32_t scalarType;
+
+    /**
+     * \brief Number of eigenvalues.
+     */
+    std::uint64_t count;
+
+    /**
+     * \brief Length of the eigenvectors, and number of them (usually \c count, 0 without eigenvectors).
+     */
+    std::uint64_t rows, vectorCount;
+
+    /**
+     * \brief Iterations performed by the solver.
+     */
+    std::int64_t iterations;
+
+    /**
+     * \brief 1 if the solver converged, else 0.
+     */
+    std::uint32_t converged;
+
+    /**
+     * \brief Reserved, 0.
+     */
+    std::uint32_t flags;
+
+    /**
+     * \brief Length of the metadata text that follows the header.
+     */
+    std::uint64_t metadataBytes;
+
+    /**
+     * \brief Offsets of the eigenvalues and of the eigenvectors from the start of the file.
+     */
+    std::uint64_t valuesOffset, vectorsOffset;
+
+    /**
+     * \brief Reserved, 0.
+     */
+    std::uint64_t reserved[6];
+};
+
+static_assert(sizeof(BinaryResultHeader) == 128, "BinaryResultHeader must stay 128 bytes");
+
+/**
+ * \brief First bytes of every binary result file.
+ */
+constexpr char kBinaryResultMagic[8] = {'P', 'C', 'S', 'C', 'R', 'E', 'S', '\x1a'};
+
+/**
+ * \brief Current result format version.
+ */
+constexpr std::uint32_t kBinaryResultVersion = 1;
+
+/**
+ * \class BinaryResultReader
+ * \brief Maps a binary result file and gives its eigenvalues and eigenvectors in place.
+ */
+class BinaryResultReader {
+public:
+    /**
+     * \brief Maps the file and validates its header.
+     * \throw std::runtime_error If the file cannot be mapped, is not a result file or is truncated.
+     */
+    explicit BinaryResultReader(const std::string& filename);
+
+    /**
+     * \brief The header of the file.
+     */
+    const BinaryResultHeader& header() const { return mHeader; }
+
+    /**
+     * \brief Value of a metadata line, e.g. \c metadata("Algorithm"), or an empty string if there is none.
+     */
+    std::string metadata(const std::string& name) const;
+
+    /**
+     * \brief The eigenvalues, in place in the mapped file.
+     * \throw std::runtime_error If the file holds the other scalar type.
+     */
+    template<typename Scalar>
+    Eigen::Map<const Eigen::Matrix<Scalar, Eigen::Dynamic, 1>> MapEigenvalues() const;
+
+    /**
+     * \brief The eigenvectors in columns, in place in the mapped file.
+     * \throw std::runtime_error If the file holds the other scalar type.
+     */
+    template<typename Scalar>
+    Eigen::Map<const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>> MapEigenvectors() const;
+
+private:
+    /**
+     * \brief Throws unless the file holds values of type \c Scalar.
+     */
+    template<typename Scalar>
+    void checkScalar() const;
+
+    MappedFile mFile;
+    BinaryResultHeader mHeader;
+};
+
+#endif // BINARYRESULT_H
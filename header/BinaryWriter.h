@@ -0,0 +1,118 @@
+#ifndef BINARYWRITER_H
+#define BINARYWRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "BinaryResult.h"
+#include "Writer.h"
+
+/**
+ * \class BinaryWriter
+ * \brief Implements the Writer interface for outputting results in the binary result format (\c .bres).
+ *
+ * \details The file holds a \c BinaryResultHeader (iterations, convergence, sizes), the algorithm and the
+ * timings as metadata lines, then the raw eigenvalues and the eigenvector matrix, each aligned on 64 bytes.
+ * Nothing is formatted: the file is created at its final size, mapped, and the blocks are copied into the
+ * mapping by several threads. A 20000 x 20000 real result is written as its 3.2 GB of doubles, and is read back
+ * in place by \c BinaryResultReader.
+ * \ingroup IO
+ * \sa Writer \sa BinaryResultReader
+ */
+class BinaryWriter : public Writer {
+public:
+    /**
+     * \brief Constructs a BinaryWriter object.
+     * \param filename The path to the output \c .bres file.
+     * \param algorithm Name of the solver, stored in the metadata (none if empty).
+     */
+    BinaryWriter(const std::string& filename, const std::string& algorithm = "");
+
+    /**
+     * \brief Sets the name of the solver stored in the metadata.
+     */
+    void setAlgorithm(const std::string& algorithm);
+
+    /**
+     * \brief Adds a timing to the metadata, written as a \c <name>Seconds line (e.g. \c SolveSeconds).
+     */
+    void setTiming(const std::string& name, double seconds);
+
+    /**
+     * \brief Adds a \c <name>,<value> metadata line, written after the timings (a second call replaces the value).
+     */
+    void setMetadata(const std::string& name, const std::string& value);
+
+    /**
+     * \brief Does not print the "Results written to" line, for files that are not results given to the user.
+     */
+    void setQuiet(bool quiet);
+
+    /**
+     * \brief Writes a single real-valued eigenvalue/eigenvector pair to the binary file.
+     * \copydoc Writer::write(double, const Eigen::VectorXd&, int, bool)
+     */
+    void write(double eigenvalue,
+              const Eigen::VectorXd& eigenvector,
+              int iterations,
+              bool converged) const override;
+
+    /**
+     * \brief Writes a single complex-valued eigenvalue/eigenvector pair to the binary file.
+     * \copydoc Writer::write(std::complex<double>, const Eigen::VectorXcd&, int, bool)
+     */
+    void write(std::complex<double> eigenvalue,
+              const Eigen::VectorXcd& eigenvector,
+              int iterations,
+              bool converged) const override;
+
+    /**
+     * \brief Writes the entire set of real-valued eigenvalues and eigenvectors to the binary file.
+     * \copydoc Writer::writeAll(const Eigen::VectorXd&, const Eigen::MatrixXd&, int, bool)
+     */
+    void writeAll(const Eigen::VectorXd& eigenvalues,
+                 const Eigen::MatrixXd& eigenvectors,
+                 int iterations,
+                 bool converged) const override;
+
+    /**
+     * \brief Writes the entire set of complex-valued eigenvalues and eigenvectors to the binary file.
+     * \copydoc Writer::writeAll(const Eigen::VectorXcd&, const Eigen::MatrixXcd&, int, bool)
+     */
+    void writeAll(const Eigen::VectorXcd& eigenvalues,
+                 const Eigen::MatrixXcd& eigenvectors,
+                 int iterations,
+                 bool converged) const override;
+
+private:
+    /**
+     * \brief Writes the file.
+     * \param values The eigenvalues, \c count scalars of \c scalarBytes bytes.
+     * \param vectors The eigenvectors, \c rows x \c cols scalars in column-major order.
+     * \throw std::runtime_error If the file cannot be created or mapped.
+     */
+    void writeResult(std::uint32_t scalarType, std::size_t scalarBytes, const void* values, long count,
+                     const void* vectors, long rows, long cols, int iterations, bool converged) const;
+
+    /**
+     * \brief Name of the solver.
+     */
+    std::string mAlgorithm;
+
+    /**
+     * \brief Timings in seconds, in the order they were set.
+     */
+    std::vector<std::pair<std::string, double>> mTimings;
+
+    /**
+     * \brief Other metadata lines, in the order they were set.
+     */
+    std::vector<std::pair<std::string, std::string>> mMetadata;
+
+    bool mQuiet;
+};
+
+#endif // BINARYWRITER_H
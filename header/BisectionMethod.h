@@ -0,0 +1,210 @@
+#ifndef BISECTIONMETHOD_H
+#define BISECTIONMETHOD_H
+
+#include "TridiagonalMatrix.h"
+#include "Parameters.h"
+#include "SolverStats.h"
+#include <Eigen/Dense>
+#include <utility>
+#include <vector>
+
+/**
+ * \class BisectionMethod
+ * \brief Computes selected eigenpairs of a (symmetrizable) real tridiagonal matrix by Sturm-sequence bisection
+ * followed by inverse iteration.
+ *
+ * \details For a symmetric tridiagonal matrix T, the number of negative pivots of the LDL^T factorization of
+ * $T - xI$ (its Sturm count) equals the number of eigenvalues smaller than x. Bisection on this count isolates
+ * the k-th eigenvalue in O(n) operations per step, independently of all the others, so only the wanted eigenvalues
+ * (indices il..iu, or those inside a value range) are ever computed. The matching eigenvectors are then obtained
+ * by inverse iteration with a tridiagonal LU factorization of $T - \lambda I$, again in O(n) per eigenvector.
+ * Both steps run in parallel, one eigenvalue (or one cluster of close eigenvalues) per task, and never form the
+ * dense matrix, which makes n = 10^6 practical.
+ *
+ * Non-symmetric matrices with \c lower(i) * \c upper(i) > 0 are handled through the diagonal similarity that makes
+ * them symmetric.
+ *
+ * \sa TridiagonalMatrix
+ * \sa QRMethod
+ */
+class BisectionMethod {
+public:
+    /**
+     * \brief Constructs the solver for a tridiagonal matrix.
+     * \details The tolerance, the maximum number of bisection steps, and the wanted index or value range are
+     * taken from \c params. Without a range, all eigenvalues are computed.
+     * \param matrix The tridiagonal matrix.
+     * \param params A structure containing the configuration settings.
+     */
+    BisectionMethod(const TridiagonalMatrix& matrix, const Parameters& params);
+
+    /**
+     * \brief Destructor for BisectionMethod.
+     */
+    virtual ~BisectionMethod();
+
+    /**
+     * \brief Computes the selected eigenvalues, then (if enabled) their eigenvectors.
+     * \pre The matrix must be symmetrizable (see \c TridiagonalMatrix::isSymmetrizable()).
+     * \post \c getAllEigenvalues() holds the selected eigenvalues in ascending order and \c getAllEigenvectors()
+     * the matching unit eigenvectors as columns.
+     * \throw std::runtime_error If the matrix is not symmetrizable.
+     */
+    void solve();
+
+    /**
+     * \brief Selects the eigenvalues with 1-based indices il..iu in ascending order.
+     */
+    void setIndexRange(int indexLow, int indexHigh);
+
+    /**
+     * \brief Selects the eigenvalues in the half-open interval [lower, upper).
+     */
+    void setValueRange(double lower, double upper);
+
+    /**
+     * \brief Enables or disables the inverse iteration step (enabled by default).
+     */
+    void setComputeEigenvectors(bool compute);
+
+    /**
+     * \brief Sets the number of threads (values below 1 mean one per hardware thread; default \c params.getThreads()).
+     */
+    void setThreadCount(int threads);
+
+    /**
+     * \brief Counts the eigenvalues strictly smaller than \c x with a Sturm sequence.
+     * \param x The point at which the count is evaluated.
+     * \return The number of eigenvalues of the matrix smaller than \c x.
+     */
+    int countEigenvaluesBelow(double x) const;
+
+    /**
+     * \brief Retrieves the selected eigenvalues in ascending order.
+     */
+    Eigen::VectorXd getAllEigenvalues() const { return mAllEigenvalues; }
+
+    /**
+     * \brief Retrieves the eigenvectors (as columns) matching \c getAllEigenvalues().
+     */
+    Eigen::MatrixXd getAllEigenvectors() const { return mAllEigenvectors; }
+
+    /**
+     * \brief Checks if every bisection reached the tolerance within the maximum number of steps.
+     */
+    bool hasConverged() const { return mConverged; }
+
+    /**
+     * \brief Retrieves the largest number of bisection steps used for one eigenvalue.
+     */
+    int getIterationCount() const { return mIterationCount; }
+
+    /**
+     * \brief Retrieves the statistics of the last \c solve(): each Sturm count is one LDL^T factorization, each
+     * inverse iteration step one tridiagonal solve, and the residual the largest $\|Tx - \lambda x\|$ of the pairs.
+     */
+    const SolverStats& getStats() const { return mStats; }
+
+private:
+    /**
+     * \brief Isolates the eigenvalue of 0-based index \c k by bisection.
+     * \param k The index of the eigenvalue in ascending order.
+     * \param steps Receives the number of bisection steps.
+     * \return The midpoint of the final bracketing interval.
+     */
+    double bisect(int k, int& steps) const;
+
+    /**
+     * \brief Computes by inverse iteration the eigenvectors of the selected eigenvalues \c first..last (inclusive),
+     * which form one cluster and are orthogonalized against each other.
+     * \return The number of tridiagonal solves performed.
+     */
+    int inverseIteration(int first, int last);
+
+    /**
+     * \brief Groups the \c count selected eigenvalues into clusters of close ones for \c inverseIteration().
+     * \details Neighbours within 1e-3 ||T|| share a cluster, as in LAPACK's dstein. A dense spectrum chains most
+     * eigenvalues into one cluster, which is serial and costs O(n k^2) in Gram-Schmidt steps, so a cluster longer
+     * than 64 is split at the widest gap of its middle half, provided that gap is at least 1e-6 ||T||: the vectors
+     * on both sides then stay orthogonal to about eps ||T|| / gap, below 1e-9.
+     * \return The first and last indices of each cluster, in ascending order.
+     */
+    std::vector<std::pair<int, int>> clusters(int count) const;
+
+    /**
+     * \brief The input matrix.
+     */
+    TridiagonalMatrix mMatrix;
+
+    /**
+     * \brief Squares of the off-diagonal entries of the equivalent symmetric matrix, \c lower(i) * \c upper(i).
+     */
+    Eigen::VectorXd mOffDiagonalSquared;
+
+    /**
+     * \brief Lower end of the Gershgorin interval containing the spectrum.
+     */
+    double mSpectrumLow;
+
+    /**
+     * \brief Upper end of the Gershgorin interval containing the spectrum.
+     */
+    double mSpectrumHigh;
+
+    /**
+     * \brief Smallest pivot allowed in the Sturm sequence, to avoid divisions by zero.
+     */
+    double mPivotMin;
+
+    /**
+     * \brief Absolute tolerance of the bisection.
+     */
+    double mTolerance;
+
+    /**
+     * \brief Maximum number of bisection steps for one eigenvalue.
+     */
+    int mMaxIteration;
+
+    /**
+     * \brief The wanted range, copied from the parameters.
+     */
+    Parameters mParams;
+
+    /**
+     * \brief Whether the inverse iteration step runs.
+     */
+    bool mComputeEigenvectors;
+
+    /**
+     * \brief Number of threads used by both steps.
+     */
+    int mThreads;
+
+    /**
+     * \brief Flag to track if every bisection converged.
+     */
+    bool mConverged;
+
+    /**
+     * \brief Largest number of bisection steps used.
+     */
+    int mIterationCount;
+
+    /**
+     * \brief Statistics of the last solve.
+     */
+    SolverStats mStats;
+
+    /**
+     * \brief The selected eigenvalues, in ascending order.
+     */
+    Eigen::VectorXd mAllEigenvalues;
+
+    /**
+     * \brief The eigenvectors of the selected eigenvalues, as columns.
+     */
+    Eigen::MatrixXd mAllEigenvectors;
+};
+
+#endif // BISECTIONMETHOD_H
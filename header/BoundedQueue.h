@@ -0,0 +1,73 @@
+#ifndef BOUNDEDQUEUE_H
+#define BOUNDEDQUEUE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+/**
+ * \class BoundedQueue
+ * \brief First-in first-out queue between two threads, holding at most \c capacity items.
+ *
+ * \details \c push() waits while the queue is full and \c pop() while it is empty, so a fast producer is held
+ * back by a slow consumer and the memory used stays bounded. After \c close(), \c push() refuses new items and
+ * \c pop() returns the remaining ones, then \c false.
+ * \tparam T The type of the items, moved in and out of the queue.
+ */
+template<typename T>
+class BoundedQueue {
+public:
+    /**
+     * \brief Constructs an empty queue.
+     * \param capacity Maximum number of items; 0 is taken as 1.
+     */
+    explicit BoundedQueue(std::size_t capacity) : mCapacity(capacity > 0 ? capacity : 1), mClosed(false) {}
+
+    /**
+     * \brief Appends an item, waiting for room.
+     * \return False if the queue was closed (the item is dropped).
+     */
+    bool push(T item) {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mNotFull.wait(lock, [this] { return mItems.size() < mCapacity || mClosed; });
+        if (mClosed) return false;
+        mItems.push_back(std::move(item));
+        mNotEmpty.notify_one();
+        return true;
+    }
+
+    /**
+     * \brief Takes the oldest item, waiting for one.
+     * \return False once the queue is closed and empty.
+     */
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mNotEmpty.wait(lock, [this] { return !mItems.empty() || mClosed; });
+        if (mItems.empty()) return false;
+        item = std::move(mItems.front());
+        mItems.pop_front();
+        mNotFull.notify_one();
+        return true;
+    }
+
+    /**
+     * \brief Ends the queue: wakes the waiting threads, refuses new items.
+     */
+    void close() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mClosed = true;
+        mNotFull.notify_all();
+        mNotEmpty.notify_all();
+    }
+
+private:
+    std::mutex mMutex;
+    std::condition_variable mNotFull, mNotEmpty;
+    std::deque<T> mItems;
+    std::size_t mCapacity;
+    bool mClosed;
+};
+
+#endif // BOUNDEDQUEUE_H
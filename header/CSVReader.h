@@ -2,6 +2,7 @@
 #define CSVREADER_H
 
 #include "Reader.h"
+#include "TextMatrixParser.h"
 #include <Eigen/Dense>
 #include <string>
 #include <complex>
@@ -14,6 +15,7 @@
 * opening the specified file, parsing the matrix elements based on commas and newlines, and converting
 * this structured text data into an \c Eigen::MatrixXd object for use by the solvers.
 * It must handle potential file errors, invalid data formats, and type conversions.
+* The file is mapped once by the constructor and parsed by a \c TextMatrixParser, which every method shares.
 */
 
 template<typename Scalar = double>
@@ -34,12 +36,24 @@ public:
 // Qu'est ce que fait exactement lka fonction
     /**
      * \brief Reads and parse the matrix from the CSV file.
-    * \details This is the core reading method. It opens the file, iterates through lines, tokenizes
-     * based on the comma, converts string tokens to double-precision numbers, and builds
-     * the \c Eigen::MatrixXd structure.
+    * \details This is the core reading method. The rows are parsed from the mapped file straight into
+     * the matrix, with values separated by commas or semicolons.
      * \return This method returns an \c Eigen::MatrixX read from the file.
      */
     Matrix ReadMatrix() override;
+    /**
+     * \brief Reads the matrix B of a generalized problem, stored after a \c MatrixB line.
+     * \return The matrix B, or an empty matrix if the file has no \c MatrixB section.
+     */
+    Matrix ReadMatrixB() override;
+    /**
+     * \brief Counts the rows of the main matrix; the lines are not parsed.
+     */
+    long CountMatrixRows() override;
+    /**
+     * \brief Parses only the rows \c firstRow .. \c firstRow + \c rowCount - 1 of the main matrix.
+     */
+    Matrix ReadMatrixRows(long firstRow, long rowCount) override;
     /**
      * \brief Reads configuration parameters from the CSV file.
      * \details This method can be used to read settings like the expected matrix size, data precision,
@@ -50,9 +64,9 @@ public:
 
 private:
     /**
-     *  \brief Private function to ignore whitespace in the CSV file.
+     * \brief Parser over the mapped file, shared by the matrix and parameter readers.
      */
-    std::string trim(const std::string& str); // to ignore whitespace
+    TextMatrixParser mParser;
 };
 /**
  * \brief Type alias for a CSVReader specialized for real-valued matrices.
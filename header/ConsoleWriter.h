@@ -1,6 +1,7 @@
 #ifndef CONSOLEWRITER_H
 #define CONSOLEWRITER_H
 
+#include <ostream>
 #include <string>
 
 #include "Writer.h"
@@ -10,27 +11,66 @@
  * \brief Implements the Writer interface to output computation results directly to the console.
  *
  * \details The ConsoleWriter output the results, such as the eigenvalues and eigenvector
- * onto the console. The user can see it directly.
+ * onto the console. The user can see it directly. Each result is formatted in one buffer and printed at once,
+ * followed by the solver statistics when they were set.
  */
 class ConsoleWriter : public Writer {
 public:
     /**
-     * \brief Default constructor for ConsoleWriter.
+     * \brief Default constructor for ConsoleWriter, printing to \c std::cout.
      */
     ConsoleWriter();
+    /**
+     * \brief Constructor printing to another stream (e.g. \c std::cerr, or a string stream in the tests).
+     * \param out The stream; it must outlive the writer.
+     */
+    explicit ConsoleWriter(std::ostream& out);
     /**
      * \brief Default destructor for ConsoleWriter.
      */
     virtual ~ConsoleWriter();
+
+    /**
+     * \brief Prints a single real-valued eigenvalue/eigenvector pair.
+     * \copydoc Writer::write(double, const Eigen::VectorXd&, int, bool)
+     */
+    void write(double eigenvalue,
+               const Eigen::VectorXd& eigenvector,
+               int iterations,
+               bool converged) const override;
+
+    /**
+     * \brief Prints a single complex-valued eigenvalue/eigenvector pair.
+     * \copydoc Writer::write(std::complex<double>, const Eigen::VectorXcd&, int, bool)
+     */
+    void write(std::complex<double> eigenvalue,
+               const Eigen::VectorXcd& eigenvector,
+               int iterations,
+               bool converged) const override;
+
     /**
-     * \brief Writes the final results of the eigenvalue calculation to the console.
-     *
-     * \details This overridden method formats and prints the eigenvalue
-     * and the associated eigenvector (eigenvector) using `std::cout`.
-     * \pre The solver process must have successfully converged and calculated the results.
+     * \brief Prints the entire set of real-valued eigenvalues and eigenvectors.
+     * \copydoc Writer::writeAll(const Eigen::VectorXd&, const Eigen::MatrixXd&, int, bool)
      */
-    virtual void Write() override;
+    void writeAll(const Eigen::VectorXd& eigenvalues,
+                  const Eigen::MatrixXd& eigenvectors,
+                  int iterations,
+                  bool converged) const override;
 
+    /**
+     * \brief Prints the entire set of complex-valued eigenvalues and eigenvectors.
+     * \copydoc Writer::writeAll(const Eigen::VectorXcd&, const Eigen::MatrixXcd&, int, bool)
+     */
+    void writeAll(const Eigen::VectorXcd& eigenvalues,
+                  const Eigen::MatrixXcd& eigenvectors,
+                  int iterations,
+                  bool converged) const override;
+
+private:
+    /**
+     * \brief The stream the results are printed to.
+     */
+    std::ostream& mOut;
 };
 
-#endif //CONSOLEWRITER_H
\ No newline at end of file
+#endif //CONSOLEWRITER_H
@@ -0,0 +1,88 @@
+#ifndef CONVERGENCEHISTORY_H
+#define CONVERGENCEHISTORY_H
+
+#include <chrono>
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+/**
+ * \class ConvergenceHistory
+ * \brief Per-iteration trace of a solve: the eigenvalue estimate, a residual and the time since the start.
+ *
+ * \details The entries live in a ring buffer allocated by \c setCapacity(), so recording never allocates; when the
+ * solve runs longer than the capacity, the oldest iterations are overwritten and the last ones are kept. Disabled
+ * (capacity 0) by default: \c record() then returns after one test, and the solvers skip the computation of the
+ * residual as well.
+ * \sa Eigenvalue::getHistory()
+ * \sa PlotWriter
+ */
+class ConvergenceHistory {
+public:
+    /**
+     * \brief One recorded iteration.
+     */
+    struct Entry {
+        int iteration;
+        double seconds;
+        std::complex<double> estimate;
+        double residual;
+    };
+
+    ConvergenceHistory();
+
+    /**
+     * \brief Allocates the ring buffer and clears the trace.
+     * \param capacity Number of iterations kept; 0 disables the recording.
+     */
+    void setCapacity(std::size_t capacity);
+
+    std::size_t getCapacity() const { return mEntries.size(); }
+
+    bool isEnabled() const { return !mEntries.empty(); }
+
+    /**
+     * \brief Clears the trace and starts its clock, at the beginning of a solve.
+     */
+    void start();
+
+    /**
+     * \brief Records one iteration, overwriting the oldest entry when the buffer is full.
+     * \param iteration The 1-based iteration number.
+     * \param estimate The eigenvalue estimate after this iteration.
+     * \param residual The residual reported by the solver (see the solver's documentation).
+     */
+    void record(int iteration, std::complex<double> estimate, double residual) {
+        if (mEntries.empty()) return;
+        Entry& entry = mEntries[mNext];
+        entry.iteration = iteration;
+        entry.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - mStart).count();
+        entry.estimate = estimate;
+        entry.residual = residual;
+        if (++mNext == mEntries.size()) mNext = 0;
+        ++mRecorded;
+    }
+
+    /**
+     * \brief Number of iterations recorded since \c start(), including those overwritten.
+     */
+    long getRecordedCount() const { return mRecorded; }
+
+    /**
+     * \brief Number of entries held: the recorded count, at most the capacity.
+     */
+    std::size_t size() const;
+
+    /**
+     * \brief The entries held, oldest first.
+     */
+    std::vector<Entry> getEntries() const;
+
+private:
+    std::vector<Entry> mEntries;
+    std::size_t mNext;
+    long mRecorded;
+    std::chrono::steady_clock::time_point mStart;
+};
+
+#endif // CONVERGENCEHISTORY_H
@@ -0,0 +1,145 @@
+#ifndef DECOMPRESSOR_H
+#define DECOMPRESSOR_H
+
+#include "MappedFile.h"
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * \brief Compression of an input file, recognized by its first bytes.
+ */
+enum class Compression {
+    /** \brief Plain file. */
+    None,
+    /** \brief gzip (\c 1f \c 8b), also zlib streams and concatenated gzip members. */
+    Gzip,
+    /** \brief Zstandard (\c 28 \c b5 \c 2f \c fd). */
+    Zstd
+};
+
+/**
+ * \brief Reads the first bytes of a file to find its compression.
+ * \throw std::runtime_error If the file cannot be opened.
+ */
+Compression detectCompression(const std::string& filename);
+
+/**
+ * \brief Name of a compression format (\c "none", \c "gzip", \c "zstd").
+ */
+const char* compressionName(Compression compression);
+
+/**
+ * \brief The file name without a trailing \c .gz or \c .zst, to find the format of the compressed data.
+ */
+std::string uncompressedName(const std::string& filename);
+
+/**
+ * \class Decompressor
+ * \brief Decompresses a gzip or zstd file on a background thread, handing out the data in order, chunk by chunk.
+ *
+ * \details The compressed file is mapped in memory and inflated by a thread started in the constructor into
+ * chunks of \c chunkBytes, queued for \c next(). The queue holds at most \c queuedChunks chunks, so the thread
+ * waits when the consumer falls behind and the memory used stays bounded; while the consumer works on one chunk
+ * (copying, indexing lines), the thread decompresses the next ones. Nothing is written to disk.
+ *
+ * gzip support needs zlib and zstd support needs libzstd at build time (\c PCSC_HAVE_ZLIB, \c PCSC_HAVE_ZSTD);
+ * without them the constructor throws.
+ */
+class Decompressor {
+public:
+    /**
+     * \brief Default size of a chunk of decompressed data.
+     */
+    static constexpr std::size_t kChunkBytes = std::size_t(4) << 20;
+
+    /**
+     * \brief Maps the file and starts decompressing it.
+     * \param filename A gzip or zstd file.
+     * \param chunkBytes Size of the chunks handed out by \c next().
+     * \param queuedChunks Maximum number of chunks decompressed ahead of the consumer.
+     * \throw std::runtime_error If the file cannot be mapped, is not compressed, or its format was not built in.
+     */
+    explicit Decompressor(const std::string& filename, std::size_t chunkBytes = kChunkBytes,
+                          std::size_t queuedChunks = 4);
+
+    /**
+     * \brief Stops the thread, even if the data was not read to the end.
+     */
+    ~Decompressor();
+
+    Decompressor(const Decompressor&) = delete;
+    Decompressor& operator=(const Decompressor&) = delete;
+
+    /**
+     * \brief Waits for the next chunk of decompressed data.
+     * \param chunk Replaced by the next chunk.
+     * \return false at the end of the data (\c chunk is then empty).
+     * \throw std::runtime_error If the compressed data is corrupted or truncated.
+     */
+    bool next(std::vector<char>& chunk);
+
+    /**
+     * \brief Size of the decompressed data announced by the file, or 0 if unknown.
+     * \details The size field of gzip is modulo 4 GiB and zstd frames may omit it: use it only to reserve memory.
+     */
+    std::size_t sizeHint() const { return mSizeHint; }
+
+    /**
+     * \brief Compression of the file.
+     */
+    Compression compression() const { return mCompression; }
+
+    /**
+     * \brief Size of the compressed file in bytes.
+     */
+    std::size_t compressedSize() const { return mInput.size(); }
+
+private:
+    /**
+     * \brief Body of the thread: decompresses the whole file, chunk by chunk.
+     */
+    void run();
+
+    /**
+     * \brief Queues a full chunk, waiting for space; returns false if the consumer is gone.
+     */
+    bool push(std::vector<char>&& chunk);
+
+    void inflateGzip();
+    void inflateZstd();
+
+    /**
+     * \brief The compressed file.
+     */
+    MappedFile mInput;
+
+    Compression mCompression;
+    std::size_t mChunkBytes, mQueuedChunks, mSizeHint;
+
+    /**
+     * \brief Chunks waiting for \c next(), with their lock and conditions.
+     */
+    std::deque<std::vector<char>> mQueue;
+    std::mutex mMutex;
+    std::condition_variable mReady, mSpace;
+
+    /**
+     * \brief Set by the thread at the end of the data, and by the destructor to stop the thread.
+     */
+    bool mDone, mStopped;
+
+    /**
+     * \brief Error raised by the thread, rethrown by \c next().
+     */
+    std::exception_ptr mError;
+
+    std::thread mThread;
+};
+
+#endif // DECOMPRESSOR_H
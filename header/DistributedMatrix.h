@@ -0,0 +1,175 @@
+#ifndef DISTRIBUTEDMATRIX_H
+#define DISTRIBUTEDMATRIX_H
+
+#include <Eigen/Dense>
+#include <complex>
+#include <vector>
+#include "Reader.h"
+#include "Transport.h"
+
+/**
+ * \struct DistributedTimings
+ * \brief Time and traffic of one rank of a distributed solver.
+ */
+struct DistributedTimings {
+    /** \brief Seconds spent in local products and reductions. */
+    double computeSeconds = 0.0;
+    /** \brief Seconds spent in collectives (including waiting for slower ranks). */
+    double communicationSeconds = 0.0;
+    /** \brief Bytes sent by this rank. */
+    double bytesSent = 0.0;
+    /** \brief Bytes received by this rank. */
+    double bytesReceived = 0.0;
+    /** \brief Number of distributed matrix-vector products. */
+    double products = 0.0;
+};
+
+/**
+ * \tparam Scalar The underlying numeric type of the matrix elements (e.g., \c double, \c std::complex<double>).
+ * \class DistributedMatrix
+ * \brief One contiguous row block of a square matrix whose rows are split between the ranks of a \c Transport.
+ *
+ * \details Rank r owns rows [first_r, first_r + count_r) with an even split (see \c rowRange()), and only those rows
+ * are ever read from the input file. The class provides the three operations Krylov methods are made of:
+ * - \c multiplyLocal(): the owned part of $Ax$, for a replicated x (no communication);
+ * - \c gather(): the replicated vector from the owned parts (one all-gather);
+ * - \c dot(): the inner product of two row-distributed vectors (one all-reduce of one scalar).
+ *
+ * A power iteration needs \c multiply() = \c multiplyLocal() + \c gather() per step; a Lanczos iteration keeps
+ * its basis distributed and adds the \c dot() reductions of the orthogonalization. Every operation is timed and
+ * split between computation and communication.
+ * \sa DistributedPowerMethod
+ */
+template<typename Scalar>
+class DistributedMatrix {
+public:
+    /**
+     * \brief Type alias for the matrix type.
+     */
+    using Matrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+
+    /**
+     * \brief Type alias for the vector type.
+     */
+    using Vector = Eigen::Matrix<Scalar, Eigen::Dynamic, 1>;
+
+    /**
+     * \brief Wraps an already loaded row block.
+     * \param localRows The rows owned by this rank (\c rowRange() of it).
+     * \param globalRows Number of rows (and columns) n of the whole matrix.
+     * \param transport The transport connecting the ranks; it must outlive this object.
+     */
+    DistributedMatrix(const Matrix& localRows, long globalRows, Transport& transport);
+
+    /**
+     * \brief Reads only the row block of this rank from \c reader.
+     * \details Every rank counts the rows of the file (without parsing them), then parses its own block.
+     * \throw std::runtime_error If the matrix is not square.
+     */
+    static DistributedMatrix fromReader(Reader<Scalar>& reader, Transport& transport);
+
+    /**
+     * \brief Even split of \c globalRows rows over \c ranks ranks: the block of \c rank.
+     * \param globalRows Number of rows n.
+     * \param rank The rank.
+     * \param ranks The number of ranks.
+     * \param firstRow Receives the first row of the block.
+     * \param rowCount Receives the number of rows of the block.
+     */
+    static void rowRange(long globalRows, int rank, int ranks, long& firstRow, long& rowCount);
+
+    /**
+     * \brief Computes the owned rows of $Ax$ for a vector x replicated on every rank.
+     */
+    void multiplyLocal(const Vector& x, Vector& localResult);
+
+    /**
+     * \brief Assembles on every rank the full vector from the owned parts.
+     */
+    void gather(const Vector& local, Vector& global);
+
+    /**
+     * \brief Computes $y = Ax$ replicated on every rank (\c multiplyLocal() then \c gather()).
+     */
+    void multiply(const Vector& x, Vector& y);
+
+    /**
+     * \brief Inner product $a^H b$ of two row-distributed vectors, identical on every rank.
+     * \param localA, localB The owned parts of a and b.
+     */
+    Scalar dot(const Vector& localA, const Vector& localB);
+
+    /**
+     * \brief Timings of this rank since construction.
+     */
+    DistributedTimings getTimings() const;
+
+    /**
+     * \brief Collects the timings of all the ranks (collective: every rank must call it).
+     * \return One entry per rank, on every rank.
+     */
+    std::vector<DistributedTimings> gatherTimings();
+
+    /**
+     * \brief Number of rows and columns n of the whole matrix.
+     */
+    long globalRows() const { return mGlobalRows; }
+
+    /**
+     * \brief First row owned by this rank.
+     */
+    long firstRow() const { return mFirstRow; }
+
+    /**
+     * \brief The owned rows.
+     */
+    const Matrix& localRows() const { return mLocalRows; }
+
+    /**
+     * \brief The transport connecting the ranks.
+     */
+    Transport& transport() { return mTransport; }
+
+private:
+    /**
+     * \brief The rows owned by this rank.
+     */
+    Matrix mLocalRows;
+
+    /**
+     * \brief Number of rows n of the whole matrix.
+     */
+    long mGlobalRows;
+
+    /**
+     * \brief First row owned by this rank.
+     */
+    long mFirstRow;
+
+    /**
+     * \brief Size in bytes of the block of each rank in a gathered vector.
+     */
+    std::vector<std::size_t> mBytesPerRank;
+
+    /**
+     * \brief The transport connecting the ranks.
+     */
+    Transport& mTransport;
+
+    /**
+     * \brief Accumulated timings.
+     */
+    DistributedTimings mTimings;
+};
+
+/**
+ * \brief Type alias for the distributed real matrix.
+ */
+using DistributedMatrixReal = DistributedMatrix<double>;
+
+/**
+ * \brief Type alias for the distributed complex matrix.
+ */
+using DistributedMatrixComplex = DistributedMatrix<std::complex<double>>;
+
+#endif // DISTRIBUTEDMATRIX_H
@@ -0,0 +1,116 @@
+#ifndef DISTRIBUTEDPOWERMETHOD_H
+#define DISTRIBUTEDPOWERMETHOD_H
+
+#include "DistributedMatrix.h"
+#include "Parameters.h"
+#include <iosfwd>
+
+/**
+ * \tparam Scalar The underlying numeric type of the matrix elements (e.g., \c double, \c std::complex<double>).
+ * \class DistributedPowerMethod
+ * \brief Power Method on a matrix whose rows are split between processes, for matrices that do not fit in the
+ * memory of one node.
+ *
+ * \details Every rank runs the same iteration as \c PowerMethod. The product is \c DistributedMatrix::multiply():
+ * each rank multiplies its row block (O(n^2 / p) work), then the blocks of $Ax$ are exchanged so that every rank
+ * holds the whole vector (O(n) traffic per rank and per iteration). The normalization, argmax and convergence
+ * test are then evaluated redundantly, and identically, on every rank, which saves a second round of messages.
+ *
+ * The class is not an \c Eigenvalue: no rank holds the whole matrix.
+ * \sa PowerMethod
+ * \sa DistributedMatrix
+ */
+template<typename Scalar>
+class DistributedPowerMethod {
+public:
+    /**
+     * \brief Type alias for the vector type.
+     */
+    using Vector = typename DistributedMatrix<Scalar>::Vector;
+
+    /**
+     * \brief Constructor.
+     * \param matrix The row block of this rank; it must outlive the solver.
+     * \param params Tolerance and maximum number of iterations.
+     */
+    DistributedPowerMethod(DistributedMatrix<Scalar>& matrix, const Parameters& params);
+
+    /**
+     * \brief Runs the iteration; collective, every rank must call it.
+     * \post Every rank holds the same eigenvalue and the whole eigenvector.
+     */
+    void solve();
+
+    /**
+     * \brief Retrieves the computed eigenvalue.
+     */
+    Scalar getEigenvalue() const { return mEigenvalue; }
+
+    /**
+     * \brief Retrieves the computed (whole) eigenvector.
+     */
+    Vector getEigenvector() const { return mEigenvector; }
+
+    /**
+     * \brief Checks if the last call to \c solve() converged.
+     */
+    bool hasConverged() const { return mConverged; }
+
+    /**
+     * \brief Retrieves the number of iterations.
+     */
+    int getIterationCount() const { return mIterationCount; }
+
+    /**
+     * \brief Prints the compute / communication breakdown of every rank (collective; only rank 0 prints).
+     */
+    void reportTimings(std::ostream& out);
+
+private:
+    /**
+     * \brief The distributed matrix.
+     */
+    DistributedMatrix<Scalar>& mMatrix;
+
+    /**
+     * \brief The maximum number of iterations.
+     */
+    int mMaxIteration;
+
+    /**
+     * \brief The convergence threshold.
+     */
+    double mTolerance;
+
+    /**
+     * \brief The computed eigenvalue.
+     */
+    Scalar mEigenvalue;
+
+    /**
+     * \brief The computed eigenvector (whole, replicated).
+     */
+    Vector mEigenvector;
+
+    /**
+     * \brief Whether the last solve converged.
+     */
+    bool mConverged;
+
+    /**
+     * \brief Number of iterations of the last solve.
+     */
+    int mIterationCount;
+};
+
+/**
+ * \brief Type alias for the distributed Power Method on real matrices.
+ */
+using DistributedPowerMethodReal = DistributedPowerMethod<double>;
+
+/**
+ * \brief Type alias for the distributed Power Method on complex matrices.
+ */
+using DistributedPowerMethodComplex = DistributedPowerMethod<std::complex<double>>;
+
+#endif // DISTRIBUTEDPOWERMETHOD_H
@@ -3,7 +3,9 @@
 
 #include <Eigen/Dense>
 #include <complex>
+#include "ConvergenceHistory.h"
 #include "Parameters.h"
+#include "SolverStats.h"
 /**
  * \class Eigenvalue
  * \brief Abstract base class for all numerical methods used to solve eigenvalue problems.
@@ -20,6 +22,7 @@ public:
     using Matrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
     using Vector = Eigen::Matrix<Scalar, Eigen::Dynamic, 1>;
     using RealScalar = typename Eigen::NumTraits<Scalar>::Real;
+    using MatrixMap = Eigen::Map<const Matrix>;
 
     /**
      * \brief Default constructor for Eigenvalue.
@@ -28,6 +31,19 @@ public:
      * such as tolerance and maximum number of iterations.
      */
     Eigenvalue(const Matrix& matrix, const Parameters& params);
+    /**
+     * \brief Constructor on a matrix owned by the caller, which is used in place instead of being copied.
+     * \details Meant for large matrices mapped from a file (see \c BinaryReader::MapMatrix()); the storage
+     * must outlive the solver.
+     * \param matrix View of the input matrix.
+     * \param params It contains all the configuration settings.
+     */
+    Eigenvalue(const MatrixMap& matrix, const Parameters& params);
+    /**
+     * \brief Not copyable: \c mMatrix may point into the object's own storage.
+     */
+    Eigenvalue(const Eigenvalue&) = delete;
+    Eigenvalue& operator=(const Eigenvalue&) = delete;
     /**
     * \brief Default destructor for Eigenvalue.
     */
@@ -49,12 +65,18 @@ public:
      * \brief Sets the matrix.
      * \param matrix The matrix obtained from the reader file.
      */
-    void setMatrix(const Matrix& matrix);
+    virtual void setMatrix(const Matrix& matrix);
     /**
      * \brief Sets the maximum number of iterations.
      * \param maxIteration The upper limit on the number of steps the iterative solver will run.
      */
     void setMaxIteration(int maxIteration);
+    /**
+     * \brief Records the eigenvalue estimate and the residual of each iteration of the next solves.
+     * \param capacity The number of last iterations kept; 0 disables the recording (default
+     * \c params.getHistoryCapacity()).
+     */
+    void setHistoryCapacity(std::size_t capacity);
     /**
      * \brief Checks if the last call to \c solve() resulted in convergence.
      * \return \c true if the algorithm converged within the given tolerance and max iterations, \c false otherwise.
@@ -87,17 +109,46 @@ public:
      */
     int getIterationCount() const;
 
+    /**
+     * \brief Retrieves the statistics of the last call to \c solve(): time per phase, operation counts, memory
+     * and final residual.
+     */
+    const SolverStats& getStats() const;
+
+    /**
+     * \brief Retrieves the convergence trace of the last call to \c solve(), empty unless enabled by
+     * \c setHistoryCapacity(). The residual recorded at each iteration depends on the solver.
+     */
+    const ConvergenceHistory& getHistory() const;
+
     /**
      * \brief Check whether the matrix is invertible.
      */
     bool IsInvertible() const;
 
 
+private:
+    /**
+     * \brief Checks the shape of the matrix and draws the random start vector.
+     */
+    void initialize();
+
 protected:
     /**
-     * \brief The square matrix for which the eigenvalue problem is being solved.
+     * \brief Computes $\|Ax - \lambda x\| / \|x\|$ for the pair, and counts its product in \c mStats.
+     * \details Overridden by the generalized solvers, for which the residual is $\|Ax - \lambda Bx\| / \|x\|$.
+     */
+    virtual double measureResidual(Scalar eigenvalue, const Vector& eigenvector);
+
+    /**
+     * \brief Owned copy of the matrix, empty when the solver uses the caller's storage.
      */
-    Matrix mMatrix;
+    Matrix mStorage;
+    /**
+     * \brief The square matrix for which the eigenvalue problem is being solved (in \c mStorage or in the
+     * caller's storage).
+     */
+    MatrixMap mMatrix;
     /**
      * \brief The computed eigenvector corresponding to \c mEigenvalue.
      */
@@ -130,6 +181,14 @@ protected:
      * \brief The count of interation to reach an admissible result.
      */
     int mIterationCount;
+    /**
+     * \brief Statistics of the last call to \c solve(), reset at its start.
+     */
+    SolverStats mStats;
+    /**
+     * \brief Convergence trace of the last call to \c solve(), restarted at its start.
+     */
+    ConvergenceHistory mHistory;
 };
 /**
  * \brief Type alias for the base solver class operating on real numbers.
@@ -0,0 +1,140 @@
+#ifndef GENERALIZEDEIGENVALUE_H
+#define GENERALIZEDEIGENVALUE_H
+
+#include "Eigenvalue.h"
+#include <Eigen/Cholesky>
+#include <Eigen/LU>
+
+/**
+ * \tparam Scalar The underlying numeric type of the matrix elements (e.g., \c double, \c std::complex<double>).
+ * \class GeneralizedEigenvalue
+ * \brief Abstract base class for solvers of the generalized eigenvalue problem $Ax = \lambda Bx$.
+ *
+ * \details Extends \c Eigenvalue with the second matrix B. Instead of forming $B^{-1}A$ (an extra O(n^3) product
+ * that destroys the symmetry of symmetric-definite pairs), derived solvers apply $B^{-1}$ through a factorization
+ * of B that is computed once and cached across \c solve() calls: a Cholesky factorization when B is Hermitian
+ * positive-definite, a partial-pivoting LU factorization otherwise.
+ * \sa GeneralizedPowerMethod
+ * \sa GeneralizedShiftedInversePowerMethod
+ * \sa GeneralizedQRMethod
+ */
+template<typename Scalar>
+class GeneralizedEigenvalue : public Eigenvalue<Scalar> {
+public:
+    /**
+     * \brief Type alias for the matrix type used by the solver.
+     */
+    using Matrix = typename Eigenvalue<Scalar>::Matrix;
+
+    /**
+     * \brief Type alias for the vector type used by the solver.
+     */
+    using Vector = typename Eigenvalue<Scalar>::Vector;
+
+    /**
+     * \brief Constructor for the generalized problem.
+     * \param matrixA The matrix A.
+     * \param matrixB The matrix B, of the same size as A.
+     * \param params It contains all the configuration settings.
+     */
+    GeneralizedEigenvalue(const Matrix& matrixA, const Matrix& matrixB, const Parameters& params);
+
+    /**
+     * \brief Destructor for GeneralizedEigenvalue.
+     */
+    virtual ~GeneralizedEigenvalue();
+
+    /**
+     * \brief Sets the matrix A and invalidates the cached factorizations that depend on it.
+     * \param matrix The new matrix A.
+     */
+    void setMatrix(const Matrix& matrix) override;
+
+    /**
+     * \brief Sets the matrix B and invalidates all cached factorizations.
+     * \param matrixB The new matrix B.
+     */
+    void setMatrixB(const Matrix& matrixB);
+
+    /**
+     * \brief Gets the matrix B.
+     */
+    const Matrix& getMatrixB() const { return mMatrixB; }
+
+    /**
+     * \brief Checks whether (A, B) is a symmetric-definite pair: A and B Hermitian, B positive-definite.
+     * \details The result and the Cholesky factorization of B computed by the check are cached.
+     */
+    bool isSymmetricDefinite();
+
+protected:
+    /**
+     * \brief Computes $\|Ax - \lambda Bx\| / \|x\|$ for the pair, and counts its two products.
+     */
+    double measureResidual(Scalar eigenvalue, const Vector& eigenvector) override;
+
+    /**
+     * \brief Computes $B^{-1} x$ with the cached factorization of B.
+     * \param rhs The vector x.
+     * \param result Receives $B^{-1} x$.
+     */
+    void applyBInverse(const Vector& rhs, Vector& result);
+
+    /**
+     * \brief Factorizes B once (Cholesky if possible, LU otherwise); a factorization done here is counted and timed
+     * in \c mStats.
+     */
+    void factorizeB();
+
+    /**
+     * \brief Called whenever A or B changes, so that derived solvers can drop their own cached factorizations.
+     */
+    virtual void invalidateFactorizations();
+
+    /**
+     * \brief The matrix B of the generalized problem.
+     */
+    Matrix mMatrixB;
+
+    /**
+     * \brief Cached Cholesky factorization $B = LL^H$ (valid if \c mHasCholesky).
+     */
+    Eigen::LLT<Matrix> mCholeskyB;
+
+    /**
+     * \brief Cached LU factorization of B, used when B is not Hermitian positive-definite (valid if \c mHasLu).
+     */
+    Eigen::PartialPivLU<Matrix> mLuB;
+
+    /**
+     * \brief Whether \c mCholeskyB holds a valid factorization of B.
+     */
+    bool mHasCholesky;
+
+    /**
+     * \brief Whether \c mLuB holds a valid factorization of B.
+     */
+    bool mHasLu;
+
+    /**
+     * \brief Whether the symmetric-definite check already ran.
+     */
+    bool mStructureChecked;
+
+    /**
+     * \brief Cached result of the symmetric-definite check.
+     */
+    bool mSymmetricDefinite;
+};
+
+/**
+ * \brief Type alias for the generalized solver base class operating on real numbers.
+ */
+using GeneralizedEigenvalueReal = GeneralizedEigenvalue<double>;
+
+/**
+ * \brief Type alias for the generalized solver base class operating on complex numbers.
+ */
+using GeneralizedEigenvalueComplex = GeneralizedEigenvalue<std::complex<double>>;
+
+#endif // GENERALIZEDEIGENVALUE_H
@@ -0,0 +1,49 @@
+#ifndef GENERALIZEDPOWERMETHOD_H
+#define GENERALIZEDPOWERMETHOD_H
+
+#include "GeneralizedEigenvalue.h"
+
+/**
+ * \tparam Scalar The underlying numeric type of the matrix elements (e.g., \c double, \c std::complex<double>).
+ * \class GeneralizedPowerMethod
+ * \brief Power Method for the dominant eigenpair of the generalized problem $Ax = \lambda Bx$.
+ *
+ * \details Iterates $x_{k+1} = B^{-1} A x_k$, where $B^{-1}$ is applied through the cached factorization of B
+ * (two triangular solves per step) rather than through an explicitly formed $B^{-1}A$.
+ * \sa PowerMethod
+ * \sa GeneralizedEigenvalue
+ */
+template<typename Scalar>
+class GeneralizedPowerMethod : public GeneralizedEigenvalue<Scalar> {
+public:
+    /**
+     * \brief Type alias for the matrix type used by the solver.
+     */
+    using Matrix = typename Eigenvalue<Scalar>::Matrix;
+
+    /**
+     * \brief Type alias for the vector type used by the solver.
+     */
+    using Vector = typename Eigenvalue<Scalar>::Vector;
+
+    /**
+     * \brief Parameterized constructor.
+     * \param matrixA The matrix A.
+     * \param matrixB The matrix B.
+     * \param params A structure containing the configuration settings.
+     */
+    GeneralizedPowerMethod(const Matrix& matrixA, const Matrix& matrixB, const Parameters& params);
+
+    /**
+     * \brief Destructor for GeneralizedPowerMethod.
+     */
+    virtual ~GeneralizedPowerMethod();
+
+    /**
+     * \brief Executes the iteration $x_{k+1} = B^{-1} A x_k / \|B^{-1} A x_k\|$.
+     * \post \c mEigenvalue and \c mEigenvector hold the dominant generalized eigenpair if convergence is achieved.
+     */
+    virtual void solve() override;
+};
+
+#endif // GENERALIZEDPOWERMETHOD_H
@@ -0,0 +1,84 @@
+#ifndef GENERALIZEDQRMETHOD_H
+#define GENERALIZEDQRMETHOD_H
+
+#include "GeneralizedEigenvalue.h"
+
+/**
+ * \tparam Scalar The underlying numeric type of the matrix elements (e.g., \c double, \c std::complex<double>).
+ * \class GeneralizedQRMethod
+ * \brief Computes all eigenvalues and eigenvectors of the generalized problem $Ax = \lambda Bx$.
+ *
+ * \details Two paths are used, depending on the structure of the pair:
+ * - Symmetric-definite pairs (A Hermitian, B Hermitian positive-definite): with the cached Cholesky factorization
+ *   $B = LL^H$, the problem is reduced to the Hermitian standard problem $C y = \lambda y$ with
+ *   $C = L^{-1} A L^{-H}$ (two triangular solves, the symmetry is kept), which is solved by \c QRMethod.
+ *   The eigenvectors are recovered as $x = L^{-H} y$ and are B-orthonormal.
+ * - General real pairs: the QZ algorithm (generalized Schur decomposition) works on A and B directly.
+ *   A real result cannot hold complex generalized eigenvalues: their real parts are kept, with a warning, and
+ *   \c hasConverged() is false; solve such pairs with the complex type.
+ * - General complex pairs: no complex QZ is available, so the standard problem $B^{-1}A$ is formed through the
+ *   cached LU factorization of B (a solve, never an explicit inverse) and solved by a complex Schur decomposition.
+ * \sa QRMethod
+ * \sa GeneralizedEigenvalue
+ */
+template<typename Scalar>
+class GeneralizedQRMethod : public GeneralizedEigenvalue<Scalar> {
+public:
+    /**
+     * \brief Type alias for the matrix type used by the solver.
+     */
+    using Matrix = typename Eigenvalue<Scalar>::Matrix;
+
+    /**
+     * \brief Type alias for the vector type used by the solver.
+     */
+    using Vector = typename Eigenvalue<Scalar>::Vector;
+
+    /**
+     * \brief Parameterized constructor.
+     * \param matrixA The matrix A.
+     * \param matrixB The matrix B.
+     * \param params A structure containing the configuration settings.
+     */
+    GeneralizedQRMethod(const Matrix& matrixA, const Matrix& matrixB, const Parameters& params);
+
+    /**
+     * \brief Destructor for GeneralizedQRMethod.
+     */
+    virtual ~GeneralizedQRMethod();
+
+    /**
+     * \brief Computes all generalized eigenpairs.
+     * \post \c mAllEigenvalues and \c mAllEigenvectors hold the complete set of solutions; \c mEigenvalue and
+     * \c mEigenvector hold the pair of largest magnitude.
+     */
+    virtual void solve() override;
+
+    /**
+     * \brief Retrieves all computed generalized eigenvalues.
+     */
+    Vector getAllEigenvalues() const { return mAllEigenvalues; }
+
+    /**
+     * \brief Retrieves all computed generalized eigenvectors (as columns).
+     */
+    Matrix getAllEigenvectors() const { return mAllEigenvectors; }
+
+private:
+    /**
+     * \brief Solves a pair that is not symmetric-definite (QZ for real pairs, LU reduction for complex ones).
+     */
+    void solveGeneralPair();
+
+    /**
+     * \brief Vector storing all computed eigenvalues.
+     */
+    Vector mAllEigenvalues;
+
+    /**
+     * \brief Matrix storing all computed eigenvectors as its columns.
+     */
+    Matrix mAllEigenvectors;
+};
+
+#endif // GENERALIZEDQRMETHOD_H
@@ -0,0 +1,74 @@
+#ifndef GENERALIZEDSHIFTEDINVERSEPOWERMETHOD_H
+#define GENERALIZEDSHIFTEDINVERSEPOWERMETHOD_H
+
+#include "GeneralizedEigenvalue.h"
+#include <Eigen/LU>
+
+/**
+ * \tparam Scalar The underlying numeric type of the matrix elements (e.g., \c double, \c std::complex<double>).
+ * \class GeneralizedShiftedInversePowerMethod
+ * \brief Shifted Inverse Power Method for the generalized eigenvalue of $Ax = \lambda Bx$ closest to a shift $\mu$.
+ *
+ * \details Iterates $x_{k+1} = (A - \mu B)^{-1} B x_k$, whose dominant eigenvalue is $1/(\lambda - \mu)$. The LU
+ * factorization of $A - \mu B$ is computed once and cached across \c solve() calls as long as A, B and the shift
+ * do not change.
+ * \sa ShiftedInversePowerMethod
+ * \sa GeneralizedEigenvalue
+ */
+template<typename Scalar>
+class GeneralizedShiftedInversePowerMethod : public GeneralizedEigenvalue<Scalar> {
+public:
+    /**
+     * \brief Type alias for the matrix type used by the solver.
+     */
+    using Matrix = typename Eigenvalue<Scalar>::Matrix;
+
+    /**
+     * \brief Type alias for the vector type used by the solver.
+     */
+    using Vector = typename Eigenvalue<Scalar>::Vector;
+
+    /**
+     * \brief Parameterized constructor; the shift $\mu$ is taken from \c params.
+     * \param matrixA The matrix A.
+     * \param matrixB The matrix B.
+     * \param params A structure containing the configuration settings, including the shift $\mu$.
+     */
+    GeneralizedShiftedInversePowerMethod(const Matrix& matrixA, const Matrix& matrixB, const Parameters& params);
+
+    /**
+     * \brief Destructor for GeneralizedShiftedInversePowerMethod.
+     */
+    virtual ~GeneralizedShiftedInversePowerMethod();
+
+    /**
+     * \brief Executes the generalized Shifted Inverse Power Method.
+     * \pre The shift $\mu$ must not be an exact generalized eigenvalue.
+     * \post \c mEigenvalue and \c mEigenvector hold the eigenpair closest to $\mu$ if convergence is achieved.
+     */
+    virtual void solve() override;
+
+protected:
+    /**
+     * \brief Drops the cached factorization of $A - \mu B$.
+     */
+    void invalidateFactorizations() override;
+
+private:
+    /**
+     * \brief Cached LU factorization of $A - \mu B$.
+     */
+    Eigen::PartialPivLU<Matrix> mLuShifted;
+
+    /**
+     * \brief Whether \c mLuShifted is valid.
+     */
+    bool mHasShiftedLu;
+
+    /**
+     * \brief The shift used for \c mLuShifted.
+     */
+    Scalar mFactorizedShift;
+};
+
+#endif // GENERALIZEDSHIFTEDINVERSEPOWERMETHOD_H
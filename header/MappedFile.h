@@ -0,0 +1,114 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * \class MappedFile
+ * \brief A file mapped in memory (\c mmap), unmapped on destruction.
+ *
+ * \details Read-only mappings are shared: the pages come from the page cache, so several processes mapping the
+ * same file share one copy, and nothing is read before it is touched. Writable mappings are created at their
+ * final size and written in place. The object is movable, not copyable.
+ */
+class MappedFile {
+public:
+    /**
+     * \brief Access pattern hints forwarded to \c madvise.
+     */
+    enum class Access {
+        /** \brief No hint. */
+        Normal,
+        /** \brief Read once from start to end (aggressive read-ahead). */
+        Sequential,
+        /** \brief Start reading the whole file now. */
+        WillNeed
+    };
+
+    /**
+     * \brief An empty mapping.
+     */
+    MappedFile();
+
+    /**
+     * \brief Maps an existing file read-only.
+     * \param filename The file; an empty file gives an empty mapping.
+     * \throw std::runtime_error If the file cannot be opened or mapped.
+     */
+    explicit MappedFile(const std::string& filename);
+
+    /**
+     * \brief Creates (or truncates) a file of \c size bytes and maps it read-write.
+     * \throw std::runtime_error If the file cannot be created, resized or mapped.
+     */
+    MappedFile(const std::string& filename, std::size_t size);
+
+    /**
+     * \brief Unmaps the file.
+     */
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * \brief First byte of the mapping (page aligned), or nullptr if empty.
+     */
+    const char* data() const { return mData; }
+
+    /**
+     * \brief First byte of a writable mapping.
+     */
+    char* mutableData() { return mWritable ? mData : nullptr; }
+
+    /**
+     * \brief Size of the mapping in bytes.
+     */
+    std::size_t size() const { return mSize; }
+
+    /**
+     * \brief Path of the mapped file.
+     */
+    const std::string& filename() const { return mFilename; }
+
+    /**
+     * \brief Gives the kernel a hint on how the mapping will be read.
+     */
+    void advise(Access access) const;
+
+    /**
+     * \brief Writes the dirty pages of a writable mapping back to the file and waits for completion.
+     */
+    void flush();
+
+private:
+    /**
+     * \brief Unmaps and resets to empty.
+     */
+    void release();
+
+    /**
+     * \brief Path of the mapped file.
+     */
+    std::string mFilename;
+
+    /**
+     * \brief The mapping.
+     */
+    char* mData;
+
+    /**
+     * \brief Size of the mapping in bytes.
+     */
+    std::size_t mSize;
+
+    /**
+     * \brief Whether the mapping is writable.
+     */
+    bool mWritable;
+};
+
+#endif // MAPPEDFILE_H
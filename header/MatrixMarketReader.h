@@ -0,0 +1,177 @@
+#ifndef MATRIXMARKETREADER_H
+#define MATRIXMARKETREADER_H
+
+#include "MappedFile.h"
+#include "Reader.h"
+#include <Eigen/Sparse>
+#include <cstddef>
+
+/**
+ * \tparam Scalar The numeric type of the matrix elements (e.g., \c double, \c std::complex<double>).
+ * \class MatrixMarketReader
+ * \brief Reads matrices in the Matrix Market exchange format (\c .mtx), the format of the sparse matrix collections.
+ *
+ * \details The constructor maps the file and reads its banner (\c %%MatrixMarket \c matrix followed by the format,
+ * the field and the symmetry) and its size line. \c ReadSparse() then streams the entries once, in file order,
+ * into triplet buffers allocated at their final size, and compresses them into a CSR matrix
+ * (\c Eigen::SparseMatrix in row-major order) with a counting sort on the rows: no dense matrix is ever built.
+ * The supported variants are:
+ * - formats \c coordinate (one \c "i j value" line per entry, 1-based) and \c array (column-major values);
+ * - fields \c real, \c double, \c integer, \c complex (real and imaginary parts) and \c pattern (values set to 1);
+ * - symmetries \c general, \c symmetric, \c skew-symmetric and \c hermitian, whose files only hold the lower
+ *   triangle: the upper one is restored by mirroring (negated, or conjugated, respectively).
+ *
+ * Duplicate coordinate entries are summed. The file holds no solver parameters; comment lines of the form
+ * \c "% Name,Value" (or \c "% Name: Value") with a known parameter name set them, the others are ignored.
+ * \sa Reader
+ */
+template<typename Scalar>
+class MatrixMarketReader : public Reader<Scalar> {
+public:
+    /**
+     * \brief Type alias for the dense matrix type.
+     */
+    using Matrix = typename Reader<Scalar>::Matrix;
+
+    /**
+     * \brief Compressed sparse row matrix.
+     */
+    using SparseMatrix = Eigen::SparseMatrix<Scalar, Eigen::RowMajor>;
+
+    /**
+     * \brief Layout of the entries.
+     */
+    enum class Format {
+        /** \brief One line per nonzero entry with its row and column. */
+        Coordinate,
+        /** \brief Every value, column by column. */
+        Array
+    };
+
+    /**
+     * \brief Type of the values.
+     */
+    enum class Field {
+        /** \brief Real values (\c real, \c double). */
+        Real,
+        /** \brief Integer values, read as real numbers. */
+        Integer,
+        /** \brief Complex values, as a real and an imaginary part. */
+        Complex,
+        /** \brief No value: only the positions of the nonzeros. */
+        Pattern
+    };
+
+    /**
+     * \brief Structure of the matrix; all but \c General store only the lower triangle.
+     */
+    enum class Symmetry {
+        /** \brief Every entry is stored. */
+        General,
+        /** \brief a(j,i) = a(i,j). */
+        Symmetric,
+        /** \brief a(j,i) = -a(i,j), with a zero diagonal. */
+        SkewSymmetric,
+        /** \brief a(j,i) = conj(a(i,j)). */
+        Hermitian
+    };
+
+    /**
+     * \brief Maps the file and reads its banner and its size line.
+     * \param filename The \c .mtx file.
+     * \throw std::runtime_error If the file cannot be mapped or its banner or size line is invalid.
+     */
+    MatrixMarketReader(const std::string& filename);
+
+    /**
+     * \brief Destructor; unmaps the file.
+     */
+    ~MatrixMarketReader() override;
+
+    /**
+     * \brief Streams the entries into triplet buffers and compresses them into a CSR matrix.
+     * \details Exact zeros of the \c array format are not stored.
+     * \throw std::runtime_error On an invalid or out-of-range entry, a truncated file, or complex values read as real.
+     */
+    SparseMatrix ReadSparse();
+
+    /**
+     * \brief The matrix as a dense matrix, expanded from \c ReadSparse().
+     */
+    Matrix ReadMatrix() override;
+
+    /**
+     * \brief Number of rows, from the size line.
+     */
+    long CountMatrixRows() override;
+
+    /**
+     * \brief The rows \c firstRow .. \c firstRow + \c rowCount - 1, expanded from the CSR matrix.
+     */
+    Matrix ReadMatrixRows(long firstRow, long rowCount) override;
+
+    /**
+     * \brief Reads the parameters given in the comment lines (default parameters if there are none).
+     */
+    Parameters ReadParameters() override;
+
+    /**
+     * \brief Number of columns, from the size line.
+     */
+    long cols() const { return mCols; }
+
+    /**
+     * \brief Number of entries stored in the file (before mirroring).
+     */
+    long storedEntries() const { return mEntries; }
+
+    /**
+     * \brief Layout of the entries.
+     */
+    Format format() const { return mFormat; }
+
+    /**
+     * \brief Type of the values.
+     */
+    Field field() const { return mField; }
+
+    /**
+     * \brief Structure of the matrix.
+     */
+    Symmetry symmetry() const { return mSymmetry; }
+
+private:
+    /**
+     * \brief The mapped file.
+     */
+    MappedFile mFile;
+
+    /**
+     * \brief Banner of the file.
+     */
+    Format mFormat;
+    Field mField;
+    Symmetry mSymmetry;
+
+    /**
+     * \brief Size line: rows, columns and stored entries.
+     */
+    long mRows, mCols, mEntries;
+
+    /**
+     * \brief Offsets of the first comment line after the banner and of the first entry line.
+     */
+    std::size_t mCommentsOffset, mDataOffset;
+};
+
+/**
+ * \brief Type alias for a MatrixMarketReader specialized for real-valued matrices.
+ */
+using MatrixMarketReaderReal = MatrixMarketReader<double>;
+
+/**
+ * \brief Type alias for a MatrixMarketReader specialized for complex-valued matrices.
+ */
+using MatrixMarketReaderComplex = MatrixMarketReader<std::complex<double>>;
+
+#endif // MATRIXMARKETREADER_H
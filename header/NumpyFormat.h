@@ -0,0 +1,137 @@
+#ifndef NUMPYFORMAT_H
+#define NUMPYFORMAT_H
+
+#include <Eigen/Dense>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * \brief Header of a NumPy array file (\c .npy), as read by \c parseNpyHeader().
+ *
+ * \details Layout of the file: the magic string \c "\x93NUMPY", a major and a minor version byte, the length of
+ * the header (2 bytes in version 1, 4 bytes in versions 2 and 3, little-endian), then the header itself, a Python
+ * dictionary literal such as <tt>{'descr': '<f8', 'fortran_order': False, 'shape': (3, 4), }</tt> padded with
+ * blanks and a newline. The raw array follows, in C (row-major) or Fortran (column-major) order.
+ * \sa NumpyReader \sa NumpyWriter
+ */
+struct NpyHeader {
+    /**
+     * \brief The dtype string, such as \c "<f8" (float64) or \c "<c16" (complex128).
+     */
+    std::string descr;
+
+    /**
+     * \brief Whether the data is in Fortran (column-major) order.
+     */
+    bool fortranOrder = false;
+
+    /**
+     * \brief Size of each dimension (empty for a scalar).
+     */
+    std::vector<std::uint64_t> shape;
+
+    /**
+     * \brief Offset of the first element from the start of the \c .npy data.
+     */
+    std::size_t dataOffset = 0;
+
+    /**
+     * \brief Number of elements (the product of the shape).
+     */
+    std::uint64_t elements() const;
+};
+
+/**
+ * \brief Location of one array in a NumPy archive (\c .npz, a zip file of \c .npy files).
+ */
+struct NpzEntry {
+    /**
+     * \brief Name of the array (the file name in the archive, without its \c .npy extension).
+     */
+    std::string name;
+
+    /**
+     * \brief Zip compression method: 0 for stored, 8 for deflated (\c np.savez_compressed).
+     */
+    std::uint16_t method = 0;
+
+    /**
+     * \brief Offset of the \c .npy data from the start of the archive.
+     */
+    std::size_t offset = 0;
+
+    /**
+     * \brief Size of the \c .npy data in the archive.
+     */
+    std::size_t size = 0;
+};
+
+/**
+ * \brief dtype of little-endian float64 values.
+ */
+constexpr const char* kNpyReal = "<f8";
+
+/**
+ * \brief dtype of little-endian complex128 values.
+ */
+constexpr const char* kNpyComplex = "<c16";
+
+/**
+ * \brief Alignment of the data after a header written by \c makeNpyHeader() (NumPy's own choice).
+ */
+constexpr std::size_t kNpyAlignment = 64;
+
+/**
+ * \brief Reads the header of a \c .npy file.
+ * \param data The first byte of the \c .npy data.
+ * \param size Its size in bytes.
+ * \throw std::runtime_error If the magic string, the version or the dictionary is invalid, or the data is truncated.
+ */
+NpyHeader parseNpyHeader(const char* data, std::size_t size);
+
+/**
+ * \brief Builds a version 1 \c .npy header whose length is a multiple of \c kNpyAlignment.
+ * \param descr The dtype string.
+ * \param fortranOrder Whether the data is stored column-major.
+ * \param shape Size of each dimension (empty for a scalar).
+ */
+std::string makeNpyHeader(const std::string& descr, bool fortranOrder, const std::vector<std::uint64_t>& shape);
+
+/**
+ * \brief Lists the arrays of a \c .npz archive from its central directory (Zip64 archives included).
+ * \param data The first byte of the archive.
+ * \param size Its size in bytes.
+ * \throw std::runtime_error If the archive is not a valid zip file.
+ */
+std::vector<NpzEntry> listNpzEntries(const char* data, std::size_t size);
+
+/**
+ * \brief CRC-32 of a buffer (the checksum of the zip format), continuing from \c crc.
+ */
+std::uint32_t crc32(const char* data, std::size_t size, std::uint32_t crc = 0);
+
+/**
+ * \class NpyMatrixWriter
+ * \brief Writes a matrix as a \c .npy file, in Fortran order so that \c NumpyReader maps it back without a copy.
+ */
+class NpyMatrixWriter {
+public:
+    /**
+     * \brief Writes a real matrix (dtype \c <f8).
+     * \param filename The output file, replaced if it exists.
+     * \param matrix The matrix.
+     * \throw std::runtime_error If the file cannot be written.
+     */
+    static void write(const std::string& filename, const Eigen::MatrixXd& matrix);
+
+    /**
+     * \brief Writes a complex matrix (dtype \c <c16).
+     * \copydetails write(const std::string&, const Eigen::MatrixXd&)
+     */
+    static void write(const std::string& filename, const Eigen::MatrixXcd& matrix);
+};
+
+#endif // NUMPYFORMAT_H
@@ -0,0 +1,154 @@
+#ifndef NUMPYREADER_H
+#define NUMPYREADER_H
+
+#include "MappedFile.h"
+#include "NumpyFormat.h"
+#include "Reader.h"
+
+/**
+ * \tparam Scalar The numeric type of the matrix elements (e.g., \c double, \c std::complex<double>).
+ * \class NumpyReader
+ * \brief Reads matrices saved by NumPy, as a single array (\c .npy, \c np.save) or as an uncompressed archive of
+ * arrays (\c .npz, \c np.savez), by mapping the file in memory.
+ *
+ * \details The constructor maps the file and parses the \c .npy header of the selected array: nothing else is read.
+ * Arrays of dtype float64 (\c <f8) or complex128 (\c <c16) with one dimension (read as a column) or two are accepted.
+ * As with \c BinaryReader, \c MapMatrix() gives an array stored in Fortran order (\c np.asfortranarray) in place,
+ * as an \c Eigen::Map over the mapped pages, while \c ReadMatrix() copies and transposes the C-ordered arrays that
+ * NumPy writes by default. In an archive, the array named \c A is read (or the first one, such as \c arr_0), and
+ * an array named \c B is the second matrix of a generalized problem. Compressed archives (\c np.savez_compressed)
+ * cannot be mapped and are rejected. An archive may also hold the solver parameters as a string named
+ * \c parameters, with one \c Name,Value line per parameter (the syntax of the CSV files):
+ * <tt>np.savez("input.npz", A=a, parameters=np.bytes_("Algorithm,QRMethod\nTolerance,1e-10"))</tt>.
+ * \sa NumpyWriter \sa NpyMatrixWriter
+ */
+template<typename Scalar>
+class NumpyReader : public Reader<Scalar> {
+public:
+    /**
+     * \brief Type alias for the matrix type.
+     */
+    using Matrix = typename Reader<Scalar>::Matrix;
+
+    /**
+     * \brief Read-only view of the mapped matrix.
+     */
+    using MatrixMap = Eigen::Map<const Matrix>;
+
+    /**
+     * \brief Maps the file and parses the header of the array.
+     * \param filename The \c .npy or \c .npz file.
+     * \param arrayName In an archive, the array to read; empty for \c A, or the first array.
+     * \throw std::runtime_error If the file cannot be mapped, is not a NumPy file, holds no such array, is compressed,
+     * or the array has another dtype or more than two dimensions.
+     */
+    NumpyReader(const std::string& filename, const std::string& arrayName = "");
+
+    /**
+     * \brief Destructor; unmaps the file, after which the views of \c MapMatrix() are invalid.
+     */
+    ~NumpyReader() override;
+
+    /**
+     * \brief The matrix, in place in the mapped file (no parsing, no copy).
+     * \details The view is valid as long as the reader exists.
+     * \throw std::runtime_error If the array has another dtype or is in C order (use \c ReadMatrix()).
+     */
+    MatrixMap MapMatrix() const;
+
+    /**
+     * \brief Copies the matrix out of the mapped file, converting real data to complex and C order to Eigen's
+     * column-major order as needed.
+     * \throw std::runtime_error If complex data is read as real.
+     */
+    Matrix ReadMatrix() override;
+
+    /**
+     * \brief The array \c B of an archive, copied like \c ReadMatrix() (an empty matrix if there is none).
+     */
+    Matrix ReadMatrixB() override;
+
+    /**
+     * \brief Number of rows, from the header.
+     */
+    long CountMatrixRows() override;
+
+    /**
+     * \brief Copies only the rows \c firstRow .. \c firstRow + \c rowCount - 1; the other pages are never touched
+     * for C-ordered data.
+     */
+    Matrix ReadMatrixRows(long firstRow, long rowCount) override;
+
+    /**
+     * \brief Reads the \c parameters string of an archive (default parameters if there is none).
+     */
+    Parameters ReadParameters() override;
+
+    /**
+     * \brief The header of the array.
+     */
+    const NpyHeader& header() const { return mHeader; }
+
+    /**
+     * \brief Whether the array can be mapped by \c MapMatrix(): same scalar type, column-major layout.
+     */
+    bool isMappable() const;
+
+private:
+    /**
+     * \brief Copies the block of rows [firstRow, firstRow + rowCount) of an array into an owned matrix.
+     */
+    static Matrix copyRows(const NpyHeader& header, const char* array, long firstRow, long rowCount);
+
+    /**
+     * \brief Parses and checks the header of the array at \c array.
+     */
+    static NpyHeader readHeader(const char* array, std::size_t size);
+
+    /**
+     * \brief Reads a string array of one element (dtype \c |S or \c <U).
+     */
+    static std::string readText(const char* array, std::size_t size);
+
+    /**
+     * \brief The mapped file.
+     */
+    MappedFile mFile;
+
+    /**
+     * \brief First byte of the \c .npy data of the array (the file itself, or an entry of the archive).
+     */
+    const char* mArray;
+
+    /**
+     * \brief Header of the array.
+     */
+    NpyHeader mHeader;
+
+    /**
+     * \brief First byte of the array \c B of an archive, or nullptr.
+     */
+    const char* mArrayB;
+
+    /**
+     * \brief Size of the \c .npy data of \c B.
+     */
+    std::size_t mArrayBSize;
+
+    /**
+     * \brief The \c parameters string of an archive, or empty.
+     */
+    std::string mParameters;
+};
+
+/**
+ * \brief Type alias for a NumpyReader specialized for real-valued matrices.
+ */
+using NumpyReaderReal = NumpyReader<double>;
+
+/**
+ * \brief Type alias for a NumpyReader specialized for complex-valued matrices.
+ */
+using NumpyReaderComplex = NumpyReader<std::complex<double>>;
+
+#endif // NUMPYREADER_H
@@ -0,0 +1,83 @@
+#ifndef NUMPYWRITER_H
+#define NUMPYWRITER_H
+
+#include <cstddef>
+#include <string>
+
+#include "Writer.h"
+
+/**
+ * \class NumpyWriter
+ * \brief Implements the Writer interface for outputting results to a NumPy archive (\c .npz), read back with
+ * \c np.load without any text formatting or parsing.
+ *
+ * \details The archive holds these arrays, stored uncompressed as by \c np.savez:
+ * - \c eigenvalues, a vector of dtype float64 or complex128 (one element for the single result methods);
+ * - \c eigenvectors, the matching eigenvectors in columns, in Fortran order (Eigen's layout, written as is);
+ * - \c iterations, a 64-bit integer, and \c converged, a boolean;
+ * - with \c setStats(), \c stats, the values of \c SolverStats::fields() as float64, and \c stats_names, their
+ *   names as a unicode array (\c dict(zip(f["stats_names"], f["stats"])) in Python).
+ *
+ * The file is sized up front and filled through a writable mapping, and every array starts on a 64-byte boundary
+ * of the file (the local headers are padded as by \c zipalign), so that \c NumpyReader can map the eigenvectors
+ * back in place. Archives over 4 GiB use the Zip64 extensions.
+ * \ingroup IO
+ * \sa Writer \sa NumpyReader
+ */
+class NumpyWriter : public Writer {
+public:
+    /**
+     * \brief Constructs a NumpyWriter object.
+     * \param filename The path to the output \c .npz file.
+     */
+    NumpyWriter(const std::string& filename);
+
+    /**
+     * \brief Writes a single real-valued eigenvalue/eigenvector pair to the archive.
+     * \copydoc Writer::write(double, const Eigen::VectorXd&, int, bool)
+     */
+    void write(double eigenvalue,
+              const Eigen::VectorXd& eigenvector,
+              int iterations,
+              bool converged) const override;
+
+    /**
+     * \brief Writes a single complex-valued eigenvalue/eigenvector pair to the archive.
+     * \copydoc Writer::write(std::complex<double>, const Eigen::VectorXcd&, int, bool)
+     */
+    void write(std::complex<double> eigenvalue,
+              const Eigen::VectorXcd& eigenvector,
+              int iterations,
+              bool converged) const override;
+
+    /**
+     * \brief Writes the entire set of real-valued eigenvalues and eigenvectors to the archive.
+     * \copydoc Writer::writeAll(const Eigen::VectorXd&, const Eigen::MatrixXd&, int, bool)
+     */
+    void writeAll(const Eigen::VectorXd& eigenvalues,
+                 const Eigen::MatrixXd& eigenvectors,
+                 int iterations,
+                 bool converged) const override;
+
+    /**
+     * \brief Writes the entire set of complex-valued eigenvalues and eigenvectors to the archive.
+     * \copydoc Writer::writeAll(const Eigen::VectorXcd&, const Eigen::MatrixXcd&, int, bool)
+     */
+    void writeAll(const Eigen::VectorXcd& eigenvalues,
+                 const Eigen::MatrixXcd& eigenvectors,
+                 int iterations,
+                 bool converged) const override;
+
+private:
+    /**
+     * \brief Writes the archive.
+     * \param descr dtype of the eigenvalues and eigenvectors.
+     * \param values The eigenvalues, \c count scalars of \c scalarBytes bytes.
+     * \param vectors The eigenvectors, \c rows x \c count scalars in column-major order.
+     * \throw std::runtime_error If the file cannot be written.
+     */
+    void writeArchive(const char* descr, std::size_t scalarBytes, const void* values, long count,
+                      const void* vectors, long rows, int iterations, bool converged) const;
+};
+
+#endif // NUMPYWRITER_H
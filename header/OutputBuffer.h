@@ -0,0 +1,64 @@
+#ifndef OUTPUTBUFFER_H
+#define OUTPUTBUFFER_H
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+/**
+ * \class OutputBuffer
+ * \brief Text built in memory with \c std::to_chars, written to a stream in one block.
+ *
+ * \details The writers format their results into an OutputBuffer instead of the file stream: numbers are
+ * converted by \c std::to_chars (no locale, no stream state) and appended to a growing string, and the text
+ * reaches the file through a single \c write() per buffer rather than a flush per line.
+ *
+ * With the default precision of 6 significant digits a \c double is written exactly as by \c std::ostream
+ * (\c %g), so files keep the same bytes; a precision of 0 writes the shortest text that reads back to the same
+ * \c double.
+ */
+class OutputBuffer {
+public:
+    /**
+     * \brief Default precision of \c std::ostream, giving the same text as \c operator<<.
+     */
+    static constexpr int kStreamPrecision = 6;
+
+    /**
+     * \brief Creates an empty buffer.
+     * \param precision Significant digits of the doubles (at most 17), or 0 for the shortest round-trip text.
+     */
+    explicit OutputBuffer(int precision = kStreamPrecision);
+
+    OutputBuffer& operator<<(std::string_view text);
+    OutputBuffer& operator<<(const char* text) { return *this << std::string_view(text); }
+    OutputBuffer& operator<<(char c);
+    OutputBuffer& operator<<(int value) { return *this << static_cast<long>(value); }
+    OutputBuffer& operator<<(long value);
+    OutputBuffer& operator<<(double value);
+
+    /**
+     * \brief Reserves room for \c bytes characters.
+     */
+    void reserve(std::size_t bytes) { mText.reserve(bytes); }
+
+    /**
+     * \brief Empties the buffer, keeping its memory.
+     */
+    void clear() { mText.clear(); }
+
+    std::size_t size() const { return mText.size(); }
+    const char* data() const { return mText.data(); }
+
+    /**
+     * \brief Writes the text to \c out and empties the buffer.
+     */
+    void writeTo(std::ostream& out);
+
+private:
+    std::string mText;
+    int mPrecision;
+};
+
+#endif // OUTPUTBUFFER_H
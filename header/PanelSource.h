@@ -0,0 +1,163 @@
+#ifndef PANELSOURCE_H
+#define PANELSOURCE_H
+
+#include "BinaryReader.h"
+#include "TextMatrixParser.h"
+#include <Eigen/Dense>
+#include <complex>
+#include <string>
+
+/**
+ * \tparam Scalar The underlying numeric type of the matrix elements (e.g., \c double, \c std::complex<double>).
+ * \class PanelSource
+ * \brief Sequential access to a matrix one row panel (a block of consecutive rows) at a time.
+ *
+ * \details Out-of-core solvers read the matrix through this interface at every iteration instead of keeping it in
+ * memory: only the panel being multiplied and the one being prefetched are resident.
+ * \sa StreamingMatrix
+ * \sa TextPanelSource
+ * \sa BinaryPanelSource
+ */
+template<typename Scalar>
+class PanelSource {
+public:
+    /**
+     * \brief Type alias for the matrix type.
+     */
+    using Matrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+
+    /**
+     * \brief Virtual destructor.
+     */
+    virtual ~PanelSource();
+
+    /**
+     * \brief Number of rows of the matrix.
+     */
+    virtual long rows() const = 0;
+
+    /**
+     * \brief Number of columns of the matrix.
+     */
+    virtual long cols() const = 0;
+
+    /**
+     * \brief Number of rows of a full panel (the last one may be shorter).
+     */
+    virtual long panelRows() const = 0;
+
+    /**
+     * \brief Goes back to the first row.
+     */
+    virtual void rewind() = 0;
+
+    /**
+     * \brief Reads the next panel.
+     * \param panel Receives the rows (resized; at most the panel height of the source).
+     * \return The index of the first row of the panel, or -1 once all the rows were read.
+     */
+    virtual long nextPanel(Matrix& panel) = 0;
+};
+
+/**
+ * \tparam Scalar The underlying numeric type of the matrix elements.
+ * \class TextPanelSource
+ * \brief Row panels parsed on the fly from the matrix part of a CSV or text input file.
+ *
+ * \details The file is mapped and indexed once by a \c TextMatrixParser, the tokenizer of \c CSVReader and
+ * \c TextFileReader, so the panels accept the same values: real numbers, complex literals such as \c (a,b) or
+ * \c a+bi, and real/imaginary column pairs with \c ComplexPairs. Parsing text at every pass is slow, but needs no
+ * conversion step and no memory beyond one panel and the row offsets.
+ */
+template<typename Scalar>
+class TextPanelSource : public PanelSource<Scalar> {
+public:
+    /**
+     * \brief Type alias for the matrix type.
+     */
+    using Matrix = typename PanelSource<Scalar>::Matrix;
+
+    /**
+     * \brief Maps the file and indexes its rows (a first pass that only parses the first row).
+     * \param filename The input file.
+     * \param panelRows Rows per panel; 0 picks about 32 MB per panel.
+     * \throw std::runtime_error If the file cannot be opened or holds no matrix.
+     */
+    TextPanelSource(const std::string& filename, long panelRows = 0);
+
+    long rows() const override { return mRows; }
+    long cols() const override { return mCols; }
+    long panelRows() const override { return mPanelRows; }
+    void rewind() override;
+    long nextPanel(Matrix& panel) override;
+
+private:
+    /**
+     * \brief The mapped file and the offsets of its rows.
+     */
+    TextMatrixParser mParser;
+
+    /**
+     * \brief Size of the matrix.
+     */
+    long mRows, mCols;
+
+    /**
+     * \brief Rows per panel.
+     */
+    long mPanelRows;
+
+    /**
+     * \brief Index of the next row to read.
+     */
+    long mNextRow;
+};
+
+/**
+ * \tparam Scalar The underlying numeric type of the matrix elements.
+ * \class BinaryPanelSource
+ * \brief Row panels copied out of a memory-mapped binary matrix file (\c .bmat).
+ *
+ * \details No parsing: a panel is a copy of mapped pages, and the page faults happen on the prefetch thread of
+ * \c StreamingMatrix. Row-major files give contiguous panels; column-major files give strided ones.
+ */
+template<typename Scalar>
+class BinaryPanelSource : public PanelSource<Scalar> {
+public:
+    /**
+     * \brief Type alias for the matrix type.
+     */
+    using Matrix = typename PanelSource<Scalar>::Matrix;
+
+    /**
+     * \brief Maps the file.
+     * \param filename The input file.
+     * \param panelRows Rows per panel; 0 picks about 32 MB per panel.
+     * \throw std::runtime_error If the file is not a valid binary matrix file.
+     */
+    BinaryPanelSource(const std::string& filename, long panelRows = 0);
+
+    long rows() const override { return mReader.header().rows; }
+    long cols() const override { return mReader.header().cols; }
+    long panelRows() const override { return mPanelRows; }
+    void rewind() override { mNextRow = 0; }
+    long nextPanel(Matrix& panel) override;
+
+private:
+    /**
+     * \brief The mapped file.
+     */
+    BinaryReader<Scalar> mReader;
+
+    /**
+     * \brief Rows per panel.
+     */
+    long mPanelRows;
+
+    /**
+     * \brief Index of the next row to read.
+     */
+    long mNextRow;
+};
+
+#endif // PANELSOURCE_H
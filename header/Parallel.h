@@ -0,0 +1,59 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/**
+ * \brief Returns the number of worker threads to use when the caller did not ask for a specific count.
+ * \return \c std::thread::hardware_concurrency(), or 1 if it is unknown.
+ */
+inline int defaultThreadCount() {
+    unsigned int hw = std::thread::hardware_concurrency();
+    return hw == 0 ? 1 : static_cast<int>(hw);
+}
+
+/**
+ * \brief Runs \c func(i) for every index \c i in [begin, end) on up to \c threads threads.
+ *
+ * \details Indices are handed out one at a time through an atomic counter, so tasks of uneven cost
+ * (e.g. clusters of eigenvalues of different sizes) are balanced between the threads. With one thread,
+ * or a single index, the loop runs on the calling thread.
+ * \param begin First index.
+ * \param end One past the last index.
+ * \param threads Maximum number of threads; values below 1 mean \c defaultThreadCount().
+ * \param func Callable taking the index; it must be safe to call concurrently for distinct indices.
+ */
+template<typename Func>
+void parallelFor(long begin, long end, int threads, Func func) {
+    if (end <= begin) return;
+    if (threads < 1) threads = defaultThreadCount();
+    long count = end - begin;
+    int workers = static_cast<int>(std::min<long>(threads, count));
+
+    if (workers <= 1) {
+        for (long i = begin; i < end; ++i) func(i);
+        return;
+    }
+
+    std::atomic<long> next(begin);
+    auto worker = [&]() {
+        for (long i = next++; i < end; i = next++) {
+            func(i);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (int t = 1; t < workers; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+}
+
+#endif // PARALLEL_H
@@ -7,6 +7,7 @@
 
 #include <string>
 #include <iostream>
+#include <vector>
 
 /**
  * \class Parameters
@@ -54,6 +55,105 @@ public:
      */
     void setShift(double shift);
 
+    /**
+     * \brief Restricts selective solvers to the eigenvalues with indices \c il..iu (1-based, ascending order).
+     * \details Used by \c BisectionMethod. A value of 0 for both bounds means "no index restriction".
+     * \param indexLow The index of the smallest wanted eigenvalue.
+     * \param indexHigh The index of the largest wanted eigenvalue.
+     */
+    void setIndexRange(int indexLow, int indexHigh);
+
+    /**
+     * \brief Restricts selective solvers to the eigenvalues lying in the half-open interval [lower, upper).
+     * \details Used by \c BisectionMethod. Takes precedence over the index range when both are set.
+     * \param lower The lower bound of the interval.
+     * \param upper The upper bound of the interval.
+     */
+    void setValueRange(double lower, double upper);
+
+    /**
+     * \brief Sets the number of wanted values for solvers returning several of them (e.g. the k of a truncated SVD).
+     * \param numValues The number of values, at least 1.
+     */
+    void setNumValues(int numValues);
+
+    /**
+     * \brief Sets the number of threads used inside a solver (parallel products, bisection tasks).
+     * \param threads The number of threads; 0 means one per hardware thread.
+     */
+    void setThreads(int threads);
+
+    /**
+     * \brief Binds the solver threads to CPUs, so that the row blocks they first touched stay on their NUMA node.
+     */
+    void setPinThreads(bool pinThreads);
+
+    /**
+     * \brief Stores complex matrices in planar form (real and imaginary parts apart) inside the solvers that
+     * support it, so that the products run on the AVX2/AVX-512 kernels of \c PlanarKernels.h.
+     */
+    void setPlanarComplex(bool planarComplex);
+
+    /**
+     * \brief Runs the Power Method out of core: the matrix is streamed from the input file at every iteration
+     * instead of being loaded (see \c StreamingPowerMethod). With \c NumValues > 1 it runs block power iteration.
+     */
+    void setOutOfCore(bool outOfCore);
+
+    /**
+     * \brief Sets the number of rows read at once by the out-of-core solvers.
+     * \param panelRows The panel height; 0 picks about 32 MB per panel.
+     */
+    void setPanelRows(int panelRows);
+
+    /**
+     * \brief Reads complex matrices from text files as pairs of real columns: real part, imaginary part.
+     * \details Without it, each complex value is one literal: \c a, \c a+bi, \c a-bj or \c (a,b).
+     */
+    void setComplexPairs(bool complexPairs);
+
+    /**
+     * \brief Records the convergence of the iterative solvers (see \c ConvergenceHistory).
+     * \param capacity The number of last iterations kept; 0 (the default) disables the recording.
+     */
+    void setHistoryCapacity(int capacity);
+
+    /**
+     * \brief Chooses whether \c QRMethod computes eigenvectors.
+     * \details With \c false only the eigenvalues are computed, and the Schur vectors are not accumulated.
+     * \param computeEigenvectors \c true (the default) for the eigenvectors.
+     */
+    void setComputeEigenvectors(bool computeEigenvectors);
+
+    /**
+     * \brief Restricts \c QRMethod to the true eigenvectors of the eigenvalues with these indices.
+     * \details The indices are 1-based positions in the eigenvalues returned by the solver. An empty list (the
+     * default) keeps all the Schur vectors, which are the eigenvectors of normal matrices only.
+     * \param indices The indices of the wanted eigenvectors.
+     */
+    void setEigenvectorIndices(const std::vector<int>& indices);
+
+    /**
+     * \brief Sets the eigenvectors computed by \c QRMethod from text.
+     * \param selection \c "All" (the default), \c "None", or 1-based indices separated by blanks (e.g. \c "1 3").
+     * \throw std::invalid_argument If the text is none of these.
+     */
+    void setEigenvectors(const std::string& selection);
+
+    /**
+     * \brief Sets a parameter from its name and text value, as they appear in the input files.
+     * \param name The parameter name (e.g. \c "Tolerance").
+     * \param value Its value (e.g. \c "1e-10").
+     * \return \c false if the name is unknown; the value is then ignored.
+     * \throw std::invalid_argument If the value cannot be converted.
+     */
+    bool setValue(const std::string& name, const std::string& value);
+
+    /**
+     * \brief Writes every parameter as \c Name,Value lines, which \c setValue() reads back.
+     */
+    void writeValues(std::ostream& out) const;
+
     /**
      * \brief Gets the path to the input matrix file.
      * \return The file path string.
@@ -84,6 +184,86 @@ public:
      */
     double getShift() const { return mShift; }
 
+    /**
+     * \brief Gets the 1-based index of the smallest wanted eigenvalue (0 if unset).
+     */
+    int getIndexLow() const { return mIndexLow; }
+
+    /**
+     * \brief Gets the 1-based index of the largest wanted eigenvalue (0 if unset).
+     */
+    int getIndexHigh() const { return mIndexHigh; }
+
+    /**
+     * \brief Checks whether a value range was set with \c setValueRange().
+     */
+    bool hasValueRange() const { return mHasValueRange; }
+
+    /**
+     * \brief Gets the lower bound of the wanted value range.
+     */
+    double getLowerBound() const { return mLowerBound; }
+
+    /**
+     * \brief Gets the upper bound of the wanted value range.
+     */
+    double getUpperBound() const { return mUpperBound; }
+
+    /**
+     * \brief Gets the number of wanted values (default 1).
+     */
+    int getNumValues() const { return mNumValues; }
+
+    /**
+     * \brief Gets the number of solver threads (0 for one per hardware thread, the default).
+     */
+    int getThreads() const { return mThreads; }
+
+    /**
+     * \brief Checks whether the solver threads are bound to CPUs.
+     */
+    bool getPinThreads() const { return mPinThreads; }
+
+    /**
+     * \brief Checks whether complex matrices are stored in planar form (default \c false).
+     */
+    bool getPlanarComplex() const { return mPlanarComplex; }
+
+    /**
+     * \brief Checks whether the matrix is streamed from the file instead of loaded (default \c false).
+     */
+    bool getOutOfCore() const { return mOutOfCore; }
+
+    /**
+     * \brief Gets the number of rows per panel of the out-of-core solvers (0 for automatic, the default).
+     */
+    int getPanelRows() const { return mPanelRows; }
+
+    /**
+     * \brief Checks whether complex matrices are read as real/imaginary column pairs (default \c false).
+     */
+    bool getComplexPairs() const { return mComplexPairs; }
+
+    /**
+     * \brief Gets the number of iterations recorded by the iterative solvers (0, the default, for none).
+     */
+    int getHistoryCapacity() const { return mHistoryCapacity; }
+
+    /**
+     * \brief Checks whether \c QRMethod computes eigenvectors (default \c true).
+     */
+    bool getComputeEigenvectors() const { return mComputeEigenvectors; }
+
+    /**
+     * \brief Gets the 1-based indices of the eigenvectors computed by \c QRMethod (empty for all, the default).
+     */
+    const std::vector<int>& getEigenvectorIndices() const { return mEigenvectorIndices; }
+
+    /**
+     * \brief Gets the eigenvector selection as \c setEigenvectors() reads it.
+     */
+    std::string getEigenvectors() const;
+
     /**
      * \brief Prints all current configuration settings to the standard output.
      * \details Useful for debugging and verifying that parameters were loaded correctly.
@@ -123,6 +303,81 @@ private:
      * \brief Shift value.
      */
     double mShift;
+
+    /**
+     * \brief 1-based index of the smallest wanted eigenvalue (0 if unset).
+     */
+    int mIndexLow;
+
+    /**
+     * \brief 1-based index of the largest wanted eigenvalue (0 if unset).
+     */
+    int mIndexHigh;
+
+    /**
+     * \brief Whether a value range [mLowerBound, mUpperBound) was requested.
+     */
+    bool mHasValueRange;
+
+    /**
+     * \brief Lower bound of the wanted value range.
+     */
+    double mLowerBound;
+
+    /**
+     * \brief Upper bound of the wanted value range.
+     */
+    double mUpperBound;
+
+    /**
+     * \brief Number of wanted values (e.g. singular triplets).
+     */
+    int mNumValues;
+
+    /**
+     * \brief Number of solver threads (0 for automatic).
+     */
+    int mThreads;
+
+    /**
+     * \brief Whether the solver threads are bound to CPUs.
+     */
+    bool mPinThreads;
+
+    /**
+     * \brief Whether complex matrices are stored in planar form.
+     */
+    bool mPlanarComplex;
+
+    /**
+     * \brief Whether the matrix is streamed from the file.
+     */
+    bool mOutOfCore;
+
+    /**
+     * \brief Rows per panel of the out-of-core solvers (0 for automatic).
+     */
+    int mPanelRows;
+
+    /**
+     * \brief Whether complex matrices are read as real/imaginary column pairs.
+     */
+    bool mComplexPairs;
+
+    /**
+     * \brief Iterations kept by the convergence recorder of the solvers (0 when disabled).
+     */
+    int mHistoryCapacity;
+
+    /**
+     * \brief Whether \c QRMethod computes eigenvectors.
+     */
+    bool mComputeEigenvectors;
+
+    /**
+     * \brief 1-based indices of the eigenvectors computed by \c QRMethod (empty for all).
+     */
+    std::vector<int> mEigenvectorIndices;
 };
 
 #endif // PCSC_PROJECT_PARAMETERS_H
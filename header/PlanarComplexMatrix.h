@@ -0,0 +1,158 @@
+#ifndef PLANARCOMPLEXMATRIX_H
+#define PLANARCOMPLEXMATRIX_H
+
+#include <Eigen/Dense>
+#include <complex>
+#include <vector>
+#include "ThreadPool.h"
+
+/**
+ * \class PlanarVector
+ * \brief Complex vector stored as two real vectors (all real parts, then all imaginary parts).
+ * \sa PlanarComplexMatrix
+ */
+class PlanarVector {
+public:
+    /**
+     * \brief Empty vector.
+     */
+    PlanarVector() {}
+
+    /**
+     * \brief Splits an interleaved complex vector.
+     */
+    explicit PlanarVector(const Eigen::VectorXcd& vector);
+
+    /**
+     * \brief Rebuilds the interleaved complex vector.
+     */
+    Eigen::VectorXcd toComplex() const;
+
+    /**
+     * \brief Number of entries.
+     */
+    Eigen::Index size() const { return mReal.size(); }
+
+    /**
+     * \brief Resizes both parts (the content is undefined).
+     */
+    void resize(Eigen::Index size);
+
+    /**
+     * \brief Entry i as a complex number.
+     */
+    std::complex<double> operator()(Eigen::Index i) const { return {mReal(i), mImag(i)}; }
+
+    /**
+     * \brief Exchanges the content with \c other without copying.
+     */
+    void swap(PlanarVector& other);
+
+    /**
+     * \brief Real parts.
+     */
+    Eigen::VectorXd mReal;
+
+    /**
+     * \brief Imaginary parts.
+     */
+    Eigen::VectorXd mImag;
+};
+
+/**
+ * \class PlanarComplexMatrix
+ * \brief Copy of a complex matrix in planar storage (separate real and imaginary matrices), split in row blocks
+ * like \c RowPartitionedMatrix, with SIMD matrix-vector products.
+ *
+ * \details Each product runs the AVX2 or AVX-512 kernel of \c PlanarKernels.h on every block, on the workers of an
+ * optional \c ThreadPool (each block being first touched by its worker). The squared norm and the argmax of the
+ * squared magnitudes of the result are reduced in the same pass. The copy costs the same memory as the
+ * interleaved matrix.
+ * \sa PowerMethod
+ */
+class PlanarComplexMatrix {
+public:
+    /**
+     * \brief Splits \c matrix into real and imaginary parts, in one row block per worker of \c pool.
+     * \param matrix The complex matrix A.
+     * \param pool Optional pool (it must outlive this object); without one, a single block is used.
+     */
+    explicit PlanarComplexMatrix(const Eigen::Ref<const Eigen::MatrixXcd>& matrix, ThreadPool* pool = nullptr);
+
+    /**
+     * \brief Computes $y = Ax$, together with $\|y\|^2$ and $\arg\max_i |y_i|^2$.
+     * \param x The input vector, of size n.
+     * \param y Receives the product, resized to m if needed; it must not be \c x.
+     * \param maxIndex Receives the index of the entry of largest magnitude.
+     * \return The squared Euclidean norm of y.
+     */
+    double multiply(const PlanarVector& x, PlanarVector& y, Eigen::Index& maxIndex);
+
+    /**
+     * \brief Multiplies \c v (of size m) by the real \c factor, block by block.
+     */
+    void scale(PlanarVector& v, double factor);
+
+    /**
+     * \brief Number of row blocks.
+     */
+    int blockCount() const { return static_cast<int>(mReal.size()); }
+
+    /**
+     * \brief Number of rows m.
+     */
+    Eigen::Index rows() const { return mRows; }
+
+    /**
+     * \brief Number of columns n.
+     */
+    Eigen::Index cols() const { return mCols; }
+
+private:
+    /**
+     * \brief Runs \c task(block) on every block, through the pool if there is one.
+     */
+    template<typename Task>
+    void forEachBlock(Task task);
+
+    /**
+     * \brief Per-block results of the reductions, padded to a cache line to avoid false sharing.
+     */
+    struct alignas(64) PartialResult {
+        double squaredNorm;
+        double maxMagnitude;
+        long maxIndex;
+    };
+
+    /**
+     * \brief The optional pool running the blocks.
+     */
+    ThreadPool* mPool;
+
+    /**
+     * \brief Number of rows and columns of A.
+     */
+    Eigen::Index mRows, mCols;
+
+    /**
+     * \brief First row of each block.
+     */
+    std::vector<Eigen::Index> mOffsets;
+
+    /**
+     * \brief Real parts of the row blocks.
+     */
+    std::vector<Eigen::MatrixXd> mReal;
+
+    /**
+     * \brief Imaginary parts of the row blocks.
+     */
+    std::vector<Eigen::MatrixXd> mImag;
+
+    /**
+     * \brief Reduction results of the last product.
+     */
+    std::vector<PartialResult> mPartials;
+};
+
+#endif // PLANARCOMPLEXMATRIX_H
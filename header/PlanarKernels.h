@@ -0,0 +1,64 @@
+#ifndef PLANARKERNELS_H
+#define PLANARKERNELS_H
+
+/**
+ * \file PlanarKernels.h
+ * \brief Hand-vectorized kernels on complex data stored in planar form (separate real and imaginary arrays).
+ *
+ * \details With interleaved storage (\c std::complex<double>), one SIMD register holds halves of complex numbers
+ * and every product needs shuffles. In planar form the real and imaginary parts of 4 (AVX2) or 8 (AVX-512)
+ * consecutive entries fill one register each, and a complex multiply-add is four plain FMAs. The best kernel
+ * supported by the CPU is selected at run time, so the binary does not need to be built with \c -march.
+ * \sa PlanarComplexMatrix
+ */
+
+/**
+ * \brief Instruction sets of the planar kernels.
+ */
+enum class PlanarKernel {
+    Scalar,  ///< Portable C++ loops
+    AVX2,    ///< 256-bit vectors with FMA
+    AVX512   ///< 512-bit vectors (AVX-512F)
+};
+
+/**
+ * \brief The kernel used by the planar functions (the best one the CPU supports, unless changed).
+ */
+PlanarKernel planarActiveKernel();
+
+/**
+ * \brief Selects the kernel used by the planar functions, e.g. to compare them in tests and benchmarks.
+ * \return \c false (and nothing changes) if the CPU or the compiler does not support \c kernel.
+ */
+bool planarSelectKernel(PlanarKernel kernel);
+
+/**
+ * \brief Name of a kernel ("scalar", "avx2", "avx512").
+ */
+const char* planarKernelName(PlanarKernel kernel);
+
+/**
+ * \brief Complex matrix-vector product $y = Ax$ in planar form.
+ * \details A is column-major with leading dimension \c ld: entry (i, j) is \c ar[i + j * ld] + i \c ai[i + j * ld].
+ * \param ar, ai Real and imaginary parts of A.
+ * \param rows, cols Size of A.
+ * \param ld Leading dimension of A (at least \c rows).
+ * \param xr, xi Real and imaginary parts of x (size \c cols).
+ * \param yr, yi Receive y (size \c rows); they must not alias x.
+ */
+void planarGemv(const double* ar, const double* ai, long rows, long cols, long ld,
+                const double* xr, const double* xi, double* yr, double* yi);
+
+/**
+ * \brief Squared Euclidean norm of a planar vector and index of its entry of largest magnitude.
+ * \details The argmax compares the squared magnitudes $re^2 + im^2$, which orders the entries like $|z|$ without
+ * a square root per entry. Ties go to the smallest index.
+ * \param re, im Real and imaginary parts (size \c n).
+ * \param n Size of the vector.
+ * \param maxIndex Receives the index of the largest squared magnitude (0 if n is 0).
+ * \param maxValue Receives that squared magnitude (-1 if n is 0).
+ * \return The squared norm $\sum_i re_i^2 + im_i^2$.
+ */
+double planarSquaredNormArgmax(const double* re, const double* im, long n, long& maxIndex, double& maxValue);
+
+#endif // PLANARKERNELS_H
@@ -2,21 +2,25 @@
 #define PLOTWRITER_H
 
 #include <string>
+#include <vector>
 
+#include "ConvergenceHistory.h"
 #include "Writer.h"
 
 /**
  * \class PlotWriter
- * \brief Implements the Writer interface to generate and save graphical plots of the solution process and results.
+ * \brief Implements the Writer interface to save the convergence curves of a solve as a plot.
  *
- * \details The PlotWriter is a concrete strategy for outputting results visually. It is typically used
- * to generate plots of the convergence history (e.g., eigenvalue error vs. iteration count) or to
- * visualize key characteristics of the eigenvector. It saves the resulting graph to a specified file,
- * usually requiring an external plotting library (like gnuplot or matplotlib-cpp) in the underlying
- * implementation of \c Write().
+ * \details The PlotWriter draws the trace recorded by the solver (see \c Eigenvalue::getHistory()): the residual
+ * against the iteration on a logarithmic scale, and the eigenvalue estimate against the iteration, titled with the
+ * final result. The plot is rendered by matplotlib-cpp (\c external/matplotlibcpp.h) when the project is built
+ * with it (\c PCSC_HAVE_MATPLOTLIB); otherwise, or if the rendering fails, the trace is written as a CSV file next
+ * to \c mFilename (\c convergence.png gives \c convergence.csv) with the columns
+ * \c Iteration,Seconds,EstimateReal,EstimateImag,Residual.
  *
  * \ingroup Writer
  * \sa Writer
+ * \sa ConvergenceHistory
  */
 class PlotWriter : public Writer {
 public:
@@ -32,24 +36,73 @@ public:
      */
     virtual ~PlotWriter();
 
-    // Public virtual Method
     /**
-     * \brief Generates the plot using the computed data and saves it to the configured file.
-     *
-     * \details This overridden method collects the necessary data (e.g., iteration data collected
-     * during the solver's execution), constructs the plot (e.g., a line graph showing error reduction),
-     * and saves the resulting image to \c mFilename.
-     * \pre The solver process must have successfully completed, and relevant iteration history must be available.
-     * \post A graphical file (e.g., PNG, SVG) is created at the location specified by \c mFilename.
-     *
+     * \brief Sets the trace drawn by the next write (a copy of its entries, oldest first).
      */
-    virtual void Write() override;
+    void setHistory(const ConvergenceHistory& history);
+
+    /**
+     * \brief Checks whether the project was built with matplotlib-cpp; if not, every plot is a CSV file.
+     */
+    static bool canRender();
+
+    /**
+     * \brief The file actually written: \c mFilename when rendered, the CSV fallback otherwise.
+     */
+    std::string getOutputFile() const;
+
+    /**
+     * \brief Plots the trace, titled with the real eigenvalue.
+     * \copydoc Writer::write(double, const Eigen::VectorXd&, int, bool)
+     */
+    void write(double eigenvalue,
+               const Eigen::VectorXd& eigenvector,
+               int iterations,
+               bool converged) const override;
+
+    /**
+     * \brief Plots the trace, titled with the complex eigenvalue.
+     * \copydoc Writer::write(std::complex<double>, const Eigen::VectorXcd&, int, bool)
+     */
+    void write(std::complex<double> eigenvalue,
+               const Eigen::VectorXcd& eigenvector,
+               int iterations,
+               bool converged) const override;
+
+    /**
+     * \brief Plots the trace, titled with the number of eigenvalues.
+     * \copydoc Writer::writeAll(const Eigen::VectorXd&, const Eigen::MatrixXd&, int, bool)
+     */
+    void writeAll(const Eigen::VectorXd& eigenvalues,
+                  const Eigen::MatrixXd& eigenvectors,
+                  int iterations,
+                  bool converged) const override;
+
+    /**
+     * \brief Plots the trace, titled with the number of eigenvalues.
+     * \copydoc Writer::writeAll(const Eigen::VectorXcd&, const Eigen::MatrixXcd&, int, bool)
+     */
+    void writeAll(const Eigen::VectorXcd& eigenvalues,
+                  const Eigen::MatrixXcd& eigenvectors,
+                  int iterations,
+                  bool converged) const override;
 
 private:
     /**
-     * \brief The file path where the generated plot will be saved.
+     * \brief Renders the plot, or writes the CSV fallback.
+     * \param title The title of the plot, with the final result.
+     */
+    void plot(const std::string& title) const;
+
+    /**
+     * \brief Writes the trace as CSV to \c getOutputFile().
+     */
+    void writeCsv() const;
+
+    /**
+     * \brief The recorded iterations, oldest first.
      */
-    std::string mFilename;
+    std::vector<ConvergenceHistory::Entry> mEntries;
 };
 
-#endif //PLOTWRITER_H
\ No newline at end of file
+#endif //PLOTWRITER_H
@@ -2,6 +2,12 @@
 #define POWERMETHOD_H
 
 #include "Eigenvalue.h"
+#include <memory>
+
+class ThreadPool;
+class PlanarComplexMatrix;
+template<typename Scalar>
+class RowPartitionedMatrix;
 
 /**
  * \tparam Scalar The underlying numeric type of the matrix elements (e.g., \c double, \c std::complex<double>).
@@ -25,6 +31,11 @@ public:
      */
     using Matrix = typename Eigenvalue<Scalar>::Matrix;
 
+    /**
+     * \brief Type alias for a view of a matrix owned by the caller.
+     */
+    using MatrixMap = typename Eigenvalue<Scalar>::MatrixMap;
+
     /**
      * \brief Type alias for the vector type used by the solver (e.g., \c Eigen::VectorXd).
      */
@@ -44,6 +55,13 @@ public:
      */
     PowerMethod(const Matrix& matrix, const Parameters& params);
 
+    /**
+     * \brief Constructor on a matrix used in place, without a copy (e.g. mapped by \c BinaryReader).
+     * \param matrix View of the input matrix; its storage must outlive the solver.
+     * \param params A structure containing the configuration settings.
+     */
+    PowerMethod(const MatrixMap& matrix, const Parameters& params);
+
     /**
      * \brief Destructor for PowerMethod.
      */
@@ -62,6 +80,37 @@ public:
      * \post The protected members \c mEigenvalue and \c mEigenvector will hold the dominant pair if convergence is achieved.
      */
     virtual void solve() override;
+
+    /**
+     * \brief Replaces the matrix, and drops the copies of the previous one kept for the parallel products.
+     * \param matrix The new matrix.
+     */
+    virtual void setMatrix(const Matrix& matrix) override;
+
+private:
+    /**
+     * \brief Buffers of the iterations, allocated by the first \c solve() and reused by the next ones while the
+     * size does not change, so that the loop itself never allocates.
+     * \details The thread pool of the parallel products and the copies of the matrix they read (row blocks, or the
+     * planar form of a complex matrix) are kept as well, until \c setMatrix() or a change of the thread count.
+     * A matrix used in place must therefore be given again with \c setMatrix() when its values change.
+     */
+    struct Workspace {
+        Vector current;
+        Vector next;
+        std::unique_ptr<ThreadPool> pool;
+        std::unique_ptr<RowPartitionedMatrix<Scalar>> partitioned;
+        std::unique_ptr<PlanarComplexMatrix> planar;
+    };
+
+    /**
+     * \brief Pool of \c threads workers of the workspace, created (dropping the copies that used the previous one)
+     * when there is none of that size.
+     * \return The pool, or \c nullptr for a single thread.
+     */
+    ThreadPool* productPool(int threads);
+
+    Workspace mWorkspace;
 };
 
 #endif // POWERMETHOD_H
\ No newline at end of file
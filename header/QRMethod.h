@@ -25,6 +25,11 @@ public:
      */
     using Matrix = typename Eigenvalue<Scalar>::Matrix;
 
+    /**
+     * \brief Type alias for a view of a matrix owned by the caller.
+     */
+    using MatrixMap = typename Eigenvalue<Scalar>::MatrixMap;
+
     /**
      * \brief Type alias for the vector type used by the solver.
      */
@@ -44,6 +49,13 @@ public:
      */
     QRMethod(const Matrix& matrix, const Parameters& params);
 
+    /**
+     * \brief Constructor on a matrix used in place, without a copy (e.g. mapped by \c BinaryReader).
+     * \param matrix View of the input matrix; its storage must outlive the solver.
+     * \param params A structure containing the configuration settings.
+     */
+    QRMethod(const MatrixMap& matrix, const Parameters& params);
+
     /**
      * \brief Destructor for QRMethod.
      */
@@ -54,7 +66,19 @@ public:
      * \details The core loop performs $A_{k+1} = R_k Q_k$ after $A_k = Q_k R_k$.
      * Upon convergence, the diagonal elements of the transformed matrix $A_k$ are stored in \c mAllEigenvalues.
      * \pre The input matrix must be square.
+     * The eigenvectors depend on the \c Eigenvectors parameter:
+     * - \c All (the default): the columns of the accumulated $Q$, i.e. the Schur vectors, which are the eigenvectors
+     *   of normal (e.g. symmetric) matrices only.
+     * - \c None: $Q$ is not accumulated, which saves a third of the work per iteration; \c getAllEigenvectors()
+     *   is then empty.
+     * - A list of indices: the true eigenvectors of these eigenvalues, by back-substitution on the Schur form
+     *   $T = Q^* A Q$ (one column per thread); the other columns are zero. A selected column also stays zero, with
+     *   a warning, when the solve did not converge or the eigenvalue is in a 2x2 block of a real matrix (a complex
+     *   conjugate pair, which needs the complex type). \c getEigenvector() is the eigenvector of the dominant
+     *   eigenvalue, back-substituted as well when it was not selected, and zero with the same warning.
+     * \pre The input matrix must be square.
      * \post The protected members \c mAllEigenvalues and \c mAllEigenvectors will hold the complete set of solutions.
+     * \throw std::runtime_error If an eigenvector index is not between 1 and the size of the matrix.
      */
     virtual void solve() override;
 
@@ -66,7 +90,9 @@ public:
 
     /**
      * \brief Retrieves all computed eigenvectors.
-     * \return A matrix where each column is an eigenvector corresponding to the eigenvalue at the same index in \c mAllEigenvalues.
+     * \return A matrix where each column is an eigenvector corresponding to the eigenvalue at the same index in
+     * \c mAllEigenvalues; it has no column without eigenvectors, and zero columns for the eigenvalues that were not
+     * selected.
      */
     Matrix getAllEigenvectors() const { return mAllEigenvectors; }
 
@@ -80,6 +106,24 @@ private:
      * \brief Matrix storing all computed eigenvectors $x_i$ as its columns.
      */
     Matrix mAllEigenvectors;
+
+    /**
+     * \brief Buffers of the iterations, allocated by the first \c solve() and reused by the next ones while the
+     * size does not change.
+     * \details Each QR step is done in place: the Householder vectors are stored below R in \c reflectors (as
+     * \c Eigen::HouseholderQR stores them) and applied on the right of R and of the accumulated Q, so that no
+     * factorization object, Q or product is created by the loop. \c accumulated is only allocated when
+     * eigenvectors are wanted.
+     */
+    struct Workspace {
+        Matrix current;
+        Matrix reflectors;
+        Matrix accumulated;
+        Vector coefficients;
+        Vector buffer;
+    };
+
+    Workspace mWorkspace;
 };
 
 
@@ -5,6 +5,7 @@
 #include <string>
 #include <complex>
 #include "Parameters.h"
+#include "Decompressor.h"
 
 
 /**
@@ -13,9 +14,12 @@
  * \brief Abstract base class providing a uniform interface for reading matrix data and configuration parameters from various input sources.
  *
  * \details The Reader class uses the strategy pattern for handling file input. Derived concrete classes,
- * like \c CSVReader, \c TextFileReader, must implement the pure virtual methods to define the specific parsing logic
+ * like \c CSVReader, \c TextFileReader, \c BinaryReader, \c MatrixMarketReader, \c NumpyReader, must implement the pure virtual methods to define the specific parsing logic
  * for their respective file formats. This templated structure ensures that the same I/O architecture can handle both
  * real and complex data types.
+ *
+ * CSV and text files may be compressed with gzip or zstd: the compression is recognized by the first bytes of the
+ * file, the format by its name without the \c .gz or \c .zst suffix (\c matrix.csv.gz is a compressed CSV file).
  */
 template<typename Scalar>
 class Reader {
@@ -34,6 +38,12 @@ public:
         CSV,
         /** \brief Plain text file format (e.g., space or tab delimited). */
         TEXT,
+        /** \brief Binary matrix format (\c .bmat), see \c BinaryMatrixHeader. */
+        BINARY,
+        /** \brief Matrix Market exchange format (\c .mtx), see \c MatrixMarketReader. */
+        MATRIX_MARKET,
+        /** \brief NumPy array (\c .npy) or uncompressed archive of arrays (\c .npz), see \c NumpyReader. */
+        NUMPY,
         /** \brief Default or unrecognized file format. */
         UNKNOWN
     };
@@ -44,6 +54,8 @@ public:
      * \details Initializes the reader and stores the path to the input file. The actual file parsing
      * is deferred to the derived classes.
      * \param filename Path to the input file to be read.
+     * \throw std::runtime_error If the file does not exist, its format is unknown, or a file other than CSV or text
+     * is compressed.
      */
     Reader(const std::string& filename);
 
@@ -69,6 +81,31 @@ public:
      */
     virtual Matrix ReadMatrix() = 0;
 
+    /**
+     * \brief Reads the second matrix B of a generalized eigenproblem $Ax = \lambda Bx$.
+     * \details In the text formats, B follows a line \c MatrixB placed after the rows of A. The default
+     * implementation is for formats without a second matrix.
+     * \return The matrix B, or an empty (0x0) matrix if the input only holds a standard problem.
+     */
+    virtual Matrix ReadMatrixB();
+
+    /**
+     * \brief Counts the rows of the main matrix without converting any value.
+     * \details Used by distributed solvers to split the rows between processes before reading them. The default
+     * implementation reads the whole matrix.
+     */
+    virtual long CountMatrixRows();
+
+    /**
+     * \brief Reads only the rows \c firstRow .. \c firstRow + \c rowCount - 1 of the main matrix.
+     * \details The text formats skip the other lines without parsing them, so that each process of a distributed
+     * solver only holds its own row block. The default implementation reads the whole matrix and slices it.
+     * \param firstRow The first wanted row (0-based).
+     * \param rowCount The number of wanted rows.
+     * \return The \c rowCount x n block.
+     */
+    virtual Matrix ReadMatrixRows(long firstRow, long rowCount);
+
     // File type methods
     /**
      * \brief Gets the identified file type.
@@ -82,6 +119,12 @@ public:
      */
     std::string GetFileTypeString() const;
 
+    /**
+     * \brief Gets the compression of the file, recognized by its first bytes.
+     * \return \c Compression::None for a plain file.
+     */
+    Compression GetCompression() const;
+
 protected:
     /**
      * \brief Path to the matrix data file.
@@ -92,6 +135,11 @@ protected:
      * \brief The determined file type of the input source.
      */
     FileType mFileType;
+
+    /**
+     * \brief Compression of the file (only CSV and text files may be compressed).
+     */
+    Compression mCompression;
 };
 
 
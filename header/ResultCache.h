@@ -0,0 +1,128 @@
+#ifndef RESULTCACHE_H
+#define RESULTCACHE_H
+
+#include "SolveJob.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+/**
+ * \brief Counters of a \c ResultCache since it was opened.
+ */
+struct CacheStats {
+    long hits = 0;
+    long misses = 0;
+    long stores = 0;
+
+    /**
+     * \brief Entries removed to keep the cache under its size cap.
+     */
+    long evictions = 0;
+
+    /**
+     * \brief Entries found damaged (truncated, wrong key or checksum) and removed.
+     */
+    long corrupt = 0;
+};
+
+/**
+ * \class ResultCache
+ * \brief On-disk cache of results, addressed by the contents of the problem.
+ *
+ * \details The key of a problem is a 128-bit hash of the scalar type, the sizes and raw values of A (and B), and
+ * the parameters written by \c Parameters::writeValues(), except those that cannot change the result (threads,
+ * thread pinning and convergence history).
+ * Each entry is a binary result file (\c .bres) named after its key, holding the eigenvalues, the eigenvectors
+ * and metadata lines: the key, the sizes of A and a CRC-32 of the values. An entry is checked against all of them
+ * when it is read, and a damaged entry is removed and counted as a miss, never served.
+ *
+ * Entries are written to a temporary file and renamed, so that a reader (another thread or process sharing the
+ * directory) never sees a partial entry. The cache is kept under \c maxBytes by removing the least recently used
+ * entries, the time of last use being the modification time of the file, renewed on each hit.
+ * \sa solveProblem()
+ */
+class ResultCache {
+public:
+    /**
+     * \brief Opens the cache, creating its directory if needed.
+     * \param maxBytes Size cap of the entries; 0 for no cap.
+     * \throw std::runtime_error If the directory cannot be created.
+     */
+    ResultCache(const std::string& directory, std::uint64_t maxBytes = 0);
+
+    /**
+     * \brief Key of a problem: 32 hexadecimal digits.
+     * \param matrixB The matrix B of a generalized problem, or an empty matrix.
+     */
+    template<typename Scalar>
+    static std::string key(const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>& matrixA,
+                           const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>& matrixB,
+                           const Parameters& params);
+
+    /**
+     * \brief Reads the entry of a key.
+     * \param rows, cols Size of A, checked against the entry.
+     * \return false if there is no valid entry.
+     */
+    template<typename Scalar>
+    bool load(const std::string& key, long rows, long cols, SolveResult<Scalar>& result);
+
+    /**
+     * \brief Writes the entry of a key, then removes old entries over the size cap.
+     * \details An entry larger than the cap on its own is not stored.
+     * \return false if the entry could not be written (disk full, directory removed): the cache only saves time,
+     * so this is not an error for the caller.
+     */
+    template<typename Scalar>
+    bool store(const std::string& key, long rows, long cols, const std::string& algorithm,
+               const SolveResult<Scalar>& result);
+
+    /**
+     * \brief The cached result of a problem, or \c solveProblem() and a new entry.
+     * \param hit Set to true if the result comes from the cache.
+     * \throw std::runtime_error As \c solveProblem().
+     */
+    template<typename Scalar>
+    SolveResult<Scalar> solve(const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>& matrixA,
+                              const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>& matrixB,
+                              const Parameters& params, bool* hit = nullptr);
+
+    /**
+     * \brief Total size of the entries in the directory.
+     */
+    std::uint64_t sizeBytes() const;
+
+    /**
+     * \brief Counters since the cache was opened.
+     */
+    CacheStats stats() const;
+
+    const std::string& directory() const { return mDirectory; }
+
+private:
+    /**
+     * \brief Path of the entry of a key.
+     */
+    std::string entryPath(const std::string& key) const;
+
+    /**
+     * \brief Removes the least recently used entries until the cache fits in \c mMaxBytes, keeping \c keep.
+     */
+    void evict(const std::string& keep);
+
+    std::string mDirectory;
+    std::uint64_t mMaxBytes;
+
+    /**
+     * \brief Serializes the evictions of this process.
+     */
+    std::mutex mEvictMutex;
+
+    /**
+     * \brief Counters, as in \c CacheStats.
+     */
+    std::atomic<long> mHits, mMisses, mStores, mEvictions, mCorrupt;
+};
+
+#endif // RESULTCACHE_H
@@ -0,0 +1,135 @@
+#ifndef ROWPARTITIONEDMATRIX_H
+#define ROWPARTITIONEDMATRIX_H
+
+#include <Eigen/Dense>
+#include <complex>
+#include <vector>
+#include "ThreadPool.h"
+
+/**
+ * \tparam Scalar The underlying numeric type of the matrix elements (e.g., \c double, \c std::complex<double>).
+ * \class RowPartitionedMatrix
+ * \brief Copy of a dense matrix split into contiguous row blocks, one per worker of a \c ThreadPool, for parallel
+ * matrix-vector products.
+ *
+ * \details Worker t owns rows [offset_t, offset_t + rows_t) and computes that part of $y = Ax$. Each block is
+ * allocated and copied by the worker that will read it (first touch), so on a NUMA machine its pages are placed
+ * on the memory node of that worker and the product streams from all memory controllers at once. The reductions
+ * a power iteration needs after the product (squared norm and index of the largest $|y_i|^2$) are computed by
+ * each worker on its own segment while it is still in cache, then combined by the caller.
+ *
+ * The copy doubles the memory used by the matrix; it is only worth it when the product dominates the run time,
+ * see \c recommendedBlockCount().
+ * \sa PowerMethod
+ */
+template<typename Scalar>
+class RowPartitionedMatrix {
+public:
+    /**
+     * \brief Type alias for the matrix type.
+     */
+    using Matrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+
+    /**
+     * \brief Type alias for the vector type.
+     */
+    using Vector = Eigen::Matrix<Scalar, Eigen::Dynamic, 1>;
+
+    /**
+     * \brief Real type of the norms.
+     */
+    using RealScalar = typename Eigen::NumTraits<Scalar>::Real;
+
+    /**
+     * \brief Splits \c matrix into \c pool.size() row blocks (fewer if it has fewer rows) and copies each block
+     * from its worker.
+     * \param matrix The matrix A.
+     * \param pool The pool used for the copy and for every later product; it must outlive this object.
+     */
+    RowPartitionedMatrix(const Eigen::Ref<const Matrix>& matrix, ThreadPool& pool);
+
+    /**
+     * \brief Number of threads worth using for an m x n product.
+     * \details Below about 32k entries per block, waking the workers costs more than the product itself.
+     * \param rows Number of rows m.
+     * \param cols Number of columns n.
+     * \param threads The available threads.
+     */
+    static int recommendedBlockCount(long rows, long cols, int threads);
+
+    /**
+     * \brief Computes $y = Ax$ in parallel, together with $\|y\|^2$ and $\arg\max_i |y_i|^2$.
+     * \param x The input vector, of size n.
+     * \param y Receives the product, resized to m if needed.
+     * \param maxIndex Receives the index of the entry of largest magnitude.
+     * \return The squared Euclidean norm of y.
+     */
+    RealScalar multiply(const Vector& x, Vector& y, Eigen::Index& maxIndex);
+
+    /**
+     * \brief Multiplies \c v (of size m) by \c factor in parallel, block by block.
+     */
+    void scale(Vector& v, RealScalar factor);
+
+    /**
+     * \brief Number of row blocks.
+     */
+    int blockCount() const { return static_cast<int>(mBlocks.size()); }
+
+    /**
+     * \brief Number of rows m.
+     */
+    Eigen::Index rows() const { return mRows; }
+
+    /**
+     * \brief Number of columns n.
+     */
+    Eigen::Index cols() const { return mCols; }
+
+private:
+    /**
+     * \brief Per-block results of the reductions, padded to a cache line to avoid false sharing.
+     */
+    struct alignas(64) PartialResult {
+        RealScalar squaredNorm;
+        RealScalar maxMagnitude;
+        Eigen::Index maxIndex;
+    };
+
+    /**
+     * \brief The pool running the blocks.
+     */
+    ThreadPool& mPool;
+
+    /**
+     * \brief Number of rows and columns of A.
+     */
+    Eigen::Index mRows, mCols;
+
+    /**
+     * \brief First row of each block.
+     */
+    std::vector<Eigen::Index> mOffsets;
+
+    /**
+     * \brief The row blocks, each allocated by its worker.
+     */
+    std::vector<Matrix> mBlocks;
+
+    /**
+     * \brief Reduction results of the last product.
+     */
+    std::vector<PartialResult> mPartials;
+};
+
+/**
+ * \brief Type alias for the partitioned real matrix.
+ */
+using RowPartitionedMatrixReal = RowPartitionedMatrix<double>;
+
+/**
+ * \brief Type alias for the partitioned complex matrix.
+ */
+using RowPartitionedMatrixComplex = RowPartitionedMatrix<std::complex<double>>;
+
+#endif // ROWPARTITIONEDMATRIX_H
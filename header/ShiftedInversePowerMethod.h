@@ -2,6 +2,7 @@
 #define SHIFTEDINVERSEPOWERMETHOD_H
 
 #include "Eigenvalue.h"
+#include <Eigen/LU>
 
 /**
  * \tparam Scalar The underlying numeric type of the matrix elements (e.g., \c double, \c std::complex<double>).
@@ -27,6 +28,11 @@ public:
      */
     using Matrix = typename Eigenvalue<Scalar>::Matrix;
 
+    /**
+     * \brief Type alias for a view of a matrix owned by the caller.
+     */
+    using MatrixMap = typename Eigenvalue<Scalar>::MatrixMap;
+
     /**
      * \brief Type alias for the vector type used by the solver.
      */
@@ -47,6 +53,13 @@ public:
      */
     ShiftedInversePowerMethod(const Matrix& matrix, const Parameters& params);
 
+    /**
+     * \brief Constructor on a matrix used in place, without a copy (e.g. mapped by \c BinaryReader).
+     * \param matrix View of the input matrix; its storage must outlive the solver.
+     * \param params A structure containing the configuration settings.
+     */
+    ShiftedInversePowerMethod(const MatrixMap& matrix, const Parameters& params);
+
     /**
      * \brief Destructor for ShiftedInversePowerMethod.
      */
@@ -61,6 +74,21 @@ public:
      * \post The protected members \c mEigenvalue and \c mEigenvector will hold the eigenvalue pair closest to $\mu$ if convergence is achieved.
      */
     virtual void solve() override;
+
+private:
+    /**
+     * \brief The shifted matrix, its factorization and the iterates, allocated by the first \c solve() and reused by
+     * the next ones while the size does not change; the solves of the loop write into \c next instead of returning
+     * new vectors.
+     */
+    struct Workspace {
+        Matrix shifted;
+        Eigen::PartialPivLU<Matrix> lu;
+        Vector current;
+        Vector next;
+    };
+
+    Workspace mWorkspace;
 };
 
 #endif // SHIFTEDINVERSEPOWERMETHOD_H
\ No newline at end of file
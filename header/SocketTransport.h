@@ -0,0 +1,93 @@
+#ifndef SOCKETTRANSPORT_H
+#define SOCKETTRANSPORT_H
+
+#include "Transport.h"
+#include <string>
+#include <vector>
+
+/**
+ * \class SocketTransport
+ * \brief \c Transport over stream sockets: Unix-domain sockets or TCP.
+ *
+ * \details Rank 0 listens on \c address and every other rank connects to it (star topology, matching the hub-based
+ * collectives of \c Transport). The address is either \c "unix:/path/to/socket" or \c "tcp:host:port"; both
+ * allow running all the ranks on one machine, and TCP also spans several nodes. Ranks that start before rank 0
+ * retry until \c timeoutSeconds.
+ *
+ * Only the links to and from rank 0 exist: \c send and \c receive between two other ranks throw.
+ * Available on POSIX systems.
+ * \sa Transport
+ */
+class SocketTransport : public Transport {
+public:
+    /**
+     * \brief Opens the connections of this rank.
+     * \param address \c "unix:PATH" or \c "tcp:HOST:PORT".
+     * \param rank Index of this process.
+     * \param size Number of processes.
+     * \param timeoutSeconds How long rank 0 waits for the others, and the others retry to connect.
+     * \throw std::runtime_error If the address is malformed or the connections cannot be established in time.
+     */
+    SocketTransport(const std::string& address, int rank, int size, double timeoutSeconds = 30.0);
+
+    /**
+     * \brief Closes the connections (and removes the socket file of a Unix address on rank 0).
+     */
+    ~SocketTransport() override;
+
+    SocketTransport(const SocketTransport&) = delete;
+    SocketTransport& operator=(const SocketTransport&) = delete;
+
+    int rank() const override { return mRank; }
+    int size() const override { return mSize; }
+    void send(int peer, const void* data, std::size_t bytes) override;
+    void receive(int peer, void* data, std::size_t bytes) override;
+
+private:
+    /**
+     * \brief Rank 0: binds, listens and accepts the other ranks.
+     */
+    void acceptPeers(double timeoutSeconds);
+
+    /**
+     * \brief Other ranks: connects to rank 0, retrying until the timeout.
+     */
+    void connectToHub(double timeoutSeconds);
+
+    /**
+     * \brief Socket connected to \c peer, or throws if there is no such link.
+     */
+    int socketFor(int peer) const;
+
+    /**
+     * \brief Index of this process.
+     */
+    int mRank;
+
+    /**
+     * \brief Number of processes.
+     */
+    int mSize;
+
+    /**
+     * \brief Whether the address is a Unix-domain socket path.
+     */
+    bool mUnix;
+
+    /**
+     * \brief Socket path (Unix) or host name (TCP).
+     */
+    std::string mHost;
+
+    /**
+     * \brief TCP port (unused for Unix sockets).
+     */
+    std::string mPort;
+
+    /**
+     * \brief Connected sockets indexed by peer rank (-1 where there is no link).
+     */
+    std::vector<int> mSockets;
+};
+
+#endif // SOCKETTRANSPORT_H
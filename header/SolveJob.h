@@ -0,0 +1,118 @@
+#ifndef SOLVEJOB_H
+#define SOLVEJOB_H
+
+#include "ConvergenceHistory.h"
+#include "Parameters.h"
+#include "Reader.h"
+#include "SolverStats.h"
+#include "Writer.h"
+#include <Eigen/Dense>
+#include <memory>
+#include <string>
+
+/**
+ * \brief Result of one solve, whatever the algorithm, as handed to a \c Writer.
+ * \tparam Scalar \c double or \c std::complex<double>.
+ */
+template<typename Scalar>
+struct SolveResult {
+    /**
+     * \brief The eigenvalues (one for the power methods, the singular values for \c TruncatedSVD).
+     */
+    Eigen::Matrix<Scalar, Eigen::Dynamic, 1> eigenvalues;
+
+    /**
+     * \brief The eigenvectors in columns (the right singular vectors for \c TruncatedSVD).
+     */
+    Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> eigenvectors;
+
+    /**
+     * \brief True for a single eigenpair, written with \c Writer::write() rather than \c Writer::writeAll().
+     */
+    bool single = false;
+
+    /**
+     * \brief Iterations (restart cycles for \c TruncatedSVD) and convergence reported by the solver.
+     */
+    int iterations = 0;
+    bool converged = false;
+
+    /**
+     * \brief Wall time of \c solve().
+     */
+    double solveSeconds = 0.0;
+
+    /**
+     * \brief Statistics reported by the solver; all zero, and not written, for a result read from a cache or
+     * received from a server.
+     */
+    SolverStats stats;
+
+    /**
+     * \brief Convergence trace of \c PowerMethod, \c ShiftedInversePowerMethod and \c QRMethod, recorded when
+     * \c HistoryCapacity is set; disabled for the other solvers and for a result read from a cache or received from
+     * a server.
+     */
+    ConvergenceHistory history;
+};
+
+/**
+ * \brief Solves one problem with the algorithm of \c params, without printing the results.
+ * \details The algorithms are the ones of the interactive mode: \c PowerMethod, \c ShiftedInversePowerMethod and
+ * \c QRMethod, their generalized versions when \c matrixB is not empty, \c TruncatedSVD for rectangular
+ * matrices, and \c BisectionMethod for real tridiagonal matrices given in dense form.
+ * \param matrixA The matrix.
+ * \param matrixB The matrix B of a generalized problem, or an empty matrix.
+ * \param params The parameters of the solver.
+ * \throw std::runtime_error For an unknown algorithm, a non-square matrix with an eigenvalue algorithm, or a
+ * complex or non-tridiagonal matrix with \c BisectionMethod.
+ */
+template<typename Scalar>
+SolveResult<Scalar> solveProblem(const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>& matrixA,
+                                 const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>& matrixB,
+                                 const Parameters& params);
+
+/**
+ * \brief Solves one problem on a matrix mapped from a file.
+ * \details As above; \c PowerMethod, \c ShiftedInversePowerMethod and \c QRMethod work on the mapped pages in
+ * place, the generalized solvers and \c TruncatedSVD on a copy.
+ */
+template<typename Scalar>
+SolveResult<Scalar> solveProblem(const Eigen::Map<const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>>& matrixA,
+                                 const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>& matrixB,
+                                 const Parameters& params);
+
+/**
+ * \brief Writes a result with \c write() or \c writeAll(), with the statistics of the solve; a \c BinaryWriter also
+ * records the solve time.
+ */
+template<typename Scalar>
+void writeResult(const SolveResult<Scalar>& result, Writer& writer);
+
+/**
+ * \brief Creates the reader of an input file, chosen from its name as in the interactive mode.
+ * \details \c .bmat, \c .npy / \c .npz and \c .mtx files get their own reader, files of labelled diagonals a
+ * \c TridiagonalReader (real only), other \c .csv files a \c CSVReader, and any other file is read as text.
+ * \throw std::runtime_error If the file cannot be opened or is not in the format of its name, or for a tridiagonal
+ * file read as complex.
+ */
+template<typename Scalar>
+std::unique_ptr<Reader<Scalar>> createReader(const std::string& filename);
+
+/**
+ * \brief Creates the writer of an output format.
+ * \param format \c csv, \c txt, \c npz or \c bres.
+ * \param filename The output file.
+ * \param algorithm Name of the solver, stored by the binary format.
+ * \throw std::runtime_error For an unknown format.
+ */
+std::unique_ptr<Writer> createWriter(const std::string& format, const std::string& filename,
+                                     const std::string& algorithm);
+
+/**
+ * \brief Extension of the files of an output format, with its dot (e.g. \c ".csv").
+ * \throw std::runtime_error For an unknown format.
+ */
+std::string outputExtension(const std::string& format);
+
+#endif // SOLVEJOB_H
@@ -0,0 +1,123 @@
+#ifndef SOLVEPIPELINE_H
+#define SOLVEPIPELINE_H
+
+#include "BoundedQueue.h"
+#include "Parameters.h"
+#include "SolveJob.h"
+#include <Eigen/Dense>
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * \brief Settings of a \c SolvePipeline.
+ */
+struct PipelineOptions {
+    /**
+     * \brief Directory of the result files, named \c result_<n> after the 1-based number of the document.
+     */
+    std::string outputDirectory = ".";
+
+    /**
+     * \brief Output format: \c csv, \c txt, \c npz or \c bres.
+     */
+    std::string format = "csv";
+
+    /**
+     * \brief Capacity of each of the two queues between the stages.
+     */
+    std::size_t queueDepth = 2;
+
+    /**
+     * \brief Threads of each solver, replacing the \c Threads parameter of the documents; -1 keeps it.
+     */
+    int threads = -1;
+};
+
+/**
+ * \brief Counts and cumulative times of the stages of a \c SolvePipeline run.
+ * \details When the stages overlap, the sum of the three stage times exceeds the wall time.
+ */
+struct PipelineStats {
+    long documents = 0;
+    long solved = 0;
+    long failed = 0;
+    double readSeconds = 0.0;
+    double solveSeconds = 0.0;
+    double writeSeconds = 0.0;
+    double wallSeconds = 0.0;
+};
+
+/**
+ * \brief Reads the next document of a stream: the lines up to a \c --- line or the end of the stream.
+ * \details Documents holding only blank lines are skipped.
+ * \param input The stream.
+ * \param text Replaced by the text of the document, with its newlines.
+ * \return false at the end of the stream (\c text is then empty).
+ */
+bool readDocument(std::istream& input, std::vector<char>& text);
+
+/**
+ * \class SolvePipeline
+ * \brief Solves a stream of problems, such as a file or the standard input holding many documents back to back.
+ *
+ * \details Each document has the format of a CSV or text input file (matrix rows, optional \c MatrixB section,
+ * parameters from the \c Algorithm line) and documents are separated by \c --- lines. Three stages run at the
+ * same time, connected by \c BoundedQueue objects of \c queueDepth jobs:
+ * - a reading thread splits the stream and parses document i + 1 with \c TextMatrixParser;
+ * - the calling thread solves document i with \c solveProblem();
+ * - a writing thread writes the result of document i - 1 with the writer of the output format.
+ *
+ * The queues hold a few jobs at most, so a long stream is never loaded whole. A document that cannot be parsed,
+ * solved or written is reported on the log and counted as failed, and the next documents are still processed.
+ * \tparam Scalar \c double or \c std::complex<double>.
+ */
+template<typename Scalar>
+class SolvePipeline {
+public:
+    /**
+     * \brief Type alias for the matrix type used by the solvers.
+     */
+    using Matrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+
+    /**
+     * \brief Constructs the pipeline.
+     * \throw std::runtime_error For an unknown output format.
+     */
+    explicit SolvePipeline(const PipelineOptions& options);
+
+    /**
+     * \brief Processes the whole stream.
+     * \param input The documents.
+     * \param log Receives one line per document.
+     * \return The counts and times of the stages.
+     * \throw std::runtime_error If a stage stops on an unexpected error (not a faulty document).
+     */
+    PipelineStats run(std::istream& input, std::ostream& log);
+
+private:
+    /**
+     * \brief A document on its way through the stages.
+     */
+    struct Job {
+        long index = 0;
+        Matrix matrixA, matrixB;
+        Parameters params;
+        SolveResult<Scalar> result;
+
+        /**
+         * \brief Why the document failed, empty while it has not.
+         */
+        std::string error;
+    };
+
+    void readStage(std::istream& input, BoundedQueue<Job>& parsed, PipelineStats& stats);
+    void solveStage(BoundedQueue<Job>& parsed, BoundedQueue<Job>& solved, PipelineStats& stats);
+    void writeStage(BoundedQueue<Job>& solved, std::ostream& log, PipelineStats& stats);
+
+    PipelineOptions mOptions;
+};
+
+#endif // SOLVEPIPELINE_H
@@ -0,0 +1,49 @@
+#ifndef SOLVERCLIENT_H
+#define SOLVERCLIENT_H
+
+#include "SolverProtocol.h"
+#include <string>
+
+/**
+ * \class SolverClient
+ * \brief Connection to a \c SolverServer, sending requests one after the other.
+ *
+ * \details Each call to \c solve() sends one request and waits for its reply; the connection stays open between
+ * calls. A client is meant for one thread: open one connection per thread to send requests concurrently.
+ * \sa SolverServer
+ */
+class SolverClient {
+public:
+    /**
+     * \brief Connects to the server, retrying while it starts.
+     * \param address \c "unix:PATH" or a plain socket path.
+     * \param timeoutSeconds Time given to the server to accept the connection.
+     * \throw std::runtime_error If the server cannot be reached in time.
+     */
+    explicit SolverClient(const std::string& address, double timeoutSeconds = 5.0);
+
+    /**
+     * \brief Closes the connection.
+     */
+    ~SolverClient();
+
+    SolverClient(const SolverClient&) = delete;
+    SolverClient& operator=(const SolverClient&) = delete;
+
+    /**
+     * \brief Sends a problem and waits for the reply.
+     * \param matrixB The matrix B of a generalized problem, or an empty matrix.
+     * \param deadlineSeconds Time the server may take; 0 for the default deadline of the server.
+     * \return The reply; a \c Busy, \c Failed or \c DeadlineExceeded status is not an exception.
+     * \throw std::runtime_error If the connection fails or the reply is malformed.
+     */
+    template<typename Scalar>
+    SolveReply<Scalar> solve(const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>& matrixA,
+                             const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>& matrixB,
+                             const Parameters& params, double deadlineSeconds = 0.0);
+
+private:
+    int mSocket;
+};
+
+#endif // SOLVERCLIENT_H
@@ -0,0 +1,213 @@
+#ifndef SOLVERPROTOCOL_H
+#define SOLVERPROTOCOL_H
+
+#include "BinaryMatrix.h"
+#include "Parameters.h"
+#include "SolveJob.h"
+#include <Eigen/Dense>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * \brief Outcome of a request to a \c SolverServer.
+ */
+enum class SolveStatus : std::uint32_t {
+    /** \brief Solved: the eigenpairs follow. */
+    Ok = 0,
+    /** \brief The request was invalid or the solver failed: the message says why. */
+    Failed = 1,
+    /** \brief Refused by admission control, the server being full: try again later. */
+    Busy = 2,
+    /** \brief Not solved before the deadline of the request. */
+    DeadlineExceeded = 3
+};
+
+/**
+ * \brief Name of a status (\c "ok", \c "failed", \c "busy", \c "deadline exceeded").
+ */
+const char* statusName(SolveStatus status);
+
+/**
+ * \brief Fixed 64-byte header of a request sent to a \c SolverServer.
+ *
+ * \details A request is this header, \c parameterBytes bytes of \c Name,Value parameter lines (as written by
+ * \c Parameters::writeValues()), then the matrix A and, if \c rowsB is not 0, the matrix B, both raw in
+ * column-major order. Integers are in the byte order of the machine: the protocol is meant for a local socket.
+ */
+struct SolveRequestHeader {
+    /**
+     * \brief \c kSolveRequestMagic.
+     */
+    char magic[8];
+
+    /**
+     * \brief \c kSolverProtocolVersion.
+     */
+    std::uint32_t version;
+
+    /**
+     * \brief \c kBinaryScalarReal or \c kBinaryScalarComplex.
+     */
+    std::uint32_t scalarType;
+
+    /**
+     * \brief Size of A, and number of rows of B (B is square, 0 for a standard problem).
+     */
+    std::uint64_t rows, cols, rowsB;
+
+    /**
+     * \brief Time the server may take, from the reception of the request; 0 for no deadline.
+     */
+    std::uint32_t deadlineMillis;
+
+    /**
+     * \brief Length of the parameter text.
+     */
+    std::uint32_t parameterBytes;
+
+    /**
+     * \brief Reserved, 0.
+     */
+    std::uint64_t reserved[2];
+};
+
+static_assert(sizeof(SolveRequestHeader) == 64, "SolveRequestHeader must stay 64 bytes");
+
+/**
+ * \brief Fixed 64-byte header of a reply of a \c SolverServer.
+ *
+ * \details A reply is this header, \c messageBytes bytes of error message, then \c count eigenvalues and the
+ * \c rows x \c vectorCount eigenvectors in column-major order, raw, as in the binary result format.
+ */
+struct SolveReplyHeader {
+    /**
+     * \brief \c kSolveReplyMagic.
+     */
+    char magic[8];
+
+    /**
+     * \brief A \c SolveStatus.
+     */
+    std::uint32_t status;
+
+    /**
+     * \brief \c kBinaryScalarReal or \c kBinaryScalarComplex.
+     */
+    std::uint32_t scalarType;
+
+    /**
+     * \brief Number of eigenvalues, length and number of the eigenvectors.
+     */
+    std::uint64_t count, rows, vectorCount;
+
+    /**
+     * \brief Iterations performed by the solver.
+     */
+    std::int32_t iterations;
+
+    /**
+     * \brief 1 if the solver converged, else 0.
+     */
+    std::uint32_t converged;
+
+    /**
+     * \brief Time spent in \c solve() on the server, and time the request waited for a worker, in microseconds.
+     */
+    std::uint32_t solveMicros, queueMicros;
+
+    /**
+     * \brief Length of the message.
+     */
+    std::uint32_t messageBytes;
+
+    /**
+     * \brief \c kReplySinglePair if the result is one eigenpair (power methods), else 0.
+     */
+    std::uint32_t flags;
+};
+
+static_assert(sizeof(SolveReplyHeader) == 64, "SolveReplyHeader must stay 64 bytes");
+
+/**
+ * \brief First bytes of a request and of a reply.
+ */
+constexpr char kSolveRequestMagic[8] = {'P', 'C', 'S', 'C', 'R', 'E', 'Q', '\x1a'};
+constexpr char kSolveReplyMagic[8] = {'P', 'C', 'S', 'C', 'R', 'E', 'P', '\x1a'};
+
+/**
+ * \brief Flag of a reply holding a single eigenpair.
+ */
+constexpr std::uint32_t kReplySinglePair = 1;
+
+/**
+ * \brief Current protocol version.
+ */
+constexpr std::uint32_t kSolverProtocolVersion = 1;
+
+/**
+ * \brief A reply, as returned by \c SolverClient.
+ * \tparam Scalar \c double or \c std::complex<double>.
+ */
+template<typename Scalar>
+struct SolveReply {
+    SolveStatus status = SolveStatus::Failed;
+
+    /**
+     * \brief Why the request was not solved, empty on success.
+     */
+    std::string message;
+
+    /**
+     * \brief The eigenpairs, iterations, convergence and solve time (valid when \c status is \c Ok).
+     */
+    SolveResult<Scalar> result;
+
+    /**
+     * \brief Time the request waited on the server for a worker.
+     */
+    double queueSeconds = 0.0;
+};
+
+/**
+ * \brief Builds a request: header, parameter text and matrices, in one buffer.
+ * \param matrixB The matrix B of a generalized problem, or an empty matrix.
+ * \param deadlineSeconds Time the server may take; 0 for no deadline.
+ */
+template<typename Scalar>
+std::vector<char> encodeRequest(const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>& matrixA,
+                                const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>& matrixB,
+                                const Parameters& params, double deadlineSeconds);
+
+/**
+ * \brief Builds a reply: header, message and eigenpairs (only with the \c Ok status), in one buffer.
+ */
+template<typename Scalar>
+std::vector<char> encodeReply(const SolveReply<Scalar>& reply);
+
+/**
+ * \brief Writes the whole buffer to a socket, retrying after signals and partial writes.
+ * \throw std::runtime_error If the socket fails or the peer is gone.
+ */
+void sendFully(int socket, const void* data, std::size_t bytes);
+
+/**
+ * \brief Reads exactly \c bytes from a socket.
+ * \return false if the peer closed the connection before the first byte (a clean end).
+ * \throw std::runtime_error If the socket fails or the peer closes the connection in the middle.
+ */
+bool receiveFully(int socket, void* data, std::size_t bytes);
+
+/**
+ * \brief Parses the \c Name,Value lines of a request.
+ */
+Parameters parseParameterText(const std::string& text);
+
+/**
+ * \brief Socket path of an address: \c "unix:PATH" or a plain path.
+ * \throw std::runtime_error If the path does not fit in a Unix socket address.
+ */
+std::string unixSocketPath(const std::string& address);
+
+#endif // SOLVERPROTOCOL_H
@@ -0,0 +1,195 @@
+#ifndef SOLVERSERVER_H
+#define SOLVERSERVER_H
+
+#include "ResultCache.h"
+#include "SolverProtocol.h"
+#include "WorkStealingPool.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * \brief Settings of a \c SolverServer.
+ */
+struct ServerOptions {
+    /**
+     * \brief \c "unix:PATH" or a plain socket path.
+     */
+    std::string address;
+
+    /**
+     * \brief Requests solved at the same time; values below 1 mean \c defaultThreadCount().
+     */
+    int workers = 0;
+
+    /**
+     * \brief Threads of each solver, replacing the \c Threads parameter of the requests.
+     */
+    int solverThreads = 1;
+
+    /**
+     * \brief Requests admitted at a time, running or waiting for a worker; the next ones are answered \c Busy.
+     */
+    std::size_t maxPending = 64;
+
+    /**
+     * \brief Connections open at a time, each holding a thread; a connection beyond them is answered \c Busy and
+     * closed without reading its request.
+     */
+    std::size_t maxConnections = 256;
+
+    /**
+     * \brief Largest request accepted, parameters and matrices included.
+     */
+    std::size_t maxRequestBytes = std::size_t(1) << 30;
+
+    /**
+     * \brief Deadline of the requests that do not set one, in seconds; 0 for none.
+     * \details A request past its deadline is answered \c DeadlineExceeded, but its solve is not cancelled: it
+     * holds its worker and its pending place until it ends.
+     */
+    double defaultDeadlineSeconds = 0.0;
+
+    /**
+     * \brief Directory of a \c ResultCache answering the problems already solved; none if empty.
+     */
+    std::string cacheDirectory;
+
+    /**
+     * \brief Size cap of the cache; 0 for none.
+     */
+    std::uint64_t cacheBytes = 0;
+};
+
+/**
+ * \brief Counters of a \c SolverServer since it started.
+ */
+struct ServerStats {
+    long connections = 0;
+    long requests = 0;
+    long solved = 0;
+    long failed = 0;
+    long rejected = 0;
+    long expired = 0;
+
+    /**
+     * \brief Requests answered from the cache (also counted as solved).
+     */
+    long cached = 0;
+};
+
+/**
+ * \class SolverServer
+ * \brief Long-running solver answering requests on a Unix-domain socket.
+ *
+ * \details Starting a process per solve costs more than solving a small matrix: loading the program, parsing a
+ * text file, writing the result as text. The server pays these costs once. Clients connect to its socket and
+ * send requests in the binary format of \c SolveRequestHeader (parameters, then raw matrices); each reply holds
+ * the raw eigenpairs (\c SolveReplyHeader). A connection can carry any number of requests, one after the other.
+ *
+ * Each connection is served by its own thread, which reads the requests and waits for their replies, while the
+ * solves run on a shared \c WorkStealingPool of \c workers threads. Admission control keeps the server
+ * responsive under load: at most \c maxPending requests are admitted at a time, and the others are answered
+ * \c Busy at once instead of queueing without bound, and at most \c maxConnections connections (and threads)
+ * are open at a time. A request may carry a deadline: if no worker has started
+ * it by then it is dropped unsolved, and if its solve is still running the client gets \c DeadlineExceeded
+ * right away, the result being discarded when it comes. With a cache directory, a problem already solved (by
+ * this server or by an earlier run sharing the cache) is answered from its \c ResultCache entry.
+ * \sa SolverClient
+ */
+class SolverServer {
+public:
+    /**
+     * \brief Creates the socket and starts the workers; requests are served by \c serve().
+     * \throw std::runtime_error If the socket cannot be created, bound or listened on.
+     */
+    explicit SolverServer(const ServerOptions& options);
+
+    /**
+     * \brief Stops serving, closes the connections, waits for the running solves and removes the socket file.
+     */
+    ~SolverServer();
+
+    SolverServer(const SolverServer&) = delete;
+    SolverServer& operator=(const SolverServer&) = delete;
+
+    /**
+     * \brief Accepts connections until \c stop() is called.
+     */
+    void serve();
+
+    /**
+     * \brief Makes \c serve() return; callable from any thread and from a signal handler.
+     */
+    void stop();
+
+    /**
+     * \brief Counters since the server started.
+     */
+    ServerStats stats() const;
+
+    /**
+     * \brief Path of the socket.
+     */
+    const std::string& path() const { return mPath; }
+
+private:
+    /**
+     * \brief A client connection and the thread serving it.
+     */
+    struct Connection {
+        int socket = -1;
+        std::thread thread;
+        std::atomic<bool> done{false};
+    };
+
+    /**
+     * \brief Body of a connection thread: answers the requests until the client closes the connection.
+     */
+    void serveConnection(Connection& connection);
+
+    /**
+     * \brief Reads the body of a request, solves it on the pool and sends the reply.
+     * \return false if the connection must be closed (malformed or oversized request).
+     */
+    template<typename Scalar>
+    bool answer(int socket, const SolveRequestHeader& header);
+
+    /**
+     * \brief Joins the threads of the finished connections.
+     */
+    void reapConnections();
+
+    ServerOptions mOptions;
+    std::string mPath;
+
+    /**
+     * \brief Listening socket, and the pipe that wakes \c serve() up when \c stop() is called.
+     */
+    int mListener;
+    int mWakeup[2];
+    std::atomic<bool> mStopping;
+
+    WorkStealingPool mPool;
+    std::unique_ptr<ResultCache> mCache;
+
+    /**
+     * \brief Requests admitted and not finished (queued or running).
+     */
+    std::atomic<std::size_t> mPending;
+
+    std::list<Connection> mConnections;
+    std::mutex mConnectionsMutex;
+
+    /**
+     * \brief Counters, as in \c ServerStats.
+     */
+    std::atomic<long> mConnectionCount, mRequests, mSolved, mFailed, mRejected, mExpired, mCached;
+};
+
+#endif // SOLVERSERVER_H
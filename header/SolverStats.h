@@ -0,0 +1,113 @@
+#ifndef SOLVERSTATS_H
+#define SOLVERSTATS_H
+
+#include <chrono>
+#include <complex>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * \brief Statistics of one call to \c solve(), filled by the solver as it runs.
+ *
+ * \details The wall time is split into four phases: setup (copies, shifted matrices, thread pools), factorizations,
+ * the iterations themselves, and the extraction of the results (eigenvalues, eigenvectors, final residual).
+ * Flops and bytes are estimates from the operation counts of each algorithm and the sizes of the buffers it
+ * allocates, not measurements; they are meant to compare runs and to see where the time goes.
+ * \sa Eigenvalue::getStats()
+ */
+struct SolverStats {
+    double setupSeconds = 0.0;
+    double factorizationSeconds = 0.0;
+    double iterationSeconds = 0.0;
+    double extractionSeconds = 0.0;
+
+    /**
+     * \brief Products of a matrix (A, B or $A^H$) with a vector, a block of k vectors counting as k products.
+     */
+    long matrixVectorProducts = 0;
+
+    /**
+     * \brief Linear systems solved with a factorization.
+     */
+    long solves = 0;
+
+    long factorizations = 0;
+
+    /**
+     * \brief Estimated real floating-point operations (a complex multiply-add counts as 8).
+     */
+    double flops = 0.0;
+
+    /**
+     * \brief Estimated heap bytes requested by the solver during the call, matrices and vectors included.
+     */
+    std::uint64_t bytesAllocated = 0;
+
+    /**
+     * \brief Residual of the result: $\|Ax - \lambda x\| / \|x\|$ for the returned pair (or $\|Ax - \lambda Bx\|$),
+     * the largest sub-diagonal entry left by the QR iterations.
+     */
+    double residual = 0.0;
+
+    /**
+     * \brief Adds the times, counts, flops and bytes of another solve, e.g. of an inner solver; the residual is kept.
+     */
+    SolverStats& operator+=(const SolverStats& other);
+
+    /**
+     * \brief Sum of the four phases.
+     */
+    double totalSeconds() const;
+
+    /**
+     * \brief The statistics as \c Name,Value pairs, in the order of the members (e.g. \c SetupSeconds,
+     * \c MatrixVectorProducts), as written by the writers.
+     */
+    std::vector<std::pair<std::string, double>> fields() const;
+};
+
+/**
+ * \brief Prints the statistics as indented lines, for the console summaries.
+ */
+void printStats(std::ostream& out, const SolverStats& stats);
+
+/**
+ * \brief Real operations per scalar operation: 1 for \c double, 4 for \c std::complex<double>.
+ */
+template<typename Scalar>
+constexpr double flopScale() {
+    return std::is_same<Scalar, std::complex<double>>::value ? 4.0 : 1.0;
+}
+
+/**
+ * \class PhaseTimer
+ * \brief Adds the wall time of a scope to one of the phases of a \c SolverStats.
+ */
+class PhaseTimer {
+public:
+    explicit PhaseTimer(double& seconds);
+
+    /**
+     * \brief Adds the time since construction, unless \c stop() was called.
+     */
+    ~PhaseTimer();
+
+    /**
+     * \brief Adds the time since construction now.
+     */
+    void stop();
+
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+private:
+    double& mSeconds;
+    std::chrono::steady_clock::time_point mStart;
+    bool mRunning;
+};
+
+#endif // SOLVERSTATS_H
@@ -0,0 +1,101 @@
+#ifndef STREAMINGMATRIX_H
+#define STREAMINGMATRIX_H
+
+#include "PanelSource.h"
+
+/**
+ * \brief Time spent by the last products of a \c StreamingMatrix.
+ */
+struct StreamingTimings {
+    /**
+     * \brief Time spent reading panels, on the prefetch thread.
+     */
+    double readSeconds = 0.0;
+
+    /**
+     * \brief Time spent multiplying panels.
+     */
+    double computeSeconds = 0.0;
+
+    /**
+     * \brief Time the multiplication waited for a panel that was not read yet.
+     */
+    double stallSeconds = 0.0;
+
+    /**
+     * \brief Number of panels multiplied.
+     */
+    long panels = 0;
+
+    /**
+     * \brief Number of products (passes over the file).
+     */
+    long products = 0;
+};
+
+/**
+ * \tparam Scalar The underlying numeric type of the matrix elements (e.g., \c double, \c std::complex<double>).
+ * \class StreamingMatrix
+ * \brief Products with a matrix that is never held in memory: every product is one pass over a \c PanelSource.
+ *
+ * \details A prefetch thread reads panel k+1 while the caller multiplies panel k (double buffering), so with a
+ * fast enough source the pass costs about max(read, compute) instead of their sum. Resident memory is two
+ * panels, whatever the size of the matrix. Each panel gives the matching rows of the product directly.
+ * \sa PanelSource
+ * \sa StreamingPowerMethod
+ */
+template<typename Scalar>
+class StreamingMatrix {
+public:
+    /**
+     * \brief Type alias for the matrix type.
+     */
+    using Matrix = typename PanelSource<Scalar>::Matrix;
+
+    /**
+     * \brief Constructor.
+     * \param source The panels; it must outlive the object.
+     */
+    explicit StreamingMatrix(PanelSource<Scalar>& source);
+
+    /**
+     * \brief Computes Y = A X in one pass over the source.
+     * \param X A block of \c cols() rows (a single vector when it has one column).
+     * \param Y Receives the product, \c rows() rows.
+     * \throw std::runtime_error If the source fails while reading.
+     */
+    void multiply(const Matrix& X, Matrix& Y);
+
+    /**
+     * \brief Number of rows of the matrix.
+     */
+    long rows() const { return mSource.rows(); }
+
+    /**
+     * \brief Number of columns of the matrix.
+     */
+    long cols() const { return mSource.cols(); }
+
+    /**
+     * \brief Time breakdown accumulated over all the products.
+     */
+    const StreamingTimings& getTimings() const { return mTimings; }
+
+private:
+    /**
+     * \brief The panels.
+     */
+    PanelSource<Scalar>& mSource;
+
+    /**
+     * \brief The two panel buffers, kept between passes to avoid reallocations.
+     */
+    Matrix mBuffers[2];
+
+    /**
+     * \brief Accumulated time breakdown.
+     */
+    StreamingTimings mTimings;
+};
+
+#endif // STREAMINGMATRIX_H
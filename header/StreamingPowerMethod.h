@@ -0,0 +1,150 @@
+#ifndef STREAMINGPOWERMETHOD_H
+#define STREAMINGPOWERMETHOD_H
+
+#include "Parameters.h"
+#include "StreamingMatrix.h"
+#include <iosfwd>
+
+/**
+ * \tparam Scalar The underlying numeric type of the matrix elements (e.g., \c double, \c std::complex<double>).
+ * \class StreamingPowerMethod
+ * \brief Out-of-core Power Method and block power iteration: the matrix is read again from its source at every
+ * iteration and is never held in memory.
+ *
+ * \details The block size is \c params.getNumValues().
+ * - With one vector the iteration, the start vector aside, is the one of \c PowerMethod: one product per
+ *   iteration, eigenvalue estimate from the largest entry, absolute tolerance on its change.
+ * - With b > 1 vectors it is block power (subspace) iteration with Rayleigh-Ritz: Y = A X costs one pass over the
+ *   file for the whole block, H = X^H Y is the projected b x b matrix whose eigenvalues approximate the b
+ *   eigenvalues of largest magnitude, and X is then replaced by an orthonormal basis of Y. The streaming cost of
+ *   a pass is shared by the b vectors, which is the point of blocking when the product is bound by the read.
+ *
+ * Real matrices keep the real parts of the Ritz values; a warning is printed if a complex pair is found.
+ * Memory is two panels and O(n b) for the block.
+ * \sa PowerMethod
+ * \sa StreamingMatrix
+ */
+template<typename Scalar>
+class StreamingPowerMethod {
+public:
+    /**
+     * \brief Type alias for the matrix type.
+     */
+    using Matrix = typename StreamingMatrix<Scalar>::Matrix;
+
+    /**
+     * \brief Type alias for the vector type.
+     */
+    using Vector = Eigen::Matrix<Scalar, Eigen::Dynamic, 1>;
+
+    /**
+     * \brief Constructor.
+     * \param matrix The streamed matrix; it must outlive the solver.
+     * \param params Tolerance, maximum number of iterations and block size (\c NumValues).
+     */
+    StreamingPowerMethod(StreamingMatrix<Scalar>& matrix, const Parameters& params);
+
+    /**
+     * \brief Runs the iteration.
+     * \throw std::runtime_error If the matrix is not square, the block is larger than the matrix or the source fails.
+     */
+    void solve();
+
+    /**
+     * \brief Retrieves the eigenvalue of largest magnitude.
+     */
+    Scalar getEigenvalue() const { return mEigenvalues.size() > 0 ? mEigenvalues(0) : Scalar(0.0); }
+
+    /**
+     * \brief Retrieves the eigenvector of the eigenvalue of largest magnitude.
+     */
+    Vector getEigenvector() const { return mEigenvectors.cols() > 0 ? Vector(mEigenvectors.col(0)) : Vector(); }
+
+    /**
+     * \brief Retrieves the block size eigenvalues, by decreasing magnitude.
+     */
+    Vector getAllEigenvalues() const { return mEigenvalues; }
+
+    /**
+     * \brief Retrieves the matching normalized eigenvectors, one per column.
+     */
+    Matrix getAllEigenvectors() const { return mEigenvectors; }
+
+    /**
+     * \brief Checks if the last call to \c solve() converged.
+     */
+    bool hasConverged() const { return mConverged; }
+
+    /**
+     * \brief Retrieves the number of iterations, which is also the number of passes over the matrix.
+     */
+    int getIterationCount() const { return mIterationCount; }
+
+    /**
+     * \brief Prints the read / compute / stall breakdown of the passes.
+     */
+    void reportTimings(std::ostream& out) const;
+
+private:
+    /**
+     * \brief One vector: the iteration of \c PowerMethod.
+     */
+    void solveVector();
+
+    /**
+     * \brief Several vectors: block power iteration with Rayleigh-Ritz.
+     */
+    void solveBlock();
+
+    /**
+     * \brief The streamed matrix.
+     */
+    StreamingMatrix<Scalar>& mMatrix;
+
+    /**
+     * \brief The maximum number of iterations.
+     */
+    int mMaxIteration;
+
+    /**
+     * \brief The convergence threshold.
+     */
+    double mTolerance;
+
+    /**
+     * \brief Number of vectors iterated together.
+     */
+    int mBlockSize;
+
+    /**
+     * \brief The computed eigenvalues, by decreasing magnitude.
+     */
+    Vector mEigenvalues;
+
+    /**
+     * \brief The computed eigenvectors, one per column.
+     */
+    Matrix mEigenvectors;
+
+    /**
+     * \brief Whether the last solve converged.
+     */
+    bool mConverged;
+
+    /**
+     * \brief Number of iterations of the last solve.
+     */
+    int mIterationCount;
+};
+
+/**
+ * \brief Type alias for the out-of-core Power Method on real matrices.
+ */
+using StreamingPowerMethodReal = StreamingPowerMethod<double>;
+
+/**
+ * \brief Type alias for the out-of-core Power Method on complex matrices.
+ */
+using StreamingPowerMethodComplex = StreamingPowerMethod<std::complex<double>>;
+
+#endif // STREAMINGPOWERMETHOD_H
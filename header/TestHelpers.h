@@ -0,0 +1,83 @@
+#ifndef TESTHELPERS_H
+#define TESTHELPERS_H
+
+#include <Eigen/Dense>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <stdlib.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+/**
+ * \brief Returns Q diag(values) Q^* with a random unitary Q: a normal matrix with known eigenvalues.
+ * \tparam Scalar The type of the entries, double or std::complex<double>.
+ * \param values The eigenvalues.
+ */
+template<typename Scalar = double>
+Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> withEigenvalues(const Eigen::VectorXd& values) {
+    using Matrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+    Matrix Q = Eigen::HouseholderQR<Matrix>(Matrix::Random(values.size(), values.size())).householderQ();
+    return Q * values.cast<Scalar>().asDiagonal() * Q.adjoint();
+}
+
+/**
+ * \brief Returns S diag(values) S^-1 with a random S: a nonsymmetric matrix with known eigenvalues, whose Schur
+ * vectors are not eigenvectors.
+ * \tparam Scalar The type of the entries, double or std::complex<double>.
+ * \param values The eigenvalues.
+ */
+template<typename Scalar>
+Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> nonsymmetric(const Eigen::Matrix<Scalar, Eigen::Dynamic, 1>& values) {
+    using Matrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+    Matrix S = Matrix::Random(values.size(), values.size()) + 2.0 * Matrix::Identity(values.size(), values.size());
+    return S * values.asDiagonal() * S.inverse();
+}
+
+/**
+ * \brief Returns the spectrum n, n r, n r^2, ..., n r^(n-1): a dominant eigenvalue whose neighbours decay at the
+ * ratio r, for the power methods.
+ * \param n The number of values.
+ * \param ratio The ratio r between neighbours.
+ */
+inline Eigen::VectorXd geometricSpectrum(int n, double ratio) {
+    Eigen::VectorXd values(n);
+    for (int i = 0; i < n; ++i) values(i) = n * std::pow(ratio, i);
+    return values;
+}
+
+/**
+ * \brief Writes a text to a file, replacing it.
+ */
+inline void writeFile(const std::string& filename, const std::string& text) {
+    std::ofstream file(filename, std::ios::binary);
+    file << text;
+}
+
+/**
+ * \brief Returns the whole content of a file, or an empty string if it cannot be read.
+ */
+inline std::string readFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    std::ostringstream text;
+    text << file.rdbuf();
+    return text.str();
+}
+
+/**
+ * \brief Creates a new empty directory /tmp/pcsc_test_<name>_<pid>_XXXXXX for the files of a test.
+ * \param name The name of the test.
+ * \return The path of the directory.
+ * \throws std::runtime_error If the directory cannot be created.
+ */
+inline std::string temporaryDirectory(const std::string& name) {
+    std::string pattern = "/tmp/pcsc_test_" + name + "_" + std::to_string(getpid()) + "_XXXXXX";
+    std::vector<char> path(pattern.begin(), pattern.end());
+    path.push_back('\0');
+    if (!mkdtemp(path.data())) throw std::runtime_error("Cannot create a temporary directory");
+    return path.data();
+}
+
+#endif // TESTHELPERS_H
@@ -2,6 +2,7 @@
 #define TESTFILEREADER_H
 
 #include "Reader.h"
+#include "TextMatrixParser.h"
 #include <Eigen/Dense>
 #include <string>
 #include <complex>
@@ -15,6 +16,7 @@
  * whitespace (spaces or tabs) and rows are delimited by newlines. It must robustly handle inconsistent
  * spacing and convert the resulting string tokens into the appropriate numeric type (\c Scalar).
  * This reader is often simpler to use than \c CSVReader for dense, regular matrices.
+ * The file is mapped once by the constructor and parsed by a \c TextMatrixParser.
  *
  *
  * \ingroup IO
@@ -51,20 +53,34 @@ public:
 
     /**
      * \brief Reads and parses the matrix data from the text file.
-     * \details This is the core reading method. It opens the file, reads line by line, uses string streams
-     * to tokenize the data based on whitespace, and converts each token to the \c Scalar type to build the matrix.
+     * \details This is the core reading method. The rows are parsed from the mapped file straight into
+     * the matrix, with values separated by whitespace or commas.
      * \return The matrix read from the text file as an \c Eigen::Matrix<Scalar, ...>.
      * \throw std::runtime_error If the file is inaccessible or contains non-numeric data.
      */
     virtual Matrix ReadMatrix() override;
 
+    /**
+     * \brief Reads the matrix B of a generalized problem, stored after a \c MatrixB line.
+     * \return The matrix B, or an empty matrix if the file has no \c MatrixB section.
+     */
+    virtual Matrix ReadMatrixB() override;
+
+    /**
+     * \brief Counts the rows of the main matrix; the lines are not parsed.
+     */
+    virtual long CountMatrixRows() override;
+
+    /**
+     * \brief Parses only the rows \c firstRow .. \c firstRow + \c rowCount - 1 of the main matrix.
+     */
+    virtual Matrix ReadMatrixRows(long firstRow, long rowCount) override;
+
 private:
     /**
-     * \brief Utility function to remove leading and trailing whitespace from a string.
-     * \param str The string to be trimmed.
-     * \return The trimmed string.
+     * \brief Parser over the mapped file, shared by the matrix and parameter readers.
      */
-    std::string trim(const std::string& str);
+    TextMatrixParser mParser;
 };
 
 // --- Type aliases documentation ---
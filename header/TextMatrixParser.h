@@ -0,0 +1,213 @@
+#ifndef TEXTMATRIXPARSER_H
+#define TEXTMATRIXPARSER_H
+
+#include "MappedFile.h"
+#include "Parameters.h"
+#include <Eigen/Dense>
+#include <complex>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * \brief Volume and time of the work of a \c TextMatrixParser, per thread.
+ */
+struct TextParseTimings {
+    /**
+     * \brief Time spent indexing the rows of the file (and decompressing it), in the constructor.
+     */
+    double indexSeconds = 0.0;
+
+    /**
+     * \brief Size of the compressed file, 0 for a plain file.
+     */
+    std::size_t compressedBytes = 0;
+
+    /**
+     * \brief Wall time of the last call to \c parse().
+     */
+    double parseSeconds = 0.0;
+
+    /**
+     * \brief Rows parsed by each thread during the last call to \c parse().
+     */
+    std::vector<long> threadRows;
+
+    /**
+     * \brief Bytes of row text parsed by each thread during the last call to \c parse().
+     */
+    std::vector<std::size_t> threadBytes;
+
+    /**
+     * \brief Time spent by each thread during the last call to \c parse().
+     */
+    std::vector<double> threadSeconds;
+};
+
+/**
+ * \class TextMatrixParser
+ * \brief Parser shared by \c CSVReader and \c TextFileReader, working on the file mapped in memory.
+ *
+ * \details The constructor maps the file and scans it once, line by line, looking only at the first character of
+ * each line: lines starting with a letter may begin the \c MatrixB or the parameter section, every other non-blank
+ * line is a matrix row whose offset is recorded. The rows are then parsed on demand with \c std::from_chars,
+ * straight into a matrix allocated at its final size: no line copies, no stream, no intermediate
+ * \c vector<vector>. The parameters come from the same mapping, so the file is opened only once.
+ *
+ * Values are separated by commas, semicolons or blanks. Every row must have the same number of values.
+ * Complex matrices hold literals such as \c 1.5, \c 1+2i, \c 3-4j, \c -2i or \c (1,2), read by a tokenizer
+ * that reports failures without exceptions; with the \c ComplexPairs parameter, they hold pairs of real columns
+ * (real part, imaginary part) instead.
+ *
+ * Large files are split into chunks at newline boundaries: the chunks are indexed in parallel, then each thread
+ * parses a contiguous block of rows into its own rows of the output matrix and checks their column count. An error
+ * is reported for the first faulty row of the file, whatever thread found it.
+ *
+ * gzip and zstd files, recognized by their first bytes, are never written back to disk uncompressed: a
+ * \c Decompressor inflates them on a background thread, and the constructor appends each chunk of text to an
+ * in-memory buffer and indexes its complete lines while the next chunk is being decompressed. The rows are then
+ * parsed from that buffer exactly as from a mapped file.
+ */
+class TextMatrixParser {
+public:
+    /**
+     * \brief The matrices a file can hold.
+     */
+    enum class Section {
+        /** \brief The main matrix A. */
+        A,
+        /** \brief The matrix B of a generalized problem, after the \c MatrixB line. */
+        B
+    };
+
+    /**
+     * \brief Maps the file and indexes its sections.
+     * \param filename The CSV or text file, possibly compressed with gzip or zstd.
+     * \param threads Maximum number of threads; values below 1 mean \c defaultThreadCount(). Each thread gets at
+     * least \c kMinimumChunkBytes of the file, so small files are handled by the calling thread alone.
+     * \throw std::runtime_error If the file cannot be mapped, or its compressed data is corrupted.
+     */
+    explicit TextMatrixParser(const std::string& filename, int threads = 0);
+
+    /**
+     * \brief Indexes a document held in memory, in the same format as a file.
+     * \param text The uncompressed text, kept by the parser.
+     * \param threads Maximum number of threads, as for a file.
+     */
+    explicit TextMatrixParser(std::vector<char> text, int threads = 0);
+
+    /**
+     * \brief Smallest chunk of the file given to one thread.
+     */
+    static constexpr std::size_t kMinimumChunkBytes = std::size_t(1) << 20;
+
+    /**
+     * \brief Number of rows of a section (0 if absent).
+     */
+    long rows(Section section) const;
+
+    /**
+     * \brief Number of values in the first row of a section (0 if absent).
+     */
+    long cols(Section section) const;
+
+    /**
+     * \brief Parses the rows \c firstRow .. \c firstRow + \c rowCount - 1 of a section.
+     * \param section The matrix to read.
+     * \param firstRow The first wanted row.
+     * \param rowCount The number of rows; -1 for all the rows from \c firstRow.
+     * \return The rows, or an empty matrix if the section has no rows.
+     * \throw std::runtime_error On an invalid value, a row of another length, or rows outside the section.
+     */
+    template<typename Scalar>
+    Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> parse(Section section, long firstRow = 0,
+                                                                  long rowCount = -1);
+
+    /**
+     * \brief Parses the parameter section (from the \c Algorithm line to the end of the file).
+     * \details Each line holds a name and a value separated by a colon, comma, semicolon or blanks.
+     * Unknown names are ignored.
+     */
+    Parameters parameters() const;
+
+    /**
+     * \brief Size of the text in bytes (decompressed).
+     */
+    std::size_t size() const { return mSize; }
+
+    /**
+     * \brief Timings of the indexing and of the last parse.
+     */
+    const TextParseTimings& getTimings() const { return mTimings; }
+
+    /**
+     * \brief Prints the throughput of the last parse, in total and per thread, in MB/s.
+     */
+    void reportTimings(std::ostream& out) const;
+
+private:
+    /**
+     * \brief Decompresses the file into \c mBuffer, indexing its lines as they arrive.
+     */
+    void loadCompressed(const std::string& filename);
+
+    /**
+     * \brief Indexes \c mData in parallel chunks (plain files and in-memory documents).
+     */
+    void indexText();
+
+    /**
+     * \brief Number of threads for \c bytes of text, between 1 and \c mThreads.
+     */
+    int workersFor(std::size_t bytes) const;
+
+    /**
+     * \brief Offsets of the row lines of a section.
+     */
+    const std::vector<std::size_t>& rowOffsets(Section section) const;
+
+    /**
+     * \brief Parses the line starting at \c offset, storing at most \c capacity values.
+     * \tparam Value \c double, or \c std::complex<double> to read complex literals.
+     * \param row Index of the row, for error messages.
+     * \return The number of values on the line (possibly more than \c capacity).
+     * \throw std::runtime_error On an invalid value.
+     */
+    template<typename Value>
+    long parseLine(std::size_t offset, Value* values, long capacity, long row) const;
+
+    /**
+     * \brief The mapped file (plain files), or the decompressed text (compressed files and in-memory documents).
+     */
+    MappedFile mFile;
+    std::vector<char> mBuffer;
+
+    /**
+     * \brief The text: the mapping or the buffer.
+     */
+    const char* mData;
+    std::size_t mSize;
+
+    /**
+     * \brief Offsets of the rows of A and of B.
+     */
+    std::vector<std::size_t> mRowsA, mRowsB;
+
+    /**
+     * \brief Offset of the \c Algorithm line (the size of the file if there is none).
+     */
+    std::size_t mParametersOffset;
+
+    /**
+     * \brief Maximum number of threads.
+     */
+    int mThreads;
+
+    /**
+     * \brief Timings of the indexing and of the last parse.
+     */
+    TextParseTimings mTimings;
+};
+
+#endif // TEXTMATRIXPARSER_H
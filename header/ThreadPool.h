@@ -0,0 +1,144 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * \class ThreadPool
+ * \brief Fixed set of worker threads that repeatedly run the same kind of fork-join task.
+ *
+ * \details Unlike \c parallelFor, which starts new threads at every call, the workers of a \c ThreadPool live as
+ * long as the pool. This matters for iterative solvers, which issue one parallel matrix-vector product per
+ * iteration: the product of a moderately sized matrix takes less time than creating the threads. Each call to
+ * \c run() hands the task to every worker and returns once all of them have finished. The calling thread takes
+ * part as worker 0, so a pool of size 1 starts no thread at all.
+ *
+ * With \c pinThreads, worker \c t >= 1 is bound to one CPU, the CPUs being spread evenly over the machine and
+ * shifted by one for each new pool, so that concurrent pools use different CPUs. Combined with first-touch
+ * allocation (memory written first by a worker is placed on the NUMA node of that worker), this keeps the data of
+ * each worker on its own memory controller. The calling thread (worker 0) keeps its affinity.
+ * \sa RowPartitionedMatrix
+ */
+class ThreadPool {
+public:
+    /**
+     * \brief Starts the workers.
+     * \param threads Number of workers including the caller; values below 1 mean \c defaultThreadCount().
+     * \param pinThreads Bind each worker to a CPU (Linux only, ignored elsewhere).
+     */
+    explicit ThreadPool(int threads = 0, bool pinThreads = false);
+
+    /**
+     * \brief Stops and joins the workers.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * \brief Number of workers, including the calling thread.
+     */
+    int size() const { return mThreads; }
+
+    /**
+     * \brief Runs \c task(t) on every worker t in [0, size()) and waits for all of them.
+     * \details Not reentrant: \c task must not call \c run() on the same pool. The task is passed by reference
+     * to the workers, never copied or wrapped, so that a call does not allocate (a \c std::function built from a
+     * lambda with several captures would, at every product of an iterative solver).
+     * \param task Callable taking the worker index.
+     */
+    template<typename Task>
+    void run(const Task& task) {
+        runTask(&invokeTask<Task>, &task);
+    }
+
+private:
+    /**
+     * \brief Calls the task at \c task, of type \c Task, for the worker \c index.
+     */
+    template<typename Task>
+    static void invokeTask(const void* task, int index) {
+        (*static_cast<const Task*>(task))(index);
+    }
+
+    /**
+     * \brief Type-erased \c run(): hands \c invoke and \c task to the workers, runs worker 0 and waits.
+     */
+    void runTask(void (*invoke)(const void*, int), const void* task);
+
+    /**
+     * \brief Loop of the worker \c index: waits for a new task generation, runs it, reports completion.
+     */
+    void workerLoop(int index);
+
+    /**
+     * \brief Number of workers, including the calling thread.
+     */
+    int mThreads;
+
+    /**
+     * \brief Whether the workers are bound to CPUs.
+     */
+    bool mPinThreads;
+
+    /**
+     * \brief Shift of the CPUs of this pool, when pinned.
+     */
+    int mPinOffset;
+
+    /**
+     * \brief Worker threads 1..mThreads-1.
+     */
+    std::vector<std::thread> mWorkers;
+
+    /**
+     * \brief Protects the task, the generation counter and the pending count.
+     */
+    std::mutex mMutex;
+
+    /**
+     * \brief Signals a new task (or the shutdown) to the workers.
+     */
+    std::condition_variable mStart;
+
+    /**
+     * \brief Signals the caller that the last worker finished.
+     */
+    std::condition_variable mDone;
+
+    /**
+     * \brief The task of the current generation and the function calling it.
+     */
+    const void* mTask;
+    void (*mInvoke)(const void*, int);
+
+    /**
+     * \brief Incremented at each call to \c run().
+     */
+    unsigned long mGeneration;
+
+    /**
+     * \brief Workers that did not finish the current task yet.
+     */
+    int mPending;
+
+    /**
+     * \brief Set by the destructor to stop the workers.
+     */
+    bool mStop;
+};
+
+/**
+ * \brief Binds the calling thread to the CPU of worker \c index out of \c count.
+ * \details The CPUs are spread evenly, so that consecutive workers land on different cores and, on multi-socket
+ * machines where the kernel numbers the CPUs node by node, the workers are split between the NUMA nodes.
+ * \param offset Shift of the CPU numbers (modulo the CPU count), different for each pool.
+ * \return \c false if the platform does not support pinning or the call failed.
+ */
+bool pinCurrentThread(int index, int count, int offset = 0);
+
+#endif // THREADPOOL_H
@@ -0,0 +1,95 @@
+#ifndef TRANSPORT_H
+#define TRANSPORT_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * \class Transport
+ * \brief Abstract message layer between the processes (ranks) of a distributed solver.
+ *
+ * \details A concrete transport only has to move bytes between two ranks (\c send, \c receive). The collective
+ * operations used by the solvers are built on top of them with rank 0 as a hub: every rank talks to rank 0 only,
+ * which is enough for a handful of processes and keeps implementations small. A transport with a better topology
+ * (ring, tree, RDMA) can override the collectives.
+ *
+ * The transport counts the bytes it moves, so that solvers can report their communication volume.
+ * \sa SocketTransport
+ * \sa DistributedMatrix
+ */
+class Transport {
+public:
+    /**
+     * \brief Virtual destructor.
+     */
+    virtual ~Transport();
+
+    /**
+     * \brief Index of this process, in [0, size()).
+     */
+    virtual int rank() const = 0;
+
+    /**
+     * \brief Number of processes.
+     */
+    virtual int size() const = 0;
+
+    /**
+     * \brief Sends \c bytes bytes to \c peer; returns once they are handed to the transport.
+     * \throw std::runtime_error If the peer is unreachable.
+     */
+    virtual void send(int peer, const void* data, std::size_t bytes) = 0;
+
+    /**
+     * \brief Receives exactly \c bytes bytes from \c peer, blocking until they arrived.
+     * \throw std::runtime_error If the peer closed the connection.
+     */
+    virtual void receive(int peer, void* data, std::size_t bytes) = 0;
+
+    /**
+     * \brief Concatenates the local buffers of all ranks, in rank order, on every rank.
+     * \param local The bytes of this rank (\c bytesPerRank[rank()] of them).
+     * \param global Receives the concatenation (sum of \c bytesPerRank).
+     * \param bytesPerRank Size of the contribution of each rank.
+     */
+    virtual void allGather(const void* local, void* global, const std::vector<std::size_t>& bytesPerRank);
+
+    /**
+     * \brief Replaces \c values on every rank by their sum over all ranks.
+     * \details The sum is formed on rank 0 in rank order, so every rank gets bitwise the same result.
+     */
+    virtual void allReduceSum(double* values, int count);
+
+    /**
+     * \brief Copies \c bytes bytes from rank 0 to every rank.
+     */
+    virtual void broadcast(void* data, std::size_t bytes);
+
+    /**
+     * \brief Returns once every rank called it.
+     */
+    void barrier();
+
+    /**
+     * \brief Number of bytes sent by this rank so far.
+     */
+    std::size_t getBytesSent() const { return mBytesSent; }
+
+    /**
+     * \brief Number of bytes received by this rank so far.
+     */
+    std::size_t getBytesReceived() const { return mBytesReceived; }
+
+protected:
+    /**
+     * \brief Bytes sent, to be updated by \c send().
+     */
+    std::size_t mBytesSent = 0;
+
+    /**
+     * \brief Bytes received, to be updated by \c receive().
+     */
+    std::size_t mBytesReceived = 0;
+};
+
+#endif // TRANSPORT_H
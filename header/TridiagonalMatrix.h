@@ -0,0 +1,102 @@
+#ifndef TRIDIAGONALMATRIX_H
+#define TRIDIAGONALMATRIX_H
+
+#include <Eigen/Dense>
+
+/**
+ * \class TridiagonalMatrix
+ * \brief Compact storage of a real tridiagonal matrix as three vectors.
+ *
+ * \details A tridiagonal matrix of size n is stored as its sub-diagonal (n-1 entries), its diagonal
+ * (n entries) and its super-diagonal (n-1 entries), so that a matrix with n = 10^6 takes a few
+ * megabytes instead of the terabytes of its dense form. It is the input of \c BisectionMethod.
+ * \sa BisectionMethod
+ * \sa TridiagonalReader
+ */
+class TridiagonalMatrix {
+public:
+    /**
+     * \brief Default constructor. Builds an empty (0x0) matrix.
+     */
+    TridiagonalMatrix();
+
+    /**
+     * \brief Builds the matrix from its three diagonals.
+     * \param lower The sub-diagonal, entries T(i+1, i).
+     * \param diagonal The main diagonal, entries T(i, i).
+     * \param upper The super-diagonal, entries T(i, i+1).
+     * \throw std::invalid_argument If the sizes of the three vectors do not match.
+     */
+    TridiagonalMatrix(const Eigen::VectorXd& lower,
+                      const Eigen::VectorXd& diagonal,
+                      const Eigen::VectorXd& upper);
+
+    /**
+     * \brief Extracts the three diagonals of a dense square matrix (all other entries are ignored).
+     * \param matrix The dense matrix.
+     * \return The tridiagonal part of \c matrix.
+     */
+    static TridiagonalMatrix fromDense(const Eigen::MatrixXd& matrix);
+
+    /**
+     * \brief Gets the dimension n of the matrix.
+     */
+    int size() const { return static_cast<int>(mDiagonal.size()); }
+
+    /**
+     * \brief Gets the sub-diagonal.
+     */
+    const Eigen::VectorXd& getLower() const { return mLower; }
+
+    /**
+     * \brief Gets the main diagonal.
+     */
+    const Eigen::VectorXd& getDiagonal() const { return mDiagonal; }
+
+    /**
+     * \brief Gets the super-diagonal.
+     */
+    const Eigen::VectorXd& getUpper() const { return mUpper; }
+
+    /**
+     * \brief Checks whether the matrix is symmetric (lower == upper).
+     */
+    bool isSymmetric() const;
+
+    /**
+     * \brief Checks whether the matrix is similar to a symmetric one through a diagonal scaling.
+     * \details This holds when \c lower(i) * \c upper(i) >= 0 for every i, with both zero or both non-zero.
+     * Only such matrices have a real spectrum that Sturm sequences can count.
+     */
+    bool isSymmetrizable() const;
+
+    /**
+     * \brief Computes the product T * x in O(n).
+     * \param x The vector to multiply.
+     * \return The product.
+     */
+    Eigen::VectorXd multiply(const Eigen::VectorXd& x) const;
+
+    /**
+     * \brief Builds the dense form of the matrix. Only meant for small matrices.
+     */
+    Eigen::MatrixXd toDense() const;
+
+private:
+    /**
+     * \brief Sub-diagonal entries T(i+1, i).
+     */
+    Eigen::VectorXd mLower;
+
+    /**
+     * \brief Diagonal entries T(i, i).
+     */
+    Eigen::VectorXd mDiagonal;
+
+    /**
+     * \brief Super-diagonal entries T(i, i+1).
+     */
+    Eigen::VectorXd mUpper;
+};
+
+#endif // TRIDIAGONALMATRIX_H
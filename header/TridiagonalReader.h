@@ -0,0 +1,73 @@
+#ifndef TRIDIAGONALREADER_H
+#define TRIDIAGONALREADER_H
+
+#include "Reader.h"
+#include "TridiagonalMatrix.h"
+#include <Eigen/Dense>
+#include <string>
+
+/**
+ * \class TridiagonalReader
+ * \brief Implements the Reader interface for tridiagonal matrices stored as three labelled vectors.
+ *
+ * \details Instead of the n rows of a dense matrix, the file holds one line per diagonal, each starting
+ * with its label, followed by the usual parameter section:
+ * \code
+ * Lower,-1,-1
+ * Diagonal,2,2,2
+ * Upper,-1,-1
+ * Algorithm,BisectionMethod
+ * IndexLow,1
+ * IndexHigh,2
+ * \endcode
+ * Values may be separated by commas, semicolons or whitespace. If the \c Upper line is missing the matrix is
+ * taken as symmetric. The file can be a \c .csv, \c .txt or \c .dat file.
+ *
+ * \ingroup IO
+ * \sa Reader
+ * \sa TridiagonalMatrix
+ * \sa BisectionMethod
+ */
+class TridiagonalReader : public Reader<double> {
+public:
+    /**
+     * \brief Constructs a TridiagonalReader object, associating it with the specified file path.
+     * \param filename The path to the file containing the three diagonals.
+     */
+    TridiagonalReader(const std::string& filename);
+
+    /**
+     * \brief Destructor for TridiagonalReader.
+     */
+    ~TridiagonalReader() override;
+
+    /**
+     * \brief Checks whether a file holds labelled diagonals: its first non-blank line starts with \c Lower,
+     * \c Diagonal or \c Upper.
+     * \param filename The path of the file.
+     * \return false if the file cannot be opened or holds a dense matrix.
+     */
+    static bool isTridiagonalFile(const std::string& filename);
+
+    /**
+     * \brief Reads the three diagonals from the file.
+     * \return The tridiagonal matrix.
+     * \throw std::runtime_error If the file cannot be opened, a diagonal is missing or the sizes do not match.
+     */
+    TridiagonalMatrix ReadTridiagonal();
+
+    /**
+     * \brief Reads the matrix and expands it to its dense form.
+     * \details Only meant for small matrices, e.g. to cross-check \c BisectionMethod against \c QRMethod.
+     * \return The dense matrix.
+     */
+    Matrix ReadMatrix() override;
+
+    /**
+     * \brief Reads configuration parameters from the parameter section of the file.
+     * \return A \c Parameters object populated with configuration settings.
+     */
+    Parameters ReadParameters() override;
+};
+
+#endif // TRIDIAGONALREADER_H
@@ -0,0 +1,198 @@
+#ifndef TRUNCATEDSVD_H
+#define TRUNCATEDSVD_H
+
+#include <Eigen/Dense>
+#include <complex>
+#include "Parameters.h"
+#include "SolverStats.h"
+
+/**
+ * \tparam Scalar The underlying numeric type of the matrix elements (e.g., \c double, \c std::complex<double>).
+ * \class TruncatedSVD
+ * \brief Computes the k largest singular triplets of a rectangular matrix by restarted Golub-Kahan-Lanczos
+ * bidiagonalization.
+ *
+ * \details The method builds orthonormal bases $U_p$, $V_p$ with $A V_p = U_p B_p$, where $B_p$ is a small
+ * p x p upper triangular (bidiagonal before the first restart) matrix, using only products with A and $A^H$.
+ * The singular values of $B_p$ approximate the largest singular values of A. When they are not yet accurate,
+ * the method is restarted from the k best Ritz vectors (thick restart), which keeps the memory at p vectors of
+ * each side. Unlike forming $A^H A$ and running \c PowerMethod on it, the condition number is not squared and
+ * no O(mn^2) product is needed.
+ *
+ * Solvers of the \c Eigenvalue hierarchy require a square matrix; this class is the one to use for rectangular
+ * inputs.
+ * \sa PowerMethod
+ */
+template<typename Scalar>
+class TruncatedSVD {
+public:
+    /**
+     * \brief Type alias for the matrix type used by the solver.
+     */
+    using Matrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+
+    /**
+     * \brief Type alias for the vector type used by the solver.
+     */
+    using Vector = Eigen::Matrix<Scalar, Eigen::Dynamic, 1>;
+
+    /**
+     * \brief Real type of the singular values.
+     */
+    using RealScalar = typename Eigen::NumTraits<Scalar>::Real;
+
+    /**
+     * \brief Type alias for the vector of singular values.
+     */
+    using RealVector = Eigen::Matrix<RealScalar, Eigen::Dynamic, 1>;
+
+    /**
+     * \brief Constructs the solver.
+     * \details The number k of wanted triplets is \c params.getNumValues(), the tolerance is relative to the
+     * largest singular value and the maximum number of iterations bounds the number of restarts.
+     * \param matrix The m x n input matrix (any shape).
+     * \param params A structure containing the configuration settings.
+     */
+    TruncatedSVD(const Matrix& matrix, const Parameters& params);
+
+    /**
+     * \brief Destructor for TruncatedSVD.
+     */
+    virtual ~TruncatedSVD();
+
+    /**
+     * \brief Sets the number k of wanted singular triplets.
+     */
+    void setNumValues(int numValues);
+
+    /**
+     * \brief Sets the size p of the Krylov subspaces (default max(2k, k + 10), bounded by min(m, n)).
+     */
+    void setSubspaceSize(int subspaceSize);
+
+    /**
+     * \brief Runs the restarted bidiagonalization.
+     * \post \c getSingularValues() holds the k largest singular values in decreasing order and the two getters
+     * of singular vectors the matching unit vectors as columns.
+     */
+    void solve();
+
+    /**
+     * \brief Retrieves the computed singular values, in decreasing order.
+     */
+    RealVector getSingularValues() const { return mSingularValues; }
+
+    /**
+     * \brief Retrieves the left singular vectors (m x k).
+     */
+    Matrix getLeftSingularVectors() const { return mLeftVectors; }
+
+    /**
+     * \brief Retrieves the right singular vectors (n x k).
+     */
+    Matrix getRightSingularVectors() const { return mRightVectors; }
+
+    /**
+     * \brief Checks whether all k residuals reached the tolerance.
+     */
+    bool hasConverged() const { return mConverged; }
+
+    /**
+     * \brief Retrieves the number of restart cycles used.
+     */
+    int getIterationCount() const { return mIterationCount; }
+
+    /**
+     * \brief Retrieves the number of products with A or $A^H$ performed.
+     */
+    long getProductCount() const { return mProductCount; }
+
+    /**
+     * \brief Retrieves the statistics of the last call to \c solve(), as \c Eigenvalue::getStats(); the residual is
+     * the largest relative residual of the k triplets at the last restart.
+     */
+    const SolverStats& getStats() const { return mStats; }
+
+private:
+    /**
+     * \brief Fills \c column with a random unit vector orthogonal to the first \c count columns of \c basis.
+     */
+    void randomOrthogonal(const Matrix& basis, int count, Eigen::Ref<Vector> column);
+
+    /**
+     * \brief The input matrix A.
+     */
+    Matrix mMatrix;
+
+    /**
+     * \brief Number k of wanted triplets.
+     */
+    int mNumValues;
+
+    /**
+     * \brief Requested subspace size (0 for the default).
+     */
+    int mSubspaceSize;
+
+    /**
+     * \brief Relative tolerance on the residuals.
+     */
+    double mTolerance;
+
+    /**
+     * \brief Maximum number of restart cycles.
+     */
+    int mMaxIteration;
+
+    /**
+     * \brief Flag to track if the residuals reached the tolerance.
+     */
+    bool mConverged;
+
+    /**
+     * \brief Number of restart cycles used.
+     */
+    int mIterationCount;
+
+    /**
+     * \brief Number of products with A or A^H.
+     */
+    long mProductCount;
+
+    /**
+     * \brief Statistics of the last call to \c solve().
+     */
+    SolverStats mStats;
+
+    /**
+     * \brief Seed of the random vectors, advanced at each use.
+     */
+    unsigned int mSeed;
+
+    /**
+     * \brief The computed singular values.
+     */
+    RealVector mSingularValues;
+
+    /**
+     * \brief The computed left singular vectors.
+     */
+    Matrix mLeftVectors;
+
+    /**
+     * \brief The computed right singular vectors.
+     */
+    Matrix mRightVectors;
+};
+
+/**
+ * \brief Type alias for the truncated SVD of real matrices.
+ */
+using TruncatedSVDReal = TruncatedSVD<double>;
+
+/**
+ * \brief Type alias for the truncated SVD of complex matrices.
+ */
+using TruncatedSVDComplex = TruncatedSVD<std::complex<double>>;
+
+#endif // TRUNCATEDSVD_H
@@ -0,0 +1,116 @@
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * \class WorkStealingPool
+ * \brief Set of worker threads running independent tasks of very different lengths.
+ *
+ * \details Where \c ThreadPool runs one fork-join task on every worker, this pool runs a queue of separate
+ * tasks, such as the jobs of a batch. Every worker owns a deque: tasks submitted from outside the pool are dealt
+ * to the deques in turn, and a task submitted by a worker goes to its own deque. A worker takes the tasks of its
+ * deque in submission order; when it runs dry it steals from the back of another deque, where the most recently
+ * submitted tasks are. Submitting the longest tasks first therefore starts them early, while the workers that
+ * finish their share take the short tasks left at the back of the others, so no worker ends up alone with a
+ * backlog.
+ *
+ * The calling thread does not run tasks: \c wait() blocks until all the submitted tasks have finished.
+ */
+class WorkStealingPool {
+public:
+    /**
+     * \brief Starts the workers.
+     * \param threads Number of workers; values below 1 mean \c defaultThreadCount().
+     */
+    explicit WorkStealingPool(int threads = 0);
+
+    /**
+     * \brief Waits for the submitted tasks, then stops and joins the workers.
+     */
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    /**
+     * \brief Number of workers.
+     */
+    int size() const { return static_cast<int>(mWorkers.size()); }
+
+    /**
+     * \brief Queues a task; it may start at once.
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * \brief Waits until every submitted task has finished.
+     * \throw The first exception thrown by a task since the last call, once all tasks have finished.
+     */
+    void wait();
+
+    /**
+     * \brief Number of tasks run by another worker than the one they were dealt to.
+     */
+    long stolenCount() const { return mStolen.load(); }
+
+private:
+    /**
+     * \brief The deque of a worker, with its lock.
+     */
+    struct TaskDeque {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    /**
+     * \brief Loop of the worker \c index: runs its own tasks, steals when it has none, sleeps when nobody has any.
+     */
+    void workerLoop(int index);
+
+    /**
+     * \brief Takes the oldest task of the worker's deque, or steals the newest task of another deque.
+     */
+    bool take(int index, std::function<void()>& task);
+
+    std::vector<std::unique_ptr<TaskDeque>> mDeques;
+    std::vector<std::thread> mWorkers;
+
+    /**
+     * \brief Protects the counters and the first error; signals new tasks and the end of the last one.
+     */
+    std::mutex mMutex;
+    std::condition_variable mWork, mIdle;
+
+    /**
+     * \brief Tasks waiting in the deques, and tasks submitted but not finished.
+     */
+    long mQueued, mPending;
+
+    /**
+     * \brief Set by the destructor to stop the workers.
+     */
+    bool mStopping;
+
+    /**
+     * \brief First exception thrown by a task, rethrown by \c wait().
+     */
+    std::exception_ptr mError;
+
+    /**
+     * \brief Next deque for a task submitted from outside the pool.
+     */
+    std::atomic<unsigned> mNext;
+
+    std::atomic<long> mStolen;
+};
+
+#endif // WORKSTEALINGPOOL_H
@@ -4,6 +4,7 @@
 #include <string>
 #include <complex>
 #include <Eigen/Dense>
+#include "SolverStats.h"
 
 /**
  * \class Writer
@@ -16,6 +17,12 @@
  * 2. Full set of eigenvalues/eigenvectors (real or complex).
  * * All derived classes must implement all four \c write signatures to correctly handle any solver result.
  *
+ * The text writers format numbers with \c std::to_chars into large buffers (see \c OutputBuffer) and write each
+ * buffer in one call; the eigenvector matrices of large results are formatted in parallel, in blocks of lines
+ * written in order, so the files are the same as with a single thread.
+ *
+ * When \c setStats() was called, the statistics of the solve follow the results, as \c Name,Value pairs in the
+ * order of \c SolverStats::fields().
  *
  * \ingroup IO
  */
@@ -26,6 +33,22 @@ protected:
      */
     std::string mFilename;
 
+    /**
+     * \brief Significant digits of the values written as text (6 by default, as \c std::ostream).
+     */
+    int mPrecision;
+
+    /**
+     * \brief Threads formatting large results; values below 1 mean \c defaultThreadCount().
+     */
+    int mThreads;
+
+    /**
+     * \brief Statistics of the solve, written only if \c mHasStats.
+     */
+    SolverStats mStats;
+    bool mHasStats;
+
 public:
     /**
      * \brief Constructor for the Writer base class.
@@ -38,6 +61,24 @@ public:
      */
     virtual ~Writer() = default;
 
+    /**
+     * \brief Sets the significant digits of the values written as text.
+     * \param digits 1 to 17 digits, or 0 for the shortest text that reads back to the same \c double.
+     * The default, 6, gives the same text as \c std::ostream.
+     */
+    void setPrecision(int digits);
+
+    /**
+     * \brief Sets the number of threads formatting large results.
+     * \param threads Thread count; values below 1 mean \c defaultThreadCount().
+     */
+    void setThreads(int threads);
+
+    /**
+     * \brief Sets the statistics of the solve, written with the next results.
+     */
+    void setStats(const SolverStats& stats);
+
 
     // --- Single Result Write Methods (For Power Methods, etc.) ---
 
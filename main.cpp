@@ -2,35 +2,329 @@
 #include "ShiftedInversePowerMethod.h"
 #include "CSVReader.h"
 #include "TextFileReader.h"
+#include "BinaryReader.h"
+#include "MatrixMarketReader.h"
+#include "NumpyReader.h"
+#include "NumpyWriter.h"
+#include "BinaryWriter.h"
 #include "QRMethod.h"
+#include "BisectionMethod.h"
+#include "TridiagonalReader.h"
+#include "DistributedPowerMethod.h"
+#include "StreamingPowerMethod.h"
+#include "SocketTransport.h"
+#include "SolvePipeline.h"
+#include "BatchRunner.h"
+#include "SolverServer.h"
+#include "SolverClient.h"
+#include "SolveJob.h"
 #include "Writer.h"
+#include "PlotWriter.h"
 #include "Parameters.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
 #include <iostream>
 #include <string>
+#include <csignal>
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
 
 // ====================================
-// FONCTION pour traiter avec double
+// Options de la ligne de commande (prioritaires sur le fichier d'entrée)
 // ====================================
-void runComputationDouble(const std::string& inputFile) {
+struct CommandLineOptions {
+    std::string inputFile;
+    int threads = -1;          // -1: keep the value of the input file
+    bool pinThreads = false;
+    int ranks = 1;             // > 1: distributed Power Method
+    int rank = -1;             // -1: start all the ranks on this machine
+    std::string address;       // unix:PATH or tcp:HOST:PORT of rank 0
+    std::string convertTo;     // non-empty: write the input as a binary matrix (or .npy) file and stop
+    std::string stream;        // non-empty: solve every document of this file ("-" for stdin) and stop
+    bool complex = false;      // --type complex (stream and batch modes, no data type question)
+    std::string format = "csv";
+    std::string outputDirectory = "../data";
+    int queueDepth = 2;
+    bool batch = false;        // --batch: solve every input file on a work-stealing pool and stop
+    std::vector<std::string> inputs;
+    std::string algorithm;     // non-empty: replaces the algorithm of the inputs (batch mode)
+    int jobs = 0;              // jobs solved at the same time (batch and server modes), 0: one per core
+    std::string serve;         // non-empty: answer solve requests on this socket until interrupted
+    std::string request;       // non-empty: send the input to the server on this socket and stop
+    int maxPending = 64;       // requests admitted at a time by the server
+    int maxConnections = 256;  // connections open at a time on the server
+    double deadline = 0.0;     // seconds the server may take for the request, 0: no deadline
+    std::string cache;         // non-empty: directory of the result cache (batch and server modes)
+    double cacheMegabytes = 0; // size cap of the cache, 0: none
+    std::string plot;          // non-empty: record the convergence and plot it to this file (CSV without matplotlib)
+    int history = 0;           // iterations recorded for --plot, 0: 10000
+    std::string eigenvectors;  // non-empty: eigenvectors of the QR Method, All, None or 1-based indices
+};
+
+CommandLineOptions parseCommandLine(int argc, char* argv[]) {
+    CommandLineOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (argument == "--threads" && i + 1 < argc) {
+            options.threads = std::stoi(argv[++i]);
+        } else if (argument == "--pin-threads") {
+            options.pinThreads = true;
+        } else if (argument == "--ranks" && i + 1 < argc) {
+            options.ranks = std::stoi(argv[++i]);
+        } else if (argument == "--rank" && i + 1 < argc) {
+            options.rank = std::stoi(argv[++i]);
+        } else if (argument == "--connect" && i + 1 < argc) {
+            options.address = argv[++i];
+        } else if (argument == "--convert" && i + 1 < argc) {
+            options.convertTo = argv[++i];
+        } else if (argument == "--stream" && i + 1 < argc) {
+            options.stream = argv[++i];
+        } else if (argument == "--type" && i + 1 < argc) {
+            std::string type = argv[++i];
+            if (type != "real" && type != "complex") {
+                throw std::runtime_error("Invalid type: " + type + " (real or complex)");
+            }
+            options.complex = type == "complex";
+        } else if (argument == "--format" && i + 1 < argc) {
+            options.format = argv[++i];
+        } else if (argument == "--output-dir" && i + 1 < argc) {
+            options.outputDirectory = argv[++i];
+        } else if (argument == "--queue-depth" && i + 1 < argc) {
+            options.queueDepth = std::stoi(argv[++i]);
+        } else if (argument == "--batch") {
+            options.batch = true;
+        } else if (argument == "--algorithm" && i + 1 < argc) {
+            options.algorithm = argv[++i];
+        } else if (argument == "--jobs" && i + 1 < argc) {
+            options.jobs = std::stoi(argv[++i]);
+        } else if (argument == "--serve" && i + 1 < argc) {
+            options.serve = argv[++i];
+        } else if (argument == "--request" && i + 1 < argc) {
+            options.request = argv[++i];
+        } else if (argument == "--max-pending" && i + 1 < argc) {
+            options.maxPending = std::stoi(argv[++i]);
+        } else if (argument == "--max-connections" && i + 1 < argc) {
+            options.maxConnections = std::stoi(argv[++i]);
+        } else if (argument == "--deadline" && i + 1 < argc) {
+            options.deadline = std::stod(argv[++i]);
+        } else if (argument == "--cache" && i + 1 < argc) {
+            options.cache = argv[++i];
+        } else if (argument == "--cache-size" && i + 1 < argc) {
+            options.cacheMegabytes = std::stod(argv[++i]);
+        } else if (argument == "--plot" && i + 1 < argc) {
+            options.plot = argv[++i];
+        } else if (argument == "--history" && i + 1 < argc) {
+            options.history = std::stoi(argv[++i]);
+        } else if (argument == "--eigenvectors" && i + 1 < argc) {
+            // "1,3" on the command line, "1 3" in the input files
+            options.eigenvectors = argv[++i];
+            std::replace(options.eigenvectors.begin(), options.eigenvectors.end(), ',', ' ');
+        } else if (argument.rfind("--", 0) == 0) {
+            throw std::runtime_error("Unknown option: " + argument);
+        } else {
+            options.inputs.push_back(argument);
+        }
+    }
+    if (!options.inputs.empty()) {
+        options.inputFile = options.inputs[0];
+    }
+    return options;
+}
 
-    //Read Matrix
-    Eigen::MatrixXd matrix;
+void applyCommandLine(const CommandLineOptions& options, Parameters& params) {
+    if (options.threads >= 0) {
+        params.setThreads(options.threads);
+    }
+    if (options.pinThreads) {
+        params.setPinThreads(true);
+    }
+    if (!options.plot.empty()) {
+        params.setHistoryCapacity(options.history > 0 ? options.history : 10000);
+    }
+    if (!options.eigenvectors.empty()) {
+        params.setEigenvectors(options.eigenvectors);
+    }
+}
+
+// ====================================
+// Résolution chronométrée : la durée est notée dans les métadonnées du format binaire, les statistiques
+// du solveur sont affichées et écrites avec les résultats
+// ====================================
+template<typename Solver>
+void solveTimed(Solver& solver, Writer* writer) {
+    auto start = std::chrono::steady_clock::now();
+    solver.solve();
+    if (BinaryWriter* binary = dynamic_cast<BinaryWriter*>(writer)) {
+        binary->setTiming("Solve", std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    writer->setStats(solver.getStats());
+    std::cout << "\nSolver statistics" << std::endl;
+    printStats(std::cout, solver.getStats());
+}
+
+// ====================================
+// Affichage d'un résultat de solveProblem() ; avec --plot, les courbes de convergence des solveurs
+// itératifs sont tracées
+// ====================================
+template<typename Scalar>
+void printResult(const SolveResult<Scalar>& result, const Parameters& params, const std::string& plotFile) {
+    const bool svd = params.getAlgorithm() == "TruncatedSVD";
+    std::cout << "\nSolver statistics" << std::endl;
+    printStats(std::cout, result.stats);
+
+    std::cout << "\nResults (" << params.getAlgorithm() << ")" << std::endl;
+    if (result.single) {
+        std::cout << "Eigenvalue: " << result.eigenvalues(0) << std::endl;
+    }
+    std::cout << (svd ? "Restart cycles: " : "Iterations: ") << result.iterations << std::endl;
+    std::cout << "Converged: " << (result.converged ? "Yes" : "No") << std::endl;
+
+    if (!result.single) {
+        // Afficher TOUTES les valeurs propres trouvées
+        std::cout << (svd ? "\nLargest singular values:" : "\nAll Eigenvalues found:") << std::endl;
+        for (int i = 0; i < result.eigenvalues.size(); ++i) {
+            if (svd) {
+                std::cout << "  σ" << (i+1) << " = " << std::real(result.eigenvalues(i)) << std::endl;
+            } else {
+                std::cout << "  λ" << (i+1) << " = " << result.eigenvalues(i) << std::endl;
+            }
+        }
+    }
+    if (!result.single && !svd) {
+        for (int i = 0; i < result.eigenvectors.cols(); ++i) {
+            if (i == 0) std::cout << "\nAll Eigenvectors:" << std::endl;
+            if (result.eigenvectors.col(i).isZero(0)) continue; // not in --eigenvectors
+            std::cout << "\n  v_" << (i+1) << " =" << std::endl;
+            for (int j = 0; j < result.eigenvectors.rows(); ++j) {
+                std::cout << "    " << result.eigenvectors(j, i) << std::endl;
+            }
+        }
+    }
+
+    if (!plotFile.empty() && result.history.isEnabled()) {
+        PlotWriter plot(plotFile);
+        plot.setHistory(result.history);
+        writeResult(result, plot);
+    }
+}
+
+// ====================================
+// FONCTION pour le mode distribué (Power Method, matrices réelles)
+// ====================================
+void runDistributedRank(const CommandLineOptions& options, int rank) {
     Parameters params;
+    std::unique_ptr<Reader<double>> reader;
+    if (options.inputFile.find(".bmat") != std::string::npos) {
+        reader.reset(new BinaryReader<double>(options.inputFile));
+    } else if (options.inputFile.find(".mtx") != std::string::npos) {
+        reader.reset(new MatrixMarketReader<double>(options.inputFile));
+    } else if (options.inputFile.find(".npy") != std::string::npos || options.inputFile.find(".npz") != std::string::npos) {
+        reader.reset(new NumpyReader<double>(options.inputFile));
+    } else if (options.inputFile.find(".csv") != std::string::npos) {
+        reader.reset(new CSVReader<double>(options.inputFile));
+    } else {
+        reader.reset(new TextFileReader<double>(options.inputFile));
+    }
+    params = reader->ReadParameters();
+    applyCommandLine(options, params);
+    if (params.getAlgorithm() != "PowerMethod") {
+        throw std::runtime_error("The distributed mode only supports PowerMethod");
+    }
+    if (!params.validate()) {
+        throw std::runtime_error("Invalid parameters!");
+    }
 
-    if (inputFile.find(".csv") != std::string::npos) {
-        CSVReader<double> reader(inputFile);
-        matrix = reader.ReadMatrix();
-        params = reader.ReadParameters();
+    // Each rank only reads its own rows
+    SocketTransport transport(options.address, rank, options.ranks);
+    DistributedMatrix<double> matrix = DistributedMatrix<double>::fromReader(*reader, transport);
+    DistributedPowerMethod<double> pm(matrix, params);
+    pm.solve();
+    pm.reportTimings(std::cout);
+    if (rank != 0) {
+        return;
+    }
+
+    std::cout << "\nResults (Distributed Power Method, " << options.ranks << " ranks)" << std::endl;
+    std::cout << "Eigenvalue: " << pm.getEigenvalue() << std::endl;
+    std::cout << "Iterations: " << pm.getIterationCount() << std::endl;
+    std::cout << "Converged: " << (pm.hasConverged() ? "Yes" : "No") << std::endl;
+
+    std::cout << "  SELECT OUTPUT FORMAT" << std::endl;
+    std::cout << "1 - CSV format (.csv)" << std::endl;
+    std::cout << "2 - Text format (.txt)" << std::endl;
+    std::cout << "3 - NumPy archive (.npz)" << std::endl;
+    std::cout << "4 - Binary result (.bres)" << std::endl;
+    std::cout << "\nYour choice [1, 2, 3 or 4]: ";
+    int outputChoice;
+    std::cin >> outputChoice;
+
+    std::string outputFile = outputChoice == 1 ? "../data/result.csv" :
+                             outputChoice == 3 ? "../data/result.npz" :
+                             outputChoice == 4 ? "../data/result.bres" : "../data/result.txt";
+    std::unique_ptr<Writer> writer;
+    if (outputChoice == 1) {
+        writer.reset(new CSVWriter(outputFile));
+    } else if (outputChoice == 3) {
+        writer.reset(new NumpyWriter(outputFile));
+    } else if (outputChoice == 4) {
+        writer.reset(new BinaryWriter(outputFile, params.getAlgorithm()));
     } else {
-        TextFileReader<double> reader(inputFile);
-        matrix = reader.ReadMatrix();
-        params = reader.ReadParameters();
+        writer.reset(new TextFileWriter(outputFile));
     }
+    writer->write(pm.getEigenvalue(), pm.getEigenvector(), pm.getIterationCount(), pm.hasConverged());
+    std::cout << "\nResults written to: " << outputFile << std::endl;
+}
 
-    std::cout << "\nMatrix size " << matrix.rows() << "x" << matrix.cols() << std::endl;
-    std::cout << "\nMatrix:" << std::endl;
-    std::cout << matrix << std::endl;
+void runDistributed(CommandLineOptions options) {
+    if (options.address.empty()) {
+        options.address = "unix:/tmp/pcsc_project_" + std::to_string(getpid()) + ".sock";
+    }
+    if (options.rank >= 0) {
+        runDistributedRank(options, options.rank);  // one rank of a job started by hand (e.g. one per node)
+        return;
+    }
 
+    // All the ranks on this machine: fork ranks 1..N-1, this process is rank 0
+    std::vector<pid_t> workers;
+    for (int rank = 1; rank < options.ranks; ++rank) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            throw std::runtime_error("fork failed");
+        }
+        if (pid == 0) {
+            int status = 0;
+            try {
+                runDistributedRank(options, rank);
+            } catch (const std::exception& e) {
+                std::cerr << "Rank " << rank << ": " << e.what() << std::endl;
+                status = 1;
+            }
+            std::fflush(nullptr);
+            _exit(status);
+        }
+        workers.push_back(pid);
+    }
+    runDistributedRank(options, 0);
+    for (pid_t pid : workers) {
+        int status = 0;
+        waitpid(pid, &status, 0);
+    }
+}
+
+// ====================================
+// FONCTION pour le mode hors mémoire (la matrice est relue à chaque itération)
+// ====================================
+template<typename Scalar>
+void runOutOfCore(const CommandLineOptions& options, Parameters& params) {
+    applyCommandLine(options, params);
+    if (params.getAlgorithm() != "PowerMethod") {
+        throw std::runtime_error("The out-of-core mode only supports PowerMethod");
+    }
     if (!params.validate()) {
         throw std::runtime_error("Invalid parameters!");
     }
@@ -38,117 +332,329 @@ void runComputationDouble(const std::string& inputFile) {
     std::cout << "\nParameters" << std::endl;
     params.display();
 
-    std::string algorithm = params.getAlgorithm();
+    if (options.inputFile.find(".mtx") != std::string::npos) {
+        throw std::runtime_error("The out-of-core mode does not read Matrix Market files, convert them with --convert");
+    }
+    if (options.inputFile.find(".npy") != std::string::npos || options.inputFile.find(".npz") != std::string::npos) {
+        throw std::runtime_error("The out-of-core mode does not read NumPy files, convert them with --convert");
+    }
+    std::unique_ptr<PanelSource<Scalar>> source;
+    if (options.inputFile.find(".bmat") != std::string::npos) {
+        source.reset(new BinaryPanelSource<Scalar>(options.inputFile, params.getPanelRows()));
+    } else {
+        source.reset(new TextPanelSource<Scalar>(options.inputFile, params.getPanelRows()));
+    }
+    std::cout << "\nStreaming a " << source->rows() << "x" << source->cols() << " matrix in panels of "
+              << source->panelRows() << " rows" << std::endl;
+    StreamingMatrix<Scalar> matrix(*source);
+    StreamingPowerMethod<Scalar> spm(matrix, params);
+    spm.solve();
+    spm.reportTimings(std::cout);
+
+    std::cout << "\nResults (Out-of-core " << (params.getNumValues() > 1 ? "Block Power Iteration" : "Power Method")
+              << ")" << std::endl;
+    std::cout << "Passes over the matrix: " << spm.getIterationCount() << std::endl;
+    std::cout << "Converged: " << (spm.hasConverged() ? "Yes" : "No") << std::endl;
+    auto eigenvalues = spm.getAllEigenvalues();
+    for (int i = 0; i < eigenvalues.size(); ++i) {
+        std::cout << "  λ" << (i+1) << " = " << eigenvalues(i) << std::endl;
+    }
+
+    // Demander le format de sortie
+    std::cout << "  SELECT OUTPUT FORMAT" << std::endl;
+    std::cout << "1 - CSV format (.csv)" << std::endl;
+    std::cout << "2 - Text format (.txt)" << std::endl;
+    std::cout << "3 - NumPy archive (.npz)" << std::endl;
+    std::cout << "4 - Binary result (.bres)" << std::endl;
+    std::cout << "\nYour choice [1, 2, 3 or 4]: ";
+
+    int outputChoice;
+    std::cin >> outputChoice;
+
+    std::string outputFile = outputChoice == 1 ? "../data/result.csv" :
+                             outputChoice == 3 ? "../data/result.npz" :
+                             outputChoice == 4 ? "../data/result.bres" : "../data/result.txt";
+    std::unique_ptr<Writer> writer;
+    if (outputChoice == 1) {
+        writer.reset(new CSVWriter(outputFile));
+    } else if (outputChoice == 3) {
+        writer.reset(new NumpyWriter(outputFile));
+    } else if (outputChoice == 4) {
+        writer.reset(new BinaryWriter(outputFile, params.getAlgorithm()));
+    } else {
+        writer.reset(new TextFileWriter(outputFile));
+    }
 
+    if (eigenvalues.size() == 1) {
+        writer->write(spm.getEigenvalue(), spm.getEigenvector(), spm.getIterationCount(), spm.hasConverged());
+    } else {
+        writer->writeAll(eigenvalues, spm.getAllEigenvectors(), spm.getIterationCount(), spm.hasConverged());
+    }
+    std::cout << "\nResults written to: " << outputFile << std::endl;
+}
 
+// ====================================
+// FONCTION pour traiter les matrices tridiagonales
+// ====================================
+void runComputationTridiagonal(const CommandLineOptions& options) {
 
+    TridiagonalReader reader(options.inputFile);
+    TridiagonalMatrix matrix = reader.ReadTridiagonal();
+    Parameters params = reader.ReadParameters();
+    applyCommandLine(options, params);
+
+    std::cout << "\nTridiagonal matrix size " << matrix.size() << "x" << matrix.size() << std::endl;
+
+    if (!params.validate()) {
+        throw std::runtime_error("Invalid parameters!");
+    }
+
+    std::cout << "\nParameters" << std::endl;
+    params.display();
 
     // Demander le format de sortie
     std::cout << "  SELECT OUTPUT FORMAT" << std::endl;
     std::cout << "1 - CSV format (.csv)" << std::endl;
     std::cout << "2 - Text format (.txt)" << std::endl;
-    std::cout << "\nYour choice [1 or 2]: ";
+    std::cout << "3 - NumPy archive (.npz)" << std::endl;
+    std::cout << "4 - Binary result (.bres)" << std::endl;
+    std::cout << "\nYour choice [1, 2, 3 or 4]: ";
 
     int outputChoice;
     std::cin >> outputChoice;
 
     std::string outputFile;
-    Writer* writer = nullptr; //llms
+    Writer* writer = nullptr;
 
     if (outputChoice == 1) {
         outputFile = "../data/result.csv";
         writer = new CSVWriter(outputFile);
+    } else if (outputChoice == 3) {
+        outputFile = "../data/result.npz";
+        writer = new NumpyWriter(outputFile);
+    } else if (outputChoice == 4) {
+        outputFile = "../data/result.bres";
+        writer = new BinaryWriter(outputFile, params.getAlgorithm());
     } else {
         outputFile = "../data/result.txt";
         writer = new TextFileWriter(outputFile);
     }
 
-    if (algorithm == "power" || algorithm == "PowerMethod") {
-        PowerMethod<double> pm(matrix, params);
-        pm.solve();
+    BisectionMethod bisection(matrix, params);
+    solveTimed(bisection, writer);
 
-        std::cout << "\n Results" << std::endl;
-        std::cout << "Eigenvalue: " << pm.getEigenvalue() << std::endl;
-        std::cout << "Iterations: " << pm.getIterationCount() << std::endl;
-        std::cout << "Converged: " << (pm.hasConverged() ? "Yes" : "No") << std::endl;
+    std::cout << "\nResults (Bisection Method)" << std::endl;
+    std::cout << "Bisection steps: " << bisection.getIterationCount() << std::endl;
+    std::cout << "Converged: " << (bisection.hasConverged() ? "Yes" : "No") << std::endl;
 
-        writer->write(pm.getEigenvalue(), pm.getEigenvector(),
-                     pm.getIterationCount(), pm.hasConverged());
+    std::cout << "\nSelected Eigenvalues:" << std::endl;
+    Eigen::VectorXd eigenvalues = bisection.getAllEigenvalues();
+    for (int i = 0; i < eigenvalues.size(); ++i) {
+        std::cout << "  λ" << (i+1) << " = " << eigenvalues(i) << std::endl;
+    }
 
-    } else if (algorithm == "shifted_inverse" || algorithm == "ShiftedInversePowerMethod") {
-        ShiftedInversePowerMethod<double> sipm(matrix, params);
-        sipm.solve();
+    writer->writeAll(eigenvalues, bisection.getAllEigenvectors(),
+                     bisection.getIterationCount(), bisection.hasConverged());
 
-        std::cout << "\nResults" << std::endl;
-        std::cout << "Eigenvalue: " << sipm.getEigenvalue() << std::endl;
-        std::cout << "Iterations: " << sipm.getIterationCount() << std::endl;
-        std::cout << "Converged: " << (sipm.hasConverged() ? "Yes" : "No") << std::endl;
+    delete writer;
+    std::cout << "\nResults written to: " << outputFile << std::endl;
+}
 
-        writer->write(sipm.getEigenvalue(), sipm.getEigenvector(),
-                     sipm.getIterationCount(), sipm.hasConverged());
+// ====================================
+// Vue sur la matrice : les pages du fichier binaire si possible, sinon la matrice lue
+// ====================================
+template<typename Scalar>
+Eigen::Map<const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>> matrixView(
+        BinaryReader<Scalar>* binaryReader, Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>& matrix) {
+    if (binaryReader) {
+        const BinaryMatrixHeader& header = binaryReader->header();
+        bool complexFile = header.scalarType == kBinaryScalarComplex;
+        if (complexFile == Eigen::NumTraits<Scalar>::IsComplex && header.storageOrder == 0) {
+            return binaryReader->MapMatrix();
+        }
+        // Other scalar type or row-major data: converted copy
+        matrix = binaryReader->ReadMatrix();
+    }
+    return Eigen::Map<const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>>(matrix.data(), matrix.rows(), matrix.cols());
+}
 
+// Arrays saved in Fortran order are mapped in place, the others are copied
+template<typename Scalar>
+Eigen::Map<const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>> matrixView(
+        NumpyReader<Scalar>* numpyReader, Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>& matrix) {
+    if (numpyReader && numpyReader->isMappable()) {
+        return numpyReader->MapMatrix();
+    }
+    if (numpyReader) {
+        matrix = numpyReader->ReadMatrix();
     }
-    else if (algorithm == "qr" || algorithm == "QRMethod") {
-        QRMethod<double> qr(matrix, params);
-        qr.solve();
+    return Eigen::Map<const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>>(matrix.data(), matrix.rows(), matrix.cols());
+}
 
-        std::cout << "\nResults (QR Method)" << std::endl;
-        std::cout << "Iterations: " << qr.getIterationCount() << std::endl;
-        std::cout << "Converged: " << (qr.hasConverged() ? "Yes" : "No") << std::endl;
+// ====================================
+// FONCTION pour traiter avec double
+// ====================================
+void runComputationDouble(const CommandLineOptions& options) {
+    const std::string& inputFile = options.inputFile;
 
-        // Afficher TOUTES les valeurs propres trouvées
-        std::cout << "\nAll Eigenvalues found:" << std::endl;
-        Eigen::VectorXd allEigenvalues = qr.getAllEigenvalues();
+    //Read Matrix
+    Eigen::MatrixXd matrix;
+    Eigen::MatrixXd matrixB;
+    Parameters params;
 
-        for (int i = 0; i < allEigenvalues.size(); ++i) {
-            std::cout << "  λ" << (i+1) << " = " << allEigenvalues(i) << std::endl;
+    // Binary and NumPy files are mapped, not read: the solvers use the mapped pages in place
+    std::unique_ptr<BinaryReader<double>> binaryReader;
+    std::unique_ptr<NumpyReader<double>> numpyReader;
+
+    if (inputFile.find(".bmat") != std::string::npos) {
+        binaryReader.reset(new BinaryReader<double>(inputFile));
+        params = binaryReader->ReadParameters();
+    } else if (inputFile.find(".npy") != std::string::npos || inputFile.find(".npz") != std::string::npos) {
+        numpyReader.reset(new NumpyReader<double>(inputFile));
+        params = numpyReader->ReadParameters();
+        matrixB = numpyReader->ReadMatrixB();
+        // The generalized solvers take owned matrices
+        if (matrixB.size() > 0) {
+            matrix = numpyReader->ReadMatrix();
+            numpyReader.reset();
         }
+    } else if (inputFile.find(".mtx") != std::string::npos) {
+        MatrixMarketReader<double> reader(inputFile);
+        params = reader.ReadParameters();
+        if (params.getAlgorithm() != "BisectionMethod" && !params.getOutOfCore()) {
+            matrix = reader.ReadMatrix();
+        }
+    } else if (inputFile.find(".csv") != std::string::npos) {
+        CSVReader<double> reader(inputFile);
+        params = reader.ReadParameters();
+        if (params.getAlgorithm() != "BisectionMethod" && !params.getOutOfCore()) {
+            matrix = reader.ReadMatrix();
+            matrixB = reader.ReadMatrixB();
+        }
+    } else {
+        TextFileReader<double> reader(inputFile);
+        params = reader.ReadParameters();
+        if (params.getAlgorithm() != "BisectionMethod" && !params.getOutOfCore()) {
+            matrix = reader.ReadMatrix();
+            matrixB = reader.ReadMatrixB();
+        }
+    }
 
-        std::cout << "\nAll Eigenvectors:" << std::endl;
-        Eigen::MatrixXd allEigenvectors = qr.getAllEigenvectors();
+    // The matrix is never loaded: it is streamed from the file at every iteration
+    if (params.getOutOfCore()) {
+        runOutOfCore<double>(options, params);
+        return;
+    }
 
-        for (int i = 0; i < allEigenvectors.cols(); ++i) {
-            std::cout << "\n  v_" << (i+1) << " =" << std::endl;
-            for (int j = 0; j < allEigenvectors.rows(); ++j) {
-                std::cout << "    " << allEigenvectors(j, i) << std::endl;
-            }
-        }
+    // Tridiagonal inputs are never expanded to a dense matrix
+    if (params.getAlgorithm() == "BisectionMethod") {
+        runComputationTridiagonal(options);
+        return;
+    }
+
+    applyCommandLine(options, params);
+    auto matrixA = numpyReader ? matrixView(numpyReader.get(), matrix) : matrixView(binaryReader.get(), matrix);
 
-        // Pour le Writer, on utilise la valeur propre dominante
-        writer->writeAll(qr.getAllEigenvalues(), qr.getAllEigenvectors(),
-                    qr.getIterationCount(), qr.hasConverged());
+    std::cout << "\nMatrix size " << matrixA.rows() << "x" << matrixA.cols() << std::endl;
+    std::cout << "\nMatrix:" << std::endl;
+    std::cout << matrixA << std::endl;
 
+    if (!params.validate()) {
+        throw std::runtime_error("Invalid parameters!");
     }
 
-    else {
-        delete writer;
-        throw std::runtime_error("Unknown algorithm: " + algorithm);
+    std::cout << "\nParameters" << std::endl;
+    params.display();
+
+    // Demander le format de sortie
+    std::cout << "  SELECT OUTPUT FORMAT" << std::endl;
+    std::cout << "1 - CSV format (.csv)" << std::endl;
+    std::cout << "2 - Text format (.txt)" << std::endl;
+    std::cout << "3 - NumPy archive (.npz)" << std::endl;
+    std::cout << "4 - Binary result (.bres)" << std::endl;
+    std::cout << "\nYour choice [1, 2, 3 or 4]: ";
+
+    int outputChoice;
+    std::cin >> outputChoice;
+
+    const std::string format = outputChoice == 1 ? "csv" : outputChoice == 3 ? "npz"
+                             : outputChoice == 4 ? "bres" : "txt";
+    const std::string outputFile = "../data/result" + outputExtension(format);
+    std::unique_ptr<Writer> writer = createWriter(format, outputFile, params.getAlgorithm());
+
+    // Generalized problem A x = lambda B x: the generalized solvers take the owned matrices
+    SolveResult<double> result;
+    if (matrixB.size() > 0) {
+        std::cout << "\nGeneralized problem with B of size " << matrixB.rows() << "x" << matrixB.cols() << std::endl;
+        result = solveProblem<double>(matrix, matrixB, params);
+    } else {
+        result = solveProblem<double>(matrixA, matrixB, params);
     }
+    writeResult(result, *writer);
+    printResult(result, params, options.plot);
 
-    delete writer;
     std::cout << "\nResults written to: " << outputFile << std::endl;
 }
 
 //To treat complex numbers
-void runComputationComplex(const std::string& inputFile) {
+void runComputationComplex(const CommandLineOptions& options) {
+    const std::string& inputFile = options.inputFile;
 
     // Lire la matrice et les paramètres
     Eigen::MatrixXcd matrix;
+    Eigen::MatrixXcd matrixB;
     Parameters params;
 
-    if (inputFile.find(".csv") != std::string::npos) {
+    // Binary and NumPy files are mapped, not read: the solvers use the mapped pages in place
+    std::unique_ptr<BinaryReader<std::complex<double>>> binaryReader;
+    std::unique_ptr<NumpyReader<std::complex<double>>> numpyReader;
+
+    if (inputFile.find(".bmat") != std::string::npos) {
+        binaryReader.reset(new BinaryReader<std::complex<double>>(inputFile));
+        params = binaryReader->ReadParameters();
+    } else if (inputFile.find(".npy") != std::string::npos || inputFile.find(".npz") != std::string::npos) {
+        numpyReader.reset(new NumpyReader<std::complex<double>>(inputFile));
+        params = numpyReader->ReadParameters();
+        matrixB = numpyReader->ReadMatrixB();
+        // The generalized solvers take owned matrices
+        if (matrixB.size() > 0) {
+            matrix = numpyReader->ReadMatrix();
+            numpyReader.reset();
+        }
+    } else if (inputFile.find(".mtx") != std::string::npos) {
+        MatrixMarketReader<std::complex<double>> reader(inputFile);
+        params = reader.ReadParameters();
+        if (!params.getOutOfCore()) {
+            matrix = reader.ReadMatrix();
+        }
+    } else if (inputFile.find(".csv") != std::string::npos) {
         CSVReader<std::complex<double>> reader(inputFile);
-        matrix = reader.ReadMatrix();
         params = reader.ReadParameters();
+        if (!params.getOutOfCore()) {
+            matrix = reader.ReadMatrix();
+            matrixB = reader.ReadMatrixB();
+        }
     } else {
         TextFileReader<std::complex<double>> reader(inputFile);
-        matrix = reader.ReadMatrix();
         params = reader.ReadParameters();
+        if (!params.getOutOfCore()) {
+            matrix = reader.ReadMatrix();
+            matrixB = reader.ReadMatrixB();
+        }
     }
 
-    std::cout << "\nMatrix size: " << matrix.rows() << "x" << matrix.cols() << std::endl;
+    // The matrix is never loaded: it is streamed from the file at every iteration
+    if (params.getOutOfCore()) {
+        runOutOfCore<std::complex<double>>(options, params);
+        return;
+    }
+
+    applyCommandLine(options, params);
+    auto matrixA = numpyReader ? matrixView(numpyReader.get(), matrix) : matrixView(binaryReader.get(), matrix);
+
+    std::cout << "\nMatrix size: " << matrixA.rows() << "x" << matrixA.cols() << std::endl;
     std::cout << "\nMatrix:" << std::endl;
-    std::cout << matrix << std::endl;
+    std::cout << matrixA << std::endl;
 
     if (!params.validate()) {
         throw std::runtime_error("Invalid parameters!");
@@ -157,82 +663,185 @@ void runComputationComplex(const std::string& inputFile) {
     std::cout << "\nParameters " << std::endl;
     params.display();
 
-    std::string algorithm = params.getAlgorithm();
-
-
     // Demander le format de sortie
     std::cout << "  \nSELECT OUTPUT FORMAT" << std::endl;
 
     std::cout << "1 - CSV format (.csv)" << std::endl;
     std::cout << "2 - Text format (.txt)" << std::endl;
-    std::cout << "\nYour choice [1 or 2]: ";
+    std::cout << "3 - NumPy archive (.npz)" << std::endl;
+    std::cout << "4 - Binary result (.bres)" << std::endl;
+    std::cout << "\nYour choice [1, 2, 3 or 4]: ";
 
     int outputChoice;
     std::cin >> outputChoice;
 
-    std::string outputFile;
-    Writer* writer = nullptr;
+    const std::string format = outputChoice == 1 ? "csv" : outputChoice == 3 ? "npz"
+                             : outputChoice == 4 ? "bres" : "txt";
+    const std::string outputFile = "../data/result_complex" + outputExtension(format);
+    std::unique_ptr<Writer> writer = createWriter(format, outputFile, params.getAlgorithm());
 
-    if (outputChoice == 1) {
-        outputFile = "../data/result_complex.csv";
-        writer = new CSVWriter(outputFile);
+    // Generalized problem A x = lambda B x: the generalized solvers take the owned matrices
+    SolveResult<std::complex<double>> result;
+    if (matrixB.size() > 0) {
+        std::cout << "\nGeneralized problem with B of size " << matrixB.rows() << "x" << matrixB.cols() << std::endl;
+        result = solveProblem<std::complex<double>>(matrix, matrixB, params);
     } else {
-        outputFile = "../data/result_complex.txt";
-        writer = new TextFileWriter(outputFile);
+        result = solveProblem<std::complex<double>>(matrixA, matrixB, params);
     }
+    writeResult(result, *writer);
+    printResult(result, params, options.plot);
 
-    if (algorithm == "power" || algorithm == "PowerMethod") {
-        PowerMethod<std::complex<double>> pm(matrix, params);
-        pm.solve();
-
-        std::cout << "\nResults " << std::endl;
-        std::cout << "Eigenvalue: " << pm.getEigenvalue() << std::endl;
-        std::cout << "Iterations: " << pm.getIterationCount() << std::endl;
-        std::cout << "Converged: " << (pm.hasConverged() ? "Yes" : "No") << std::endl;
-
-        writer->write(pm.getEigenvalue(), pm.getEigenvector(),
-                     pm.getIterationCount(), pm.hasConverged());
+    std::cout << "\nResults written to: " << outputFile << std::endl;
+}
 
-    } else if (algorithm == "shifted_inverse" || algorithm == "ShiftedInversePowerMethod") {
-        ShiftedInversePowerMethod<std::complex<double>> sipm(matrix, params);
-        sipm.solve();
+// ====================================
+// FONCTION pour convertir un fichier en fichier binaire (.bmat) ou NumPy (.npy)
+// ====================================
+template<typename Scalar>
+void runConversion(const CommandLineOptions& options) {
+    std::unique_ptr<Reader<Scalar>> reader;
+    if (options.inputFile.find(".mtx") != std::string::npos) {
+        reader.reset(new MatrixMarketReader<Scalar>(options.inputFile));
+    } else if (options.inputFile.find(".npy") != std::string::npos || options.inputFile.find(".npz") != std::string::npos) {
+        reader.reset(new NumpyReader<Scalar>(options.inputFile));
+    } else if (options.inputFile.find(".csv") != std::string::npos) {
+        reader.reset(new CSVReader<Scalar>(options.inputFile));
+    } else {
+        reader.reset(new TextFileReader<Scalar>(options.inputFile));
+    }
+    Parameters params = reader->ReadParameters();
+    Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> matrix = reader->ReadMatrix();
+    if (options.convertTo.find(".npy") != std::string::npos) {
+        NpyMatrixWriter::write(options.convertTo, matrix);
+    } else {
+        BinaryMatrixWriter::write(options.convertTo, matrix, &params);
+    }
+    std::cout << "\nMatrix " << matrix.rows() << "x" << matrix.cols() << " written to: " << options.convertTo << std::endl;
+}
 
-        std::cout << "\nResults " << std::endl;
-        std::cout << "Eigenvalue: " << sipm.getEigenvalue() << std::endl;
-        std::cout << "Iterations: " << sipm.getIterationCount() << std::endl;
-        std::cout << "Converged: " << (sipm.hasConverged() ? "Yes" : "No") << std::endl;
+// ====================================
+// FONCTION pour le mode flux : lecture, résolution et écriture en parallèle
+// ====================================
+template<typename Scalar>
+void runStream(const CommandLineOptions& options) {
+    PipelineOptions pipelineOptions;
+    pipelineOptions.outputDirectory = options.outputDirectory;
+    pipelineOptions.format = options.format;
+    pipelineOptions.queueDepth = static_cast<std::size_t>(std::max(1, options.queueDepth));
+    pipelineOptions.threads = options.threads;
+    SolvePipeline<Scalar> pipeline(pipelineOptions);
+
+    PipelineStats stats;
+    if (options.stream == "-") {
+        stats = pipeline.run(std::cin, std::cout);
+    } else {
+        std::ifstream input(options.stream, std::ios::binary);
+        if (!input) {
+            throw std::runtime_error("Cannot open the stream file: " + options.stream);
+        }
+        stats = pipeline.run(input, std::cout);
+    }
 
-        writer->write(sipm.getEigenvalue(), sipm.getEigenvector(),
-                     sipm.getIterationCount(), sipm.hasConverged());
+    std::cout << "\n" << stats.documents << " documents: " << stats.solved << " solved, " << stats.failed
+              << " failed" << std::endl;
+    std::cout << "Read " << stats.readSeconds << " s, solve " << stats.solveSeconds << " s, write "
+              << stats.writeSeconds << " s, wall " << stats.wallSeconds << " s" << std::endl;
+}
 
+// ====================================
+// FONCTION pour le mode batch : un fichier de résultats par entrée, sans question
+// ====================================
+template<typename Scalar>
+void runBatch(const CommandLineOptions& options) {
+    BatchOptions batchOptions;
+    batchOptions.outputDirectory = options.outputDirectory;
+    batchOptions.format = options.format;
+    batchOptions.algorithm = options.algorithm;
+    batchOptions.jobs = options.jobs;
+    batchOptions.threads = options.threads;
+    batchOptions.cacheDirectory = options.cache;
+    batchOptions.cacheBytes = static_cast<std::uint64_t>(options.cacheMegabytes * 1024 * 1024);
+    BatchRunner<Scalar> runner(batchOptions);
+
+    std::vector<std::string> inputs = expandInputs(options.inputs);
+    if (inputs.empty()) {
+        throw std::runtime_error("No input file for the batch");
     }
-    else if (algorithm == "qr" || algorithm == "QRMethod") {
-        QRMethod<std::complex<double>> qr(matrix, params);
-        qr.solve();
-
-        std::cout << "\nResults (QR Method)" << std::endl;
-        std::cout << "Iterations: " << qr.getIterationCount() << std::endl;
-        std::cout << "Converged: " << (qr.hasConverged() ? "Yes" : "No") << std::endl;
+    BatchStats stats = runner.run(inputs, std::cout);
+
+    std::cout << "\n" << stats.jobs << " jobs: " << stats.solved << " solved, " << stats.failed << " failed, "
+              << stats.stolen << " stolen, " << stats.cached << " from the cache, " << stats.duplicates
+              << " duplicates" << std::endl;
+    std::cout << "Job time " << stats.jobSeconds << " s, wall " << stats.wallSeconds << " s" << std::endl;
+    if (stats.failed > 0) {
+        throw std::runtime_error(std::to_string(stats.failed) + " jobs failed");
+    }
+}
 
-        // Afficher TOUTES les valeurs propres trouvées
-        std::cout << "\nAll Eigenvalues found:" << std::endl;
-        Eigen::VectorXcd allEigenvalues = qr.getAllEigenvalues();
+// ====================================
+// FONCTIONS pour le mode serveur : un solveur résident répond aux requêtes d'un socket Unix
+// ====================================
+SolverServer* gServer = nullptr;
 
-        for (int i = 0; i < allEigenvalues.size(); ++i) {
-            std::cout << "  λ" << (i+1) << " = " << allEigenvalues(i) << std::endl;
-        }
+void stopServer(int) {
+    if (gServer) {
+        gServer->stop();
+    }
+}
 
+void runServer(const CommandLineOptions& options) {
+    ServerOptions serverOptions;
+    serverOptions.address = options.serve;
+    serverOptions.workers = options.jobs;
+    serverOptions.solverThreads = options.threads >= 0 ? options.threads : 1;
+    serverOptions.maxPending = static_cast<std::size_t>(std::max(1, options.maxPending));
+    serverOptions.maxConnections = static_cast<std::size_t>(std::max(1, options.maxConnections));
+    serverOptions.defaultDeadlineSeconds = options.deadline;
+    serverOptions.cacheDirectory = options.cache;
+    serverOptions.cacheBytes = static_cast<std::uint64_t>(options.cacheMegabytes * 1024 * 1024);
+    SolverServer server(serverOptions);
+
+    gServer = &server;
+    std::signal(SIGINT, stopServer);
+    std::signal(SIGTERM, stopServer);
+    std::cout << "Serving on " << server.path() << " (Ctrl-C to stop)" << std::endl;
+    server.serve();
+    gServer = nullptr;
+
+    ServerStats stats = server.stats();
+    std::cout << "\n" << stats.connections << " connections, " << stats.requests << " requests: " << stats.solved
+              << " solved, " << stats.failed << " failed, " << stats.rejected << " busy, " << stats.expired
+              << " past their deadline, " << stats.cached << " from the cache" << std::endl;
+}
 
-        writer->writeAll(qr.getAllEigenvalues(), qr.getAllEigenvectors(),
-                    qr.getIterationCount(), qr.hasConverged());
+template<typename Scalar>
+void runRequest(const CommandLineOptions& options) {
+    if (options.inputFile.empty()) {
+        throw std::runtime_error("No input file for the request");
     }
-    else {
-        delete writer;
-        throw std::runtime_error("Unknown algorithm: " + algorithm);
+    std::unique_ptr<Reader<Scalar>> reader = createReader<Scalar>(options.inputFile);
+    Parameters params = reader->ReadParameters();
+    if (!options.algorithm.empty()) {
+        params.setAlgorithm(options.algorithm);
     }
-
-    delete writer;
-    std::cout << "\nResults written to: " << outputFile << std::endl;
+    Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> matrixA = reader->ReadMatrix();
+    Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> matrixB = reader->ReadMatrixB();
+    reader.reset();
+
+    SolverClient client(options.request);
+    SolveReply<Scalar> reply = client.solve<Scalar>(matrixA, matrixB, params, options.deadline);
+    if (reply.status != SolveStatus::Ok) {
+        throw std::runtime_error(std::string("Request ") + statusName(reply.status) +
+                                 (reply.message.empty() ? "" : ": " + reply.message));
+    }
+    std::cout << "Solved in " << reply.result.solveSeconds << " s after waiting " << reply.queueSeconds << " s, "
+              << reply.result.iterations << " iterations, "
+              << (reply.result.converged ? "converged" : "not converged") << std::endl;
+
+    std::string outputFile = options.outputDirectory + "/" + resultName(options.inputFile,
+                                                                         outputExtension(options.format));
+    std::unique_ptr<Writer> writer = createWriter(options.format, outputFile, params.getAlgorithm());
+    writeResult(reply.result, *writer);
 }
 
 // ====================================
@@ -240,13 +849,66 @@ void runComputationComplex(const std::string& inputFile) {
 // ====================================
 int main(int argc, char* argv[]) {
     try {
-        std::string inputFile;
+        // Usage: PCSC_project [input file] [--threads N] [--pin-threads]
+        //                    [--ranks N [--rank R] [--connect unix:PATH | tcp:HOST:PORT]]
+        //                    [--convert OUTPUT.bmat | OUTPUT.npy]
+        //                    [--stream FILE | - [--type real|complex] [--format csv|txt|npz|bres]
+        //                     [--output-dir DIR] [--queue-depth N]]
+        //                    [--batch [--jobs N] [--algorithm NAME] [--type ...] [--format ...] [--output-dir DIR]
+        //                     [--cache DIR [--cache-size MB]] INPUT | 'PATTERN' | @MANIFEST ...]
+        //                    [--serve unix:PATH [--jobs N] [--threads N] [--max-pending N]
+        //                     [--max-connections N] [--deadline SECONDS] [--cache DIR [--cache-size MB]]]
+        //                    [--request unix:PATH INPUT [--deadline SECONDS] [--algorithm NAME] [--type ...]
+        //                     [--format ...] [--output-dir DIR]]
+        //                    [--plot FILE [--history N]] [--eigenvectors all | none | I,J,...]
+        CommandLineOptions options = parseCommandLine(argc, argv);
+
+        // Server mode: solve the requests of the clients until interrupted
+        if (!options.serve.empty()) {
+            runServer(options);
+            return 0;
+        }
 
-        if (argc > 1) {
-            inputFile = argv[1];
-        } else {
+        // Client of a server: one input sent, its result written
+        if (!options.request.empty()) {
+            if (options.complex) {
+                runRequest<std::complex<double>>(options);
+            } else {
+                runRequest<double>(options);
+            }
+            return 0;
+        }
+
+        // Batch mode: many input files, no question asked
+        if (options.batch) {
+            if (options.complex) {
+                runBatch<std::complex<double>>(options);
+            } else {
+                runBatch<double>(options);
+            }
+            return 0;
+        }
+
+        // Stream mode: many documents, no question asked
+        if (!options.stream.empty()) {
+            if (options.complex) {
+                runStream<std::complex<double>>(options);
+            } else {
+                runStream<double>(options);
+            }
+            return 0;
+        }
+
+        if (options.inputFile.empty()) {
             std::cout << "Enter input file path: ";
-            std::cin >> inputFile;
+            std::cin >> options.inputFile;
+        }
+
+        // Distributed mode: real matrices only, no data type question
+        if (options.ranks > 1) {
+            runDistributed(options);
+            std::cout << "  COMPUTATION COMPLETED SUCCESSFULLY" << std::endl;
+            return 0;
         }
 
 
@@ -260,10 +922,16 @@ int main(int argc, char* argv[]) {
         int choice;
         std::cin >> choice;
 
-        if (choice == 1) {
-            runComputationDouble(inputFile);
+        if (!options.convertTo.empty()) {
+            if (choice == 1) {
+                runConversion<double>(options);
+            } else {
+                runConversion<std::complex<double>>(options);
+            }
+        } else if (choice == 1) {
+            runComputationDouble(options);
         } else if (choice == 2) {
-            runComputationComplex(inputFile);
+            runComputationComplex(options);
         } else {
             throw std::runtime_error("Invalid choice! Must be 1 or 2.");
         }